@@ -40,6 +40,7 @@
 #include "nodes/makefuncs.h"
 #include "nodes/nodeFuncs.h"
 #include "nodes/primnodes.h"
+#include "utils/fmgroids.h"
 #include "utils/memutils.h"
 #include "utils/numeric.h"
 #include "utils/rowtypes.h"
@@ -424,6 +425,123 @@ YbgStatus YbgExprCollation(const YbgPreparedExpr expr, int32_t *collid)
 	PG_STATUS_OK();
 }
 
+/*
+ * Returns true if funcid is a comparison function of two integers of the same type, and sets
+ * op accordingly.
+ */
+static bool
+yb_integer_compare_op(Oid funcid, YbgCompareOp *op)
+{
+	switch (funcid)
+	{
+		case F_INT2EQ:
+		case F_INT4EQ:
+		case F_INT8EQ:
+			*op = YBG_COMPARE_EQ;
+			return true;
+		case F_INT2NE:
+		case F_INT4NE:
+		case F_INT8NE:
+			*op = YBG_COMPARE_NE;
+			return true;
+		case F_INT2LT:
+		case F_INT4LT:
+		case F_INT8LT:
+			*op = YBG_COMPARE_LT;
+			return true;
+		case F_INT2LE:
+		case F_INT4LE:
+		case F_INT8LE:
+			*op = YBG_COMPARE_LE;
+			return true;
+		case F_INT2GT:
+		case F_INT4GT:
+		case F_INT8GT:
+			*op = YBG_COMPARE_GT;
+			return true;
+		case F_INT2GE:
+		case F_INT4GE:
+		case F_INT8GE:
+			*op = YBG_COMPARE_GE;
+			return true;
+		default:
+			return false;
+	}
+}
+
+static int64_t
+yb_integer_datum_value(Oid typid, Datum datum)
+{
+	switch (typid)
+	{
+		case INT2OID:
+			return DatumGetInt16(datum);
+		case INT4OID:
+			return DatumGetInt32(datum);
+		default:
+			return DatumGetInt64(datum);
+	}
+}
+
+static bool
+yb_expr_column_comparison(Node *expr, YbgColumnComparison *comparison)
+{
+	OpExpr	   *opexpr;
+	YbgCompareOp op;
+	Node	   *left;
+	Node	   *right;
+	Var		   *var;
+	Const	   *con;
+
+	if (!IsA(expr, OpExpr))
+		return false;
+	opexpr = (OpExpr *) expr;
+	if (list_length(opexpr->args) != 2 || !yb_integer_compare_op(opexpr->opfuncid, &op))
+		return false;
+
+	left = (Node *) linitial(opexpr->args);
+	right = (Node *) lsecond(opexpr->args);
+	if (IsA(left, Const) && IsA(right, Var))
+	{
+		/* Constant on the left side, so swap the sides and the comparison. */
+		Node	   *tmp = left;
+		left = right;
+		right = tmp;
+		switch (op)
+		{
+			case YBG_COMPARE_LT: op = YBG_COMPARE_GT; break;
+			case YBG_COMPARE_LE: op = YBG_COMPARE_GE; break;
+			case YBG_COMPARE_GT: op = YBG_COMPARE_LT; break;
+			case YBG_COMPARE_GE: op = YBG_COMPARE_LE; break;
+			default: break;
+		}
+	}
+	if (!IsA(left, Var) || !IsA(right, Const))
+		return false;
+
+	var = (Var *) left;
+	con = (Const *) right;
+	if (var->vartype != con->consttype ||
+		(var->vartype != INT2OID && var->vartype != INT4OID && var->vartype != INT8OID))
+		return false;
+
+	comparison->attno = var->varattno;
+	comparison->op = op;
+	comparison->value_is_null = con->constisnull;
+	comparison->value = con->constisnull
+		? 0 : yb_integer_datum_value(con->consttype, con->constvalue);
+	return true;
+}
+
+YbgStatus YbgExprColumnComparison(const YbgPreparedExpr expr,
+								  YbgColumnComparison *comparison,
+								  bool *is_column_comparison)
+{
+	PG_SETUP_ERROR_REPORTING();
+	*is_column_comparison = yb_expr_column_comparison((Node *) expr, comparison);
+	PG_STATUS_OK();
+}
+
 YbgStatus YbgEvalExpr(YbgPreparedExpr expr, YbgExprContext expr_ctx, uint64_t *datum, bool *is_null)
 {
 	PG_SETUP_ERROR_REPORTING();
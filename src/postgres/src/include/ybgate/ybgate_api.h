@@ -162,6 +162,39 @@ YbgStatus YbgExprTypmod(const YbgPreparedExpr expr, int32_t *typmod);
 
 YbgStatus YbgExprCollation(const YbgPreparedExpr expr, int32_t *collid);
 
+/*
+ * Comparison operators recognized by YbgExprColumnComparison.
+ */
+typedef enum YbgCompareOp
+{
+	YBG_COMPARE_EQ,
+	YBG_COMPARE_NE,
+	YBG_COMPARE_LT,
+	YBG_COMPARE_LE,
+	YBG_COMPARE_GT,
+	YBG_COMPARE_GE,
+} YbgCompareOp;
+
+/*
+ * Comparison of an integer column with a constant of the same type.
+ */
+typedef struct YbgColumnComparison
+{
+	int32_t attno;
+	YbgCompareOp op;
+	int64_t value;
+	bool value_is_null;
+} YbgColumnComparison;
+
+/*
+ * Check whether the expression is a comparison of an int2, int4 or int8 column with a constant,
+ * so it could be evaluated by the caller without the expression context.
+ * Sets is_column_comparison to false if it is not.
+ */
+YbgStatus YbgExprColumnComparison(const YbgPreparedExpr expr,
+								  YbgColumnComparison *comparison,
+								  bool *is_column_comparison);
+
 /*
  * Evaluate an expression, using the expression context to resolve scan variables.
  * Will filling in datum and is_null with the result.
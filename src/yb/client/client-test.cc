@@ -46,6 +46,7 @@
 #include "yb/client/client_utils.h"
 #include "yb/client/error.h"
 #include "yb/client/meta_cache.h"
+#include "yb/client/pipelined_session.h"
 #include "yb/client/schema.h"
 #include "yb/client/session.h"
 #include "yb/client/table.h"
@@ -125,11 +126,13 @@ DECLARE_int32(master_inject_latency_on_tablet_lookups_ms);
 DECLARE_int32(max_create_tablets_per_ts);
 DECLARE_int32(tablet_server_svc_queue_length);
 DECLARE_int32(replication_factor);
+DECLARE_uint32(pipelined_session_batch_size);
 
 DEFINE_UNKNOWN_int32(test_scan_num_rows, 1000, "Number of rows to insert and scan");
 DECLARE_int32(min_backoff_ms_exponent);
 DECLARE_int32(max_backoff_ms_exponent);
 DECLARE_bool(TEST_force_master_lookup_all_tablets);
+DECLARE_bool(meta_cache_lock_free_lookup);
 DECLARE_double(TEST_simulate_lookup_timeout_probability);
 
 DECLARE_bool(ysql_legacy_colocated_database_creation);
@@ -2654,6 +2657,106 @@ TEST_F(ClientTest, RefreshPartitions) {
   LOG(INFO) << "num_lookups_done: " << num_lookups_done;
 }
 
+// Checks that lookups by key of cached tablets are served from the meta cache snapshot, without
+// master lookups, and return tablets serving the requested keys. With lock free lookups disabled
+// the same lookups should be served by the locked path.
+TEST_F(ClientTest, LockFreeLookupTabletByKey) {
+  const auto kNumThreads = 4;
+  const auto kNumLookupsPerThread = 1000;
+
+  const auto table = client_table_.table();
+  const auto lookup = [this, &table](const PartitionKey& partition_key) {
+    return client_->LookupTabletByKeyFuture(
+        table, partition_key, CoarseMonoClock::now() + 10s).get();
+  };
+
+  // Fill the cache.
+  for (const auto& partition_start : table->GetPartitionsCopy()) {
+    ASSERT_OK(lookup(partition_start));
+  }
+
+  for (auto lock_free : {true, false}) {
+    LOG(INFO) << "Lock free lookup: " << lock_free;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_meta_cache_lock_free_lookup) = lock_free;
+
+    const auto lookup_serial_start = client::internal::TEST_GetLookupSerial();
+    const auto lock_free_lookups_start = client::internal::TEST_GetLockFreeLookups();
+
+    TestThreadHolder thread_holder;
+    for (int i = 0; i != kNumThreads; ++i) {
+      thread_holder.AddThreadFunctor([&lookup] {
+        for (int j = 0; j != kNumLookupsPerThread; ++j) {
+          const auto hash_code = RandomUniformInt<uint16_t>(0, PartitionSchema::kMaxPartitionKey);
+          const auto partition_key = PartitionSchema::EncodeMultiColumnHashValue(hash_code);
+          auto tablet = ASSERT_RESULT(lookup(partition_key));
+          ASSERT_TRUE(tablet->partition().ContainsKey(partition_key))
+              << "Key: " << Slice(partition_key).ToDebugHexString()
+              << ", tablet: " << tablet->ToString();
+        }
+      });
+    }
+    thread_holder.JoinAll();
+
+    ASSERT_EQ(client::internal::TEST_GetLookupSerial(), lookup_serial_start);
+    ASSERT_EQ(client::internal::TEST_GetLockFreeLookups() - lock_free_lookups_start,
+              lock_free ? kNumThreads * kNumLookupsPerThread : 0);
+  }
+}
+
+// Checks that operations applied to the pipelined session are written and reported
+// one by one.
+TEST_F(ClientTest, PipelinedSession) {
+  constexpr int kNumRows = 1000;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_pipelined_session_batch_size) = 16;
+
+  std::atomic<int> num_done{0};
+  std::atomic<int> num_failed{0};
+  {
+    YBPipelinedSession session(
+        client_.get(), 10s * kTimeMultiplier,
+        [&num_done, &num_failed](const YBOperationPtr& op, const Status& status) {
+      if (!status.ok()) {
+        LOG(WARNING) << "Operation " << op->ToString() << " failed: " << status;
+        ++num_failed;
+      }
+      ++num_done;
+    });
+    for (int i = 0; i != kNumRows; ++i) {
+      session.Apply(BuildTestRow(client_table_, i));
+    }
+    ASSERT_OK(session.Flush());
+  }
+  ASSERT_EQ(num_done.load(), kNumRows);
+  ASSERT_EQ(num_failed.load(), 0);
+  ASSERT_EQ(CountRowsFromClient(client_table_), kNumRows);
+}
+
+// Checks that operations that were not flushed before destruction of the pipelined session are
+// reported as aborted.
+TEST_F(ClientTest, PipelinedSessionDestroyedWithoutFlush) {
+  constexpr int kNumRows = 10;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_pipelined_session_batch_size) = kNumRows * 2;
+
+  std::atomic<int> num_done{0};
+  std::atomic<int> num_aborted{0};
+  {
+    YBPipelinedSession session(
+        client_.get(), 10s * kTimeMultiplier,
+        [&num_done, &num_aborted](const YBOperationPtr& op, const Status& status) {
+      if (status.IsAborted()) {
+        ++num_aborted;
+      }
+      ++num_done;
+    });
+    for (int i = 0; i != kNumRows; ++i) {
+      session.Apply(BuildTestRow(client_table_, i));
+    }
+  }
+  ASSERT_EQ(num_done.load(), kNumRows);
+  ASSERT_EQ(num_aborted.load(), kNumRows);
+  ASSERT_EQ(CountRowsFromClient(client_table_), 0);
+}
+
 class ColocationClientTest: public ClientTest {
  public:
   void SetUp() override {
@@ -34,9 +34,11 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <atomic>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
@@ -116,6 +118,10 @@ DEFINE_test_flag(double, simulate_lookup_timeout_probability, 0,
 DEFINE_test_flag(double, simulate_lookup_partition_list_mismatch_probability, 0,
                  "Probability for simulating the partition list mismatch error on tablet lookup.");
 
+DEFINE_RUNTIME_bool(meta_cache_lock_free_lookup, true,
+                    "Lookup tablets by partition key in the snapshot of the meta cache cached by "
+                    "the current thread, without locking the meta cache.");
+
 METRIC_DEFINE_coarse_histogram(
   server, dns_resolve_latency_during_init_proxy,
   "yb.client.MetaCache.InitProxy DNS Resolve",
@@ -155,6 +161,124 @@ const size_t kPartitionGroupSize = 4;
 #endif
 
 std::atomic<int64_t> lookup_serial_{1};
+std::atomic<int64_t> lock_free_lookups_{0};
+
+std::atomic<uint64_t> next_meta_cache_id{1};
+
+} // namespace
+
+// Immutable copy of TableData::tablets_by_partition and corresponding partition list.
+struct TabletsByPartitionSnapshot {
+  VersionedTablePartitionListPtr partition_list;
+  std::map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
+};
+
+// Versioned snapshot of a single table. Changing the table only bumps the version, the snapshot
+// is built on demand by the first lookup that needs it.
+class TableSnapshotHolder {
+ public:
+  uint64_t version() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  // Should be invoked under exclusive lock of MetaCache::mutex_, after tablets_by_partition or
+  // partition_list of the table was changed.
+  void Invalidate() {
+    version_.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot_ = nullptr;
+  }
+
+  // Returns the snapshot of the table and its version. The caller must hold shared lock of
+  // MetaCache::mutex_, so the table could not be changed concurrently.
+  std::shared_ptr<const TabletsByPartitionSnapshot> Get(
+      const TableData& table_data, uint64_t* version) {
+    *version = this->version();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (snapshot_version_ != *version || !snapshot_) {
+      snapshot_ = std::make_shared<TabletsByPartitionSnapshot>(TabletsByPartitionSnapshot {
+        .partition_list = table_data.partition_list,
+        .tablets_by_partition = table_data.tablets_by_partition,
+      });
+      snapshot_version_ = *version;
+    }
+    return snapshot_;
+  }
+
+ private:
+  std::atomic<uint64_t> version_{1};
+  std::mutex mutex_;
+  uint64_t snapshot_version_ GUARDED_BY(mutex_) = 0;
+  std::shared_ptr<const TabletsByPartitionSnapshot> snapshot_ GUARDED_BY(mutex_);
+};
+
+namespace {
+
+// Table snapshots used by the current thread. The lookup only reads the version of the table
+// snapshot, and takes the meta cache lock when the table was changed since the previous lookup.
+struct CachedTableSnapshot {
+  uint64_t meta_cache_id = 0;
+  TableId table_id;
+  std::shared_ptr<TableSnapshotHolder> holder;
+  uint64_t version = 0;
+  std::shared_ptr<const TabletsByPartitionSnapshot> snapshot;
+};
+
+constexpr size_t kMaxThreadTableSnapshots = 16;
+
+thread_local std::array<CachedTableSnapshot, kMaxThreadTableSnapshots> thread_table_snapshots;
+thread_local size_t thread_table_snapshots_next_idx = 0;
+thread_local size_t thread_table_snapshots_check_idx = 0;
+
+// Checks one of the snapshots cached by the current thread per call, and releases it if the table
+// was changed or removed. So the thread does not keep tablets of outdated snapshots alive.
+void ReleaseOutdatedThreadTableSnapshot() {
+  auto& entry = thread_table_snapshots[
+      thread_table_snapshots_check_idx++ % kMaxThreadTableSnapshots];
+  if (entry.holder && entry.holder->version() != entry.version) {
+    entry = CachedTableSnapshot();
+  }
+}
+
+// Finds tablet serving partition starting from partition_start_key, when partition list version
+// used to calculate it matches partition_list.
+RemoteTabletPtr FindTabletByPartitionStart(
+    const VersionedTablePartitionListPtr& partition_list,
+    const std::map<PartitionKey, RemoteTabletPtr>& tablets_by_partition,
+    const VersionedPartitionStartKey& versioned_partition_start_key) {
+  if (PREDICT_FALSE(
+          partition_list->version != versioned_partition_start_key.partition_list_version)) {
+    // TableData::partition_list version in cache does not match partition_list_version used to
+    // calculate partition_key_start, can't use cache.
+    return nullptr;
+  }
+
+  const auto& partition_start_key = *versioned_partition_start_key.key;
+
+  DCHECK_EQ(
+      partition_start_key,
+      *client::FindPartitionStart(partition_list, partition_start_key));
+  auto tablet_it = tablets_by_partition.find(partition_start_key);
+  if (PREDICT_FALSE(tablet_it == tablets_by_partition.end())) {
+    // No tablets with a start partition key lower than 'partition_key'.
+    return nullptr;
+  }
+
+  const auto& result = tablet_it->second;
+
+  // Stale entries must be re-fetched.
+  if (result->stale()) {
+    return nullptr;
+  }
+
+  if (result->partition().partition_key_end().compare(partition_start_key) > 0 ||
+      result->partition().partition_key_end().empty()) {
+    // partition_start_key < partition.end OR tablet does not end.
+    return result;
+  }
+
+  return nullptr;
+}
 
 } // namespace
 
@@ -162,6 +286,10 @@ int64_t TEST_GetLookupSerial() {
   return lookup_serial_.load(std::memory_order_acquire);
 }
 
+int64_t TEST_GetLockFreeLookups() {
+  return lock_free_lookups_.load(std::memory_order_acquire);
+}
+
 ////////////////////////////////////////////////////////////
 
 RemoteTabletServer::RemoteTabletServer(const master::TSInfoPB& pb)
@@ -321,8 +449,7 @@ RemoteTablet::RemoteTablet(std::string tablet_id,
       partition_(std::move(partition)),
       partition_list_version_(partition_list_version),
       split_depth_(split_depth),
-      split_parent_tablet_id_(split_parent_tablet_id),
-      stale_(false) {
+      split_parent_tablet_id_(split_parent_tablet_id) {
 }
 
 RemoteTablet::~RemoteTablet() {
@@ -365,18 +492,17 @@ void RemoteTablet::Refresh(
   } else {
     ++lookups_without_new_replicas_;
   }
-  stale_ = false;
+  UpdateHasLeaderUnlocked();
+  stale_.store(false, std::memory_order_release);
   refresh_time_.store(MonoTime::Now(), std::memory_order_release);
 }
 
 void RemoteTablet::MarkStale() {
-  std::lock_guard<rw_spinlock> lock(mutex_);
-  stale_ = true;
+  stale_.store(true, std::memory_order_release);
 }
 
 bool RemoteTablet::stale() const {
-  SharedLock<rw_spinlock> lock(mutex_);
-  return stale_;
+  return stale_.load(std::memory_order_acquire);
 }
 
 void RemoteTablet::MarkAsSplit() {
@@ -397,6 +523,7 @@ bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& statu
   for (RemoteReplica& rep : replicas_) {
     if (rep.ts == ts) {
       rep.MarkFailed();
+      UpdateHasLeaderUnlocked();
       return true;
     }
   }
@@ -457,7 +584,18 @@ RemoteTabletServer* RemoteTablet::LeaderTServer() const {
 }
 
 bool RemoteTablet::HasLeader() const {
-  return LeaderTServer() != nullptr;
+  return has_leader_.load(std::memory_order_acquire);
+}
+
+void RemoteTablet::UpdateHasLeaderUnlocked() {
+  bool has_leader = false;
+  for (const RemoteReplica& replica : replicas_) {
+    if (!replica.Failed() && replica.role == PeerRole::LEADER) {
+      has_leader = true;
+      break;
+    }
+  }
+  has_leader_.store(has_leader, std::memory_order_release);
 }
 
 void RemoteTablet::GetRemoteTabletServers(
@@ -565,6 +703,7 @@ void RemoteTablet::GetRemoteTabletServers(
         update.replica->ClearFailed();
       }
     }
+    UpdateHasLeaderUnlocked();
   }
 }
 
@@ -589,6 +728,7 @@ bool RemoteTablet::MarkTServerAsLeader(const RemoteTabletServer* server) {
       replica.role = PeerRole::FOLLOWER;
     }
   }
+  UpdateHasLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   VLOG_IF_WITH_PREFIX(3, !found) << "Specified server not found: " << server->ToString()
                                  << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -604,6 +744,7 @@ void RemoteTablet::MarkTServerAsFollower(const RemoteTabletServer* server) {
       found = true;
     }
   }
+  UpdateHasLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   DCHECK(found) << "Tablet " << tablet_id_ << ": Specified server not found: "
                 << server->ToString() << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -670,6 +811,7 @@ void LookupCallbackVisitor::operator()(
 
 MetaCache::MetaCache(YBClient* client)
   : client_(client),
+    id_(next_meta_cache_id.fetch_add(1, std::memory_order_acq_rel)),
     master_lookup_sem_(FLAGS_max_concurrent_master_lookups),
     log_prefix_(Format("MetaCache($0)(client_id: $1): ", static_cast<void*>(this), client_->id())) {
 }
@@ -947,20 +1089,38 @@ Status MetaCache::ProcessTabletLocations(
   {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
     ProcessedTablesMap processed_tables;
+    std::unordered_set<TableId> changed_tables;
 
+    Status status;
     for (const TabletLocationsPB& loc : locations) {
-      auto remote = VERIFY_RESULT(ProcessTabletLocation(
-          loc, &processed_tables, table_partition_list_version, lookup_rpc));
+      auto remote = ProcessTabletLocation(
+          loc, &processed_tables, &changed_tables, table_partition_list_version, lookup_rpc);
+      if (!remote.ok()) {
+        status = remote.status();
+        break;
+      }
 
       auto it = tablet_lookups_by_id_.find(loc.tablet_id());
       if (it != tablet_lookups_by_id_.end()) {
         while (auto* lookup = it->second.lookups.Pop()) {
           to_notify.emplace_back(std::move(lookup->callback),
-                                 LookupCallbackVisitor(remote));
+                                 LookupCallbackVisitor(*remote));
           delete lookup;
         }
       }
     }
+
+    // Tables could be already updated by the time of failure, so their snapshots should be
+    // invalidated in any case. Refreshing replicas of already cached tablets does not change
+    // tablets_by_partition, so snapshots of such tables are kept.
+    for (const auto& table_id : changed_tables) {
+      auto it = tables_.find(table_id);
+      if (it != tables_.end()) {
+        it->second.snapshot_holder->Invalidate();
+      }
+    }
+    RETURN_NOT_OK(status);
+
     if (lookup_rpc) {
       lookup_rpc->AddCallbacksToBeNotified(processed_tables, &tables_, &to_notify);
       lookup_rpc->CleanupRequest();
@@ -976,6 +1136,7 @@ Status MetaCache::ProcessTabletLocations(
 
 Result<RemoteTabletPtr> MetaCache::ProcessTabletLocation(
     const TabletLocationsPB& location, ProcessedTablesMap* processed_tables,
+    std::unordered_set<TableId>* changed_tables,
     const boost::optional<PartitionListVersion>& table_partition_list_version,
     LookupRpc* lookup_rpc) {
   const std::string& tablet_id = location.tablet_id();
@@ -1067,7 +1228,11 @@ Result<RemoteTabletPtr> MetaCache::ProcessTabletLocation(
       // in a previous iteration of the for loop (for location.table_ids()).
       // We need to add this tablet to the current table's tablets_by_key map.
       if (tablets_by_key) {
-        (*tablets_by_key)[remote->partition().partition_key_start()] = remote;
+        auto& tablet = (*tablets_by_key)[remote->partition().partition_key_start()];
+        if (tablet != remote) {
+          tablet = remote;
+          changed_tables->insert(table_id);
+        }
       }
 
       VLOG_WITH_PREFIX(5) << "Refreshing tablet " << tablet_id << ": "
@@ -1084,6 +1249,7 @@ Result<RemoteTabletPtr> MetaCache::ProcessTabletLocation(
       CHECK(tablets_by_id_.emplace(tablet_id, remote).second);
       if (tablets_by_key) {
         (*tablets_by_key)[partition.partition_key_start()] = remote;
+        changed_tables->insert(table_id);
       }
     }
     remote->Refresh(ts_cache_, location.replicas());
@@ -1175,6 +1341,7 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
     // Only update partitions here after invalidating TableData cache to avoid inconsistencies.
     // See https://github.com/yugabyte/yugabyte-db/issues/6890.
     table_data.partition_list = table_partition_list;
+    table_data.snapshot_holder->Invalidate();
   }
   for (const auto& callback : to_notify) {
     const auto s = STATUS_EC_FORMAT(
@@ -1773,40 +1940,8 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
   }
 
   const auto& table_data = it->second;
-
-  if (PREDICT_FALSE(
-          table_data.partition_list->version !=
-          versioned_partition_start_key.partition_list_version)) {
-    // TableData::partition_list version in cache does not match partition_list_version used to
-    // calculate partition_key_start, can't use cache.
-    return nullptr;
-  }
-
-  const auto& partition_start_key = *versioned_partition_start_key.key;
-
-  DCHECK_EQ(
-      partition_start_key,
-      *client::FindPartitionStart(table_data.partition_list, partition_start_key));
-  auto tablet_it = table_data.tablets_by_partition.find(partition_start_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
-    // No tablets with a start partition key lower than 'partition_key'.
-    return nullptr;
-  }
-
-  const auto& result = tablet_it->second;
-
-  // Stale entries must be re-fetched.
-  if (result->stale()) {
-    return nullptr;
-  }
-
-  if (result->partition().partition_key_end().compare(partition_start_key) > 0 ||
-      result->partition().partition_key_end().empty()) {
-    // partition_start_key < partition.end OR tablet does not end.
-    return result;
-  }
-
-  return nullptr;
+  return FindTabletByPartitionStart(
+      table_data.partition_list, table_data.tablets_by_partition, versioned_partition_start_key);
 }
 
 boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnlocked(
@@ -1844,6 +1979,55 @@ RemoteTabletPtr MetaCache::FastLookupTabletByKeyUnlocked(
   return nullptr;
 }
 
+const TabletsByPartitionSnapshot* MetaCache::ThreadTableSnapshot(const TableId& table_id) {
+  ReleaseOutdatedThreadTableSnapshot();
+
+  CachedTableSnapshot* entry = nullptr;
+  for (auto& cached : thread_table_snapshots) {
+    if (cached.meta_cache_id == id_ && cached.table_id == table_id) {
+      if (cached.holder->version() == cached.version) {
+        return cached.snapshot.get();
+      }
+      entry = &cached;
+      break;
+    }
+  }
+
+  SharedLock lock(mutex_);
+  auto it = tables_.find(table_id);
+  if (it == tables_.end()) {
+    if (entry) {
+      *entry = CachedTableSnapshot();
+    }
+    return nullptr;
+  }
+  if (!entry) {
+    entry = &thread_table_snapshots[
+        thread_table_snapshots_next_idx++ % kMaxThreadTableSnapshots];
+    entry->meta_cache_id = id_;
+    entry->table_id = table_id;
+  }
+  entry->holder = it->second.snapshot_holder;
+  entry->snapshot = entry->holder->Get(it->second, &entry->version);
+  return entry->snapshot.get();
+}
+
+RemoteTabletPtr MetaCache::LockFreeLookupTabletByKey(
+    const TableId& table_id, const VersionedPartitionStartKey& partition_start) {
+  const auto* snapshot = ThreadTableSnapshot(table_id);
+  if (!snapshot) {
+    return nullptr;
+  }
+  auto result = FindTabletByPartitionStart(
+      snapshot->partition_list, snapshot->tablets_by_partition, partition_start);
+  if (result && result->HasLeader()) {
+    VLOG_WITH_PREFIX(5) << "Lock free lookup: found tablet " << result->tablet_id();
+    lock_free_lookups_.fetch_add(1, std::memory_order_relaxed);
+    return result;
+  }
+  return nullptr;
+}
+
 template <class Mutex>
 bool IsUniqueLock(const std::lock_guard<Mutex>*) {
   return true;
@@ -2027,6 +2211,15 @@ void MetaCache::LookupTabletByKey(const std::shared_ptr<YBTable>& table,
                     << ", partition_key: " << Slice(partition_key).ToDebugHexString()
                     << ", partition_start: " << Slice(*partition_start).ToDebugHexString();
 
+  if (FLAGS_meta_cache_lock_free_lookup) {
+    auto tablet = LockFreeLookupTabletByKey(
+        table->id(), {partition_start, table_partition_list->version});
+    if (tablet) {
+      callback(tablet);
+      return;
+    }
+  }
+
   PartitionGroupStartKeyPtr partition_group_start;
   if (DoLookupTabletByKey<SharedLock<std::shared_timed_mutex>>(
           table, table_partition_list, partition_start, deadline, &callback,
@@ -2254,10 +2447,16 @@ void LookupDataGroup::Finished(
 }
 
 TableData::TableData(const VersionedTablePartitionListPtr& partition_list_)
-    : partition_list(partition_list_) {
+    : partition_list(partition_list_),
+      snapshot_holder(std::make_shared<TableSnapshotHolder>()) {
   DCHECK_ONLY_NOTNULL(partition_list);
 }
 
+TableData::~TableData() {
+  // Let threads that cached the snapshot of this table release it.
+  snapshot_holder->Invalidate();
+}
+
 std::string VersionedPartitionStartKey::ToString() const {
   return YB_STRUCT_TO_STRING(key, partition_list_version);
 }
@@ -351,6 +351,9 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // Same as ReplicasAsString(), except that the caller must hold mutex_.
   std::string ReplicasAsStringUnlocked() const;
 
+  // Updates has_leader_ after change of replicas_, the caller must hold exclusive lock on mutex_.
+  void UpdateHasLeaderUnlocked();
+
   const std::string tablet_id_;
   const std::string log_prefix_;
   const Partition partition_;
@@ -360,13 +363,18 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
 
   // All non-const members are protected by 'mutex_'.
   mutable rw_spinlock mutex_;
-  bool stale_;
   bool is_split_ = false;
   std::vector<RemoteReplica> replicas_;
   PartitionListVersion last_known_partition_list_version_ = 0;
 
   std::atomic<ReplicasCount> replicas_count_{{0, 0}};
 
+  // Stale and has leader flags are checked on every lookup of the tablet, so they are kept in
+  // atomics and could be read without locking mutex_. has_leader_ is the cached result of
+  // LeaderTServer() != nullptr and is only updated under exclusive lock of mutex_.
+  std::atomic<bool> stale_{false};
+  std::atomic<bool> has_leader_{false};
+
   // Last time this object was refreshed. Initialized to MonoTime::Min() so we don't have to be
   // checking whether it has been initialized everytime we use this value.
   std::atomic<MonoTime> refresh_time_{MonoTime::Min()};
@@ -443,8 +451,13 @@ struct LookupDataGroup {
   ~LookupDataGroup();
 };
 
+// Immutable snapshot of tablets_by_partition and partition_list of a table.
+struct TabletsByPartitionSnapshot;
+class TableSnapshotHolder;
+
 struct TableData {
   explicit TableData(const VersionedTablePartitionListPtr& partition_list_);
+  ~TableData();
 
   VersionedTablePartitionListPtr partition_list;
   std::map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
@@ -452,6 +465,9 @@ struct TableData {
   std::vector<RemoteTabletPtr> all_tablets;
   LookupDataGroup full_table_lookups;
   bool stale = false;
+  // Used by lookups that do not lock MetaCache, invalidated whenever tablets_by_partition or
+  // partition_list is changed.
+  std::shared_ptr<TableSnapshotHolder> snapshot_holder;
   // To resolve partition_key to tablet_id MetaCache uses client::FindPartitionStart with
   // TableData::partition_list and then translates partition_start to tablet_id based on
   // TableData::tablets_by_partition.
@@ -637,6 +653,16 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
       const TableId& table_id,
       const VersionedPartitionStartKey& partition_start) REQUIRES_SHARED(mutex_);
 
+  // Same as FastLookupTabletByKeyUnlocked, but uses snapshot of the table cached by the current
+  // thread instead of locking mutex_. The lock is only taken when the table was changed since
+  // the previous lookup of the current thread.
+  RemoteTabletPtr LockFreeLookupTabletByKey(
+      const TableId& table_id, const VersionedPartitionStartKey& partition_start);
+
+  // Returns the latest snapshot of the table, cached by the current thread, or nullptr if the
+  // table is not cached.
+  const TabletsByPartitionSnapshot* ThreadTableSnapshot(const TableId& table_id);
+
   // Lookup from cache the set of tablets corresponding to a tiven table.
   // Returns empty vector if the cache is invalid or a tablet is stale,
   // otherwise returns a list of tablets.
@@ -672,6 +698,7 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   Result<RemoteTabletPtr> ProcessTabletLocation(
       const master::TabletLocationsPB& locations, ProcessedTablesMap* processed_tables,
+      std::unordered_set<TableId>* changed_tables,
       const boost::optional<PartitionListVersion>& table_partition_list_version,
       LookupRpc* lookup_rpc) REQUIRES(mutex_);
 
@@ -702,6 +729,9 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   // Cache of deleted tablets.
   std::unordered_set<TabletId> deleted_tablets_ GUARDED_BY(mutex_);
 
+  // Unique id of this meta cache, used to find table snapshots in the thread local cache.
+  const uint64_t id_;
+
   // Prevents master lookup "storms" by delaying master lookups when all
   // permits have been acquired.
   Semaphore master_lookup_sem_;
@@ -712,6 +742,8 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 };
 
 int64_t TEST_GetLookupSerial();
+// Number of tablet lookups by key served from the meta cache snapshot without locking.
+int64_t TEST_GetLockFreeLookups();
 
 } // namespace internal
 } // namespace client
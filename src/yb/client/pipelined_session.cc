@@ -0,0 +1,231 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/client/pipelined_session.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "yb/client/client.h"
+#include "yb/client/error.h"
+#include "yb/client/meta_cache.h"
+#include "yb/client/session.h"
+#include "yb/client/table.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+#include "yb/util/unique_lock.h"
+
+DEFINE_RUNTIME_uint32(pipelined_session_batch_size, 256,
+    "Number of operations of a single tablet that are sent together by pipelined session.");
+
+DEFINE_RUNTIME_uint32(pipelined_session_max_in_flight_batches_per_tablet, 2,
+    "Max number of batches of a single tablet that pipelined session keeps in flight. "
+    "Apply blocks when the tablet buffer is full and this number of batches is in flight.");
+
+namespace yb {
+namespace client {
+
+namespace {
+
+size_t BatchSize() {
+  return std::max<size_t>(FLAGS_pipelined_session_batch_size, 1);
+}
+
+size_t MaxInFlightBatchesPerTablet() {
+  return std::max<size_t>(FLAGS_pipelined_session_max_in_flight_batches_per_tablet, 1);
+}
+
+} // namespace
+
+YBPipelinedSession::YBPipelinedSession(
+    YBClient* client, MonoDelta timeout, OpCallback op_callback)
+    : client_(client), timeout_(timeout), op_callback_(std::move(op_callback)) {
+}
+
+YBPipelinedSession::~YBPipelinedSession() {
+  std::vector<YBOperationPtr> unsent_ops;
+  {
+    UniqueLock lock(mutex_);
+    WaitOnConditionVariable(&cond_, &lock, [this] { return batches_in_flight_ == 0; });
+    for (auto& [tablet_id, buffer] : tablets_) {
+      std::move(buffer.ops.begin(), buffer.ops.end(), std::back_inserter(unsent_ops));
+      buffer.ops.clear();
+    }
+  }
+  if (unsent_ops.empty()) {
+    return;
+  }
+  LOG(WARNING) << "Pipelined session destroyed with " << unsent_ops.size()
+               << " operations that were not flushed";
+  static const Status kAbortedStatus = STATUS(
+      Aborted, "Pipelined session destroyed before operation was sent");
+  for (const auto& op : unsent_ops) {
+    OpDone(op, kAbortedStatus);
+  }
+}
+
+Result<internal::RemoteTabletPtr> YBPipelinedSession::ResolveTablet(const YBOperation& op) {
+  if (op.tablet()) {
+    return op.tablet();
+  }
+  std::string partition_key;
+  RETURN_NOT_OK(op.GetPartitionKey(&partition_key));
+  // Tablets of the ingested table are usually cached, so lookup completes synchronously.
+  return client_->LookupTabletByKeyFuture(
+      op.mutable_table(), partition_key, CoarseMonoClock::now() + timeout_).get();
+}
+
+void YBPipelinedSession::Apply(YBOperationPtr op) {
+  auto tablet = ResolveTablet(*op);
+  if (!tablet.ok()) {
+    OpDone(op, tablet.status());
+    return;
+  }
+  op->SetTablet(*tablet);
+  const auto& tablet_id = (*tablet)->tablet_id();
+
+  std::vector<YBOperationPtr> batch;
+  {
+    UniqueLock lock(mutex_);
+    auto& buffer = tablets_[tablet_id];
+    WaitOnConditionVariable(&cond_, &lock, [&buffer] {
+      return buffer.ops.size() < BatchSize() ||
+             buffer.batches_in_flight < MaxInFlightBatchesPerTablet();
+    });
+    buffer.ops.push_back(std::move(op));
+    batch = PickBatchUnlocked(&buffer);
+  }
+  if (!batch.empty()) {
+    SendBatch(tablet_id, std::move(batch));
+  }
+}
+
+Status YBPipelinedSession::Flush() {
+  std::vector<std::pair<TabletId, std::vector<YBOperationPtr>>> batches;
+  {
+    std::lock_guard lock(mutex_);
+    ++flushes_;
+    for (auto& [tablet_id, buffer] : tablets_) {
+      auto batch = PickBatchUnlocked(&buffer);
+      if (!batch.empty()) {
+        batches.emplace_back(tablet_id, std::move(batch));
+      }
+    }
+  }
+  for (auto& [tablet_id, batch] : batches) {
+    SendBatch(tablet_id, std::move(batch));
+  }
+
+  UniqueLock lock(mutex_);
+  // Buffers that could not be sent because of in flight batches are sent when those batches are
+  // done, see BatchDone.
+  WaitOnConditionVariable(&cond_, &lock, [this] {
+    if (batches_in_flight_ != 0) {
+      return false;
+    }
+    for (const auto& [tablet_id, buffer] : tablets_) {
+      if (!buffer.ops.empty()) {
+        return false;
+      }
+    }
+    return true;
+  });
+  --flushes_;
+  const auto failed_ops = std::exchange(failed_ops_, 0);
+  if (failed_ops) {
+    return STATUS_FORMAT(IOError, "$0 operations failed", failed_ops);
+  }
+  return Status::OK();
+}
+
+std::vector<YBOperationPtr> YBPipelinedSession::PickBatchUnlocked(TabletBuffer* buffer) {
+  if (buffer->ops.empty() || buffer->batches_in_flight >= MaxInFlightBatchesPerTablet() ||
+      (buffer->ops.size() < BatchSize() && flushes_ == 0)) {
+    return {};
+  }
+  ++buffer->batches_in_flight;
+  ++batches_in_flight_;
+  std::vector<YBOperationPtr> result;
+  result.swap(buffer->ops);
+  return result;
+}
+
+void YBPipelinedSession::SendBatch(const TabletId& tablet_id, std::vector<YBOperationPtr> batch) {
+  VLOG(4) << "Sending " << batch.size() << " operations to " << tablet_id;
+
+  auto session = client_->NewSession();
+  session->SetTimeout(timeout_);
+  session->Apply(batch);
+  session->FlushAsync(
+      [this, tablet_id, batch = std::move(batch)](FlushStatus* flush_status) {
+    BatchDone(tablet_id, batch, flush_status);
+  });
+}
+
+void YBPipelinedSession::BatchDone(
+    const TabletId& tablet_id, const std::vector<YBOperationPtr>& batch,
+    FlushStatus* flush_status) {
+  VLOG(4) << "Batch of " << batch.size() << " operations to " << tablet_id << " done: "
+          << flush_status->status;
+
+  if (flush_status->errors.empty()) {
+    // Either all operations succeeded, or the whole batch failed.
+    for (const auto& op : batch) {
+      OpDone(op, flush_status->status);
+    }
+  } else {
+    std::unordered_map<const YBOperation*, Status> errors;
+    for (const auto& error : flush_status->errors) {
+      errors.emplace(&error->failed_op(), error->status());
+    }
+    for (const auto& op : batch) {
+      auto it = errors.find(op.get());
+      OpDone(op, it != errors.end() ? it->second : Status::OK());
+    }
+  }
+
+  std::vector<YBOperationPtr> next_batch;
+  {
+    std::lock_guard lock(mutex_);
+    auto& buffer = tablets_[tablet_id];
+    --buffer.batches_in_flight;
+    // The next batch is accounted before the completed one is released, so the session could not
+    // be destroyed before the next batch is sent.
+    next_batch = PickBatchUnlocked(&buffer);
+    --batches_in_flight_;
+    cond_.notify_all();
+  }
+  if (!next_batch.empty()) {
+    SendBatch(tablet_id, std::move(next_batch));
+  }
+}
+
+void YBPipelinedSession::OpDone(const YBOperationPtr& op, const Status& status) {
+  if (!status.ok()) {
+    VLOG(3) << "Operation " << op->ToString() << " failed: " << status;
+    std::lock_guard lock(mutex_);
+    ++failed_ops_;
+  }
+  if (op_callback_) {
+    op_callback_(op, status);
+  }
+}
+
+} // namespace client
+} // namespace yb
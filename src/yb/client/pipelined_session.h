@@ -0,0 +1,104 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids_types.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace client {
+
+// Session for streaming ingest of non transactional operations, that pipelines operations of
+// different tablets.
+//
+// YBSession sends all applied operations on flush, and reports completion when all of them are
+// done. So ingest throughput is bounded by the slowest tablet of every flush.
+// YBPipelinedSession instead routes operations to per tablet buffers as soon as they are applied.
+// The buffer is sent to its tablet as soon as it is full, and up to
+// pipelined_session_max_in_flight_batches_per_tablet batches of the same tablet could be in flight.
+// Completion is reported for every operation via the callback specified at creation.
+//
+// Operations of the same tablet sent in different batches could be applied in any order, unless
+// pipelined_session_max_in_flight_batches_per_tablet is 1.
+//
+// Apply and Flush could block, waiting for tablet lookup or for in flight batches, so they
+// should not be invoked from RPC callbacks. The operation callback is invoked from RPC callback
+// threads.
+//
+// This class is thread safe.
+class YBPipelinedSession {
+ public:
+  using OpCallback = std::function<void(const YBOperationPtr& op, const Status& status)>;
+
+  YBPipelinedSession(YBClient* client, MonoDelta timeout, OpCallback op_callback);
+
+  // Waits for all in flight operations. Buffered operations are not sent, they are completed
+  // with Aborted status via the operation callback. Flush should be invoked before destruction
+  // to write all applied operations.
+  ~YBPipelinedSession();
+
+  // Adds operation to the buffer of its tablet, sending the buffer when it is full.
+  // Blocks while the buffer is full and max number of batches of this tablet is in flight.
+  void Apply(YBOperationPtr op);
+
+  // Sends all buffered operations and waits until all applied operations are done.
+  // Returns error if some operations have failed since the previous flush, details are reported
+  // to the operation callback.
+  Status Flush();
+
+ private:
+  struct TabletBuffer {
+    std::vector<YBOperationPtr> ops;
+    size_t batches_in_flight = 0;
+  };
+
+  Result<internal::RemoteTabletPtr> ResolveTablet(const YBOperation& op);
+
+  // Picks buffered operations of the tablet to send, when they should be sent.
+  std::vector<YBOperationPtr> PickBatchUnlocked(TabletBuffer* buffer) REQUIRES(mutex_);
+
+  void SendBatch(const TabletId& tablet_id, std::vector<YBOperationPtr> batch);
+  void BatchDone(
+      const TabletId& tablet_id, const std::vector<YBOperationPtr>& batch,
+      FlushStatus* flush_status);
+
+  void OpDone(const YBOperationPtr& op, const Status& status);
+
+  YBClient* const client_;
+  const MonoDelta timeout_;
+  const OpCallback op_callback_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::unordered_map<TabletId, TabletBuffer> tablets_ GUARDED_BY(mutex_);
+  size_t batches_in_flight_ GUARDED_BY(mutex_) = 0;
+  // Number of Flush calls in progress. While flushing, partially filled buffers are also sent.
+  size_t flushes_ GUARDED_BY(mutex_) = 0;
+  size_t failed_ops_ GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace client
+} // namespace yb
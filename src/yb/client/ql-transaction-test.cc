@@ -24,6 +24,7 @@
 #include "yb/client/yb_op.h"
 
 #include "yb/common/ql_value.h"
+#include "yb/common/transaction_error.h"
 
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log.h"
@@ -44,6 +45,7 @@
 
 #include "yb/util/async_util.h"
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
@@ -62,6 +64,8 @@ DECLARE_bool(TEST_disable_proactive_txn_cleanup_on_abort);
 DECLARE_bool(TEST_fail_in_apply_if_no_metadata);
 DECLARE_bool(TEST_master_fail_transactional_tablet_lookups);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
+DECLARE_bool(batch_transaction_heartbeats);
+DECLARE_bool(batch_transaction_status_requests);
 DECLARE_bool(delete_intents_sst_files);
 DECLARE_bool(enable_load_balancing);
 DECLARE_bool(fail_on_out_of_range_clock_skew);
@@ -71,10 +75,18 @@ DECLARE_int32(TEST_delay_init_tablet_peer_ms);
 DECLARE_int32(log_min_seconds_to_retain);
 DECLARE_int32(remote_bootstrap_max_chunk_size);
 DECLARE_int64(transaction_rpc_timeout_ms);
+DECLARE_uint64(TEST_inject_txn_get_status_delay_ms);
 DECLARE_uint64(TEST_transaction_delay_status_reply_usec_in_tests);
 DECLARE_uint64(aborted_intent_cleanup_ms);
+DECLARE_uint64(conflict_check_merged_scan_min_keys);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(transaction_heartbeat_usec);
+DECLARE_uint64(transaction_status_cache_ttl_ms);
+DECLARE_uint64(txn_intents_cache_max_records);
+
+METRIC_DECLARE_counter(transaction_status_shared_cache_hits);
+METRIC_DECLARE_counter(transactions_applied_from_intents_cache);
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_GetTransactionStatus);
 
 namespace yb {
 namespace client {
@@ -442,6 +454,65 @@ TEST_F(QLTransactionTest, Heartbeat) {
   AssertNoRunningTransactions();
 }
 
+// Checks that transactions are applied correctly with and without intents kept in memory.
+TEST_F(QLTransactionTest, IntentsCache) {
+  auto applied_from_cache = [this] {
+    int64_t result = 0;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      auto tablet = peer->shared_tablet();
+      if (tablet) {
+        result += METRIC_transactions_applied_from_intents_cache.Instantiate(
+            tablet->GetTabletMetricsEntity())->value();
+      }
+    }
+    return result;
+  };
+
+  // 0 disables the cache. Rows written to some tablets do not fit into cache of size 1.
+  const std::vector<uint64_t> kMaxRecords = {0, 1, 1000};
+  int64_t last_applied_from_cache = 0;
+  for (size_t i = 0; i != kMaxRecords.size(); ++i) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_txn_intents_cache_max_records) = kMaxRecords[i];
+    auto txn = CreateTransaction();
+    ASSERT_OK(WriteRows(CreateSession(txn), i));
+    ASSERT_OK(txn->CommitFuture().get());
+    ASSERT_OK(WaitTransactionsCleaned());
+
+    auto new_applied_from_cache = applied_from_cache();
+    LOG(INFO) << "Max records: " << kMaxRecords[i] << ", applied from cache: "
+              << new_applied_from_cache - last_applied_from_cache;
+    if (kMaxRecords[i] == 0) {
+      ASSERT_EQ(new_applied_from_cache, last_applied_from_cache);
+    } else if (kMaxRecords[i] >= kNumRows) {
+      ASSERT_GT(new_applied_from_cache, last_applied_from_cache);
+    }
+    last_applied_from_cache = new_applied_from_cache;
+  }
+  VerifyData(kMaxRecords.size());
+  ASSERT_OK(cluster_->RestartSync());
+  VerifyData(kMaxRecords.size());
+}
+
+// Checks that transactions are kept alive by heartbeats sent in batches, including heartbeats of
+// multiple transactions to the same status tablet.
+TEST_F(QLTransactionTest, BatchedHeartbeats) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_batch_transaction_heartbeats) = true;
+  constexpr size_t kTransactions = 10;
+  std::vector<YBTransactionPtr> transactions;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    ASSERT_OK(WriteRows(session, i));
+    transactions.push_back(std::move(txn));
+  }
+  std::this_thread::sleep_for(GetTransactionTimeout(false /* is_external */) * 2);
+  for (const auto& txn : transactions) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+  VerifyData(kTransactions);
+  AssertNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, Expire) {
   SetDisableHeartbeatInTests(true);
   auto txn = CreateTransaction();
@@ -512,6 +583,95 @@ TEST_F(QLTransactionTest, ResendApplying) {
   AssertNoRunningTransactions();
 }
 
+// Compares time of transactional write batches of different sizes, when conflicts with committed
+// values are checked by a separate seek per key, and by a single pass over the regular DB.
+// Large batches are written only when slow tests are allowed.
+TEST_F(QLTransactionTest, ConflictCheckBenchmark) {
+  const int kMaxBatchSize = AllowSlowTests() ? RegularBuildVsSanitizers(10000, 100) : 100;
+
+  auto write_batch = [this](int batch_size, int value, WriteOpType op_type) -> Result<MonoDelta> {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    for (int key = 0; key != batch_size; ++key) {
+      RETURN_NOT_OK(WriteRow(session, key, value, op_type, Flush::kFalse));
+    }
+    auto start = MonoTime::Now();
+    RETURN_NOT_OK(session->TEST_Flush());
+    auto result = MonoTime::Now() - start;
+    RETURN_NOT_OK(txn->CommitFuture().get());
+    return result;
+  };
+
+  // So conflicts are checked against values that are present in the regular DB.
+  ASSERT_OK(ResultToStatus(write_batch(kMaxBatchSize, 0, WriteOpType::INSERT)));
+  ASSERT_OK(WaitTransactionsCleaned());
+
+  int value = 0;
+  for (int batch_size = 1; batch_size <= kMaxBatchSize; batch_size *= 10) {
+    for (bool merged_scan : {false, true}) {
+      ANNOTATE_UNPROTECTED_WRITE(FLAGS_conflict_check_merged_scan_min_keys) = merged_scan ? 1 : 0;
+      auto time = ASSERT_RESULT(write_batch(batch_size, ++value, WriteOpType::UPDATE));
+      LOG(INFO) << "Batch size: " << batch_size << ", merged scan: " << merged_scan
+                << ", write time: " << time;
+    }
+  }
+
+  // The last batch updates all rows.
+  auto session = CreateSession();
+  for (int key = 0; key < kMaxBatchSize; key += 97) {
+    ASSERT_EQ(ASSERT_RESULT(SelectRow(session, key)), value);
+  }
+}
+
+// Checks that the conflict check of a batch large enough to use a single pass over the regular DB
+// detects values committed after the transaction read time.
+TEST_F(QLTransactionTest, ConflictCheckMergedScan) {
+  constexpr int kMergedScanMinKeys = 16;
+  constexpr int kBatchSize = 500;
+  constexpr int kConflictingKeyStep = 50;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_conflict_check_merged_scan_min_keys) = kMergedScanMinKeys;
+
+  {
+    auto session = CreateSession();
+    for (int key = 0; key != kBatchSize; ++key) {
+      ASSERT_OK(WriteRow(session, key, key, WriteOpType::INSERT, Flush::kFalse));
+    }
+    ASSERT_OK(session->TEST_Flush());
+  }
+
+  auto txn = CreateTransaction();
+  auto txn_session = CreateSession(txn);
+  // Pick the read time of the transaction.
+  ASSERT_EQ(ASSERT_RESULT(SelectRow(txn_session, 0)), 0);
+
+  // Values written after the read time, to keys spread over all tablets.
+  {
+    auto session = CreateSession();
+    for (int key = kConflictingKeyStep - 1; key < kBatchSize; key += kConflictingKeyStep) {
+      ASSERT_OK(WriteRow(session, key, -key, WriteOpType::UPDATE, Flush::kFalse));
+    }
+    ASSERT_OK(session->TEST_Flush());
+  }
+
+  for (int key = 0; key != kBatchSize; ++key) {
+    ASSERT_OK(WriteRow(txn_session, key, key * 2, WriteOpType::UPDATE, Flush::kFalse));
+  }
+  auto flush_status = txn_session->TEST_FlushAndGetOpsErrors();
+  ASSERT_NOK(flush_status.status);
+  ASSERT_FALSE(flush_status.errors.empty());
+  for (const auto& error : flush_status.errors) {
+    ASSERT_TRUE(TransactionError(error->status()) == TransactionErrorCode::kConflict)
+        << error->status();
+  }
+  txn->Abort();
+
+  auto session = CreateSession();
+  for (int key = 0; key != kBatchSize; ++key) {
+    const auto expected = (key + 1) % kConflictingKeyStep == 0 ? -key : key;
+    ASSERT_EQ(ASSERT_RESULT(SelectRow(session, key)), expected);
+  }
+}
+
 TEST_F(QLTransactionTest, ConflictResolution) {
   constexpr int kTotalTransactions = 5;
   constexpr int kNumRows = 10;
@@ -1779,5 +1939,123 @@ TEST_F(QLTransactionTest, DeleteTableDuringWrite) {
   }, 10s * kTimeMultiplier, "Cleanup transactions from coordinator"));
 }
 
+// Single tablet server cluster, so all tablets written by a transaction are served by the same
+// tablet server and share its transaction status cache.
+class QLTransactionRf1Test : public QLTransactionTest {
+ protected:
+  void SetUp() override {
+    mini_cluster_opt_.num_tablet_servers = 1;
+    QLTransactionTest::SetUp();
+  }
+
+  int64_t SharedStatusCacheHits() {
+    int64_t result = 0;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      auto tablet = peer->shared_tablet();
+      if (tablet) {
+        result += METRIC_transaction_status_shared_cache_hits.Instantiate(
+            tablet->GetTabletMetricsEntity())->value();
+      }
+    }
+    return result;
+  }
+
+  uint64_t GetTransactionStatusRpcs() {
+    return METRIC_handler_latency_yb_tserver_TabletServerService_GetTransactionStatus.Instantiate(
+        cluster_->mini_tablet_server(0)->server()->metric_entity())->TotalCount();
+  }
+
+  void WriteAndCommit(size_t first_transaction, size_t num_transactions) {
+    std::vector<YBTransactionPtr> transactions;
+    for (size_t i = 0; i != num_transactions; ++i) {
+      auto txn = CreateTransaction();
+      ASSERT_OK(WriteRows(CreateSession(txn), first_transaction + i));
+      transactions.push_back(std::move(txn));
+    }
+    for (const auto& txn : transactions) {
+      ASSERT_OK(txn->CommitFuture().get());
+    }
+  }
+};
+
+// Checks that participants resolve statuses of concurrently read transactions with fewer status
+// RPCs when requests to the same status tablet are batched.
+TEST_F(QLTransactionRf1Test, BatchStatusRequests) {
+  constexpr size_t kTransactions = 10;
+
+  DisableApplyingIntents();
+  // Disable shared cache, so both iterations resolve the same number of statuses.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_transaction_status_cache_ttl_ms) = 0;
+  // Keep status requests in flight long enough for concurrent requests to be queued.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_inject_txn_get_status_delay_ms) = 100;
+
+  std::vector<uint64_t> status_rpcs;
+  size_t first_transaction = 0;
+  for (auto batch : {false, true}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_batch_transaction_status_requests) = batch;
+    ASSERT_NO_FATALS(WriteAndCommit(first_transaction, kTransactions));
+
+    const auto status_rpcs_start = GetTransactionStatusRpcs();
+    TestThreadHolder thread_holder;
+    for (size_t i = 0; i != kTransactions; ++i) {
+      thread_holder.AddThreadFunctor([this, transaction = first_transaction + i] {
+        VerifyRows(CreateSession(), transaction);
+      });
+    }
+    thread_holder.JoinAll();
+    status_rpcs.push_back(GetTransactionStatusRpcs() - status_rpcs_start);
+    LOG(INFO) << "Batch: " << batch << ", status RPCs: " << status_rpcs.back();
+
+    first_transaction += kTransactions;
+  }
+
+  ASSERT_LT(status_rpcs[1], status_rpcs[0]);
+}
+
+// Checks that status received by participant of one tablet is used by participants of other
+// tablets, and remembered by them, so the following reads do not need the shared cache.
+TEST_F(QLTransactionRf1Test, SharedStatusCache) {
+  constexpr size_t kTransactions = 10;
+
+  DisableApplyingIntents();
+  // Entries should not expire while the test reads.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_transaction_status_cache_ttl_ms) = 60000 * kTimeMultiplier;
+  ASSERT_NO_FATALS(WriteAndCommit(0, kTransactions));
+
+  // Rows are read one by one, so the status of transaction is already cached when participant of
+  // another tablet reads its intents.
+  auto session = CreateSession();
+  auto read_rows = [this, &session] {
+    for (size_t i = 0; i != kTransactions; ++i) {
+      for (size_t r = 0; r != kNumRows; ++r) {
+        VERIFY_ROW(
+            session, KeyForTransactionAndIndex(i, r),
+            ValueForTransactionAndIndex(i, r, WriteOpType::INSERT));
+      }
+    }
+  };
+
+  auto hits_start = SharedStatusCacheHits();
+  ASSERT_NO_FATALS(read_rows());
+  LOG(INFO) << "Shared status cache hits: " << SharedStatusCacheHits() - hits_start;
+  ASSERT_GT(SharedStatusCacheHits(), hits_start);
+
+  hits_start = SharedStatusCacheHits();
+  ASSERT_NO_FATALS(read_rows());
+  ASSERT_EQ(SharedStatusCacheHits(), hits_start);
+
+  // Intents of aborted transaction should not be visible, including tablets that got the aborted
+  // status from the shared cache.
+  auto txn = CreateTransaction();
+  ASSERT_OK(WriteRows(CreateSession(txn), kTransactions));
+  txn->Abort();
+  for (int pass = 0; pass != 2; ++pass) {
+    for (size_t r = 0; r != kNumRows; ++r) {
+      auto row = SelectRow(session, KeyForTransactionAndIndex(kTransactions, r));
+      ASSERT_TRUE(!row.ok() && row.status().IsNotFound()) << "Bad row: " << row;
+    }
+  }
+}
+
 } // namespace client
 } // namespace yb
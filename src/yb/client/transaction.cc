@@ -80,6 +80,7 @@ DEFINE_UNKNOWN_uint64(transaction_heartbeat_usec, 500000 * yb::kTimeMultiplier,
 DEFINE_UNKNOWN_bool(transaction_disable_heartbeat_in_tests, false,
     "Disable heartbeat during test.");
 DECLARE_uint64(max_clock_skew_usec);
+DECLARE_bool(batch_transaction_heartbeats);
 
 DEFINE_UNKNOWN_bool(auto_promote_nonlocal_transactions_to_global, true,
             "Automatically promote transactions touching data outside of region to global.");
@@ -1673,6 +1674,24 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
       timeout = TransactionRpcTimeout();
     }
 
+    if (status == TransactionStatus::PENDING &&
+        GetAtomicFlag(&FLAGS_batch_transaction_heartbeats)) {
+      internal::RemoteTabletPtr status_tablet;
+      {
+        SharedLock<std::shared_mutex> lock(mutex_);
+        status_tablet = !send_to_new_tablet && old_status_tablet_ ? old_status_tablet_
+                                                                  : status_tablet_;
+      }
+      // Callback could be invoked synchronously, so heartbeat is not sent under the lock.
+      manager_->SendBatchedHeartbeat(
+          status_tablet, id,
+          [this, status, transaction, send_to_new_tablet](const Status& heartbeat_status) {
+        HeartbeatDone(heartbeat_status, /* request= */ {}, /* response= */ {}, status,
+                      transaction, send_to_new_tablet);
+      });
+      return;
+    }
+
     rpc::RpcCommandPtr rpc;
     {
       SharedLock<std::shared_mutex> lock(mutex_);
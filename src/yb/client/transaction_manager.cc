@@ -18,20 +18,28 @@
 #include "yb/client/client.h"
 #include "yb/client/meta_cache.h"
 #include "yb/client/table.h"
+#include "yb/client/transaction_rpc.h"
 #include "yb/client/yb_table_name.h"
 
+#include "yb/common/wire_protocol.h"
+
 #include "yb/master/catalog_manager.h"
 
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
 #include "yb/rpc/tasks_pool.h"
 
 #include "yb/server/server_base_options.h"
 
+#include "yb/tserver/tserver_service.pb.h"
+
 #include "yb/util/flags.h"
 #include "yb/util/format.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
 #include "yb/util/thread_restrictions.h"
+#include "yb/util/tsan_util.h"
 
 DEFINE_UNKNOWN_uint64(transaction_manager_workers_limit, 50,
               "Max number of workers used by transaction manager");
@@ -39,6 +47,18 @@ DEFINE_UNKNOWN_uint64(transaction_manager_workers_limit, 50,
 DEFINE_UNKNOWN_uint64(transaction_manager_queue_limit, 500,
               "Max number of tasks used by transaction manager");
 
+DEFINE_RUNTIME_AUTO_bool(batch_transaction_heartbeats, kLocalVolatile, false, true,
+    "Send heartbeats of transactions managed by the same status tablet in a single RPC.");
+
+DEFINE_RUNTIME_uint64(transaction_heartbeat_batch_interval_usec, 50000 * yb::kTimeMultiplier,
+    "Max time a heartbeat waits for other heartbeats to the same status tablet, when heartbeats "
+    "are batched.");
+
+DEFINE_RUNTIME_uint32(transaction_heartbeat_max_batch_size, 1000,
+    "Max number of heartbeats sent in a single RPC, when heartbeats are batched.");
+
+DECLARE_uint64(transaction_heartbeat_usec);
+
 DEFINE_test_flag(string, transaction_manager_preferred_tablet, "",
                  "For testing only. If non-empty, transaction manager will try to use the status "
                  "tablet with id matching this flag, if present in the list of status tablets.");
@@ -251,6 +271,7 @@ class TransactionManager::Impl {
         tasks_pool_(FLAGS_transaction_manager_queue_limit),
         invoke_callback_tasks_(FLAGS_transaction_manager_queue_limit) {
     CHECK(clock);
+    heartbeats_flush_task_.Bind(&client_->messenger()->scheduler());
   }
 
   ~Impl() {
@@ -325,7 +346,40 @@ class TransactionManager::Impl {
     clock_->Update(time);
   }
 
+  void SendBatchedHeartbeat(
+      const internal::RemoteTabletPtr& status_tablet, const TransactionId& id,
+      HeartbeatCallback callback) {
+    {
+      std::lock_guard lock(heartbeats_mutex_);
+      if (!heartbeats_closing_) {
+        auto& batch = heartbeat_batches_[status_tablet->tablet_id()];
+        if (!batch.status_tablet) {
+          batch.status_tablet = status_tablet;
+        }
+        batch.heartbeats.push_back(BatchedHeartbeat {
+          .id = id,
+          .callback = std::move(callback),
+        });
+        if (!heartbeats_flush_scheduled_) {
+          heartbeats_flush_scheduled_ = true;
+          heartbeats_flush_task_.Schedule(
+              [this](const Status& status) { FlushHeartbeats(status); },
+              std::chrono::microseconds(FLAGS_transaction_heartbeat_batch_interval_usec));
+        }
+        return;
+      }
+    }
+    callback(STATUS(Aborted, "Transaction manager shutting down"));
+  }
+
   void Shutdown() {
+    {
+      std::lock_guard lock(heartbeats_mutex_);
+      heartbeats_closing_ = true;
+    }
+    heartbeats_flush_task_.Shutdown();
+    // Heartbeats that were queued after the flush task was aborted.
+    FlushHeartbeats(STATUS(Aborted, "Transaction manager shutting down"));
     rpcs_.Shutdown();
     thread_pool_.Shutdown();
   }
@@ -339,6 +393,89 @@ class TransactionManager::Impl {
   }
 
  private:
+  struct BatchedHeartbeat {
+    TransactionId id;
+    HeartbeatCallback callback;
+  };
+
+  struct HeartbeatBatch {
+    internal::RemoteTabletPtr status_tablet;
+    std::vector<BatchedHeartbeat> heartbeats;
+  };
+
+  void FlushHeartbeats(const Status& status) {
+    std::unordered_map<TabletId, HeartbeatBatch> batches;
+    {
+      std::lock_guard lock(heartbeats_mutex_);
+      heartbeats_flush_scheduled_ = false;
+      batches.swap(heartbeat_batches_);
+    }
+    for (auto& [tablet_id, batch] : batches) {
+      if (!status.ok()) {
+        for (const auto& heartbeat : batch.heartbeats) {
+          heartbeat.callback(status);
+        }
+        continue;
+      }
+      const size_t max_batch_size = std::max<size_t>(
+          FLAGS_transaction_heartbeat_max_batch_size, 1);
+      for (size_t begin = 0; begin < batch.heartbeats.size(); begin += max_batch_size) {
+        auto it = batch.heartbeats.begin() + begin;
+        auto end = batch.heartbeats.begin() + std::min(begin + max_batch_size,
+                                                       batch.heartbeats.size());
+        SendHeartbeats(
+            batch.status_tablet,
+            std::vector<BatchedHeartbeat>(
+                std::make_move_iterator(it), std::make_move_iterator(end)));
+      }
+    }
+  }
+
+  void SendHeartbeats(
+      const internal::RemoteTabletPtr& status_tablet, std::vector<BatchedHeartbeat> heartbeats) {
+    VLOG(4) << "Sending " << heartbeats.size() << " heartbeats to " << status_tablet->tablet_id();
+
+    tserver::UpdateTransactionsRequestPB req;
+    req.set_tablet_id(status_tablet->tablet_id());
+    req.set_propagated_hybrid_time(Now().ToUint64());
+    for (const auto& heartbeat : heartbeats) {
+      auto& state = *req.add_states();
+      state.set_transaction_id(heartbeat.id.data(), heartbeat.id.size());
+      state.set_status(TransactionStatus::PENDING);
+    }
+
+    auto handle = rpcs_.Prepare();
+    if (handle == rpcs_.InvalidHandle()) {
+      for (const auto& heartbeat : heartbeats) {
+        heartbeat.callback(STATUS(Aborted, "Transaction manager shutting down"));
+      }
+      return;
+    }
+    *handle = UpdateTransactions(
+        CoarseMonoClock::now() + std::chrono::microseconds(FLAGS_transaction_heartbeat_usec),
+        status_tablet.get(), client_, &req,
+        [this, handle, heartbeats = std::move(heartbeats)](
+            const Status& status, const tserver::UpdateTransactionsResponsePB& resp) {
+      auto retained_self = rpcs_.Unregister(handle);
+      if (resp.has_propagated_hybrid_time()) {
+        UpdateClock(HybridTime(resp.propagated_hybrid_time()));
+      }
+      const auto num_statuses = static_cast<size_t>(resp.statuses_size());
+      for (size_t i = 0; i != heartbeats.size(); ++i) {
+        if (!status.ok()) {
+          heartbeats[i].callback(status);
+        } else if (i >= num_statuses) {
+          heartbeats[i].callback(STATUS_FORMAT(
+              IllegalState, "Status of heartbeat $0 is missing, $1 statuses received",
+              i, num_statuses));
+        } else {
+          heartbeats[i].callback(StatusFromPB(resp.statuses(static_cast<int>(i))));
+        }
+      }
+    });
+    (**handle).SendRpc();
+  }
+
   YBClient* const client_;
   scoped_refptr<ClockBase> clock_;
   TransactionTableState table_state_;
@@ -348,6 +485,12 @@ class TransactionManager::Impl {
   yb::rpc::TasksPool<LoadStatusTabletsTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
   yb::rpc::Rpcs rpcs_;
+
+  std::mutex heartbeats_mutex_;
+  std::unordered_map<TabletId, HeartbeatBatch> heartbeat_batches_ GUARDED_BY(heartbeats_mutex_);
+  bool heartbeats_flush_scheduled_ GUARDED_BY(heartbeats_mutex_) = false;
+  bool heartbeats_closing_ GUARDED_BY(heartbeats_mutex_) = false;
+  rpc::ScheduledTaskTracker heartbeats_flush_task_;
 };
 
 TransactionManager::TransactionManager(
@@ -399,6 +542,12 @@ uint64_t TransactionManager::GetLoadedStatusTabletsVersion() {
   return impl_->GetLoadedStatusTabletsVersion();
 }
 
+void TransactionManager::SendBatchedHeartbeat(
+    const internal::RemoteTabletPtr& status_tablet, const TransactionId& id,
+    HeartbeatCallback callback) {
+  impl_->SendBatchedHeartbeat(status_tablet, id, std::move(callback));
+}
+
 void TransactionManager::Shutdown() {
   impl_->Shutdown();
 }
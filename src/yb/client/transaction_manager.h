@@ -22,6 +22,7 @@
 
 #include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
 #include "yb/common/transaction.pb.h"
 
 #include "yb/rpc/rpc_fwd.h"
@@ -31,6 +32,7 @@ namespace client {
 
 using PickStatusTabletCallback = std::function<void(const Result<std::string>&)>;
 using UpdateTransactionTablesVersionCallback = std::function<void(const Status&)>;
+using HeartbeatCallback = std::function<void(const Status&)>;
 
 // TransactionManager manages multiple transactions. It lives at the YQL engine layer.
 class TransactionManager {
@@ -59,6 +61,13 @@ class TransactionManager {
 
   void UpdateClock(HybridTime time);
 
+  // Sends heartbeat of the pending transaction together with heartbeats of other transactions
+  // managed by the same status tablet, see batch_transaction_heartbeats.
+  // Callback is invoked with the status of the heartbeat of this transaction.
+  void SendBatchedHeartbeat(
+      const internal::RemoteTabletPtr& status_tablet, const TransactionId& id,
+      HeartbeatCallback callback);
+
   bool PlacementLocalTransactionsPossible();
 
   uint64_t GetLoadedStatusTabletsVersion();
@@ -178,4 +178,26 @@ LocalityLevel PlacementInfoConverter::GetLocalityLevel(
   return LocalityLevel::kZone;
 }
 
+PeerPlacementRegistry& PeerPlacementRegistry::Instance() {
+  static PeerPlacementRegistry instance;
+  return instance;
+}
+
+void PeerPlacementRegistry::Register(const std::string& host, const CloudInfoPB& cloud_info) {
+  if (host.empty()) {
+    return;
+  }
+  std::lock_guard lock(mutex_);
+  peers_[host] = cloud_info;
+}
+
+std::optional<CloudInfoPB> PeerPlacementRegistry::Find(const std::string& host) const {
+  std::lock_guard lock(mutex_);
+  auto it = peers_.find(host);
+  if (it == peers_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
 } // namespace yb
@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <rapidjson/document.h>
@@ -23,6 +26,8 @@
 
 #include "yb/common/common_net.pb.h"
 
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/util/result.h"
 
 namespace yb {
@@ -58,4 +63,19 @@ class PlacementInfoConverter {
                                     const rapidjson::Document& placement);
 };
 
+// Placement of known peers by their host, used to make placement dependent decisions for
+// connections to them. For instance whether connection should use stream compression.
+class PeerPlacementRegistry {
+ public:
+  static PeerPlacementRegistry& Instance();
+
+  void Register(const std::string& host, const CloudInfoPB& cloud_info);
+
+  std::optional<CloudInfoPB> Find(const std::string& host) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, CloudInfoPB> peers_ GUARDED_BY(mutex_);
+};
+
 } // namespace yb
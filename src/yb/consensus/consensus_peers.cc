@@ -41,6 +41,7 @@
 #include <boost/optional.hpp>
 #include <glog/logging.h>
 
+#include "yb/common/placement_info.h"
 #include "yb/common/wire_protocol.h"
 
 #include "yb/consensus/consensus.h"
@@ -52,6 +53,7 @@
 #include "yb/gutil/strings/substitute.h"
 
 #include "yb/rpc/periodic.h"
+#include "yb/rpc/proxy.h"
 #include "yb/rpc/rpc_controller.h"
 
 #include "yb/tablet/tablet_error.h"
@@ -83,6 +85,11 @@ DEFINE_UNKNOWN_int32(max_wait_for_processresponse_before_closing_ms,
              "finish before returning proceding to close the Peer and return");
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
+DEFINE_RUNTIME_bool(consensus_send_serialized_ops, true,
+    "Keep the wire format of ops sent to followers in the log cache, and send it without copying "
+    "in update requests to all followers, instead of encoding the same ops for every request. "
+    "The wire format is accounted in the log cache memory usage.");
+
 DECLARE_int32(raft_heartbeat_interval_ms);
 
 DECLARE_bool(enable_multi_raft_heartbeat_batcher);
@@ -330,15 +337,18 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
       return;
     }
 
-    // TODO(lw_uc) support multiraft heartbeat with LW
-    update_request_->ToGoogleProtobuf(&heartbeat_request_);
-    update_response_->ToGoogleProtobuf(&heartbeat_response_);
+    // The heartbeat could outlive update_request_, that is reset by the next update.
+    heartbeat_arena_.Reset(ResetMode::kKeepFirst);
+    heartbeat_request_ = heartbeat_arena_.NewObject<LWConsensusRequestPB>(
+        &heartbeat_arena_, *update_request_);
+    heartbeat_response_ = heartbeat_arena_.NewObject<LWConsensusResponsePB>(
+        &heartbeat_arena_, *update_response_);
     cur_heartbeat_id_++;
     processing_lock.unlock();
     performing_update_lock.unlock();
     performing_heartbeat_lock.release();
     multi_raft_batcher_->AddRequestToBatch(
-        &heartbeat_request_, &heartbeat_response_,
+        heartbeat_request_, heartbeat_response_,
         std::bind(&Peer::ProcessHeartbeatResponse, retain_self, _1));
     return;
   }
@@ -351,9 +361,36 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // and this new request in the same order they were received by the remote peer.
   // TODO: Remove batched but unsent heartbeats (in the respective MultiRaftBatcher) in this case
   minimum_viable_heartbeat_ = cur_heartbeat_id_ + 1;
+
+  // Small updates could be sent together with updates of other tablets to the same tserver.
+  if (!req_is_heartbeat && multi_raft_batcher_) {
+    auto request_size = update_request_->SerializedSize();
+    if (MultiRaftHeartbeatBatcher::ShouldBatchUpdate(request_size)) {
+      processing_lock.unlock();
+      performing_update_lock.release();
+      multi_raft_batcher_->AddUpdateToBatch(
+          update_request_, update_response_,
+          std::bind(&Peer::ProcessBatchedUpdateResponse, retain_self, _1), request_size);
+      return;
+    }
+  }
+
   processing_lock.unlock();
   performing_update_lock.release();
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  if (!update_request_->ops().empty() && FLAGS_consensus_send_serialized_ops &&
+      proxy_->SupportsSerializedOps()) {
+    // Ops are appended to the request as already serialized fields, sharing the buffers with the
+    // log cache and requests to other followers.
+    queue_->SerializeMessages(&msgs_holder);
+    std::vector<RefCntSlice> serialized_ops;
+    serialized_ops.reserve(msgs_holder.messages().size());
+    for (const auto& op : *msgs_holder.mutable_serialized_messages()) {
+      serialized_ops.emplace_back(op);
+    }
+    update_request_->mutable_ops()->clear();
+    controller_.set_request_tail(std::move(serialized_ops));
+  }
   proxy_->UpdateAsync(update_request_, trigger_mode, update_response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
 }
@@ -460,7 +497,7 @@ void Peer::ProcessResponse() {
 
 void Peer::ProcessHeartbeatResponse(const Status& status) {
   DCHECK(performing_heartbeat_mutex_.is_locked()) << "Got a heartbeat when nothing was pending.";
-  DCHECK(heartbeat_request_.ops().empty()) << "Got a heartbeat with a non-zero number of ops.";
+  DCHECK(heartbeat_request_->ops().empty()) << "Got a heartbeat with a non-zero number of ops.";
 
   auto performing_heartbeat_lock = LockPerformingHeartbeat(std::adopt_lock);
   auto processing_lock = StartProcessingUnlocked();
@@ -476,9 +513,7 @@ void Peer::ProcessHeartbeatResponse(const Status& status) {
     return;
   }
 
-  // TODO(lw_uc) support multiraft heartbeat with LW
-  auto lw_response = rpc::CopySharedMessage(heartbeat_response_);
-  bool more_pending = ProcessResponseWithStatus(status, lw_response.get());
+  bool more_pending = ProcessResponseWithStatus(status, heartbeat_response_);
 
   if (more_pending) {
     auto performing_update_lock = LockPerformingUpdate(std::try_to_lock);
@@ -492,6 +527,23 @@ void Peer::ProcessHeartbeatResponse(const Status& status) {
   }
 }
 
+void Peer::ProcessBatchedUpdateResponse(const Status& status) {
+  DCHECK(performing_update_mutex_.is_locked()) << "Got a response when nothing was pending.";
+
+  auto performing_update_lock = LockPerformingUpdate(std::adopt_lock);
+  auto processing_lock = StartProcessingUnlocked();
+  if (!processing_lock.owns_lock()) {
+    return;
+  }
+  bool more_pending = ProcessResponseWithStatus(status, update_response_);
+
+  if (more_pending) {
+    processing_lock.unlock();
+    performing_update_lock.release();
+    SendNextRequest(RequestTriggerMode::kAlwaysSend);
+  }
+}
+
 Status Peer::SendRemoteBootstrapRequest() {
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(INFO, 30) << "Sending request to remotely bootstrap";
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolNormal);
@@ -627,6 +679,10 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
   consensus_proxy_->StartRemoteBootstrapAsync(*request, response, controller, callback);
 }
 
+bool RpcPeerProxy::SupportsSerializedOps() const {
+  return !consensus_proxy_->proxy().IsServiceLocal();
+}
+
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
@@ -634,6 +690,16 @@ RpcPeerProxyFactory::RpcPeerProxyFactory(
     : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
+  if (peer_pb.has_cloud_info()) {
+    // Remember placement of the peer, so connections to it could depend on locality.
+    auto& registry = PeerPlacementRegistry::Instance();
+    for (const auto* addrs : {&peer_pb.last_known_private_addr(),
+                              &peer_pb.last_known_broadcast_addr()}) {
+      for (const auto& addr : *addrs) {
+        registry.Register(addr.host(), peer_pb.cloud_info());
+      }
+    }
+  }
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
   return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
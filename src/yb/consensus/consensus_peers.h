@@ -189,6 +189,9 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // Signals that a heartbeat response was received from the peer.
   void ProcessHeartbeatResponse(const Status& status);
 
+  // Signals that a response to the update request sent via multi-Raft batch was received.
+  void ProcessBatchedUpdateResponse(const Status& status);
+
   // Returns true if there are more pending ops to process, false otherwise.
   bool ProcessResponseWithStatus(const Status& status,
                                  LWConsensusResponsePB* response);
@@ -238,9 +241,10 @@ class Peer : public std::enable_shared_from_this<Peer> {
   LWConsensusRequestPB* update_request_ = nullptr;
   LWConsensusResponsePB* update_response_ = nullptr;
 
-  // Latest heartbeat request and response
-  ConsensusRequestPB heartbeat_request_;
-  ConsensusResponsePB heartbeat_response_;
+  // Latest heartbeat request and response stored in heartbeat_arena_.
+  ThreadSafeArena heartbeat_arena_;
+  LWConsensusRequestPB* heartbeat_request_ = nullptr;
+  LWConsensusResponsePB* heartbeat_response_ = nullptr;
 
   // Each time a heartbeat request is sent this value is incremented.
   int64_t cur_heartbeat_id_ = 0;
@@ -334,6 +338,12 @@ class PeerProxy {
     LOG(DFATAL) << "Not implemented";
   }
 
+  // Whether UpdateAsync sends the request over a remote RPC call, so ops could be passed as
+  // already serialized request tail, see RpcController::set_request_tail.
+  virtual bool SupportsSerializedOps() const {
+    return false;
+  }
+
   virtual ~PeerProxy() {}
 };
 
@@ -383,6 +393,8 @@ class RpcPeerProxy : public PeerProxy {
                                        rpc::RpcController* controller,
                                        const rpc::ResponseCallback& callback) override;
 
+  bool SupportsSerializedOps() const override;
+
   virtual ~RpcPeerProxy();
 
  private:
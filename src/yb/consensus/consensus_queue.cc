@@ -671,7 +671,9 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     if (result->read_from_disk_size) {
       consumption = ScopedTrackedConsumption(operations_mem_tracker_, result->read_from_disk_size);
     }
-    *msgs_holder = LWReplicateMsgsHolder(std::move(result->messages), std::move(consumption));
+    *msgs_holder = LWReplicateMsgsHolder(
+        std::move(result->messages), std::move(result->serialized_messages),
+        std::move(consumption));
 
     if (propagated_safe_time &&
         !result->have_more_messages &&
@@ -718,6 +720,10 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   return Status::OK();
 }
 
+void PeerMessageQueue::SerializeMessages(LWReplicateMsgsHolder* msgs_holder) {
+  log_cache_.SerializeMessages(msgs_holder->messages(), msgs_holder->mutable_serialized_messages());
+}
+
 Result<ReadOpsResult> PeerMessageQueue::ReadFromLogCache(
     int64_t after_index, int64_t to_index, size_t max_batch_size, const std::string& peer_uuid,
     const CoarseTimePoint deadline, const bool fetch_single_entry) {
@@ -299,6 +299,10 @@ class PeerMessageQueue {
       PeerMemberType* member_type = nullptr,
       bool* last_exchange_successful = nullptr);
 
+  // Fills wire format of messages held by msgs_holder, reusing the one kept in the log cache, see
+  // LogCache::SerializeMessages.
+  void SerializeMessages(LWReplicateMsgsHolder* msgs_holder);
+
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
   // peer->needs_remote_bootstrap to false.
@@ -46,6 +46,7 @@
 #include "yb/consensus/log.messages.h"
 #include "yb/consensus/log-test-base.h"
 #include "yb/consensus/log_index.h"
+#include "yb/consensus/log_sync_coordinator.h"
 #include "yb/consensus/opid_util.h"
 
 #include "yb/gutil/stl_util.h"
@@ -68,6 +69,9 @@ DECLARE_bool(TEST_simulate_abrupt_server_restart);
 DECLARE_bool(TEST_skip_file_close);
 DECLARE_int64(reuse_unclosed_segment_threshold);
 
+METRIC_DECLARE_entity(server);
+METRIC_DECLARE_histogram(log_group_sync_size);
+
 namespace yb {
 namespace log {
 
@@ -365,6 +369,30 @@ TEST_F(LogTest, TestFsync) {
   ASSERT_OK(log_->Close());
 }
 
+// Tests that forced syncs go through the sync coordinator only when it is specified, and that
+// log works the same way without it.
+TEST_F(LogTest, TestFsyncWithSyncCoordinator) {
+  auto server_entity = METRIC_ENTITY_server.Instantiate(metric_registry_.get(), "log-test");
+  LogSyncCoordinator coordinator(server_entity);
+  auto group_size = METRIC_log_group_sync_size.Instantiate(server_entity);
+  options_.durable_wal_write = true;
+
+  OpIdPB opid;
+  opid.set_term(0);
+  opid.set_index(1);
+  for (auto* sync_coordinator : {static_cast<LogSyncCoordinator*>(nullptr), &coordinator}) {
+    options_.sync_coordinator = sync_coordinator;
+    BuildLog();
+    ASSERT_OK(AppendNoOp(&opid));
+    ASSERT_OK(log_->Close());
+    if (!sync_coordinator) {
+      ASSERT_EQ(group_size->TotalCount(), 0U);
+    } else {
+      ASSERT_GT(group_size->TotalCount(), 0U);
+    }
+  }
+}
+
 // Tests interval for durable wal write
 TEST_F(LogTest, TestFsyncInterval) {
   options_.interval_durable_wal_write = MonoDelta::FromMilliseconds(1);
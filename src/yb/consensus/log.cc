@@ -52,6 +52,7 @@
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_sync_coordinator.h"
 #include "yb/consensus/log_util.h"
 
 #include "yb/fs/fs_manager.h"
@@ -605,6 +606,7 @@ Log::Log(
     CreateNewSegment create_new_segment)
     : options_(std::move(options)),
       wal_dir_(std::move(wal_dir)),
+      wal_root_dir_(DirName(DirName(wal_dir_))),
       tablet_id_(std::move(tablet_id)),
       peer_uuid_(std::move(peer_uuid)),
       schema_(std::make_unique<Schema>(schema)),
@@ -1232,7 +1234,13 @@ Status Log::Sync() {
       break;
     }
     case SyncType::kForceFsync: {
-      RETURN_NOT_OK(DoSync());
+      if (options_.sync_coordinator) {
+        RETURN_NOT_OK(options_.sync_coordinator->Sync(wal_root_dir_, [this] {
+          return DoSync();
+        }));
+      } else {
+        RETURN_NOT_OK(DoSync());
+      }
       break;
     }
   }
@@ -495,6 +495,10 @@ class Log : public RefCountedThreadSafe<Log> {
   // The dir path where the write-ahead log for this tablet is stored.
   std::string wal_dir_;
 
+  // The WAL root directory that contains wal_dir_, logs of the same root are grouped by the sync
+  // coordinator.
+  const std::string wal_root_dir_;
+
   // The ID of the tablet this log is dedicated to.
   std::string tablet_id_;
 
@@ -42,6 +42,7 @@
 #include "yb/common/wire_protocol-test-util.h"
 
 #include "yb/consensus/consensus-test-util.h"
+#include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_cache.h"
 #include "yb/consensus/log_reader.h"
@@ -49,6 +50,7 @@
 #include "yb/fs/fs_manager.h"
 
 #include "yb/gutil/bind.h"
+#include "yb/gutil/casts.h"
 #include "yb/gutil/stl_util.h"
 
 #include "yb/server/hybrid_clock.h"
@@ -219,6 +221,59 @@ TEST_F(LogCacheTest, TestAppendAndGetMessages) {
   EXPECT_EQ(MakeOpIdForIndex(start + 1), OpId::FromPB(read_result.messages[0]->id()));
 }
 
+// Test that wire format of messages is kept in the cache, shared by subsequent reads and accounted
+// in the cache memory usage.
+TEST_F(LogCacheTest, TestSerializeMessages) {
+  constexpr size_t kNumOps = 3;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kNumOps));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  const auto size_before = cache_->metrics_.size->value();
+  const auto consumption_before = cache_->tracker_->consumption();
+
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(read_result.messages.size(), kNumOps);
+  ASSERT_EQ(read_result.serialized_messages.size(), kNumOps);
+  for (const auto& serialized : read_result.serialized_messages) {
+    ASSERT_FALSE(serialized);
+  }
+  cache_->SerializeMessages(read_result.messages, &read_result.serialized_messages);
+
+  // Concatenated wire format of messages should be parsed as ops of the consensus request.
+  std::string request_str;
+  int64_t serialized_size = 0;
+  for (const auto& serialized : read_result.serialized_messages) {
+    ASSERT_TRUE(serialized);
+    request_str.append(serialized.data(), serialized.size());
+    serialized_size += serialized.size();
+  }
+  ConsensusRequestPB request;
+  ASSERT_TRUE(request.ParsePartialFromString(request_str));
+  ASSERT_EQ(request.ops_size(), narrow_cast<int>(kNumOps));
+  for (size_t i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(request.ops(narrow_cast<int>(i)).SerializeAsString(),
+              read_result.messages[i]->SerializeAsString());
+  }
+  ASSERT_EQ(cache_->metrics_.size->value(), size_before + serialized_size);
+  ASSERT_EQ(cache_->tracker_->consumption(), consumption_before + serialized_size);
+
+  // Second read should reuse wire format kept in the cache.
+  auto second_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(second_result.serialized_messages.size(), kNumOps);
+  for (size_t i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(second_result.serialized_messages[i].data(),
+              read_result.serialized_messages[i].data());
+  }
+  cache_->SerializeMessages(second_result.messages, &second_result.serialized_messages);
+  ASSERT_EQ(cache_->metrics_.size->value(), size_before + serialized_size);
+  ASSERT_EQ(cache_->tracker_->consumption(), consumption_before + serialized_size);
+
+  // Eviction should release the memory used by the wire format as well.
+  cache_->EvictThroughOp(kNumOps);
+  ASSERT_EQ(cache_->metrics_.num_ops->value(), 0);
+  ASSERT_EQ(cache_->metrics_.size->value(), 0);
+  ASSERT_EQ(cache_->tracker_->consumption(), 0);
+}
+
 // Test cache entry shouldn't be evicted until it's synced to disk.
 TEST_F(LogCacheTest, ShouldNotEvictUnsyncedOpFromCache) {
   ASSERT_OK(AppendReplicateMessageToCache(/* term = */ 1, /* index = */ 1));
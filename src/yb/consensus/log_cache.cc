@@ -37,13 +37,18 @@
 #include <mutex>
 #include <vector>
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
 #include "yb/consensus/consensus.messages.h"
+#include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/consensus_util.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_reader.h"
 #include "yb/consensus/opid_util.h"
 
 #include "yb/gutil/bind.h"
+#include "yb/gutil/casts.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 
@@ -319,6 +324,10 @@ Result<yb::OpId> LogCache::LookupOpId(int64_t op_index) const {
 
 namespace {
 
+constexpr auto kOpsTag = google::protobuf::internal::WireFormatLite::MakeTag(
+    ConsensusRequestPB::kOpsFieldNumber,
+    google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+
 // Calculate the total byte size that will be used on the wire to replicate this message as part of
 // a consensus update request. This accounts for the length delimiting and tagging of the message.
 int64_t TotalByteSizeForMessage(const LWReplicateMsg& msg) {
@@ -328,6 +337,20 @@ int64_t TotalByteSizeForMessage(const LWReplicateMsg& msg) {
   return msg_size;
 }
 
+// Serializes msg as the ops field of ConsensusRequestPB.
+RefCntBuffer SerializeMessage(const LWReplicateMsg& msg) {
+  using google::protobuf::io::CodedOutputStream;
+  const auto msg_size = msg.SerializedSize();
+  RefCntBuffer result(
+      CodedOutputStream::VarintSize32(kOpsTag) +
+      google::protobuf::internal::WireFormatLite::LengthDelimitedSize(msg_size));
+  auto* out = CodedOutputStream::WriteTagToArray(kOpsTag, result.udata());
+  out = CodedOutputStream::WriteVarint32ToArray(narrow_cast<uint32_t>(msg_size), out);
+  out = msg.SerializeToArray(out);
+  DCHECK_EQ(out, result.uend());
+  return result;
+}
+
 } // anonymous namespace
 
 Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index, size_t max_size_bytes) {
@@ -418,6 +441,7 @@ Result<ReadOpsResult> LogCache::ReadOps(
           break;
         }
         result.messages.push_back(msg);
+        result.serialized_messages.emplace_back();
         result.read_from_disk_size += current_message_size;
         next_index++;
       }
@@ -435,19 +459,22 @@ Result<ReadOpsResult> LogCache::ReadOps(
         if (to_op_index > 0 && next_index > to_op_index) {
           break;
         }
-        const ReplicateMsgPtr& msg = iter->second.msg;
+        const CacheEntry& entry = iter->second;
+        const ReplicateMsgPtr& msg = entry.msg;
         int64_t index = msg->id().index();
         if (index != next_index) {
           continue;
         }
 
-        auto current_message_size = TotalByteSizeForMessage(*msg);
+        int64_t current_message_size = entry.serialized
+            ? static_cast<int64_t>(entry.serialized.size()) : TotalByteSizeForMessage(*msg);
         remaining_space -= current_message_size;
         if (remaining_space < 0 && !result.messages.empty()) {
           break;
         }
 
         result.messages.push_back(msg);
+        result.serialized_messages.push_back(entry.serialized);
         next_index++;
       }
     }
@@ -456,6 +483,40 @@ Result<ReadOpsResult> LogCache::ReadOps(
   return result;
 }
 
+void LogCache::SerializeMessages(
+    const ReplicateMsgs& messages, std::vector<RefCntBuffer>* serialized) {
+  DCHECK_EQ(serialized->size(), messages.size());
+  boost::container::small_vector<size_t, 8> new_serialized;
+  for (size_t i = 0; i != messages.size(); ++i) {
+    if (!(*serialized)[i]) {
+      // Serialize outside of the lock, since messages could be large.
+      (*serialized)[i] = SerializeMessage(*messages[i]);
+      new_serialized.push_back(i);
+    }
+  }
+  if (new_serialized.empty()) {
+    return;
+  }
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  for (auto i : new_serialized) {
+    const auto& msg = messages[i];
+    auto it = cache_.find(msg->id().index());
+    // Message could be read from disk, replaced, evicted or serialized concurrently.
+    if (it == cache_.end() || it->second.msg != msg || it->second.serialized) {
+      continue;
+    }
+    auto& entry = it->second;
+    entry.serialized = (*serialized)[i];
+    const auto size = entry.serialized.size();
+    entry.mem_usage += size;
+    metrics_.size->IncrementBy(size);
+    if (entry.tracked) {
+      tracker_->Consume(size);
+    }
+  }
+}
+
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
   // Capture the evicted messages and release the memory outside of lock.
   ReplicateMsgVector evicted_messages;
@@ -60,6 +60,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/mutex.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/status_callback.h"
 
@@ -77,6 +78,9 @@ class ReplicateMsg;
 
 struct ReadOpsResult {
   ReplicateMsgs messages;
+  // Wire format of messages, in the same order as messages, see LogCache::SerializeMessages.
+  // ReadOps fills it only for messages whose wire format is kept in the cache, others are null.
+  std::vector<RefCntBuffer> serialized_messages;
   OpId preceding_op;
   HaveMoreMessages have_more_messages = HaveMoreMessages::kFalse;
   int64_t read_from_disk_size = 0;
@@ -132,6 +136,14 @@ class LogCache {
       CoarseTimePoint deadline = CoarseTimePoint::max(),
       bool fetch_single_entry = false);
 
+  // Fills wire format of messages, serializing the ones that do not have it yet. serialized should
+  // contain an entry for every message, as returned by ReadOps. The wire format of a message is the
+  // complete ops field of ConsensusRequestPB, i.e. tag, length and the message itself, so it could
+  // be appended to a serialized request as is.
+  // Wire format of messages that are still present in the cache is kept there and accounted in
+  // the cache memory usage, so every message is serialized once and shared by all followers.
+  void SerializeMessages(const ReplicateMsgs& messages, std::vector<RefCntBuffer>* serialized);
+
   // Append the operations into the log and the cache.  When the messages have completed writing
   // into the on-disk log, fires 'callback'.
   //
@@ -193,12 +205,15 @@ class LogCache {
   // An entry in the cache.
   struct CacheEntry {
     ReplicateMsgPtr msg;
-    // The cached value of msg->SpaceUsedLong(). This method is expensive
-    // to compute, so we compute it only once upon insertion.
+    // The cached value of msg->SpaceUsedLong(), plus the size of serialized when it is present.
+    // SpaceUsedLong is expensive to compute, so we compute it only once upon insertion.
     size_t mem_usage = 0;
 
     // Did we start memory tracking for this entry.
     bool tracked = false;
+
+    // Wire format of msg, set when it is sent to a follower for the first time.
+    RefCntBuffer serialized;
   };
 
   typedef boost::container::small_vector<ReplicateMsgPtr, 8> ReplicateMsgVector;
@@ -29,6 +29,7 @@ class LogEntryBatchPB;
 class LogEntryPB;
 class LogIndex;
 class LogReader;
+class LogSyncCoordinator;
 class LogSegmentFooterPB;
 class LogSegmentHeaderPB;
 class ReadableLogSegment;
@@ -0,0 +1,178 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/log_sync_coordinator.h"
+
+#include "yb/util/metrics.h"
+#include "yb/util/status.h"
+#include "yb/util/status_format.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_thread_holder.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(log_group_sync_window_us);
+DECLARE_int32(log_group_sync_max_size);
+
+METRIC_DECLARE_entity(server);
+METRIC_DECLARE_histogram(log_group_sync_size);
+
+namespace yb {
+namespace log {
+
+constexpr int kNumSyncs = 4;
+
+class LogSyncCoordinatorTest : public YBTest {
+ protected:
+  LogSyncCoordinatorTest()
+      : metric_entity_(METRIC_ENTITY_server.Instantiate(&metric_registry_, "test")),
+        coordinator_(metric_entity_) {
+  }
+
+  MetricRegistry metric_registry_;
+  scoped_refptr<MetricEntity> metric_entity_;
+  LogSyncCoordinator coordinator_;
+};
+
+TEST_F(LogSyncCoordinatorTest, SingleSync) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_group_sync_window_us) = 0;
+  int syncs = 0;
+  ASSERT_OK(coordinator_.Sync("/wals", [&syncs] {
+    ++syncs;
+    return Status::OK();
+  }));
+  ASSERT_EQ(syncs, 1);
+  ASSERT_NOK(coordinator_.Sync("/wals", [] {
+    return STATUS(IOError, "Sync failed");
+  }));
+}
+
+// Checks that syncs of the same WAL root are released together, once the group is full, and that
+// every member performs its sync from its own thread, concurrently with other members.
+TEST_F(LogSyncCoordinatorTest, FullGroup) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_group_sync_window_us) = 60 * 1000 * 1000;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_group_sync_max_size) = kNumSyncs;
+
+  std::atomic<int> entered{0};
+  std::atomic<int> running{0};
+  std::mutex mutex;
+  std::set<std::thread::id> sync_threads;
+  TestThreadHolder thread_holder;
+  const auto start = MonoTime::Now();
+  for (int i = 0; i != kNumSyncs; ++i) {
+    thread_holder.AddThread([this, &entered, &running, &mutex, &sync_threads] {
+      entered.fetch_add(1);
+      const auto caller_thread = std::this_thread::get_id();
+      ASSERT_OK(coordinator_.Sync("/wals", [&entered, &running, &mutex, &sync_threads,
+                                            caller_thread] {
+        EXPECT_EQ(entered.load(), kNumSyncs);
+        EXPECT_EQ(std::this_thread::get_id(), caller_thread);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          sync_threads.insert(std::this_thread::get_id());
+        }
+        // Would not finish if syncs of the group were performed one by one.
+        running.fetch_add(1);
+        const auto deadline = MonoTime::Now() + 30s;
+        while (running.load() != kNumSyncs && MonoTime::Now() < deadline) {
+          std::this_thread::sleep_for(1ms);
+        }
+        EXPECT_EQ(running.load(), kNumSyncs);
+        return Status::OK();
+      }));
+    });
+  }
+  thread_holder.JoinAll();
+  ASSERT_EQ(sync_threads.size(), static_cast<size_t>(kNumSyncs));
+  // Full group should not wait for the window.
+  ASSERT_LT(MonoTime::Now() - start, MonoDelta(30s));
+
+  auto group_size = METRIC_log_group_sync_size.Instantiate(metric_entity_);
+  ASSERT_EQ(group_size->TotalCount(), 1U);
+  ASSERT_EQ(group_size->MaxValueForTests(), static_cast<uint64_t>(kNumSyncs));
+}
+
+// Checks that incomplete group is released when the window expires, and that logs of different
+// WAL roots are not grouped.
+TEST_F(LogSyncCoordinatorTest, WindowExpires) {
+  constexpr auto kWindow = 200ms;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_group_sync_window_us) =
+      static_cast<int32_t>(ToMicroseconds(kWindow));
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_group_sync_max_size) = 2;
+
+  TestThreadHolder thread_holder;
+  const auto start = MonoTime::Now();
+  for (const auto* wal_root : {"/wals1", "/wals2"}) {
+    thread_holder.AddThread([this, wal_root] {
+      ASSERT_OK(coordinator_.Sync(wal_root, [] {
+        return Status::OK();
+      }));
+    });
+  }
+  thread_holder.JoinAll();
+  ASSERT_GE(MonoTime::Now() - start, MonoDelta(kWindow));
+
+  auto group_size = METRIC_log_group_sync_size.Instantiate(metric_entity_);
+  ASSERT_EQ(group_size->TotalCount(), 2U);
+  ASSERT_EQ(group_size->MaxValueForTests(), 1U);
+}
+
+// Checks that syncs that arrive while the previous group is synced are grouped together, without
+// waiting for the window, and that statuses are returned to the corresponding members.
+TEST_F(LogSyncCoordinatorTest, GroupWhileSyncing) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_group_sync_window_us) = 0;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_group_sync_max_size) = 64;
+
+  std::atomic<bool> first_sync_started{false};
+  std::atomic<int> entered{0};
+  TestThreadHolder thread_holder;
+  thread_holder.AddThread([this, &first_sync_started, &entered] {
+    ASSERT_OK(coordinator_.Sync("/wals", [&first_sync_started, &entered] {
+      first_sync_started = true;
+      while (entered.load() != kNumSyncs) {
+        std::this_thread::sleep_for(1ms);
+      }
+      // Give the syncs time to join the next group.
+      std::this_thread::sleep_for(100ms);
+      return Status::OK();
+    }));
+  });
+  while (!first_sync_started.load()) {
+    std::this_thread::sleep_for(1ms);
+  }
+  for (int i = 0; i != kNumSyncs; ++i) {
+    thread_holder.AddThread([this, i, &entered] {
+      entered.fetch_add(1);
+      auto status = coordinator_.Sync("/wals", [i] {
+        return i % 2 ? STATUS_FORMAT(IOError, "Sync $0 failed", i) : Status::OK();
+      });
+      ASSERT_EQ(status.ok(), i % 2 == 0) << status;
+    });
+  }
+  thread_holder.JoinAll();
+
+  auto group_size = METRIC_log_group_sync_size.Instantiate(metric_entity_);
+  ASSERT_EQ(group_size->TotalCount(), 2U);
+  ASSERT_EQ(group_size->MaxValueForTests(), static_cast<uint64_t>(kNumSyncs));
+}
+
+} // namespace log
+} // namespace yb
@@ -0,0 +1,168 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_sync_coordinator.h"
+
+#include <algorithm>
+#include <condition_variable>
+
+#include "yb/util/flags.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+DEFINE_RUNTIME_int32(log_group_sync_window_us, 0,
+    "Max time that the leader of a WAL sync group waits for syncs of other tablets placed on the "
+    "same WAL root directory to join the group. 0 to not wait, in this case the group contains "
+    "syncs that arrived while the previous group was synced.");
+
+DEFINE_RUNTIME_int32(log_group_sync_max_size, 64,
+    "Max number of WAL syncs in a sync group. The group is closed without waiting for the rest "
+    "of log_group_sync_window_us when it is full.");
+
+METRIC_DEFINE_coarse_histogram(server, log_group_sync_size, "Log Group Sync Size",
+                               yb::MetricUnit::kRequests,
+                               "Number of WAL syncs performed together in a sync group");
+
+METRIC_DEFINE_coarse_histogram(server, log_group_sync_wait_time, "Log Group Sync Wait Time",
+                               yb::MetricUnit::kMicroseconds,
+                               "Microseconds a WAL sync group waited for the previous group and "
+                               "for other syncs to join it");
+
+METRIC_DEFINE_coarse_histogram(server, log_group_sync_latency, "Log Group Sync Latency",
+                               yb::MetricUnit::kMicroseconds,
+                               "Microseconds spent on syncing all WAL segments of a sync group");
+
+namespace yb {
+namespace log {
+
+struct LogSyncCoordinator::Group {
+  explicit Group(uint64_t group_seq) : seq(group_seq) {}
+
+  // Groups of the device are synced in the order of their sequence numbers.
+  const uint64_t seq;
+
+  // Number of group members. Not modified after the group is closed.
+  size_t size = 0;
+
+  // Number of members whose syncs are not finished yet.
+  size_t pending = 0;
+
+  bool full = false;
+
+  // Set by the leader when the previous group of the device is synced, so members could
+  // perform their syncs.
+  bool started = false;
+};
+
+struct LogSyncCoordinator::Device {
+  std::mutex mutex;
+  std::condition_variable cond;
+
+  // Group that accepts new syncs, protected by mutex.
+  std::shared_ptr<Group> open_group;
+
+  // Sequence number of the next group and of the last synced group, protected by mutex.
+  uint64_t next_group_seq = 1;
+  uint64_t synced_group_seq = 0;
+};
+
+LogSyncCoordinator::LogSyncCoordinator(const scoped_refptr<MetricEntity>& metric_entity) {
+  if (metric_entity) {
+    group_size_ = METRIC_log_group_sync_size.Instantiate(metric_entity);
+    group_wait_time_ = METRIC_log_group_sync_wait_time.Instantiate(metric_entity);
+    group_sync_latency_ = METRIC_log_group_sync_latency.Instantiate(metric_entity);
+  }
+}
+
+LogSyncCoordinator::~LogSyncCoordinator() = default;
+
+LogSyncCoordinator::Device& LogSyncCoordinator::GetDevice(const std::string& wal_root) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& device = devices_[wal_root];
+  if (!device) {
+    device = std::make_unique<Device>();
+  }
+  return *device;
+}
+
+Status LogSyncCoordinator::Sync(
+    const std::string& wal_root, const std::function<Status()>& sync) {
+  auto& device = GetDevice(wal_root);
+  const auto start = MonoTime::Now();
+  std::unique_lock<std::mutex> lock(device.mutex);
+  const bool leader = !device.open_group;
+  if (leader) {
+    device.open_group = std::make_shared<Group>(device.next_group_seq++);
+  }
+  auto group = device.open_group;
+  ++group->size;
+  ++group->pending;
+  if (group->size >= static_cast<size_t>(std::max(FLAGS_log_group_sync_max_size, 1))) {
+    group->full = true;
+    device.open_group.reset();
+    device.cond.notify_all();
+  }
+
+  if (!leader) {
+    device.cond.wait(lock, [&group] { return group->started; });
+    lock.unlock();
+    auto status = sync();
+    lock.lock();
+    if (--group->pending == 0) {
+      device.cond.notify_all();
+    }
+    return status;
+  }
+
+  const auto window = FLAGS_log_group_sync_window_us;
+  if (window > 0) {
+    device.cond.wait_until(
+        lock, (start + MonoDelta::FromMicroseconds(window)).ToSteadyTimePoint(),
+        [&group] { return group->full; });
+  }
+  // Syncs that arrive while the previous group is synced join this group.
+  device.cond.wait(lock, [&device, &group] {
+    return device.synced_group_seq + 1 == group->seq;
+  });
+  if (device.open_group == group) {
+    device.open_group.reset();
+  }
+
+  // The group is closed, release its members, so all syncs of the group are issued concurrently.
+  const auto sync_start = MonoTime::Now();
+  group->started = true;
+  device.cond.notify_all();
+  lock.unlock();
+
+  if (group_size_) {
+    group_size_->Increment(static_cast<int64_t>(group->size));
+  }
+  if (group_wait_time_) {
+    group_wait_time_->Increment((sync_start - start).ToMicroseconds());
+  }
+  auto status = sync();
+
+  lock.lock();
+  --group->pending;
+  device.cond.wait(lock, [&group] { return group->pending == 0; });
+  if (group_sync_latency_) {
+    group_sync_latency_->Increment((MonoTime::Now() - sync_start).ToMicroseconds());
+  }
+  device.synced_group_seq = group->seq;
+  device.cond.notify_all();
+  return status;
+}
+
+} // namespace log
+} // namespace yb
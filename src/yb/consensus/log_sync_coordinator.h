@@ -0,0 +1,70 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/gutil/ref_counted.h"
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+
+class Histogram;
+class MetricEntity;
+
+namespace log {
+
+// Node wide coordinator of WAL fsyncs, shared by logs of all tablets. Used only when
+// enable_log_group_sync is set, otherwise logs sync their segments independently.
+//
+// Logs placed on the same WAL root directory are expected to share a device, so their syncs are
+// performed as groups. The sync that finds no open group becomes the group leader, other syncs of
+// the same WAL root join its group. The leader waits until the previous group of the device is
+// synced, optionally waits up to log_group_sync_window_us for more syncs to join, closes the
+// group and releases its members. Then every member issues the fsync of its own segment from its
+// own thread, so fsyncs of the group are in flight concurrently, and the group is considered
+// synced when all of them are done. So at most one group per WAL root is synced at a time, and
+// syncs that arrive meanwhile are accumulated in the next group, without an added delay when the
+// device is idle.
+class LogSyncCoordinator {
+ public:
+  explicit LogSyncCoordinator(const scoped_refptr<MetricEntity>& metric_entity);
+  ~LogSyncCoordinator();
+
+  // Invokes sync as a member of the sync group of the specified WAL root directory, from the
+  // calling thread, once the group is released. Returns status of the sync.
+  Status Sync(const std::string& wal_root, const std::function<Status()>& sync);
+
+ private:
+  struct Group;
+  struct Device;
+
+  Device& GetDevice(const std::string& wal_root);
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<Device>> devices_ GUARDED_BY(mutex_);
+
+  scoped_refptr<Histogram> group_size_;
+  scoped_refptr<Histogram> group_wait_time_;
+  scoped_refptr<Histogram> group_sync_latency_;
+};
+
+} // namespace log
+} // namespace yb
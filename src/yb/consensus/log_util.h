@@ -110,6 +110,9 @@ struct LogOptions {
 
   int64_t initial_active_segment_sequence_number = 0;
 
+  // If set, syncs on the write path are performed in groups with syncs of other logs.
+  LogSyncCoordinator* sync_coordinator = nullptr;
+
   LogOptions();
 };
 
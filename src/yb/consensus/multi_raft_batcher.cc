@@ -14,14 +14,22 @@
 #include <memory>
 #include <thread>
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
 #include "yb/common/wire_protocol.h"
 
 #include "yb/consensus/consensus_meta.h"
+#include "yb/consensus/consensus.messages.h"
 #include "yb/consensus/consensus.proxy.h"
 
+#include "yb/rpc/lightweight_message.h"
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/periodic.h"
+#include "yb/rpc/scheduler.h"
 
 #include "yb/util/flags.h"
+#include "yb/util/size_literals.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -37,28 +45,96 @@ DEFINE_UNKNOWN_uint64(multi_raft_batch_size, 0,
               "Maximum batch size for a multi-Raft consensus payload. Ignored if set to zero.");
 TAG_FLAG(multi_raft_batch_size, advanced);
 
+DEFINE_RUNTIME_bool(enable_multi_raft_update_batching, false,
+    "If true, small UpdateConsensus requests that carry ops are also sent via multi-Raft batches, "
+    "together with requests of other tablets to the same tserver. Requires "
+    "enable_multi_raft_heartbeat_batcher.");
+
+DEFINE_RUNTIME_uint64(multi_raft_max_batched_update_bytes, 64_KB,
+    "Max serialized size of an UpdateConsensus request that could be added to a multi-Raft batch.");
+
+DEFINE_RUNTIME_uint64(multi_raft_update_batch_window_us, 500,
+    "Max time that an UpdateConsensus request carrying ops waits in a multi-Raft batch before the "
+    "batch is sent.");
+
+DEFINE_RUNTIME_uint64(multi_raft_update_batch_max_bytes, 1_MB,
+    "Multi-Raft batch is sent immediately once UpdateConsensus requests in it reach this size.");
+
 DECLARE_int32(consensus_rpc_timeout_ms);
 
 namespace yb {
 namespace consensus {
 
+using google::protobuf::internal::WireFormatLite;
 using rpc::PeriodicTimer;
 
 namespace {
 
+constexpr auto kConsensusRequestTag = WireFormatLite::MakeTag(
+    MultiRaftConsensusRequestPB::kConsensusRequestFieldNumber,
+    WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+
 // Tracks a single peers ConsensusResponsePB as well as its ProcessResponse callback.
 struct ResponseCallbackData {
-  ConsensusResponsePB* resp;
+  LWConsensusResponsePB* resp;
   HeartbeatResponseCallback callback;
 };
 
+// Multi-Raft batch request that refers to the requests of the peers instead of holding their
+// copies, so ops are not copied into the batch. The referenced requests are written as the
+// consensus_request field, so the result of serialization is the same as for
+// LWMultiRaftConsensusRequestPB.
+class MultiRaftBatchRequestPB : public LWMultiRaftConsensusRequestPB {
+ public:
+  explicit MultiRaftBatchRequestPB(ThreadSafeArena* arena)
+      : LWMultiRaftConsensusRequestPB(arena) {}
+
+  void AddRequest(const LWConsensusRequestPB* request) {
+    requests_.push_back(request);
+  }
+
+  size_t num_requests() const {
+    return requests_.size();
+  }
+
+  size_t SerializedSize() const override {
+    auto result = LWMultiRaftConsensusRequestPB::SerializedSize();
+    const auto tag_size = google::protobuf::io::CodedOutputStream::VarintSize32(
+        kConsensusRequestTag);
+    for (const auto* request : requests_) {
+      result += tag_size + RequestSerialization::Size(*request);
+    }
+    return result;
+  }
+
+  uint8_t* SerializeToArray(uint8_t* out) const override {
+    out = LWMultiRaftConsensusRequestPB::SerializeToArray(out);
+    for (const auto* request : requests_) {
+      out = google::protobuf::io::CodedOutputStream::WriteTagToArray(kConsensusRequestTag, out);
+      out = RequestSerialization::Write(*request, out);
+    }
+    return out;
+  }
+
+ private:
+  using RequestSerialization = rpc::LightweightSerialization<
+      WireFormatLite::TYPE_MESSAGE, LWConsensusRequestPB>;
+
+  std::vector<const LWConsensusRequestPB*> requests_;
+};
+
 }
 
 struct MultiRaftHeartbeatBatcher::MultiRaftConsensusData {
-  MultiRaftConsensusRequestPB batch_req;
-  MultiRaftConsensusResponsePB batch_res;
+  ThreadSafeArena arena;
+  MultiRaftBatchRequestPB batch_req{&arena};
+  LWMultiRaftConsensusResponsePB batch_res{&arena};
   rpc::RpcController controller;
   std::vector<ResponseCallbackData> response_callback_data;
+  // Total size of requests added via AddUpdateToBatch.
+  size_t update_bytes = 0;
+  // Whether sending of this batch was scheduled for the end of the update latency budget.
+  bool send_scheduled = false;
 };
 
 MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
@@ -90,26 +166,76 @@ MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
       << "Not empty batch in ~MultiRaftHeartbeatBatcher";
 }
 
-void MultiRaftHeartbeatBatcher::AddRequestToBatch(ConsensusRequestPB* request,
-                                                  ConsensusResponsePB* response,
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(const LWConsensusRequestPB* request,
+                                                  LWConsensusResponsePB* response,
                                                   HeartbeatResponseCallback callback) {
-  std::shared_ptr<MultiRaftConsensusData> data = nullptr;
+  std::shared_ptr<MultiRaftConsensusData> data;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    current_batch_->response_callback_data.push_back({
-      .resp = response,
-      .callback = std::move(callback)
-    });
-    // Add a ConsensusRequestPB to the batch
-    current_batch_->batch_req.add_consensus_request()->Swap(request);
-    if (FLAGS_multi_raft_batch_size > 0
-        && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size) {
+    data = AddToBatchUnlocked(request, response, std::move(callback));
+  }
+  SendBatchRequest(data);
+}
+
+bool MultiRaftHeartbeatBatcher::ShouldBatchUpdate(size_t request_size) {
+  return FLAGS_enable_multi_raft_update_batching &&
+         request_size <= FLAGS_multi_raft_max_batched_update_bytes;
+}
+
+void MultiRaftHeartbeatBatcher::AddUpdateToBatch(const LWConsensusRequestPB* request,
+                                                 LWConsensusResponsePB* response,
+                                                 HeartbeatResponseCallback callback,
+                                                 size_t request_size) {
+  std::shared_ptr<MultiRaftConsensusData> data;
+  std::shared_ptr<MultiRaftConsensusData> batch_to_schedule;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_batch_->update_bytes += request_size;
+    if (!current_batch_->send_scheduled) {
+      current_batch_->send_scheduled = true;
+      batch_to_schedule = current_batch_;
+    }
+    data = AddToBatchUnlocked(request, response, std::move(callback));
+    if (!data && current_batch_->update_bytes >= FLAGS_multi_raft_update_batch_max_bytes) {
       data = PrepareNextBatchRequest();
     }
   }
+  // Batch that is already being sent does not need a delayed send.
+  if (batch_to_schedule && batch_to_schedule != data) {
+    std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+    std::weak_ptr<MultiRaftConsensusData> weak_batch = batch_to_schedule;
+    messenger_->scheduler().Schedule([weak_self, weak_batch](const Status& status) {
+      if (!status.ok()) {
+        // The reactor was shut down.
+        return;
+      }
+      auto self = weak_self.lock();
+      auto batch = weak_batch.lock();
+      if (self && batch) {
+        self->SendBatchIfCurrent(batch);
+      }
+    }, std::chrono::microseconds(FLAGS_multi_raft_update_batch_window_us));
+  }
   SendBatchRequest(data);
 }
 
+std::shared_ptr<MultiRaftHeartbeatBatcher::MultiRaftConsensusData>
+    MultiRaftHeartbeatBatcher::AddToBatchUnlocked(const LWConsensusRequestPB* request,
+                                                  LWConsensusResponsePB* response,
+                                                  HeartbeatResponseCallback callback) {
+  current_batch_->response_callback_data.push_back({
+    .resp = response,
+    .callback = std::move(callback)
+  });
+  // Add a ConsensusRequestPB to the batch
+  current_batch_->batch_req.AddRequest(request);
+  if (FLAGS_multi_raft_batch_size > 0
+      && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size) {
+    return PrepareNextBatchRequest();
+  }
+  return nullptr;
+}
+
 void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
   std::shared_ptr<MultiRaftConsensusData> data;
   {
@@ -119,9 +245,22 @@ void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
   SendBatchRequest(data);
 }
 
+void MultiRaftHeartbeatBatcher::SendBatchIfCurrent(
+    const std::shared_ptr<MultiRaftConsensusData>& batch) {
+  std::shared_ptr<MultiRaftConsensusData> data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (current_batch_ != batch) {
+      return;
+    }
+    data = PrepareNextBatchRequest();
+  }
+  SendBatchRequest(data);
+}
+
 std::shared_ptr<MultiRaftHeartbeatBatcher::MultiRaftConsensusData>
     MultiRaftHeartbeatBatcher::PrepareNextBatchRequest() {
-  if (!current_batch_ || current_batch_->batch_req.consensus_request_size() == 0) {
+  if (!current_batch_ || current_batch_->batch_req.num_requests() == 0) {
     return nullptr;
   }
   batch_sender_->Snooze();
@@ -138,15 +277,27 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
   }
 
   data->controller.Reset();
-  data->controller.set_timeout(MonoDelta::FromMilliseconds(
-      FLAGS_consensus_rpc_timeout_ms * data->batch_req.consensus_request_size()));
+  // Requests of the batch are applied by the remote server concurrently, so the batch does not
+  // need more time than a single request.
+  data->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  if (data->update_bytes) {
+    // Responses to updates are processed in the same way as Peer::ProcessResponse does.
+    data->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  }
   auto callback = [data, running_calls = running_calls_]() {
     --*running_calls;
     auto status = data->controller.status();
-    for (int i = 0; i < data->batch_req.consensus_request_size(); i++) {
-      auto callback_data = data->response_callback_data[i];
+    if (status.ok() &&
+        data->batch_res.consensus_response().size() != data->response_callback_data.size()) {
+      status = STATUS_FORMAT(
+          IllegalState, "Wrong number of responses in multi-Raft batch: $0, expected: $1",
+          data->batch_res.consensus_response().size(), data->response_callback_data.size());
+    }
+    auto response_it = data->batch_res.consensus_response().begin();
+    for (const auto& callback_data : data->response_callback_data) {
       if (status.ok()) {
-        callback_data.resp->Swap(data->batch_res.mutable_consensus_response(i));
+        callback_data.resp->CopyFrom(*response_it);
+        ++response_it;
       }
       callback_data.callback(status);
     }
@@ -40,6 +40,10 @@ using HeartbeatResponseCallback = std::function<void(const Status&)>;
 // - A heartbeat is added to a batch upon calling AddRequestToBatch and a batch is sent
 //   out every FLAGS_multi_raft_heartbeat_interval_ms ms or once the batch size reaches
 //   FLAGS_multi_raft_batch_size
+// - When FLAGS_enable_multi_raft_update_batching is set, small UpdateConsensus requests that carry
+//   ops are added to the same batch via AddUpdateToBatch. Such a batch is sent at most
+//   FLAGS_multi_raft_update_batch_window_us after the first update was added to it, or once the
+//   updates in the batch reach FLAGS_multi_raft_update_batch_max_bytes
 // - To improve efficency multiple batches may be processed concurrently
 //   but only a single batch is being built at any given time
 class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
@@ -54,14 +58,25 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
   // Required to start a periodic timer to send out batches.
   void Start();
 
-  // When called adds the request to a batch (request data will be swapped).
+  // When called adds the request to a batch. The request is not copied, so it should stay alive
+  // until the callback is executed.
   // If the batch executes sucessfully then the response is populated and the callback is executed.
   // If the batch rpc call fails the response will NOT be populated and the callback will be
   // executed with an error status.
-  void AddRequestToBatch(ConsensusRequestPB* request,
-                         ConsensusResponsePB* response,
+  void AddRequestToBatch(const LWConsensusRequestPB* request,
+                         LWConsensusResponsePB* response,
                          HeartbeatResponseCallback callback);
 
+  // Same as AddRequestToBatch, but for requests that carry ops, so the batch is sent within
+  // the update latency budget. request_size is the serialized size of the request.
+  void AddUpdateToBatch(const LWConsensusRequestPB* request,
+                        LWConsensusResponsePB* response,
+                        HeartbeatResponseCallback callback,
+                        size_t request_size);
+
+  // Whether the update request of specified size should be sent via the batcher.
+  static bool ShouldBatchUpdate(size_t request_size);
+
   void Shutdown();
 
  private:
@@ -69,8 +84,16 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
   // ResponseCallbackData registered by each local peer with this batch in AddRequestToBatch().
   struct MultiRaftConsensusData;
 
+  // Adds the request to the current batch, returns the batch that should be sent, if any.
+  std::shared_ptr<MultiRaftConsensusData> AddToBatchUnlocked(
+      const LWConsensusRequestPB* request, LWConsensusResponsePB* response,
+      HeartbeatResponseCallback callback) REQUIRES(mutex_);
+
   void PrepareAndSendBatchRequest();
 
+  // Sends the batch if it is still being built, used when the update latency budget expires.
+  void SendBatchIfCurrent(const std::shared_ptr<MultiRaftConsensusData>& batch);
+
   // This method will return a nullptr if the current batch is empty.
   std::shared_ptr<MultiRaftConsensusData> PrepareNextBatchRequest() REQUIRES(mutex_);
 
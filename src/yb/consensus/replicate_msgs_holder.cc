@@ -56,19 +56,30 @@ LWReplicateMsgsHolder::LWReplicateMsgsHolder(
       consumption_(std::move(consumption)) {
 }
 
+LWReplicateMsgsHolder::LWReplicateMsgsHolder(
+    ReplicateMsgs messages, std::vector<RefCntBuffer> serialized_messages,
+    ScopedTrackedConsumption consumption)
+    : messages_(std::move(messages)),
+      serialized_messages_(std::move(serialized_messages)),
+      consumption_(std::move(consumption)) {
+}
+
 LWReplicateMsgsHolder::LWReplicateMsgsHolder(LWReplicateMsgsHolder&& rhs)
     : messages_(std::move(rhs.messages_)),
+      serialized_messages_(std::move(rhs.serialized_messages_)),
       consumption_(std::move(rhs.consumption_)) {
 }
 
 void LWReplicateMsgsHolder::operator=(LWReplicateMsgsHolder&& rhs) {
   Reset();
   messages_ = std::move(rhs.messages_);
+  serialized_messages_ = std::move(rhs.serialized_messages_);
   consumption_ = std::move(rhs.consumption_);
 }
 
 void LWReplicateMsgsHolder::Reset() {
   messages_.clear();
+  serialized_messages_.clear();
   consumption_ = ScopedTrackedConsumption();
 }
 
@@ -19,6 +19,7 @@
 
 #include "yb/util/mem_tracker.h"
 #include "yb/util/memory/arena.h"
+#include "yb/util/ref_cnt_buffer.h"
 
 namespace yb {
 namespace consensus {
@@ -63,13 +64,30 @@ class LWReplicateMsgsHolder {
   LWReplicateMsgsHolder() = default;
 
   explicit LWReplicateMsgsHolder(ReplicateMsgs messages, ScopedTrackedConsumption consumption);
+  LWReplicateMsgsHolder(
+      ReplicateMsgs messages, std::vector<RefCntBuffer> serialized_messages,
+      ScopedTrackedConsumption consumption);
   LWReplicateMsgsHolder(LWReplicateMsgsHolder&& rhs);
   void operator=(LWReplicateMsgsHolder&& rhs);
 
   void Reset();
+
+  const ReplicateMsgs& messages() const {
+    return messages_;
+  }
+
+  // Wire format of messages_, in the same order, see LogCache::SerializeMessages.
+  std::vector<RefCntBuffer>* mutable_serialized_messages() {
+    return &serialized_messages_;
+  }
+
  private:
   ReplicateMsgs messages_;
 
+  // Wire format of messages_ shared with the log cache, null for messages that were not
+  // serialized yet.
+  std::vector<RefCntBuffer> serialized_messages_;
+
   ScopedTrackedConsumption consumption_;
 };
 
@@ -29,6 +29,7 @@
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/transaction_dump.h"
 #include "yb/gutil/stl_util.h"
+#include "yb/util/flags.h"
 #include "yb/util/lazy_invoke.h"
 #include "yb/util/logging.h"
 #include "yb/util/memory/memory.h"
@@ -41,6 +42,11 @@
 using namespace std::literals;
 using namespace std::placeholders;
 
+DEFINE_RUNTIME_uint64(conflict_check_merged_scan_min_keys, 32,
+    "Min number of intent keys of a transactional write batch, for which conflicts with committed "
+    "values are checked by a single forward pass over the regular DB, instead of a separate seek "
+    "per key. 0 to disable.");
+
 namespace yb {
 namespace docdb {
 
@@ -195,7 +201,9 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
     VLOG_WITH_PREFIX_AND_FUNC(4) << "Check conflicts in intents DB; Seek: "
                                  << intent_key_prefix->AsSlice().ToDebugHexString() << " for type "
                                  << ToString(type);
-    intent_iter_.Seek(intent_key_prefix->AsSlice());
+    // Intents are usually checked in increasing key order, so the iterator could reach the next
+    // key using Next instead of Seek.
+    ROCKSDB_SEEK(&intent_iter_, intent_key_prefix->AsSlice());
     while (intent_iter_.Valid()) {
       auto existing_key = intent_iter_.key();
       auto existing_value = intent_iter_.value();
@@ -701,31 +709,38 @@ class IntentProcessor {
 
 class StrongConflictChecker {
  public:
+  // When merged_scan is true, keys should be checked in increasing order.
   StrongConflictChecker(const TransactionId& transaction_id,
                         HybridTime read_time,
                         ConflictResolver* resolver,
                         Counter* conflicts_metric,
-                        KeyBytes* buffer)
+                        KeyBytes* buffer,
+                        bool merged_scan)
       : transaction_id_(transaction_id),
         read_time_(read_time),
         resolver_(*resolver),
         conflicts_metric_(*conflicts_metric),
-        buffer_(*buffer)
+        buffer_(*buffer),
+        merged_scan_(merged_scan)
   {}
 
   Status Check(
       const Slice& intent_key, bool strong, ConflictManagementPolicy conflict_management_policy) {
-    const auto hash = VERIFY_RESULT(DecodeDocKeyHash(intent_key));
-    if (PREDICT_FALSE(!value_iter_.Initialized() || hash != value_iter_hash_)) {
-      value_iter_ = CreateRocksDBIterator(
-          resolver_.doc_db().regular,
-          resolver_.doc_db().key_bounds,
-          BloomFilterMode::USE_BLOOM_FILTER,
-          intent_key,
-          rocksdb::kDefaultQueryId);
-      value_iter_hash_ = hash;
+    if (merged_scan_) {
+      SeekForwardTo(intent_key);
+    } else {
+      const auto hash = VERIFY_RESULT(DecodeDocKeyHash(intent_key));
+      if (PREDICT_FALSE(!value_iter_.Initialized() || hash != value_iter_hash_)) {
+        value_iter_ = CreateRocksDBIterator(
+            resolver_.doc_db().regular,
+            resolver_.doc_db().key_bounds,
+            BloomFilterMode::USE_BLOOM_FILTER,
+            intent_key,
+            rocksdb::kDefaultQueryId);
+        value_iter_hash_ = hash;
+      }
+      value_iter_.Seek(intent_key);
     }
-    value_iter_.Seek(intent_key);
     VLOG_WITH_PREFIX_AND_FUNC(4)
         << "Overwrite; Seek: " << intent_key.ToDebugString() << " ("
         << SubDocKey::DebugSliceToString(intent_key) << "), strong: " << strong
@@ -785,7 +800,11 @@ class StrongConflictChecker {
       buffer_.Reset(existing_key);
       // Already have ValueType::kHybridTime at the end
       buffer_.AppendHybridTime(DocHybridTime::kMin);
-      ROCKSDB_SEEK(&value_iter_, buffer_.AsSlice());
+      if (merged_scan_) {
+        SeekForwardTo(buffer_.AsSlice());
+      } else {
+        ROCKSDB_SEEK(&value_iter_, buffer_.AsSlice());
+      }
     }
 
     return value_iter_.status();
@@ -796,15 +815,42 @@ class StrongConflictChecker {
     return Format("$0: ", transaction_id_);
   }
 
+  // Positions value_iter_ to the first key that is not less than key.
+  // The whole batch is checked using single iterator without bloom filter, that is created on the
+  // first check. Iterator stays at the first key that is not less than the previous seek key, so
+  // when the key is between them, iterator is already at the right position. That is the usual
+  // case for a batch that writes keys, that are not present in the regular DB yet.
+  void SeekForwardTo(Slice key) {
+    if (PREDICT_FALSE(!value_iter_.Initialized())) {
+      value_iter_ = CreateRocksDBIterator(
+          resolver_.doc_db().regular,
+          resolver_.doc_db().key_bounds,
+          BloomFilterMode::DONT_USE_BLOOM_FILTER,
+          boost::none /* user_key_for_filter */,
+          rocksdb::kDefaultQueryId);
+    } else if (key.compare(last_seek_key_.AsSlice()) >= 0 &&
+               (!value_iter_.Valid() || value_iter_.key().compare(key) >= 0) &&
+               value_iter_.status().ok()) {
+      last_seek_key_.Reset(key);
+      return;
+    }
+    last_seek_key_.Reset(key);
+    ROCKSDB_SEEK(&value_iter_, key);
+  }
+
   const TransactionId& transaction_id_;
   const HybridTime read_time_;
   ConflictResolver& resolver_;
   Counter& conflicts_metric_;
   KeyBytes& buffer_;
 
+  const bool merged_scan_;
+
   // RocksDb iterator with bloom filter can be reused in case keys has same hash component.
   BoundedRocksDbIterator value_iter_;
   boost::optional<DocKeyHash> value_iter_hash_;
+  // Key of the last seek of value_iter_ in merged scan mode.
+  KeyBytes last_seek_key_;
 
 };
 
@@ -988,8 +1034,12 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
     VLOG_WITH_PREFIX_AND_FUNC(4) << "Check txn's conflicts for following intents: "
                                  << AsString(container);
 
+    // Keys of the container are ordered, so conflicts of a large batch could be checked by a
+    // single pass over the regular DB.
+    const auto merged_scan_min_keys = FLAGS_conflict_check_merged_scan_min_keys;
     StrongConflictChecker checker(
-        *transaction_id_, read_time_, resolver, GetConflictsMetric(), &buffer);
+        *transaction_id_, read_time_, resolver, GetConflictsMetric(), &buffer,
+        merged_scan_min_keys != 0 && container.size() >= merged_scan_min_keys);
     // Iterator on intents DB should be created before iterator on regular DB.
     // This is to prevent the case when we create an iterator on the regular DB where a
     // provisional record has not yet been applied, and then create an iterator the intents
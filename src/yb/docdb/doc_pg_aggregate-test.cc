@@ -0,0 +1,150 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/bfpg/tserver_opcodes.h"
+
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+
+#include "yb/docdb/doc_expr.h"
+#include "yb/docdb/doc_pg_aggregate.h"
+#include "yb/docdb/doc_row_batch.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr int kIntColumn = 11;
+constexpr int kDoubleColumn = 12;
+constexpr int kStringColumn = 13;
+
+void AddTarget(bfpg::TSOpcode opcode, int column_id, PgsqlReadRequestPB* request) {
+  auto* tscall = request->add_targets()->mutable_tscall();
+  tscall->set_opcode(static_cast<int32_t>(opcode));
+  tscall->add_operands()->set_column_id(column_id);
+}
+
+QLValuePB RandomValue(DataType type) {
+  if (RandomWithChance(5)) {
+    return QLValuePB();
+  }
+  switch (type) {
+    case DataType::INT32:
+      return QLValue::Primitive(RandomUniformInt<int32_t>(-1000, 1000));
+    case DataType::DOUBLE:
+      return QLValue::Primitive(RandomUniformReal<double>(-1000, 1000));
+    case DataType::STRING:
+      return QLValue::Primitive(RandomHumanReadableString(RandomUniformInt(0, 16)));
+    default:
+      CHECK(false) << "Not supported data type: " << type;
+  }
+}
+
+} // namespace
+
+// Checks that aggregates accumulated over row batches match per row evaluation.
+TEST(DocPgAggregatorTest, MatchesRowwiseEvaluation) {
+  const std::vector<DataType> column_types = {
+      DataType::INT32, DataType::INT32, DataType::DOUBLE, DataType::STRING};
+  Schema schema({
+      ColumnSchema("k", DataType::INT32, /* is_nullable = */ false),
+      ColumnSchema("i", DataType::INT32, true),
+      ColumnSchema("d", DataType::DOUBLE, true),
+      ColumnSchema("s", DataType::STRING, true),
+  }, {
+      ColumnId(10),
+      ColumnId(kIntColumn),
+      ColumnId(kDoubleColumn),
+      ColumnId(kStringColumn),
+  }, 1);
+
+  PgsqlReadRequestPB request;
+  request.set_is_aggregate(true);
+  {
+    // COUNT(*)
+    auto* tscall = request.add_targets()->mutable_tscall();
+    tscall->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+    tscall->add_operands()->mutable_value()->set_int64_value(0);
+  }
+  AddTarget(bfpg::TSOpcode::kCount, kIntColumn, &request);
+  AddTarget(bfpg::TSOpcode::kSumInt32, kIntColumn, &request);
+  AddTarget(bfpg::TSOpcode::kSumDouble, kDoubleColumn, &request);
+  AddTarget(bfpg::TSOpcode::kMin, kIntColumn, &request);
+  AddTarget(bfpg::TSOpcode::kMax, kDoubleColumn, &request);
+  AddTarget(bfpg::TSOpcode::kMin, kStringColumn, &request);
+  AddTarget(bfpg::TSOpcode::kMax, kStringColumn, &request);
+  ASSERT_TRUE(DocPgAggregator::IsSupported(request));
+
+  DocRowBatch batch;
+  batch.Init(schema, /* need_tuple_ids= */ false);
+  DocPgAggregator aggregator(request);
+  aggregator.Prepare(batch);
+
+  DocExprExecutor executor;
+  std::vector<QLExprResult> expected(request.targets().size());
+  QLTableRow row;
+  std::vector<size_t> selected_rows;
+  for (int batch_idx = 0; batch_idx != 10; ++batch_idx) {
+    batch.Clear();
+    selected_rows.clear();
+    const auto num_rows = RandomUniformInt(0, 100);
+    for (int i = 0; i != num_rows; ++i) {
+      const auto row_idx = batch.AddRow();
+      for (size_t column_idx = 0; column_idx != schema.num_columns(); ++column_idx) {
+        *batch.mutable_value(column_idx, row_idx) = RandomValue(column_types[column_idx]);
+      }
+      // Emulate rows filtered out by where clauses.
+      if (RandomWithChance(4)) {
+        continue;
+      }
+      selected_rows.push_back(row_idx);
+      row.Clear();
+      batch.ExtractRow(row_idx, &row);
+      int target_idx = 0;
+      for (const auto& target : request.targets()) {
+        ASSERT_OK(executor.EvalExpr(target, row, expected[target_idx++].Writer()));
+      }
+    }
+    ASSERT_OK(aggregator.Accumulate(batch, selected_rows));
+  }
+
+  std::vector<QLExprResult> actual;
+  aggregator.Finish(&actual);
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i != actual.size(); ++i) {
+    ASSERT_EQ(QLValue(actual[i].Value()).ToString(), QLValue(expected[i].Value()).ToString())
+        << "Target: " << request.targets(i).ShortDebugString();
+  }
+}
+
+TEST(DocPgAggregatorTest, Unsupported) {
+  PgsqlReadRequestPB request;
+  request.set_is_aggregate(true);
+  AddTarget(bfpg::TSOpcode::kAvg, kIntColumn, &request);
+  ASSERT_FALSE(DocPgAggregator::IsSupported(request));
+
+  request.Clear();
+  auto* tscall = request.add_targets()->mutable_tscall();
+  tscall->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kSumInt64));
+  tscall->add_operands()->mutable_value()->set_int64_value(1);
+  ASSERT_FALSE(DocPgAggregator::IsSupported(request));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,281 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/doc_pg_aggregate.h"
+
+#include "yb/bfpg/tserver_opcodes.h"
+
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/doc_row_batch.h"
+
+#include "yb/gutil/macros.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+void AddCount(int64_t count, QLValuePB* aggr_count) {
+  if (count == 0) {
+    return;
+  }
+  if (IsNull(*aggr_count)) {
+    aggr_count->set_int64_value(count);
+  } else {
+    aggr_count->set_int64_value(aggr_count->int64_value() + count);
+  }
+}
+
+template <class Extractor>
+void AccumulateSumInt(
+    const std::vector<QLValuePB>& column, const std::vector<size_t>& rows,
+    const Extractor& extractor, std::vector<int64_t>* buffer, QLValuePB* aggr_sum) {
+  buffer->clear();
+  for (auto row : rows) {
+    const auto& value = column[row];
+    if (!IsNull(value)) {
+      buffer->push_back(extractor(value));
+    }
+  }
+  if (buffer->empty()) {
+    return;
+  }
+
+  // Integer addition is associative, so the batch is summed separately in a plain loop over
+  // contiguous values, that compiler is able to vectorize. Unsigned arithmetic is used to get
+  // the same wraparound as the per row sum without undefined behaviour.
+  uint64_t sum = 0;
+  for (auto value : *buffer) {
+    sum += static_cast<uint64_t>(value);
+  }
+  if (!IsNull(*aggr_sum)) {
+    sum += static_cast<uint64_t>(aggr_sum->int64_value());
+  }
+  aggr_sum->set_int64_value(static_cast<int64_t>(sum));
+}
+
+template <class T, class Extractor, class Setter>
+void AccumulateSumReal(
+    const std::vector<QLValuePB>& column, const std::vector<size_t>& rows,
+    const Extractor& extractor, const Setter& setter, QLValuePB* aggr_sum) {
+  // Floating point addition is not associative, so values are added in the same order and with
+  // the same precision as the per row evaluation does.
+  bool has_sum = !IsNull(*aggr_sum);
+  T sum = has_sum ? extractor(*aggr_sum) : T();
+  for (auto row : rows) {
+    const auto& value = column[row];
+    if (IsNull(value)) {
+      continue;
+    }
+    sum = has_sum ? sum + extractor(value) : extractor(value);
+    has_sum = true;
+  }
+  if (has_sum) {
+    setter(sum, aggr_sum);
+  }
+}
+
+// Replaces aggr with the value from the column that is "better" according to is_better.
+// The best value of the batch is copied to aggr only once.
+template <class IsBetter>
+void AccumulateMinMax(
+    const std::vector<QLValuePB>& column, const std::vector<size_t>& rows,
+    const IsBetter& is_better, QLValuePB* aggr) {
+  const QLValuePB* best = IsNull(*aggr) ? nullptr : aggr;
+  for (auto row : rows) {
+    const auto& value = column[row];
+    if (!IsNull(value) && (!best || is_better(value, *best))) {
+      best = &value;
+    }
+  }
+  if (best && best != aggr) {
+    *aggr = *best;
+  }
+}
+
+} // namespace
+
+class DocPgAggregator::Target {
+ public:
+  Target(bfpg::TSOpcode opcode_, const PgsqlExpressionPB& operand_)
+      : opcode(opcode_), operand(operand_) {}
+
+  const bfpg::TSOpcode opcode;
+  const PgsqlExpressionPB& operand;
+  size_t column_idx = DocRowBatch::kColumnNotFound;
+  QLValuePB result;
+};
+
+bool DocPgAggregator::IsSupported(const PgsqlReadRequestPB& request) {
+  for (const PgsqlExpressionPB& target : request.targets()) {
+    if (!target.has_tscall() || target.tscall().operands().size() != 1) {
+      return false;
+    }
+    const auto& operand = *target.tscall().operands().begin();
+    switch (static_cast<bfpg::TSOpcode>(target.tscall().opcode())) {
+      case bfpg::TSOpcode::kCount:
+        if (operand.has_value()) {
+          // COUNT(*) or COUNT(constant).
+          break;
+        }
+        FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt64: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumFloat: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumDouble: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kMin: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kMax:
+        if (!operand.has_column_id() || operand.column_id() < 0) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+DocPgAggregator::DocPgAggregator(const PgsqlReadRequestPB& request) {
+  targets_.reserve(request.targets().size());
+  for (const PgsqlExpressionPB& target : request.targets()) {
+    targets_.emplace_back(
+        static_cast<bfpg::TSOpcode>(target.tscall().opcode()),
+        *target.tscall().operands().begin());
+  }
+}
+
+DocPgAggregator::~DocPgAggregator() = default;
+
+void DocPgAggregator::Prepare(const DocRowBatch& batch) {
+  for (auto& target : targets_) {
+    if (target.operand.has_column_id()) {
+      target.column_idx = batch.find_column(target.operand.column_id());
+    }
+  }
+}
+
+Status DocPgAggregator::Accumulate(const DocRowBatch& batch, const std::vector<size_t>& rows) {
+  for (auto& target : targets_) {
+    RETURN_NOT_OK(AccumulateTarget(batch, rows, &target));
+  }
+  return Status::OK();
+}
+
+Status DocPgAggregator::AccumulateTarget(
+    const DocRowBatch& batch, const std::vector<size_t>& rows, Target* target) {
+  if (!target->operand.has_column_id()) {
+    DCHECK(target->opcode == bfpg::TSOpcode::kCount);
+    // COUNT(null) is bound to return zero, otherwise every row is counted.
+    if (!IsNull(target->operand.value())) {
+      AddCount(rows.size(), &target->result);
+    }
+    return Status::OK();
+  }
+
+  if (target->column_idx == DocRowBatch::kColumnNotFound) {
+    // Column is not read, so its value is NULL for every row and does not affect the result.
+    return Status::OK();
+  }
+
+  const auto& column = batch.column(target->column_idx);
+  auto* result = &target->result;
+  switch (target->opcode) {
+    case bfpg::TSOpcode::kCount: {
+      int64_t count = 0;
+      for (auto row : rows) {
+        count += !IsNull(column[row]);
+      }
+      AddCount(count, result);
+      return Status::OK();
+    }
+
+    case bfpg::TSOpcode::kSumInt8:
+      AccumulateSumInt(column, rows, [](const auto& value) {
+        return value.int8_value();
+      }, &int_values_, result);
+      return Status::OK();
+
+    case bfpg::TSOpcode::kSumInt16:
+      AccumulateSumInt(column, rows, [](const auto& value) {
+        return value.int16_value();
+      }, &int_values_, result);
+      return Status::OK();
+
+    case bfpg::TSOpcode::kSumInt32:
+      AccumulateSumInt(column, rows, [](const auto& value) {
+        return value.int32_value();
+      }, &int_values_, result);
+      return Status::OK();
+
+    case bfpg::TSOpcode::kSumInt64:
+      AccumulateSumInt(column, rows, [](const auto& value) {
+        return value.int64_value();
+      }, &int_values_, result);
+      return Status::OK();
+
+    case bfpg::TSOpcode::kSumFloat:
+      AccumulateSumReal<float>(
+          column, rows,
+          [](const auto& value) { return value.float_value(); },
+          [](float value, auto* out) { return out->set_float_value(value); },
+          result);
+      return Status::OK();
+
+    case bfpg::TSOpcode::kSumDouble:
+      AccumulateSumReal<double>(
+          column, rows,
+          [](const auto& value) { return value.double_value(); },
+          [](double value, auto* out) { return out->set_double_value(value); },
+          result);
+      return Status::OK();
+
+    case bfpg::TSOpcode::kMin:
+      AccumulateMinMax(column, rows, [](const auto& value, const auto& best) {
+        return best > value;
+      }, result);
+      return Status::OK();
+
+    case bfpg::TSOpcode::kMax:
+      AccumulateMinMax(column, rows, [](const auto& value, const auto& best) {
+        return best < value;
+      }, result);
+      return Status::OK();
+
+    default:
+      break;
+  }
+  return STATUS_FORMAT(
+      NotSupported, "Aggregate $0 could not be evaluated over row batch", target->opcode);
+}
+
+void DocPgAggregator::Finish(std::vector<QLExprResult>* results) {
+  results->resize(targets_.size());
+  for (size_t i = 0; i != targets_.size(); ++i) {
+    auto writer = (*results)[i].Writer();
+    if (IsNull(targets_[i].result)) {
+      writer.SetNull();
+    } else {
+      writer.NewValue() = std::move(targets_[i].result);
+    }
+  }
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,69 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <vector>
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_expr.h"
+
+#include "yb/docdb/docdb_fwd.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// DocPgAggregator evaluates aggregate targets of YSQL read request (COUNT, SUM, MIN, MAX) over
+// column-oriented row batches produced by YQLRowwiseIteratorIf::NextBatch.
+//
+// For every aggregate, the referenced column values of the selected rows are gathered into a
+// contiguous array of native values once per batch, so accumulation runs in tight loops over
+// plain integers or floating point numbers, instead of evaluating the aggregate expression per
+// row via QLTableRow. Results are the same as produced by DocExprExecutor::EvalTSCall.
+//
+// Only aggregates with a single column reference or constant operand are supported,
+// IsSupported should be checked before using the aggregator for a request.
+class DocPgAggregator {
+ public:
+  // Whether every target of the request is an aggregate supported by this class.
+  static bool IsSupported(const PgsqlReadRequestPB& request);
+
+  explicit DocPgAggregator(const PgsqlReadRequestPB& request);
+  ~DocPgAggregator();
+
+  // Resolves columns referenced by the aggregates. Should be called after batch is initialized
+  // and before the first Accumulate.
+  void Prepare(const DocRowBatch& batch);
+
+  // Accumulates rows of the batch with the specified indexes.
+  Status Accumulate(const DocRowBatch& batch, const std::vector<size_t>& rows);
+
+  // Stores final aggregate values to results, one entry per request target.
+  void Finish(std::vector<QLExprResult>* results);
+
+ private:
+  class Target;
+
+  Status AccumulateTarget(const DocRowBatch& batch, const std::vector<size_t>& rows,
+                          Target* target);
+
+  std::vector<Target> targets_;
+
+  // Buffer for integer values gathered from the batch, reused between batches.
+  std::vector<int64_t> int_values_;
+};
+
+}  // namespace docdb
+}  // namespace yb
@@ -11,12 +11,15 @@
 // under the License.
 //
 
+#include <functional>
 #include <list>
 
 #include "yb/docdb/doc_pg_expr.h"
+#include "yb/docdb/doc_row_batch.h"
 #include "yb/docdb/docdb_pgapi.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
+#include "yb/util/status_format.h"
 #include "yb/yql/pggate/pg_value.h"
 
 using yb::pggate::PgValueToPB;
@@ -29,6 +32,69 @@ namespace docdb {
 // Deserialized Postgres expression paired with type information to convert results to DocDB format
 typedef std::pair<YbgPreparedExpr, DocPgVarRef> DocPgEvalExprData;
 
+namespace {
+
+// Removes from rows the indexes of rows where the integer column value does not satisfy compare.
+// Null values never match, since comparison operators are strict.
+template <class Compare>
+Status FilterIntegerColumn(
+    const std::vector<QLValuePB>& column, int64_t value, const Compare& compare,
+    std::vector<size_t>* rows) {
+  size_t num_selected = 0;
+  for (auto row_idx : *rows) {
+    const auto& column_value = column[row_idx];
+    int64_t int_value;
+    switch (column_value.value_case()) {
+      case QLValuePB::kInt16Value:
+        int_value = column_value.int16_value();
+        break;
+      case QLValuePB::kInt32Value:
+        int_value = column_value.int32_value();
+        break;
+      case QLValuePB::kInt64Value:
+        int_value = column_value.int64_value();
+        break;
+      case QLValuePB::VALUE_NOT_SET:
+        continue;
+      default:
+        return STATUS_FORMAT(
+            InternalError, "Unexpected value of integer column: $0",
+            column_value.ShortDebugString());
+    }
+    if (compare(int_value, value)) {
+      (*rows)[num_selected++] = row_idx;
+    }
+  }
+  rows->resize(num_selected);
+  return Status::OK();
+}
+
+Status FilterIntegerColumn(
+    const std::vector<QLValuePB>& column, const YbgColumnComparison& comparison,
+    std::vector<size_t>* rows) {
+  if (comparison.value_is_null) {
+    rows->clear();
+    return Status::OK();
+  }
+  switch (comparison.op) {
+    case YBG_COMPARE_EQ:
+      return FilterIntegerColumn(column, comparison.value, std::equal_to<int64_t>(), rows);
+    case YBG_COMPARE_NE:
+      return FilterIntegerColumn(column, comparison.value, std::not_equal_to<int64_t>(), rows);
+    case YBG_COMPARE_LT:
+      return FilterIntegerColumn(column, comparison.value, std::less<int64_t>(), rows);
+    case YBG_COMPARE_LE:
+      return FilterIntegerColumn(column, comparison.value, std::less_equal<int64_t>(), rows);
+    case YBG_COMPARE_GT:
+      return FilterIntegerColumn(column, comparison.value, std::greater<int64_t>(), rows);
+    case YBG_COMPARE_GE:
+      return FilterIntegerColumn(column, comparison.value, std::greater_equal<int64_t>(), rows);
+  }
+  return STATUS_FORMAT(InternalError, "Unexpected comparison: $0", comparison.op);
+}
+
+} // namespace
+
 class DocPgExprExecutor::Private {
  public:
   Private() {
@@ -74,11 +140,14 @@ class DocPgExprExecutor::Private {
   // Process a where clause expression
   Status PreparePgWhereExpr(const PgsqlExpressionPB& ql_expr,
                             const Schema *schema) {
-    YbgPreparedExpr expr;
+    WhereExpr where_expr;
     // Deserialize Postgres expression. Expression type is known to be boolean
-    RETURN_NOT_OK(prepare_pg_expr_call(ql_expr, schema, &expr, nullptr));
+    RETURN_NOT_OK(prepare_pg_expr_call(ql_expr, schema, &where_expr.expr, nullptr));
+    // Check whether the expression could be evaluated over column arrays of row batches
+    RETURN_NOT_OK(DocPgExprColumnComparison(
+        where_expr.expr, &where_expr.column_comparison, &where_expr.is_column_comparison));
     // Store the Postgres expression in the list
-    where_clause_.push_back(expr);
+    where_clause_.push_back(where_expr);
     VLOG(1) << "A condition has been added";
     return Status::OK();
   }
@@ -178,16 +247,19 @@ class DocPgExprExecutor::Private {
     return Status::OK();
   }
 
-  // Evaluate where clause expressions
-  Status EvalWhereExprCalls(bool *result) {
+  // Evaluate where clause expressions, except those already applied to the row batch
+  Status EvalWhereExprCalls(bool skip_batch_filters, bool *result) {
     // If where_clause_ is empty or all the expressions yield true, the result will remain true
     *result = true;
 
     uint64_t datum;
     bool is_null;
-    for (auto expr : where_clause_) {
+    for (const auto& where_expr : where_clause_) {
+      if (skip_batch_filters && where_expr.batch_column_idx != DocRowBatch::kColumnNotFound) {
+        continue;
+      }
       // Evaluate expression
-      RETURN_NOT_OK(DocPgEvalExpr(expr, expr_ctx_, &datum, &is_null));
+      RETURN_NOT_OK(DocPgEvalExpr(where_expr.expr, expr_ctx_, &datum, &is_null));
       // Stop iteration and return false if expression does not yield true
       if (is_null || !datum) {
         *result = false;
@@ -227,6 +299,70 @@ class DocPgExprExecutor::Private {
   Status Exec(const QLTableRow& table_row,
               std::vector<QLExprResult>* results,
               bool* match) {
+    return DoExec(table_row, /* skip_batch_filters= */ false, results, match);
+  }
+
+  Status ExecBatch(const DocRowBatch& batch, std::vector<size_t>* selected_rows) {
+    SCHECK(targets_.empty(), InternalError, "Target expressions are not supported for row batch");
+    selected_rows->clear();
+    for (size_t row_idx = 0; row_idx != batch.num_rows(); ++row_idx) {
+      selected_rows->push_back(row_idx);
+    }
+
+    // Column comparisons are evaluated over column arrays, when the column is present in the
+    // batch.
+    bool has_row_filters = false;
+    for (auto& where_expr : where_clause_) {
+      where_expr.batch_column_idx = DocRowBatch::kColumnNotFound;
+      if (where_expr.is_column_comparison) {
+        auto it = var_map_.find(where_expr.column_comparison.attno);
+        if (it != var_map_.end()) {
+          where_expr.batch_column_idx = batch.find_column(it->second.var_colid);
+        }
+      }
+      if (where_expr.batch_column_idx == DocRowBatch::kColumnNotFound) {
+        has_row_filters = true;
+        continue;
+      }
+      RETURN_NOT_OK(FilterIntegerColumn(
+          batch.column(where_expr.batch_column_idx), where_expr.column_comparison,
+          selected_rows));
+    }
+    if (!has_row_filters) {
+      return Status::OK();
+    }
+
+    // The rest of expressions are evaluated per row.
+    size_t num_selected = 0;
+    for (auto row_idx : *selected_rows) {
+      table_row_.Clear();
+      batch.ExtractRow(row_idx, &table_row_);
+      bool match = true;
+      RETURN_NOT_OK(DoExec(table_row_, /* skip_batch_filters= */ true, nullptr, &match));
+      if (match) {
+        (*selected_rows)[num_selected++] = row_idx;
+      }
+    }
+    selected_rows->resize(num_selected);
+    return Status::OK();
+  }
+
+ private:
+  // Deserialized where clause expression.
+  struct WhereExpr {
+    YbgPreparedExpr expr;
+    // Whether the expression is a comparison of an integer column with a constant.
+    bool is_column_comparison = false;
+    YbgColumnComparison column_comparison;
+    // Index of the compared column in the row batch processed by ExecBatch, or
+    // DocRowBatch::kColumnNotFound if expression should be evaluated per row.
+    size_t batch_column_idx = DocRowBatch::kColumnNotFound;
+  };
+
+  Status DoExec(const QLTableRow& table_row,
+                bool skip_batch_filters,
+                std::vector<QLExprResult>* results,
+                bool* match) {
     *match = true;
 
     // early exit if there are no operations to process
@@ -248,7 +384,7 @@ class DocPgExprExecutor::Private {
 
     Status status = PreparePgRowData(table_row);
     if (status.ok())
-      status = EvalWhereExprCalls(match);
+      status = EvalWhereExprCalls(skip_batch_filters, match);
 
     if (status.ok() && *match)
       status = EvalTargetExprCalls(results);
@@ -259,7 +395,6 @@ class DocPgExprExecutor::Private {
     return status;
   }
 
- private:
   // Memory context for permanent allocations. Exists for executor's lifetime.
   YbgMemoryContext mem_ctx_ = nullptr;
   // Memory context for per row allocations. Reset with every new row.
@@ -268,7 +403,7 @@ class DocPgExprExecutor::Private {
   // Provides fast access to is_nulls and datums by index(attribute number).
   YbgExprContext expr_ctx_ = nullptr;
   // List of where clause expressions
-  std::list<YbgPreparedExpr> where_clause_;
+  std::list<WhereExpr> where_clause_;
   // List of target expressions with their type info
   std::list<DocPgEvalExprData> targets_;
   // Storage for column references. Key is the attribute number, value is basically DocDB column id
@@ -277,6 +412,8 @@ class DocPgExprExecutor::Private {
   // references, second is that we iterate over columns in their schema order, hopefully this speeds
   // up access to data.
   std::map<int, const DocPgVarRef> var_map_;
+  // Row of the batch that is evaluated by ExecBatch.
+  QLTableRow table_row_;
 };
 
 void DocPgExprExecutor::private_deleter::operator()(DocPgExprExecutor::Private* ptr) const {
@@ -312,5 +449,16 @@ Status DocPgExprExecutor::Exec(
   return !private_.get() ? Status::OK() : private_->Exec(table_row, results, match);
 }
 
+Status DocPgExprExecutor::ExecBatch(const DocRowBatch& batch, std::vector<size_t>* selected_rows) {
+  if (!private_.get()) {
+    selected_rows->clear();
+    for (size_t row_idx = 0; row_idx != batch.num_rows(); ++row_idx) {
+      selected_rows->push_back(row_idx);
+    }
+    return Status::OK();
+  }
+  return private_->ExecBatch(batch, selected_rows);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -16,6 +16,9 @@
 #include "yb/common/ql_expr.h"
 #include "yb/common/pgsql_protocol.pb.h"
 #include "yb/common/schema.h"
+
+#include "yb/docdb/docdb_fwd.h"
+
 #include "yb/util/status.h"
 
 namespace yb {
@@ -85,6 +88,12 @@ class DocPgExprExecutor {
               std::vector<QLExprResult>* results,
               bool* match);
 
+  // Evaluate where clause expressions for all rows of the batch, and fill selected_rows with
+  // indexes of rows that match. Should be used only when no target expressions were added.
+  // Comparisons of integer columns with constants are evaluated over column arrays of the batch,
+  // the rest of where clause expressions are evaluated per remaining row, like in Exec.
+  Status ExecBatch(const DocRowBatch& batch, std::vector<size_t>* selected_rows);
+
  private:
   // The relation schema
   const Schema *schema_;
@@ -230,8 +230,12 @@ DocDBTableReader::DocDBTableReader(
   if (projection_) {
     auto projection_size = projection_->size();
     encoded_projection_.resize(projection_size);
+    projection_column_ids_.reserve(projection_size);
     for (size_t i = 0; i != projection_size; ++i) {
-      (*projection_)[i].subkey.AppendToKey(&encoded_projection_[i]);
+      const auto& subkey = (*projection_)[i].subkey;
+      subkey.AppendToKey(&encoded_projection_[i]);
+      projection_column_ids_.push_back(
+          subkey.IsColumnId() ? subkey.GetColumnId() : kInvalidColumnId);
     }
   }
   VLOG_WITH_FUNC(4)
@@ -249,6 +253,17 @@ Status DocDBTableReader::UpdateTableTombstoneTime(DocHybridTime doc_ht) {
   return Status::OK();
 }
 
+const PackedRowDecoder& DocDBTableReader::GetPackedRowDecoder(const SchemaPacking& packing) {
+  // Usually there are only one or two live schema versions, so linear search is fastest here.
+  for (const auto& decoder : packed_row_decoders_) {
+    if (&decoder.packing() == &packing) {
+      return decoder;
+    }
+  }
+  packed_row_decoders_.emplace_back(packing, projection_column_ids_);
+  return packed_row_decoders_.back();
+}
+
 // Scan state entry. See state_ description below for details.
 struct StateEntry {
   KeyBytes key_entry; // Represents the part of the key that is related to this state entry.
@@ -313,7 +328,7 @@ class DocDBTableReader::GetHelperBase {
     // projection could be null in tests only.
     if (reader_.projection_) {
       if (reader_.projection_->empty()) {
-        packed_column_data_ = GetPackedColumn(KeyEntryValue::kLivenessColumn.GetColumnId());
+        packed_column_data_ = GetPackedLivenessColumn();
         RETURN_NOT_OK(Scan(CheckExistOnly::kTrue));
         return Found();
       }
@@ -507,7 +522,8 @@ class DocDBTableReader::GetHelperBase {
   void UpdatePackedColumnData() {
     auto& column = (*reader_.projection_)[column_index_].subkey;
     if (column.IsColumnId()) {
-      packed_column_data_ = GetPackedColumn(column.GetColumnId());
+      packed_column_data_ = column.GetColumnId() == KeyEntryValue::kLivenessColumn.GetColumnId()
+          ? GetPackedLivenessColumn() : GetPackedColumn(column_index_);
     } else {
       // Used in tests only.
       packed_column_data_.row = nullptr;
@@ -540,7 +556,8 @@ class DocDBTableReader::GetHelperBase {
     auto value_type = DecodeValueEntryType(value);
     if (value_type == ValueEntryType::kPackedRow) {
       value.consume_byte();
-      schema_packing_ = &VERIFY_RESULT(reader_.schema_packing_storage_.GetPacking(&value)).get();
+      packed_row_decoder_ = &reader_.GetPackedRowDecoder(
+          VERIFY_RESULT(reader_.schema_packing_storage_.GetPacking(&value)));
       packed_row_.Assign(value);
       packed_row_data_.doc_ht = doc_ht;
       packed_row_data_.control_fields = control_fields;
@@ -560,29 +577,36 @@ class DocDBTableReader::GetHelperBase {
     return Status::OK();
   }
 
-  PackedColumnData GetPackedColumn(ColumnId column_id) {
-    if (!schema_packing_) {
+  PackedColumnData GetPackedLivenessColumn() {
+    if (!packed_row_decoder_) {
       // Actual for tests only.
       return PackedColumnData();
     }
 
-    if (column_id == KeyEntryValue::kLivenessColumn.GetColumnId()) {
-      DVLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row for liveness column";
-      return PackedColumnData {
-        .row = &packed_row_data_,
-        .encoded_value = NullSlice(),
-        .liveness_column = true,
-      };
+    DVLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row for liveness column";
+    return PackedColumnData {
+      .row = &packed_row_data_,
+      .encoded_value = NullSlice(),
+      .liveness_column = true,
+    };
+  }
+
+  // Returns packed data for the column with specified index in projection.
+  PackedColumnData GetPackedColumn(size_t projection_idx) {
+    if (!packed_row_decoder_) {
+      // Actual for tests only.
+      return PackedColumnData();
     }
 
-    auto slice = schema_packing_->GetValue(column_id, packed_row_.AsSlice());
+    auto slice = packed_row_decoder_->GetValue(projection_idx, packed_row_.AsSlice());
     if (!slice) {
-      DVLOG_WITH_PREFIX_AND_FUNC(4) << "No packed row data for " << column_id;
+      DVLOG_WITH_PREFIX_AND_FUNC(4)
+          << "No packed row data for " << (*reader_.projection_)[projection_idx].subkey;
       return PackedColumnData();
     }
 
-    DVLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row " << column_id << ": "
-                                  << slice->ToDebugHexString();
+    DVLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row " << (*reader_.projection_)[projection_idx].subkey
+                                  << ": " << slice->ToDebugHexString();
     return PackedColumnData {
       .row = &packed_row_data_,
       .encoded_value = slice->empty() ? NullSlice() : *slice,
@@ -639,7 +663,7 @@ class DocDBTableReader::GetHelperBase {
   // Packed row related fields. Not changed after initialization.
   ValueBuffer packed_row_;
   PackedRowData packed_row_data_;
-  const SchemaPacking* schema_packing_ = nullptr;
+  const PackedRowDecoder* packed_row_decoder_ = nullptr;
 
   // If packed row is found, this field contains data related to currently scanned column.
   PackedColumnData packed_column_data_;
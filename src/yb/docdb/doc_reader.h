@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,7 @@
 #include "yb/docdb/deadline_info.h"
 #include "yb/docdb/docdb_types.h"
 #include "yb/docdb/expiration.h"
+#include "yb/docdb/schema_packing.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
 
@@ -121,6 +123,10 @@ class DocDBTableReader {
   // at that row.
   Status InitForKey(const Slice& sub_doc_key);
 
+  // Returns decoder of packed rows with specified packing for the projection, creating it when
+  // this packing is met for the first time. Returned reference is valid until the next call.
+  const PackedRowDecoder& GetPackedRowDecoder(const SchemaPacking& packing);
+
   template <bool is_flat_doc, bool ysql>
   class GetHelperBase;
 
@@ -135,6 +141,11 @@ class DocDBTableReader {
   const SchemaPackingStorage& schema_packing_storage_;
 
   std::vector<KeyBytes> encoded_projection_;
+  // Column ids of projection entries, kInvalidColumnId for entries that are not columns.
+  std::vector<ColumnId> projection_column_ids_;
+  // Deque keeps references returned by GetPackedRowDecoder valid when decoder for another schema
+  // version is added during the same scan.
+  std::deque<PackedRowDecoder> packed_row_decoders_;
   EncodedDocHybridTime table_tombstone_time_{EncodedDocHybridTime::kMin};
   Expiration table_expiration_;
 };
@@ -0,0 +1,91 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/doc_row_batch.h"
+
+#include "yb/common/ql_expr.h"
+#include "yb/common/schema.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/tostring.h"
+
+namespace yb {
+namespace docdb {
+
+void DocRowBatch::Init(const Schema& projection, bool need_tuple_ids) {
+  column_ids_.clear();
+  column_ids_.reserve(projection.num_columns());
+  for (size_t i = 0; i != projection.num_columns(); ++i) {
+    column_ids_.push_back(projection.column_id(i));
+  }
+  columns_.resize(column_ids_.size());
+  need_tuple_ids_ = need_tuple_ids;
+  Clear();
+}
+
+void DocRowBatch::Clear() {
+  num_rows_ = 0;
+  tuple_ids_buffer_.clear();
+  tuple_id_ends_.clear();
+}
+
+size_t DocRowBatch::find_column(ColumnIdRep column_id) const {
+  for (size_t i = 0; i != column_ids_.size(); ++i) {
+    if (column_ids_[i].rep() == column_id) {
+      return i;
+    }
+  }
+  return kColumnNotFound;
+}
+
+size_t DocRowBatch::AddRow() {
+  for (auto& column : columns_) {
+    if (column.size() == num_rows_) {
+      column.emplace_back();
+    } else {
+      column[num_rows_].Clear();
+    }
+  }
+  return num_rows_++;
+}
+
+void DocRowBatch::AddTupleId(Slice tuple_id) {
+  DCHECK(need_tuple_ids_);
+  DCHECK_EQ(tuple_id_ends_.size() + 1, num_rows_);
+  tuple_ids_buffer_.append(tuple_id.cdata(), tuple_id.size());
+  tuple_id_ends_.push_back(tuple_ids_buffer_.size());
+}
+
+void DocRowBatch::ExtractRow(size_t row_idx, QLTableRow* table_row) const {
+  DCHECK_LT(row_idx, num_rows_);
+  for (size_t i = 0; i != column_ids_.size(); ++i) {
+    table_row->AllocColumn(column_ids_[i], columns_[i][row_idx]);
+  }
+}
+
+void DocRowBatch::AppendRow(const QLTableRow& table_row) {
+  auto row_idx = AddRow();
+  for (size_t i = 0; i != column_ids_.size(); ++i) {
+    const auto* value = table_row.GetColumn(column_ids_[i].rep());
+    if (value) {
+      columns_[i][row_idx] = *value;
+    }
+  }
+}
+
+std::string DocRowBatch::ToString() const {
+  return YB_CLASS_TO_STRING(column_ids, num_rows, need_tuple_ids);
+}
+
+}  // namespace docdb
+}  // namespace yb
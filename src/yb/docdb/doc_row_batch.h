@@ -0,0 +1,116 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "yb/common/column_id.h"
+#include "yb/common/common_fwd.h"
+#include "yb/common/value.pb.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace docdb {
+
+// Column-oriented batch of rows filled by YQLRowwiseIteratorIf::NextBatch.
+//
+// Values of the column with projection index i for all rows of the batch are stored contiguously
+// in column(i), so filters and serialization could run over column arrays instead of building a
+// QLTableRow per row. The batch is expected to be reused between NextBatch calls: Clear keeps
+// allocated values, so decoding the next batch reuses memory of string and binary values.
+class DocRowBatch {
+ public:
+  static constexpr size_t kColumnNotFound = std::numeric_limits<size_t>::max();
+
+  DocRowBatch() = default;
+
+  DocRowBatch(const DocRowBatch&) = delete;
+  void operator=(const DocRowBatch&) = delete;
+
+  // Prepares batch to be filled with rows of the specified projection.
+  // When need_tuple_ids is true, the iterator also stores tuple id of every row in the batch.
+  void Init(const Schema& projection, bool need_tuple_ids);
+
+  // Removes all rows from the batch, keeping the projection.
+  void Clear();
+
+  size_t num_rows() const {
+    return num_rows_;
+  }
+
+  size_t num_columns() const {
+    return column_ids_.size();
+  }
+
+  bool need_tuple_ids() const {
+    return need_tuple_ids_;
+  }
+
+  ColumnId column_id(size_t column_idx) const {
+    return column_ids_[column_idx];
+  }
+
+  // Returns index of the column with specified id, or kColumnNotFound.
+  size_t find_column(ColumnIdRep column_id) const;
+
+  // Values of the specified column. Only first num_rows() entries are meaningful.
+  const std::vector<QLValuePB>& column(size_t column_idx) const {
+    return columns_[column_idx];
+  }
+
+  const QLValuePB& value(size_t column_idx, size_t row_idx) const {
+    return columns_[column_idx][row_idx];
+  }
+
+  QLValuePB* mutable_value(size_t column_idx, size_t row_idx) {
+    return &columns_[column_idx][row_idx];
+  }
+
+  // Appends new row with all columns set to null and returns its index.
+  size_t AddRow();
+
+  Slice tuple_id(size_t row_idx) const {
+    const auto* data = tuple_ids_buffer_.data();
+    const auto begin = row_idx ? tuple_id_ends_[row_idx - 1] : 0;
+    return Slice(data + begin, data + tuple_id_ends_[row_idx]);
+  }
+
+  // Should be called exactly once for every added row when need_tuple_ids() is true.
+  void AddTupleId(Slice tuple_id);
+
+  // Fills table_row with values of the specified row. Used for expressions that could not be
+  // evaluated over column arrays.
+  void ExtractRow(size_t row_idx, QLTableRow* table_row) const;
+
+  // Appends values of table_row as a new row.
+  void AppendRow(const QLTableRow& table_row);
+
+  std::string ToString() const;
+
+ private:
+  std::vector<ColumnId> column_ids_;
+  std::vector<std::vector<QLValuePB>> columns_;
+  size_t num_rows_ = 0;
+
+  bool need_tuple_ids_ = false;
+  std::string tuple_ids_buffer_;
+  // End offset of every tuple id in tuple_ids_buffer_.
+  std::vector<size_t> tuple_id_ends_;
+};
+
+}  // namespace docdb
+}  // namespace yb
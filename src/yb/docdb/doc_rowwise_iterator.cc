@@ -36,6 +36,7 @@
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/doc_read_context.h"
 #include "yb/docdb/doc_reader.h"
+#include "yb/docdb/doc_row_batch.h"
 #include "yb/docdb/doc_scanspec_util.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_types.h"
@@ -504,14 +505,17 @@ string DocRowwiseIterator::ToString() const {
 
 namespace {
 
-// Set primary key column values (hashed or range columns) in a QL row value map.
-Status SetQLPrimaryKeyColumnValues(const Schema& schema,
-                                   const size_t begin_index,
-                                   const size_t column_count,
-                                   const char* column_type,
-                                   const size_t end_referenced_key_column_index,
-                                   DocKeyDecoder* decoder,
-                                   QLTableRow* table_row) {
+// Decode primary key column values (hashed or range columns). value_provider(col_idx) returns
+// the QLValuePB to store value of the column with the specified schema index, or nullptr when
+// this value is not needed.
+template <class ValueProvider>
+Status DecodePrimaryKeyColumnValues(const Schema& schema,
+                                    const size_t begin_index,
+                                    const size_t column_count,
+                                    const char* column_type,
+                                    const size_t end_referenced_key_column_index,
+                                    DocKeyDecoder* decoder,
+                                    const ValueProvider& value_provider) {
   const auto end_group_index = begin_index + column_count;
   SCHECK_LE(
       end_group_index, schema.num_columns(), InvalidArgument,
@@ -527,15 +531,42 @@ Status SetQLPrimaryKeyColumnValues(const Schema& schema,
   KeyEntryValue key_entry_value;
   size_t col_idx = begin_index;
   for (; col_idx < std::min(end_group_index, end_referenced_key_column_index); ++col_idx) {
-    const auto ql_type = schema.column(col_idx).type();
-    QLTableColumn& column = table_row->AllocColumn(schema.column_id(col_idx));
     RETURN_NOT_OK(decoder->DecodeKeyEntryValue(&key_entry_value));
-    key_entry_value.ToQLValuePB(ql_type, &column.value);
+    auto* value = value_provider(col_idx);
+    if (value) {
+      key_entry_value.ToQLValuePB(schema.column(col_idx).type(), value);
+    }
   }
 
   return col_idx == end_group_index ? decoder->ConsumeGroupEnd() : Status::OK();
 }
 
+template <class ValueProvider>
+Status DecodePrimaryKeyColumnValues(const Schema& schema,
+                                    const Slice& row_key,
+                                    const size_t end_referenced_key_column_index,
+                                    const ValueProvider& value_provider) {
+  DocKeyDecoder decoder(row_key);
+  RETURN_NOT_OK(decoder.DecodeCotableId());
+  RETURN_NOT_OK(decoder.DecodeColocationId());
+  bool has_hash_components = VERIFY_RESULT(decoder.DecodeHashCode());
+
+  // Populate the key column values from the doc key. The key column values in doc key were
+  // written in the same order as in the table schema (see DocKeyFromQLKey). If the range columns
+  // are present, read them also.
+  if (has_hash_components) {
+    RETURN_NOT_OK(DecodePrimaryKeyColumnValues(
+        schema, 0, schema.num_hash_key_columns(), "hash", end_referenced_key_column_index,
+        &decoder, value_provider));
+  }
+  if (!decoder.GroupEnded()) {
+    RETURN_NOT_OK(DecodePrimaryKeyColumnValues(
+        schema, schema.num_hash_key_columns(), schema.num_range_key_columns(), "range",
+        end_referenced_key_column_index, &decoder, value_provider));
+  }
+  return Status::OK();
+}
+
 } // namespace
 
 void DocRowwiseIterator::SkipRow() {
@@ -569,25 +600,12 @@ Status DocRowwiseIterator::DoNextRow(
   }
 
   if (end_referenced_key_column_index_ > 0) {
-    DocKeyDecoder decoder(row_key_);
-    RETURN_NOT_OK(decoder.DecodeCotableId());
-    RETURN_NOT_OK(decoder.DecodeColocationId());
-    bool has_hash_components = VERIFY_RESULT(decoder.DecodeHashCode());
-
-    // Populate the key column values from the doc key. The key column values in doc key were
-    // written in the same order as in the table schema (see DocKeyFromQLKey). If the range columns
-    // are present, read them also.
-    if (has_hash_components) {
-      RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
-          doc_read_context_.schema, 0, doc_read_context_.schema.num_hash_key_columns(), "hash",
-          end_referenced_key_column_index_, &decoder, table_row));
-    }
-    if (!decoder.GroupEnded()) {
-      RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
-          doc_read_context_.schema, doc_read_context_.schema.num_hash_key_columns(),
-          doc_read_context_.schema.num_range_key_columns(), "range",
-          end_referenced_key_column_index_, &decoder, table_row));
-    }
+    const auto& schema = doc_read_context_.schema;
+    RETURN_NOT_OK(DecodePrimaryKeyColumnValues(
+        schema, row_key_, end_referenced_key_column_index_,
+        [&schema, table_row](size_t col_idx) {
+      return &table_row->AllocColumn(schema.column_id(col_idx)).value;
+    }));
   }
 
   const auto& projection = projection_opt.get_value_or(schema());
@@ -641,6 +659,60 @@ Status DocRowwiseIterator::DoNextRow(
   return Status::OK();
 }
 
+Result<size_t> DocRowwiseIterator::NextBatch(
+    size_t max_rows, CoarseTimePoint deadline, DocRowBatch* batch) {
+  if (!is_flat_doc_) {
+    return YQLRowwiseIteratorIf::NextBatch(max_rows, deadline, batch);
+  }
+
+  batch->Clear();
+
+  // Map key columns and columns of the reader projection to the batch columns once per batch,
+  // so values decoded for every row are moved straight to the column arrays.
+  const auto& schema = doc_read_context_.schema;
+  const auto num_key_columns = std::min(end_referenced_key_column_index_, schema.num_key_columns());
+  batch_key_columns_.clear();
+  for (size_t i = 0; i != num_key_columns; ++i) {
+    batch_key_columns_.push_back(batch->find_column(schema.column_id(i)));
+  }
+  batch_value_columns_.clear();
+  for (const auto& column : reader_projection_) {
+    const auto column_id = column.subkey.GetColumnId();
+    batch_value_columns_.push_back(
+        column_id.rep() == static_cast<ColumnIdRep>(SystemColumnIds::kLivenessColumn)
+            ? DocRowBatch::kColumnNotFound : batch->find_column(column_id));
+  }
+
+  while (batch->num_rows() < max_rows && VERIFY_RESULT(HasNext())) {
+    // Always read at least one row, so the scan makes progress.
+    if (batch->num_rows() && CoarseMonoClock::now() >= deadline) {
+      break;
+    }
+    const auto row_idx = batch->AddRow();
+    if (end_referenced_key_column_index_ > 0) {
+      RETURN_NOT_OK(DecodePrimaryKeyColumnValues(
+          schema, row_key_, end_referenced_key_column_index_,
+          [this, batch, row_idx](size_t col_idx) -> QLValuePB* {
+        const auto batch_idx = batch_key_columns_[col_idx];
+        return batch_idx == DocRowBatch::kColumnNotFound
+            ? nullptr : batch->mutable_value(batch_idx, row_idx);
+      }));
+    }
+    for (size_t i = 0; i != batch_value_columns_.size(); ++i) {
+      const auto batch_idx = batch_value_columns_[i];
+      if (batch_idx != DocRowBatch::kColumnNotFound) {
+        batch->mutable_value(batch_idx, row_idx)->Swap(&(*values_)[i]);
+      }
+    }
+    if (batch->need_tuple_ids()) {
+      batch->AddTupleId(VERIFY_RESULT(GetTupleId()));
+    }
+    row_ready_ = false;
+  }
+
+  return batch->num_rows();
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
   if (is_flat_doc_) {
     return !IsNull((*values_)[0]);
@@ -678,33 +750,64 @@ Result<Slice> DocRowwiseIterator::GetTupleId() const {
   return tuple_id;
 }
 
-Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
+Slice DocRowwiseIterator::TupleKey(const Slice& tuple_id) {
   // If cotable id / colocation id is present in the table schema, then
   // we need to prepend it in the tuple key to seek.
-  if (doc_read_context_.schema.has_cotable_id() || doc_read_context_.schema.has_colocation_id()) {
-    uint32_t size = doc_read_context_.schema.has_colocation_id() ? sizeof(ColocationId) : kUuidSize;
-    if (!tuple_key_) {
-      tuple_key_.emplace();
-      tuple_key_->Reserve(1 + size + tuple_id.size());
-
-      if (doc_read_context_.schema.has_cotable_id()) {
-        std::string bytes;
-        doc_read_context_.schema.cotable_id().EncodeToComparable(&bytes);
-        tuple_key_->AppendKeyEntryType(KeyEntryType::kTableId);
-        tuple_key_->AppendRawBytes(bytes);
-      } else {
-        tuple_key_->AppendKeyEntryType(KeyEntryType::kColocationId);
-        tuple_key_->AppendUInt32(doc_read_context_.schema.colocation_id());
-      }
+  if (!doc_read_context_.schema.has_cotable_id() &&
+      !doc_read_context_.schema.has_colocation_id()) {
+    return tuple_id;
+  }
+  uint32_t size = doc_read_context_.schema.has_colocation_id() ? sizeof(ColocationId) : kUuidSize;
+  if (!tuple_key_) {
+    tuple_key_.emplace();
+    tuple_key_->Reserve(1 + size + tuple_id.size());
+
+    if (doc_read_context_.schema.has_cotable_id()) {
+      std::string bytes;
+      doc_read_context_.schema.cotable_id().EncodeToComparable(&bytes);
+      tuple_key_->AppendKeyEntryType(KeyEntryType::kTableId);
+      tuple_key_->AppendRawBytes(bytes);
     } else {
-      tuple_key_->Truncate(1 + size);
+      tuple_key_->AppendKeyEntryType(KeyEntryType::kColocationId);
+      tuple_key_->AppendUInt32(doc_read_context_.schema.colocation_id());
     }
-    tuple_key_->AppendRawBytes(tuple_id);
-    db_iter_->Seek(*tuple_key_);
   } else {
-    db_iter_->Seek(tuple_id);
+    tuple_key_->Truncate(1 + size);
+  }
+  tuple_key_->AppendRawBytes(tuple_id);
+  return tuple_key_->AsSlice();
+}
+
+Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
+  db_iter_->Seek(TupleKey(tuple_id));
+
+  iter_key_.Clear();
+  row_ready_ = false;
+
+  return VERIFY_RESULT(HasNext()) && VERIFY_RESULT(GetTupleId()) == tuple_id;
+}
+
+Result<bool> DocRowwiseIterator::SeekTupleForward(const Slice& tuple_id) {
+  if (!is_forward_scan_ || done_) {
+    return SeekTuple(tuple_id);
   }
 
+  if (row_ready_) {
+    // HasNext has already read the row and moved db_iter_ past it, so the row should be checked
+    // before moving further.
+    auto cmp = VERIFY_RESULT(GetTupleId()).compare(tuple_id);
+    if (cmp == 0) {
+      return true;
+    }
+    if (cmp > 0) {
+      // There are no rows between the previous target and the ready row, so tuple is missing.
+      // Keep the ready row, since it could be the target of the next seek.
+      return false;
+    }
+  }
+
+  db_iter_->SeekForward(TupleKey(tuple_id));
+
   iter_key_.Clear();
   row_ready_ = false;
 
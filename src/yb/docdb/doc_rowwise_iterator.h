@@ -120,9 +120,18 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // the cotable id.
   Result<bool> SeekTuple(const Slice& tuple_id) override;
 
+  // Seeks to the given tuple, that should not be less than the tuple of the previous seek.
+  // Target is reached via a few Next calls when it is close to the current position, and the
+  // row that was already read by HasNext is reused, so sorted lookups don't pay for full seeks.
+  Result<bool> SeekTupleForward(const Slice& tuple_id) override;
+
   // Retrieves the next key to read after the iterator finishes for the given page.
   Status GetNextReadSubDocKey(SubDocKey* sub_doc_key) override;
 
+  // For flat docs decoded values are moved directly to the batch columns, bypassing QLTableRow.
+  Result<size_t> NextBatch(
+      size_t max_rows, CoarseTimePoint deadline, DocRowBatch* batch) override;
+
   void set_debug_dump(bool value) {
     debug_dump_ = value;
   }
@@ -142,6 +151,9 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // ensures that the iterator will be positioned on the first kv-pair of the next row.
   Status AdvanceIteratorToNextDesiredRow() const;
 
+  // Returns the key to seek for the given tuple id, prepending cotable id / colocation id if any.
+  Slice TupleKey(const Slice& tuple_id);
+
   // Read next row into a value map using the specified projection.
   Status DoNextRow(boost::optional<const Schema&> projection, QLTableRow* table_row) override;
 
@@ -230,6 +242,11 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
 
   ReaderProjection reader_projection_;
 
+  // Indexes of batch columns for schema key columns and reader_projection_ entries, used by
+  // NextBatch. DocRowBatch::kColumnNotFound when the column is not present in the batch.
+  std::vector<size_t> batch_key_columns_;
+  std::vector<size_t> batch_value_columns_;
+
   // Used for keeping track of errors in HasNext.
   Status has_next_status_;
 
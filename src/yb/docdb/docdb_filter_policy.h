@@ -24,6 +24,9 @@ class DocDbAwareFilterPolicyBase : public rocksdb::FilterPolicy {
         filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
   }
 
+  explicit DocDbAwareFilterPolicyBase(std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy)
+      : builtin_policy_(std::move(builtin_policy)) {}
+
   void CreateFilter(const Slice* keys, int n, std::string* dst) const override;
 
   bool KeyMayMatch(const Slice& key, const Slice& filter) const override;
@@ -78,4 +81,20 @@ class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
   const KeyTransformer* GetKeyTransformer() const override;
 };
 
+// Uses the same keys as DocDbAwareV3FilterPolicy, but stores them in blocked bloom filter, see
+// rocksdb::NewFixedSizeBlockedBloomFilterPolicy. Filter format differs, so this policy has its own
+// name, and SST files written with DocDbAwareV3FilterPolicy remain readable when it is enabled.
+class DocDbAwareV3BlockedBloomFilterPolicy : public DocDbAwareFilterPolicyBase {
+ public:
+  DocDbAwareV3BlockedBloomFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger)
+      : DocDbAwareFilterPolicyBase(std::unique_ptr<const rocksdb::FilterPolicy>(
+            rocksdb::NewFixedSizeBlockedBloomFilterPolicy(
+                filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+                logger))) {}
+
+  const char* Name() const override { return "DocKeyV3BlockedBloomFilter"; }
+
+  const KeyTransformer* GetKeyTransformer() const override;
+};
+
 }  // namespace yb::docdb
@@ -25,12 +25,14 @@
 namespace yb {
 namespace docdb {
 
+class CachedIntents;
 class ConsensusFrontier;
 class DeadlineInfo;
 class DocDBCompactionFilterFactory;
 class DocOperation;
 class DocPgsqlScanSpec;
 class DocQLScanSpec;
+class DocRowBatch;
 class DocRowwiseIterator;
 class DocWriteBatch;
 class ExternalTxnIntentsState;
@@ -41,6 +43,7 @@ class IntentIterator;
 class KeyBytes;
 class KeyEntryValue;
 class ManualHistoryRetentionPolicy;
+class PackedRowDecoder;
 class PgsqlWriteOperation;
 class PrimitiveValue;
 class QLWriteOperation;
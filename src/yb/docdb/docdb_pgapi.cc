@@ -261,6 +261,13 @@ Status DocPgEvalExpr(YbgPreparedExpr expr,
   return Status::OK();
 }
 
+Status DocPgExprColumnComparison(YbgPreparedExpr expr,
+                                 YbgColumnComparison *comparison,
+                                 bool *is_column_comparison) {
+  PG_RETURN_NOT_OK(YbgExprColumnComparison(expr, comparison, is_column_comparison));
+  return Status::OK();
+}
+
 Status SetValueFromQLBinary(
     const QLValuePB ql_value, const int pg_data_type,
     const std::unordered_map<uint32_t, string> &enum_oid_label_map,
@@ -96,6 +96,12 @@ Status DocPgEvalExpr(YbgPreparedExpr expr,
                      uint64_t *datum,
                      bool *is_null);
 
+// Checks whether the expression compares an integer column with a constant, so it could be
+// evaluated over column values without converting them to Postgres format.
+Status DocPgExprColumnComparison(YbgPreparedExpr expr,
+                                 YbgColumnComparison *comparison,
+                                 bool *is_column_comparison);
+
 // Given a 'ql_value' with a binary value, interpret the binary value as a text
 // array, and store the individual elements in 'ql_value_vec';
 Result<std::vector<std::string>> ExtractTextArrayFromQLBinaryValue(const QLValuePB& ql_value);
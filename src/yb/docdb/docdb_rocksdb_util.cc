@@ -127,6 +127,12 @@ DEFINE_UNKNOWN_int32(memstore_size_mb, 128,
 
 DEFINE_UNKNOWN_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_NON_RUNTIME_bool(use_docdb_blocked_bloom_filter, false,
+    "Whether new SST files should use blocked bloom filter, where every key is mapped to a single "
+    "cache line, instead of classic bloom filter. Node-wide: applies to all tables of this "
+    "server, there is no per-table selection. SST files with either filter format are "
+    "readable regardless of this flag. Has effect only when use_docdb_aware_bloom_filter is "
+    "true.");
 // Empirically 2 is a minimal value that provides best performance on sequential scan.
 DEFINE_UNKNOWN_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
@@ -158,6 +164,14 @@ DEFINE_UNKNOWN_string(compression_type, "Snappy",
               "On-disk compression type to use in RocksDB."
               "By default, Snappy is used if supported.");
 
+DEFINE_NON_RUNTIME_uint32(rocksdb_compression_max_dict_bytes, 0,
+    "Max size of the dictionary built per SST file to compress its data blocks, when "
+    "compression_type is Zlib or LZ4. 0 disables dictionary compression.");
+
+DEFINE_NON_RUNTIME_uint32(rocksdb_compression_dict_buffer_bytes, 0,
+    "Amount of data blocks buffered while writing SST file to build its compression "
+    "dictionary. 0 means 100 times rocksdb_compression_max_dict_bytes.");
+
 DEFINE_UNKNOWN_int32(block_restart_interval, kDefaultDataBlockRestartInterval,
              "Controls the number of keys to look at for computing the diff encoding.");
 
@@ -647,6 +661,8 @@ void InitRocksDBOptions(
   // Since the flag validator for FLAGS_compression_type will fail if the result of this call is not
   // OK, this CHECK_RESULT should never fail and is safe.
   options->compression = CHECK_RESULT(GetConfiguredCompressionType(FLAGS_compression_type));
+  options->compression_opts.max_dict_bytes = FLAGS_rocksdb_compression_max_dict_bytes;
+  options->compression_opts.max_dict_buffer_bytes = FLAGS_rocksdb_compression_dict_buffer_bytes;
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -667,10 +683,19 @@ void InitRocksDBOptions(
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     const auto filter_block_size_bits = table_options.filter_block_size * 8;
-    table_options.filter_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
+    auto v3_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
+        filter_block_size_bits, options->info_log.get());
+    auto v3_blocked_bloom_policy = std::make_shared<const DocDbAwareV3BlockedBloomFilterPolicy>(
         filter_block_size_bits, options->info_log.get());
     table_options.supported_filter_policies =
         std::make_shared<rocksdb::BlockBasedTableOptions::FilterPoliciesMap>();
+    if (FLAGS_use_docdb_blocked_bloom_filter) {
+      table_options.filter_policy = v3_blocked_bloom_policy;
+      AddSupportedFilterPolicy(v3_policy, &table_options);
+    } else {
+      table_options.filter_policy = v3_policy;
+      AddSupportedFilterPolicy(v3_blocked_bloom_policy, &table_options);
+    }
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareHashedComponentsFilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV2FilterPolicy>(
@@ -22,6 +22,7 @@
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_read_context.h"
+#include "yb/docdb/doc_row_batch.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
@@ -186,6 +187,8 @@ class DocRowwiseIteratorTest : public DocDBTestBase {
   // as deleted.
   void TestDeletedDocumentUsingLivenessColumnDelete();
   void TestPartialKeyColumnsProjection();
+  void TestNextBatch(TableType table_type);
+  void TestSeekTupleForward();
 
   std::optional<Schema> projection_;
 };
@@ -1878,6 +1881,109 @@ void DocRowwiseIteratorTest::TestPartialKeyColumnsProjection() {
   }
 }
 
+void DocRowwiseIteratorTest::TestNextBatch(TableType table_type) {
+  constexpr int kVersion = 0;
+  auto& schema_packing = ASSERT_RESULT(
+      doc_read_context().schema_packing_storage.GetPacking(kVersion)).get();
+
+  InsertPackedRow(
+      kVersion, schema_packing, kEncodedDocKey1, HybridTime::FromMicros(1000),
+      {
+          {30_ColId, QLValue::Primitive("row1_c")},
+          {40_ColId, QLValue::PrimitiveInt64(10000)},
+          {50_ColId, QLValue::Primitive("row1_e")},
+      });
+
+  InsertPackedRow(
+      kVersion, schema_packing, kEncodedDocKey2, HybridTime::FromMicros(1000),
+      {
+          {30_ColId, QLValue::Primitive("row2_c")},
+      });
+
+  const auto& schema = doc_read_context().schema;
+  auto iter = std::make_unique<DocRowwiseIterator>(
+      schema, doc_read_context(), kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max(), ReadHybridTime::FromMicros(2000));
+  iter->Init(table_type);
+
+  // Batch projection skips column "c" and reorders remaining columns.
+  Schema projection;
+  ASSERT_OK(schema.CreateProjectionByNames({"b", "a", "e", "d"}, &projection));
+  DocRowBatch batch;
+  batch.Init(projection, /* need_tuple_ids= */ true);
+
+  auto dump_row = [&batch](size_t row_idx) {
+    std::string result;
+    for (size_t column_idx = 0; column_idx != batch.num_columns(); ++column_idx) {
+      result += QLValue(batch.value(column_idx, row_idx)).ToString() + ";";
+    }
+    return result;
+  };
+
+  ASSERT_EQ(ASSERT_RESULT(iter->NextBatch(1, CoarseTimePoint::max(), &batch)), 1U);
+  ASSERT_EQ(dump_row(0), "int64:11111;string:\"row1\";string:\"row1_e\";int64:10000;");
+  ASSERT_EQ(batch.tuple_id(0), kEncodedDocKey1.AsSlice());
+
+  ASSERT_EQ(ASSERT_RESULT(iter->NextBatch(10, CoarseTimePoint::max(), &batch)), 1U);
+  ASSERT_EQ(dump_row(0), "int64:22222;string:\"row2\";null;null;");
+  ASSERT_EQ(batch.tuple_id(0), kEncodedDocKey2.AsSlice());
+
+  ASSERT_EQ(ASSERT_RESULT(iter->NextBatch(10, CoarseTimePoint::max(), &batch)), 0U);
+}
+
+void DocRowwiseIteratorTest::TestSeekTupleForward() {
+  constexpr int kVersion = 0;
+  auto& schema_packing = ASSERT_RESULT(
+      doc_read_context().schema_packing_storage.GetPacking(kVersion)).get();
+
+  InsertPackedRow(
+      kVersion, schema_packing, kEncodedDocKey1, HybridTime::FromMicros(1000),
+      {
+          {30_ColId, QLValue::Primitive("row1_c")},
+      });
+
+  InsertPackedRow(
+      kVersion, schema_packing, kEncodedDocKey2, HybridTime::FromMicros(1000),
+      {
+          {30_ColId, QLValue::Primitive("row2_c")},
+      });
+
+  const KeyBytes missing_between(DocKey(KeyEntryValues(kStrKey1, kIntKey2)).Encode());
+  const KeyBytes missing_after(DocKey(KeyEntryValues(kStrKey2, kIntKey2 + 1)).Encode());
+
+  const auto& schema = doc_read_context().schema;
+  auto iter = std::make_unique<DocRowwiseIterator>(
+      schema, doc_read_context(), kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max(), ReadHybridTime::FromMicros(2000));
+  iter->Init(TableType::PGSQL_TABLE_TYPE);
+
+  QLTableRow row;
+  QLValue value;
+  ASSERT_TRUE(ASSERT_RESULT(iter->SeekTupleForward(kEncodedDocKey1.AsSlice())));
+  ASSERT_OK(iter->NextRow(&row));
+  ASSERT_OK(row.GetValue(schema.column_id(2), &value));
+  ASSERT_EQ(value.string_value(), "row1_c");
+
+  // Miss leaves the next row read, it should be found by the following seek.
+  ASSERT_FALSE(ASSERT_RESULT(iter->SeekTupleForward(missing_between.AsSlice())));
+  ASSERT_TRUE(ASSERT_RESULT(iter->HasNext()));
+  ASSERT_TRUE(ASSERT_RESULT(iter->SeekTupleForward(kEncodedDocKey2.AsSlice())));
+  row.Clear();
+  ASSERT_OK(iter->NextRow(&row));
+  ASSERT_OK(row.GetValue(schema.column_id(2), &value));
+  ASSERT_EQ(value.string_value(), "row2_c");
+
+  // Iterator that is not exhausted could also seek back after a miss.
+  ASSERT_FALSE(ASSERT_RESULT(iter->SeekTuple(missing_between.AsSlice())));
+  ASSERT_TRUE(ASSERT_RESULT(iter->HasNext()));
+  ASSERT_TRUE(ASSERT_RESULT(iter->SeekTuple(kEncodedDocKey1.AsSlice())));
+  ASSERT_TRUE(ASSERT_RESULT(iter->SeekTupleForward(kEncodedDocKey2.AsSlice())));
+
+  // Miss after the last row exhausts the iterator.
+  ASSERT_FALSE(ASSERT_RESULT(iter->SeekTupleForward(missing_after.AsSlice())));
+  ASSERT_FALSE(ASSERT_RESULT(iter->HasNext()));
+}
+
 TEST_F(DocRowwiseIteratorTest, ClusteredFilterTestRange) {
   TestClusteredFilterRange();
 }
@@ -1990,5 +2096,17 @@ TEST_F(DocRowwiseIteratorTest, PartialKeyColumnsProjection) {
   TestPartialKeyColumnsProjection();
 }
 
+TEST_F(DocRowwiseIteratorTest, NextBatchFlatDoc) {
+  TestNextBatch(TableType::PGSQL_TABLE_TYPE);
+}
+
+TEST_F(DocRowwiseIteratorTest, NextBatchSubDocument) {
+  TestNextBatch(TableType::YQL_TABLE_TYPE);
+}
+
+TEST_F(DocRowwiseIteratorTest, SeekTupleForward) {
+  TestSeekTupleForward();
+}
+
 }  // namespace docdb
 }  // namespace yb
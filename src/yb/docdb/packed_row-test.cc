@@ -11,6 +11,10 @@
 // under the License.
 //
 
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+
 #include <gtest/gtest.h>
 
 #include "yb/common/ql_value.h"
@@ -72,6 +76,25 @@ void TestRowPacking(const Schema& schema, const std::vector<QLValuePB>& values)
     }
     LOG(INFO) << i << ": " << value_slice.ToDebugHexString() << ", " << decoded_value;
   }
+
+  // Decoder for all columns in random order and a column that is not present in packing.
+  std::vector<ColumnId> column_ids;
+  for (size_t i = schema.num_key_columns(); i != schema.num_columns(); ++i) {
+    column_ids.push_back(schema.column_id(i));
+  }
+  std::shuffle(column_ids.begin(), column_ids.end(), ThreadLocalRandom());
+  column_ids.push_back(kInvalidColumnId);
+  PackedRowDecoder decoder(schema_packing, column_ids);
+  for (size_t i = 0; i != column_ids.size(); ++i) {
+    auto value_slice = decoder.GetValue(i, packed);
+    if (column_ids[i] == kInvalidColumnId) {
+      ASSERT_FALSE(value_slice);
+      continue;
+    }
+    auto expected = schema_packing.GetValue(column_ids[i], packed);
+    ASSERT_TRUE(value_slice);
+    ASSERT_EQ(value_slice->ToDebugHexString(), expected->ToDebugHexString());
+  }
 }
 
 void TestPacking(const std::vector<DataType>& types) {
@@ -117,5 +140,83 @@ TEST(PackedRowTest, Random) {
   }
 }
 
+// Compares throughput of extracting projection columns from packed rows of wide table via
+// SchemaPacking::GetValue lookup by column id and via precompiled PackedRowDecoder.
+TEST(PackedRowTest, DecodePerformance) {
+  constexpr size_t kNumColumns = 128;
+  constexpr size_t kNumRows = 1000;
+  constexpr int kNumIterations = 100;
+  constexpr int kVersion = 1;
+
+  SchemaBuilder builder;
+  ASSERT_OK(builder.AddHashKeyColumn("h1", DataType::INT32));
+  std::vector<DataType> types;
+  for (size_t i = 0; i != kNumColumns; ++i) {
+    types.push_back(i % 4 == 3 ? DataType::STRING : DataType::INT64);
+    auto name = "v_" + std::to_string(builder.next_column_id());
+    if (i % 2) {
+      ASSERT_OK(builder.AddNullableColumn(name, types.back()));
+    } else {
+      ASSERT_OK(builder.AddColumn(name, types.back()));
+    }
+  }
+  auto schema = builder.Build();
+  SchemaPacking schema_packing(TableType::PGSQL_TABLE_TYPE, schema);
+
+  std::vector<std::string> rows;
+  for (size_t row = 0; row != kNumRows; ++row) {
+    RowPacker packer(
+        kVersion, schema_packing, /* packed_size_limit= */ std::numeric_limits<int64_t>::max(),
+        /* value_control_fields= */ Slice());
+    for (size_t i = 0; i != kNumColumns; ++i) {
+      ASSERT_OK(packer.AddValue(
+          schema.column_id(schema.num_key_columns() + i), RandomQLValue(types[i])));
+    }
+    auto packed = ASSERT_RESULT(packer.Complete());
+    packed.consume_byte();
+    ASSERT_OK(util::FastDecodeUnsignedVarInt(&packed));
+    rows.push_back(packed.ToBuffer());
+  }
+
+  // Every fourth column is projected, as typical for queries that read a subset of columns.
+  std::vector<ColumnId> projection;
+  for (size_t i = 0; i < kNumColumns; i += 4) {
+    projection.push_back(schema.column_id(schema.num_key_columns() + i));
+  }
+  PackedRowDecoder decoder(schema_packing, projection);
+
+  size_t total_size = 0;
+  auto measure = [&rows, &total_size](const char* name, const auto& decode_row) {
+    total_size = 0;
+    std::clock_t start_time = std::clock();
+    for (int i = 0; i != kNumIterations; ++i) {
+      for (const auto& row : rows) {
+        total_size += decode_row(Slice(row));
+      }
+    }
+    std::clock_t end_time = std::clock();
+    LOG(INFO) << name << std::fixed << std::setprecision(2) << ", CPU time used: "
+              << 1000.0 * (end_time - start_time) / CLOCKS_PER_SEC << " ms";
+  };
+
+  measure("By column id", [&schema_packing, &projection](Slice packed) {
+    size_t result = 0;
+    for (auto column_id : projection) {
+      result += schema_packing.GetValue(column_id, packed)->size();
+    }
+    return result;
+  });
+  auto expected_size = total_size;
+
+  measure("Decoder", [&decoder](Slice packed) {
+    size_t result = 0;
+    for (size_t i = 0; i != decoder.num_columns(); ++i) {
+      result += decoder.GetValue(i, packed)->size();
+    }
+    return result;
+  });
+  ASSERT_EQ(total_size, expected_size);
+}
+
 } // namespace docdb
 } // namespace yb
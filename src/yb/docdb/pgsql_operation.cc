@@ -13,7 +13,10 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -29,9 +32,11 @@
 #include "yb/common/ql_value.h"
 
 #include "yb/docdb/doc_path.h"
+#include "yb/docdb/doc_pg_aggregate.h"
 #include "yb/docdb/doc_pg_expr.h"
 #include "yb/docdb/doc_pgsql_scanspec.h"
 #include "yb/docdb/doc_read_context.h"
+#include "yb/docdb/doc_row_batch.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb.messages.h"
@@ -49,8 +54,10 @@
 #include "yb/util/flags.h"
 #include "yb/util/result.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/trace.h"
+#include "yb/util/write_buffer.h"
 #include "yb/util/yb_pg_errcodes.h"
 
 #include "yb/yql/pggate/util/pg_doc_data.h"
@@ -59,6 +66,7 @@ using std::vector;
 using std::string;
 
 using namespace std::literals;
+using namespace yb::size_literals;
 
 DECLARE_bool(ysql_disable_index_backfill);
 
@@ -80,6 +88,16 @@ DEFINE_UNKNOWN_bool(pgsql_consistent_transactional_paging, true,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_RUNTIME_uint64(ysql_scan_batch_rows, 1024,
+                      "Max number of rows fetched from DocDB iterator in a single column-oriented "
+                      "batch during YSQL scans, when every target is a plain column reference. "
+                      "0 to fetch and evaluate rows one by one.");
+
+DEFINE_RUNTIME_bool(ysql_sort_batched_ybctids, true,
+                    "Whether ybctids of a batched YSQL read request should be looked up in the key "
+                    "order, so DocDB iterator moves only forward and reaches close keys via Next "
+                    "instead of a separate seek per ybctid.");
+
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
@@ -1380,70 +1398,76 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
 
   // Fetching data.
   size_t match_count = 0;
-  QLTableRow row;
-  while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
-         !scan_time_exceeded) {
-    row.Clear();
-    bool is_match = true;
+  if (CanUseBatchedScan()) {
+    RETURN_NOT_OK(ExecuteBatchedScan(
+        iter, &doc_expr_exec, row_count_limit, stop_scan, result_buffer, &fetched_rows,
+        &match_count, &scan_time_exceeded));
+  } else {
+    QLTableRow row;
+    while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
+           !scan_time_exceeded) {
+      row.Clear();
+      bool is_match = true;
 
-    if (request_.has_index_request()) {
-      // Index scan over colocated table case, get next index row
-      RETURN_NOT_OK(iter->NextRow(&row));
+      if (request_.has_index_request()) {
+        // Index scan over colocated table case, get next index row
+        RETURN_NOT_OK(iter->NextRow(&row));
 
-      // Check index conditions
-      RETURN_NOT_OK(index_expr_exec.Exec(row, nullptr, &is_match));
+        // Check index conditions
+        RETURN_NOT_OK(index_expr_exec.Exec(row, nullptr, &is_match));
 
-      if (!is_match) {
-        // If no match continue with next tuple from the iterator.
-        VLOG(1) << "Row filtered out by colocated index condition";
-        continue;
-      }
+        if (!is_match) {
+          // If no match continue with next tuple from the iterator.
+          VLOG(1) << "Row filtered out by colocated index condition";
+          continue;
+        }
 
-      // Index matches the condition, get the ybctid of the target row.
-      const auto& tuple_id = row.GetValue(ybbasectid_id);
-      SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
-      // Seek the target row using main table iterator
-      // unless index is corrupted, seek is expected to be successful
-      if (!VERIFY_RESULT(table_iter_->SeekTuple(tuple_id->binary_value()))) {
-        if (FLAGS_TEST_ysql_suppress_ybctid_corruption_details) {
-          return STATUS(Corruption, "ybctid not found in indexed table");
-        } else {
-          DocKey doc_key;
-          RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id->binary_value()));
-          return STATUS_FORMAT(
-              Corruption,
-              "ybctid $0 not found in indexed table. index table id is $1",
-              doc_key,
-              request_.index_request().table_id());
+        // Index matches the condition, get the ybctid of the target row.
+        const auto& tuple_id = row.GetValue(ybbasectid_id);
+        SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
+        // Seek the target row using main table iterator
+        // unless index is corrupted, seek is expected to be successful
+        if (!VERIFY_RESULT(table_iter_->SeekTuple(tuple_id->binary_value()))) {
+          if (FLAGS_TEST_ysql_suppress_ybctid_corruption_details) {
+            return STATUS(Corruption, "ybctid not found in indexed table");
+          } else {
+            DocKey doc_key;
+            RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id->binary_value()));
+            return STATUS_FORMAT(
+                Corruption,
+                "ybctid $0 not found in indexed table. index table id is $1",
+                doc_key,
+                request_.index_request().table_id());
+          }
         }
+        // Remove table row currently held by the variable.
+        row.Clear();
+        // Fetch main table row
+        RETURN_NOT_OK(table_iter_->NextRow(&row));
+      } else {
+        // Fetch main table row
+        RETURN_NOT_OK(iter->NextRow(&row));
       }
-      // Remove table row currently held by the variable.
-      row.Clear();
-      // Fetch main table row
-      RETURN_NOT_OK(table_iter_->NextRow(&row));
-    } else {
-      // Fetch main table row
-      RETURN_NOT_OK(iter->NextRow(&row));
-    }
 
-    // Match the row with the where condition before adding to the row block.
-    RETURN_NOT_OK(doc_expr_exec.Exec(row, nullptr, &is_match));
+      // Match the row with the where condition before adding to the row block.
+      RETURN_NOT_OK(doc_expr_exec.Exec(row, nullptr, &is_match));
 
-    if (!is_match) {
-      VLOG(1) << "Row filtered out by the condition";
-      continue;
-    }
+      if (!is_match) {
+        VLOG(1) << "Row filtered out by the condition";
+        continue;
+      }
 
-    ++match_count;
-    if (request_.is_aggregate()) {
-      RETURN_NOT_OK(EvalAggregate(row));
-    } else {
-      RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
-      ++fetched_rows;
-    }
+      ++match_count;
+      if (request_.is_aggregate()) {
+        RETURN_NOT_OK(EvalAggregate(row));
+      } else {
+        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+        ++fetched_rows;
+      }
 
-    // Check if we are running out of time
-    scan_time_exceeded = CoarseMonoClock::now() >= stop_scan;
+      // Check if we are running out of time
+      scan_time_exceeded = CoarseMonoClock::now() >= stop_scan;
+    }
   }
 
   VLOG(1) << "Stopped iterator after " << match_count << " matches, "
@@ -1471,6 +1495,108 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   return fetched_rows;
 }
 
+bool PgsqlReadOperation::CanUseBatchedScan() const {
+  if (FLAGS_ysql_scan_batch_rows == 0 || request_.has_index_request()) {
+    return false;
+  }
+  if (request_.is_aggregate()) {
+    return DocPgAggregator::IsSupported(request_);
+  }
+  for (const PgsqlExpressionPB& expr : request_.targets()) {
+    if (expr.expr_case() != PgsqlExpressionPB::ExprCase::kColumnId ||
+        (expr.column_id() < 0 &&
+         expr.column_id() != static_cast<int>(PgSystemAttrNum::kYBTupleId))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status PgsqlReadOperation::ExecuteBatchedScan(YQLRowwiseIteratorIf* iter,
+                                              DocPgExprExecutor* expr_exec,
+                                              size_t row_count_limit,
+                                              CoarseTimePoint stop_scan,
+                                              WriteBuffer* result_buffer,
+                                              size_t* fetched_rows,
+                                              size_t* match_count,
+                                              bool* scan_time_exceeded) {
+  // Index of the batch column for every target. Tuple id is not a regular column, so it is
+  // marked with a dedicated index.
+  constexpr size_t kTupleIdColumn = DocRowBatch::kColumnNotFound - 1;
+  const bool is_aggregate = request_.is_aggregate();
+  bool need_tuple_ids = false;
+  if (!is_aggregate) {
+    for (const PgsqlExpressionPB& expr : request_.targets()) {
+      need_tuple_ids |= expr.column_id() == static_cast<int>(PgSystemAttrNum::kYBTupleId);
+    }
+  }
+  DocRowBatch batch;
+  batch.Init(iter->schema(), need_tuple_ids);
+
+  std::optional<DocPgAggregator> aggregator;
+  std::vector<size_t> target_columns;
+  if (is_aggregate) {
+    aggregator.emplace(request_);
+    aggregator->Prepare(batch);
+  } else {
+    target_columns.reserve(request_.targets().size());
+    for (const PgsqlExpressionPB& expr : request_.targets()) {
+      target_columns.push_back(
+          expr.column_id() == static_cast<int>(PgSystemAttrNum::kYBTupleId)
+              ? kTupleIdColumn : batch.find_column(expr.column_id()));
+    }
+  }
+
+  const QLValuePB null_value;
+  QLValuePB tuple_id_value;
+  // Indexes of batch rows that match where clauses.
+  std::vector<size_t> selected_rows;
+  while (*fetched_rows < row_count_limit && !*scan_time_exceeded) {
+    // Never read more rows than could be returned in this response, so the iterator is positioned
+    // right after the last processed row when paging state is filled.
+    // The batch is also limited by the scan deadline, so the scan stops in time like the row by
+    // row scan does.
+    const auto max_rows = std::min<size_t>(
+        FLAGS_ysql_scan_batch_rows, row_count_limit - *fetched_rows);
+    const auto num_rows = VERIFY_RESULT(iter->NextBatch(max_rows, stop_scan, &batch));
+
+    RETURN_NOT_OK(expr_exec->ExecBatch(batch, &selected_rows));
+    VLOG(1) << num_rows - selected_rows.size() << " rows filtered out by the condition";
+    *match_count += selected_rows.size();
+
+    if (aggregator) {
+      RETURN_NOT_OK(aggregator->Accumulate(batch, selected_rows));
+    } else {
+      for (auto row_idx : selected_rows) {
+        for (auto column_idx : target_columns) {
+          if (column_idx == kTupleIdColumn) {
+            const auto tuple_id = batch.tuple_id(row_idx);
+            tuple_id_value.set_binary_value(tuple_id.cdata(), tuple_id.size());
+            RETURN_NOT_OK(pggate::WriteColumn(tuple_id_value, result_buffer));
+          } else if (column_idx == DocRowBatch::kColumnNotFound) {
+            RETURN_NOT_OK(pggate::WriteColumn(null_value, result_buffer));
+          } else {
+            RETURN_NOT_OK(pggate::WriteColumn(batch.value(column_idx, row_idx), result_buffer));
+          }
+        }
+      }
+      *fetched_rows += selected_rows.size();
+    }
+
+    // Check if we are running out of time
+    *scan_time_exceeded = CoarseMonoClock::now() >= stop_scan;
+
+    if (num_rows < max_rows && !*scan_time_exceeded) {
+      break;
+    }
+  }
+
+  if (aggregator) {
+    aggregator->Finish(&aggr_result_);
+  }
+  return Status::OK();
+}
+
 Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_storage,
                                                       CoarseTimePoint deadline,
                                                       const ReadHybridTime& read_time,
@@ -1507,33 +1633,110 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_sto
     }
   }
 
-  bool iter_valid = false;
-  for(const PgsqlBatchArgumentPB& batch_argument : batch_args) {
-    if (!iter_valid) {
-      // It can be the case like when there is a tablet split that we still want
-      // to continue seeking through all the given batch arguments even though one
-      // of them wasn't found. If it wasn't found, table_iter_ becomes invalid
-      // and we have to make a new iterator.
+  const bool sort_ybctids = FLAGS_ysql_sort_batched_ybctids;
+  bool create_iter = true;
+  // Looks up the row for the batch argument and writes it to buffer when the row exists and
+  // matches where clauses. Returns true if the row was written.
+  auto fetch_row = [&](const PgsqlBatchArgumentPB& batch_argument, bool seek_forward,
+                       WriteBuffer* buffer) -> Result<bool> {
+    if (create_iter) {
       RETURN_NOT_OK(ql_storage.GetIterator(
           request_.stmt_id(), projection, doc_read_context, txn_op_context_,
           deadline, read_time, min_arg->ybctid().value(),
           max_arg->ybctid().value(), &table_iter_));
+      create_iter = false;
     }
     // Get the row.
-    auto &tuple_id = batch_argument.ybctid().value();
-    iter_valid = VERIFY_RESULT(table_iter_->SeekTuple(tuple_id.binary_value()));
-    if (iter_valid) {
-      row.Clear();
-      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
-      bool is_match = true;
-      RETURN_NOT_OK(expr_exec.Exec(row, nullptr, &is_match));
-      if (is_match) {
-        // Populate result set.
-        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+    const auto& tuple_id = batch_argument.ybctid().value().binary_value();
+    const auto found = VERIFY_RESULT(seek_forward ? table_iter_->SeekTupleForward(tuple_id)
+                                                  : table_iter_->SeekTuple(tuple_id));
+    if (!found) {
+      // It can be the case like when there is a tablet split that we still want to continue
+      // seeking through all the given batch arguments even though one of them wasn't found.
+      // When the row is not found, the iterator is positioned at the next row within the bounds of
+      // batch arguments and is reused for the next argument.
+      // An exhausted iterator cannot seek anymore. Arguments are visited in the key order when
+      // sorted, so remaining arguments could not be found either and the iterator is kept.
+      // Otherwise a new iterator is created for the next argument.
+      create_iter = !sort_ybctids && !VERIFY_RESULT(table_iter_->HasNext());
+      return false;
+    }
+    row.Clear();
+    RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+    bool is_match = true;
+    RETURN_NOT_OK(expr_exec.Exec(row, nullptr, &is_match));
+    if (!is_match) {
+      return false;
+    }
+    // Populate result set.
+    RETURN_NOT_OK(PopulateResultSet(row, buffer));
+    return true;
+  };
+
+  if (!sort_ybctids) {
+    for (const PgsqlBatchArgumentPB& batch_argument : batch_args) {
+      if (VERIFY_RESULT(fetch_row(batch_argument, /* seek_forward= */ false, result_buffer))) {
         response_.add_batch_orders(batch_argument.order());
         row_count++;
       }
     }
+  } else {
+    // Visit arguments in the key order, so the iterator moves only forward.
+    std::vector<int> arg_indexes(batch_args.size());
+    std::iota(arg_indexes.begin(), arg_indexes.end(), 0);
+    auto tuple_id_less = [&batch_args](int lhs, int rhs) {
+      return batch_args[lhs].ybctid().value().binary_value() <
+             batch_args[rhs].ybctid().value().binary_value();
+    };
+    const bool in_key_order = std::is_sorted(
+        arg_indexes.begin(), arg_indexes.end(), tuple_id_less);
+    if (!in_key_order) {
+      std::stable_sort(arg_indexes.begin(), arg_indexes.end(), tuple_id_less);
+    }
+
+    // Rows of the response should follow the order of the request arguments. So when arguments
+    // are not in the key order, found rows are serialized to a separate buffer first, and then
+    // copied to the result in the argument order.
+    constexpr auto kRowNotFound = std::numeric_limits<size_t>::max();
+    std::optional<WriteBuffer> rows_buffer;
+    std::vector<std::pair<size_t, size_t>> row_ranges;
+    if (!in_key_order) {
+      rows_buffer.emplace(1_KB);
+      row_ranges.assign(batch_args.size(), {kRowNotFound, kRowNotFound});
+    }
+    const std::string* prev_tuple_id = nullptr;
+    for (auto arg_idx : arg_indexes) {
+      const auto& batch_argument = batch_args[arg_idx];
+      const auto& tuple_id = batch_argument.ybctid().value().binary_value();
+      // Iterator is already past the row of the duplicate argument, so a real seek is required.
+      const bool seek_forward = !prev_tuple_id || *prev_tuple_id != tuple_id;
+      prev_tuple_id = &tuple_id;
+      if (in_key_order) {
+        if (VERIFY_RESULT(fetch_row(batch_argument, seek_forward, result_buffer))) {
+          response_.add_batch_orders(batch_argument.order());
+          row_count++;
+        }
+        continue;
+      }
+      const auto begin = rows_buffer->size();
+      if (VERIFY_RESULT(fetch_row(batch_argument, seek_forward, &*rows_buffer))) {
+        row_ranges[arg_idx] = {begin, rows_buffer->size()};
+      }
+    }
+
+    if (!in_key_order) {
+      std::string row_data;
+      for (int arg_idx = 0; arg_idx != batch_args.size(); ++arg_idx) {
+        const auto& range = row_ranges[arg_idx];
+        if (range.first == kRowNotFound) {
+          continue;
+        }
+        rows_buffer->AssignTo(range.first, range.second, &row_data);
+        result_buffer->Append(row_data.data(), row_data.size());
+        response_.add_batch_orders(batch_args[arg_idx].order());
+        row_count++;
+      }
+    }
   }
 
   // Set status for this batch.
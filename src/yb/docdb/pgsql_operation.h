@@ -29,6 +29,8 @@ class IndexInfo;
 
 namespace docdb {
 
+class DocPgExprExecutor;
+
 YB_STRONGLY_TYPED_BOOL(IsUpsert);
 
 bool ShouldYsqlPackRow(bool has_cotable_id);
@@ -199,6 +201,23 @@ class PgsqlReadOperation : public DocExprExecutor {
                                HybridTime *restart_read_ht,
                                bool *has_paging_state);
 
+  // Whether ExecuteScalar could fetch rows using ExecuteBatchedScan, i.e. rows are read from the
+  // main table iterator only and every target is a plain column reference or an aggregate
+  // supported by DocPgAggregator.
+  bool CanUseBatchedScan() const;
+
+  // Fetches rows from the iterator in column-oriented batches and writes the targets straight
+  // from the column arrays, or accumulates aggregates over them, without evaluating target
+  // expressions per row. Row is materialized into QLTableRow only to evaluate where clauses.
+  Status ExecuteBatchedScan(YQLRowwiseIteratorIf* iter,
+                            DocPgExprExecutor* expr_exec,
+                            size_t row_count_limit,
+                            CoarseTimePoint stop_scan,
+                            WriteBuffer* result_buffer,
+                            size_t* fetched_rows,
+                            size_t* match_count,
+                            bool* scan_time_exceeded);
+
   Status PopulateResultSet(const QLTableRow& table_row,
                            WriteBuffer *result_buffer);
 
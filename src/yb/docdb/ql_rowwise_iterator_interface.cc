@@ -14,6 +14,9 @@
 #include "yb/docdb/ql_rowwise_iterator_interface.h"
 
 #include "yb/common/hybrid_time.h"
+#include "yb/common/ql_expr.h"
+
+#include "yb/docdb/doc_row_batch.h"
 
 #include "yb/util/result.h"
 
@@ -32,6 +35,28 @@ Result<bool> YQLRowwiseIteratorIf::SeekTuple(const Slice& tuple_id) {
   return STATUS(NotSupported, "This iterator cannot seek by tuple id");
 }
 
+Result<bool> YQLRowwiseIteratorIf::SeekTupleForward(const Slice& tuple_id) {
+  return SeekTuple(tuple_id);
+}
+
+Result<size_t> YQLRowwiseIteratorIf::NextBatch(
+    size_t max_rows, CoarseTimePoint deadline, DocRowBatch* batch) {
+  batch->Clear();
+  QLTableRow row;
+  while (batch->num_rows() < max_rows && VERIFY_RESULT(HasNext())) {
+    if (batch->num_rows() && CoarseMonoClock::now() >= deadline) {
+      break;
+    }
+    row.Clear();
+    RETURN_NOT_OK(NextRow(&row));
+    batch->AppendRow(row);
+    if (batch->need_tuple_ids()) {
+      batch->AddTupleId(VERIFY_RESULT(GetTupleId()));
+    }
+  }
+  return batch->num_rows();
+}
+
 HybridTime YQLRowwiseIteratorIf::TEST_MaxSeenHt() {
   return HybridTime::kInvalid;
 }
@@ -21,6 +21,7 @@
 
 #include "yb/docdb/docdb_fwd.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/status_fwd.h"
 
 namespace yb {
@@ -75,6 +76,19 @@ class YQLRowwiseIteratorIf {
   // Seeks to the given tuple by its id. See DocRowwiseIterator for details.
   virtual Result<bool> SeekTuple(const Slice& tuple_id);
 
+  // Same as SeekTuple, but could be used only when tuple_id is not less than the tuple id passed
+  // to the previous seek, so iterator is allowed to move only forward.
+  // The default implementation just calls SeekTuple.
+  virtual Result<bool> SeekTupleForward(const Slice& tuple_id);
+
+  // Reads up to max_rows next rows into the batch, that should be initialized with a projection
+  // that is a subset of schema(). Stops before reading the next row when deadline is reached.
+  // Returns the number of rows read, it is less than max_rows only when the iterator is exhausted
+  // or the deadline is reached.
+  // The default implementation reads rows one by one via NextRow.
+  virtual Result<size_t> NextBatch(
+      size_t max_rows, CoarseTimePoint deadline, DocRowBatch* batch);
+
   //------------------------------------------------------------------------------------------------
   // Common API methods.
   //------------------------------------------------------------------------------------------------
@@ -117,6 +117,33 @@ void PutApplyState(
   handler->Put(key_parts, value_parts);
 }
 
+// Updates range of schema versions of packed rows with the version of the row in the value, if
+// it is a packed row.
+Status UpdateSchemaVersionRange(
+    Slice value, SchemaVersion* min_schema_version, SchemaVersion* max_schema_version) {
+  RETURN_NOT_OK(ValueControlFields::Decode(&value));
+  if (value.TryConsumeByte(ValueEntryTypeAsChar::kPackedRow)) {
+    auto schema_version = narrow_cast<SchemaVersion>(VERIFY_RESULT(
+        util::FastDecodeUnsignedVarInt(&value)));
+    *min_schema_version = std::min(*min_schema_version, schema_version);
+    *max_schema_version = std::max(*max_schema_version, schema_version);
+  }
+  return Status::OK();
+}
+
+void UpdateFrontiersSchemaVersion(
+    SchemaVersion min_schema_version, SchemaVersion max_schema_version,
+    ConsensusFrontiers* frontiers) {
+  if (min_schema_version > max_schema_version) {
+    return;
+  }
+  auto table_id = Uuid::Nil();
+  frontiers->Smallest().UpdateSchemaVersion(
+      table_id, min_schema_version, rocksdb::UpdateUserValueType::kSmallest);
+  frontiers->Largest().UpdateSchemaVersion(
+      table_id, max_schema_version, rocksdb::UpdateUserValueType::kLargest);
+}
+
 } // namespace
 
 NonTransactionalWriter::NonTransactionalWriter(
@@ -311,6 +338,12 @@ Status TransactionalWriter::operator()(
   }
   AddIntent<kNumKeyParts>(transaction_id_, key_parts, value, handler_, reverse_value_prefix);
 
+  if (intents_cache_ && strong_intent_types_.Test(IntentType::kStrongWrite) &&
+      !IsValidRowMarkType(row_mark_)) {
+    intents_cache_->Add(
+        key->AsSlice(), key_parts[2], value_slice, intra_txn_write_id_ - 1, subtransaction_id_);
+  }
+
   return Status::OK();
 }
 
@@ -578,14 +611,8 @@ Result<bool> ApplyIntentsContext::Entry(
         commit_ht_, write_id_, decoded_value.body);
 
     if (frontiers_) {
-      Slice value_slice = decoded_value.body;
-      RETURN_NOT_OK(ValueControlFields::Decode(&value_slice));
-      if (value_slice.TryConsumeByte(ValueEntryTypeAsChar::kPackedRow)) {
-        auto schema_version = narrow_cast<SchemaVersion>(VERIFY_RESULT(
-            util::FastDecodeUnsignedVarInt(&value_slice)));
-        min_schema_version_ = std::min(min_schema_version_, schema_version);
-        max_schema_version_ = std::max(max_schema_version_, schema_version);
-      }
+      RETURN_NOT_OK(UpdateSchemaVersionRange(
+          decoded_value.body, &min_schema_version_, &max_schema_version_));
     }
   }
 
@@ -598,13 +625,91 @@ void ApplyIntentsContext::Complete(rocksdb::DirectWriteHandler* handler) {
     std::array<Slice, 1> value_parts = {{Slice(&tombstone_value_type, 1)}};
     PutApplyState(transaction_id().AsSlice(), commit_ht_, write_id_, value_parts, handler);
   }
-  if (min_schema_version_ <= max_schema_version_) {
-    auto table_id = Uuid::Nil();
-    frontiers_->Smallest().UpdateSchemaVersion(
-        table_id, min_schema_version_, rocksdb::UpdateUserValueType::kSmallest);
-    frontiers_->Largest().UpdateSchemaVersion(
-        table_id, max_schema_version_, rocksdb::UpdateUserValueType::kLargest);
+  if (frontiers_) {
+    UpdateFrontiersSchemaVersion(min_schema_version_, max_schema_version_, frontiers_);
+  }
+}
+
+void CachedIntents::Add(
+    Slice doc_path, Slice doc_ht, Slice body, IntraTxnWriteId write_id,
+    SubTransactionId subtransaction_id) {
+  buffer_.append(doc_path.cdata(), doc_path.size());
+  buffer_.append(doc_ht.cdata(), doc_ht.size());
+  buffer_.append(body.cdata(), body.size());
+  records_.push_back(Record {
+    .doc_path_size = doc_path.size(),
+    .doc_ht_size = doc_ht.size(),
+    .body_size = body.size(),
+    .write_id = write_id,
+    .subtransaction_id = subtransaction_id,
+  });
+}
+
+void CachedIntents::Append(const CachedIntents& rhs) {
+  buffer_.append(rhs.buffer_);
+  records_.insert(records_.end(), rhs.records_.begin(), rhs.records_.end());
+}
+
+size_t CachedIntents::memory_usage() const {
+  return sizeof(*this) + buffer_.size() + records_.size() * sizeof(Record);
+}
+
+CachedIntentsWriter::CachedIntentsWriter(
+    const TransactionId& transaction_id,
+    const CachedIntents& intents,
+    const SubtxnSet& aborted,
+    HybridTime commit_ht,
+    const KeyBounds* key_bounds,
+    ConsensusFrontiers* frontiers)
+    : transaction_id_(transaction_id),
+      intents_(intents),
+      aborted_(aborted),
+      commit_ht_(commit_ht),
+      key_bounds_(key_bounds),
+      frontiers_(frontiers) {
+}
+
+Status CachedIntentsWriter::Apply(rocksdb::DirectWriteHandler* handler) {
+  DocHybridTimeBuffer doc_ht_buffer;
+  auto min_schema_version = std::numeric_limits<SchemaVersion>::max();
+  auto max_schema_version = std::numeric_limits<SchemaVersion>::min();
+  const char* data = intents_.buffer_.data();
+  for (const auto& record : intents_.records_) {
+    Slice doc_path(data, record.doc_path_size);
+    data += record.doc_path_size;
+    Slice intent_doc_ht(data, record.doc_ht_size);
+    data += record.doc_ht_size;
+    Slice body(data, record.body_size);
+    data += record.body_size;
+
+    // Same as ApplyIntentsContext::Entry, but intents are taken from memory.
+    if (aborted_.Test(record.subtransaction_id) || !IsWithinBounds(key_bounds_, doc_path)) {
+      continue;
+    }
+
+    std::array<Slice, 2> key_parts = {{
+        doc_path,
+        doc_ht_buffer.EncodeWithValueType(commit_ht_, record.write_id),
+    }};
+    std::array<Slice, 2> value_parts = {{
+        intent_doc_ht,
+        body,
+    }};
+    handler->Put(key_parts, value_parts);
+
+    YB_TRANSACTION_DUMP(
+        ApplyIntent, transaction_id_, doc_path.size(), doc_path, commit_ht_, record.write_id + 1,
+        body);
+
+    if (frontiers_) {
+      RETURN_NOT_OK(UpdateSchemaVersionRange(body, &min_schema_version, &max_schema_version));
+    }
+  }
+
+  if (frontiers_) {
+    UpdateFrontiersSchemaVersion(min_schema_version, max_schema_version, frontiers_);
   }
+  return Status::OK();
 }
 
 RemoveIntentsContext::RemoveIntentsContext(const TransactionId& transaction_id, uint8_t reason)
@@ -59,6 +59,42 @@ class DocHybridTimeBuffer {
   std::array<char, 1 + kMaxBytesPerEncodedHybridTime> buffer_;
 };
 
+// Strong write intents of a transaction that are also kept in memory, so the committed transaction
+// could be applied to the regular DB without reading its intents back from the intents DB.
+// Only intents that are written as regular records on apply are kept, i.e. there are no read
+// intents and row locks.
+class CachedIntents {
+ public:
+  void Add(
+      Slice doc_path, Slice doc_ht, Slice body, IntraTxnWriteId write_id,
+      SubTransactionId subtransaction_id);
+
+  // Appends intents of the batch that was written after intents of this one.
+  void Append(const CachedIntents& rhs);
+
+  size_t num_records() const {
+    return records_.size();
+  }
+
+  // Approximate number of bytes used to keep the intents.
+  size_t memory_usage() const;
+
+ private:
+  friend class CachedIntentsWriter;
+
+  // Doc path, doc hybrid time and value of the record are stored one after another in buffer_.
+  struct Record {
+    size_t doc_path_size;
+    size_t doc_ht_size;
+    size_t body_size;
+    IntraTxnWriteId write_id;
+    SubTransactionId subtransaction_id;
+  };
+
+  std::string buffer_;
+  std::vector<Record> records_;
+};
+
 class TransactionalWriter : public rocksdb::DirectWriter {
  public:
   TransactionalWriter(
@@ -80,6 +116,11 @@ class TransactionalWriter : public rocksdb::DirectWriter {
     metadata_to_store_ = value;
   }
 
+  // Strong write intents are also added to the specified cache, if set.
+  void SetIntentsCache(CachedIntents* value) {
+    intents_cache_ = value;
+  }
+
   Status operator()(
       IntentStrength intent_strength, FullDocKey, Slice value_slice, KeyBytes* key,
       LastKey last_key);
@@ -100,6 +141,7 @@ class TransactionalWriter : public rocksdb::DirectWriter {
   IntraTxnWriteId intra_txn_write_id_;
   IntraTxnWriteId write_id_ = 0;
   const LWTransactionMetadataPB* metadata_to_store_ = nullptr;
+  CachedIntents* intents_cache_ = nullptr;
 
   // TODO(dtxn) weak & strong intent in one batch.
   // TODO(dtxn) extract part of code knowing about intents structure to lower level.
@@ -217,6 +259,29 @@ class ApplyIntentsContext : public IntentsWriterContext {
   ConsensusFrontiers* frontiers_;
 };
 
+// Applies intents of the committed transaction kept in memory, instead of reading them from the
+// intents DB as ApplyIntentsContext does. All intents are written in a single batch.
+class CachedIntentsWriter : public rocksdb::DirectWriter {
+ public:
+  CachedIntentsWriter(
+      const TransactionId& transaction_id,
+      const CachedIntents& intents,
+      const SubtxnSet& aborted,
+      HybridTime commit_ht,
+      const KeyBounds* key_bounds,
+      ConsensusFrontiers* frontiers);
+
+  Status Apply(rocksdb::DirectWriteHandler* handler) override;
+
+ private:
+  const TransactionId& transaction_id_;
+  const CachedIntents& intents_;
+  const SubtxnSet& aborted_;
+  HybridTime commit_ht_;
+  const KeyBounds* key_bounds_;
+  ConsensusFrontiers* frontiers_;
+};
+
 class RemoveIntentsContext : public IntentsWriterContext {
  public:
   explicit RemoveIntentsContext(const TransactionId& transaction_id, uint8_t reason);
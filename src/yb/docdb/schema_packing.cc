@@ -128,6 +128,11 @@ bool SchemaPacking::SkippedColumn(ColumnId column_id) const {
   return it != column_to_idx_.end() && it->second == kSkippedColumnIdx;
 }
 
+int64_t SchemaPacking::GetIndex(ColumnId column_id) const {
+  auto it = column_to_idx_.find(column_id);
+  return it != column_to_idx_.end() ? it->second : kSkippedColumnIdx;
+}
+
 Slice SchemaPacking::GetValue(size_t idx, const Slice& packed) const {
   const auto& column_data = columns_[idx];
   size_t offset = column_data.num_varlen_columns_before
@@ -175,6 +180,42 @@ bool SchemaPacking::CouldPack(
   return true;
 }
 
+PackedRowDecoder::PackedRowDecoder(
+    std::reference_wrapper<const SchemaPacking> packing, const std::vector<ColumnId>& column_ids)
+    : packing_(packing), prefix_len_(packing_.prefix_len()) {
+  columns_.reserve(column_ids.size());
+  for (auto column_id : column_ids) {
+    auto idx = column_id == kInvalidColumnId ? kSkippedColumnIdx : packing_.GetIndex(column_id);
+    if (idx == kSkippedColumnIdx) {
+      columns_.push_back(Column {
+        .packed = false,
+        .prev_varlen_idx = kNoVarlen,
+        .varlen_idx = kNoVarlen,
+        .offset = 0,
+        .size = 0,
+      });
+      continue;
+    }
+    const auto& column_data = packing_.column_packing_data(idx);
+    auto num_varlen_before = narrow_cast<uint32_t>(column_data.num_varlen_columns_before);
+    columns_.push_back(Column {
+      .packed = true,
+      .prev_varlen_idx = num_varlen_before ? num_varlen_before - 1 : kNoVarlen,
+      .varlen_idx = column_data.varlen() ? num_varlen_before : kNoVarlen,
+      .offset = narrow_cast<uint32_t>(prefix_len_ + column_data.offset_after_prev_varlen_column),
+      .size = narrow_cast<uint32_t>(column_data.size),
+    });
+  }
+}
+
+std::string PackedRowDecoder::Column::ToString() const {
+  return YB_STRUCT_TO_STRING(packed, prev_varlen_idx, varlen_idx, offset, size);
+}
+
+std::string PackedRowDecoder::ToString() const {
+  return YB_CLASS_TO_STRING(prefix_len, columns);
+}
+
 SchemaPackingStorage::SchemaPackingStorage(TableType table_type) : table_type_(table_type) {}
 
 SchemaPackingStorage::SchemaPackingStorage(
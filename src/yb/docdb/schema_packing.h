@@ -13,7 +13,10 @@
 
 #pragma once
 
+#include <limits>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/functional/hash.hpp>
 
@@ -25,6 +28,8 @@
 
 #include "yb/docdb/docdb.fwd.h"
 
+#include "yb/gutil/endian.h"
+
 #include "yb/util/slice.h"
 #include "yb/util/strongly_typed_bool.h"
 
@@ -84,6 +89,10 @@ class SchemaPacking {
   }
 
   bool SkippedColumn(ColumnId column_id) const;
+
+  // Returns index of the column in packing, or -1 if column is not packed.
+  int64_t GetIndex(ColumnId column_id) const;
+
   Slice GetValue(size_t idx, const Slice& packed) const;
   std::optional<Slice> GetValue(ColumnId column_id, const Slice& packed) const;
   void ToPB(SchemaPackingPB* out) const;
@@ -105,6 +114,70 @@ class SchemaPacking {
   size_t varlen_columns_count_;
 };
 
+// Precompiled plan to extract a fixed list of columns (usually read projection) from packed rows
+// of a particular schema packing.
+// Column ids are resolved to packed column indexes and value offsets are precomputed once per
+// schema version, so decoding a row does not perform hash lookups and only touches requested
+// columns. Offsets of fixed size columns that are not preceded by varlen columns are constant,
+// so such columns are extracted without reading the varlen prefix.
+class PackedRowDecoder {
+ public:
+  // column_ids could contain kInvalidColumnId for entries that are never packed.
+  PackedRowDecoder(
+      std::reference_wrapper<const SchemaPacking> packing, const std::vector<ColumnId>& column_ids);
+
+  const SchemaPacking& packing() const {
+    return packing_;
+  }
+
+  size_t num_columns() const {
+    return columns_.size();
+  }
+
+  // Returns encoded value of column with specified index in column_ids passed to constructor,
+  // or nullopt if this column is not packed.
+  std::optional<Slice> GetValue(size_t idx, const Slice& packed) const {
+    const auto& column = columns_[idx];
+    if (!column.packed) {
+      return std::nullopt;
+    }
+    const auto* data = packed.cdata();
+    size_t begin = column.offset;
+    if (column.prev_varlen_idx != kNoVarlen) {
+      begin += LoadEnd(column.prev_varlen_idx, data);
+    }
+    size_t end = column.size ? begin + column.size : prefix_len_ + LoadEnd(column.varlen_idx, data);
+    return Slice(data + begin, data + end);
+  }
+
+  std::string ToString() const;
+
+ private:
+  static constexpr uint32_t kNoVarlen = std::numeric_limits<uint32_t>::max();
+
+  struct Column {
+    bool packed;
+    // Index of varlen column end that precedes this column, kNoVarlen if there is no such column.
+    uint32_t prev_varlen_idx;
+    // Index of this column end in varlen prefix, actual only for varlen columns.
+    uint32_t varlen_idx;
+    // Offset that should be added to the end of previous varlen column.
+    uint32_t offset;
+    // Fixed size of this column, 0 if it is varlen column.
+    uint32_t size;
+
+    std::string ToString() const;
+  };
+
+  static size_t LoadEnd(size_t idx, const char* data) {
+    return LittleEndian::Load32(data + idx * sizeof(uint32_t));
+  }
+
+  const SchemaPacking& packing_;
+  const size_t prefix_len_;
+  std::vector<Column> columns_;
+};
+
 class SchemaPackingStorage {
  public:
   explicit SchemaPackingStorage(TableType table_type);
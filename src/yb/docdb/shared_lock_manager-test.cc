@@ -25,6 +25,7 @@
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/result.h"
 #include "yb/util/test_macros.h"
+#include "yb/util/test_thread_holder.h"
 #include "yb/util/test_util.h"
 
 using namespace std::literals;
@@ -162,6 +163,51 @@ TEST_F(SharedLockManagerTest, QuickLockUnlock) {
   }
 }
 
+// Emulates many concurrent small writes to the same tablet. Each batch takes weak locks on the
+// common prefix and the row, and strong lock on the column, so batches don't conflict, but
+// contend on the lock manager itself.
+TEST_F(SharedLockManagerTest, ContendedLockUnlockBenchmark) {
+  const auto kThreads = 16;
+  const auto kRowsPerThread = 100;
+  const int kDurationSeconds = AllowSlowTests() ? 30 : 5;
+  const IntentTypeSet kWeakIntents({IntentType::kWeakRead, IntentType::kWeakWrite});
+  const IntentTypeSet kStrongIntents({IntentType::kStrongRead, IntentType::kStrongWrite});
+  const RefCntPrefix kCommonPrefix("table"s);
+
+  TestThreadHolder thread_holder;
+  std::atomic<size_t> num_batches{0};
+  for (int thread_idx = 0; thread_idx != kThreads; ++thread_idx) {
+    thread_holder.AddThreadFunctor(
+        [this, thread_idx, &kWeakIntents, &kStrongIntents, &kCommonPrefix, &num_batches,
+         &stop = thread_holder.stop_flag()] {
+      std::vector<RefCntPrefix> rows, columns;
+      for (int i = 0; i != kRowsPerThread; ++i) {
+        rows.emplace_back(Format("row_$0_$1", thread_idx, i));
+        columns.emplace_back(Format("row_$0_$1_column", thread_idx, i));
+      }
+      size_t batches = 0;
+      while (!stop.load(std::memory_order_acquire)) {
+        const auto row_idx = batches % kRowsPerThread;
+        LockBatch lb(&lm_, {
+            {kCommonPrefix, kWeakIntents},
+            {rows[row_idx], kWeakIntents},
+            {columns[row_idx], kStrongIntents}},
+            CoarseTimePoint::max());
+        ASSERT_OK(lb.status());
+        ++batches;
+      }
+      num_batches.fetch_add(batches, std::memory_order_acq_rel);
+    });
+  }
+
+  thread_holder.WaitAndStop(kDurationSeconds * 1s);
+  const auto total_batches = num_batches.load(std::memory_order_acquire);
+  LOG(INFO) << "Locked " << total_batches << " batches using " << kThreads << " threads in "
+            << kDurationSeconds << "s, " << total_batches / kDurationSeconds
+            << " batches per second";
+  ASSERT_GT(total_batches, 0);
+}
+
 TEST_F(SharedLockManagerTest, LockConflicts) {
   rpc::ThreadPool tp(rpc::ThreadPoolOptions{
     .name = "test_pool"s,
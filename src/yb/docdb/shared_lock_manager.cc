@@ -19,11 +19,14 @@
 #include <unordered_map>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <glog/logging.h>
 
 #include "yb/docdb/lock_batch.h"
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/enums.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
@@ -135,10 +138,13 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and covers this field for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the lock manager
+  // shard, that owns this entry, is locked.
   size_t ref_count = 0;
 
+  // Index of the lock manager shard that owns this entry.
+  size_t shard_idx = 0;
+
   // Number of holders for each type
   std::atomic<LockState> num_holding{0};
 
@@ -162,28 +168,45 @@ class SharedLockManager::Impl {
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
+  // Lock entries are distributed between shards by key hash, so concurrent batches with
+  // different keys rarely contend on the same mutex.
+  struct Shard {
+    // Taken only for short duration, with no blocking wait. Protects all other fields.
+    std::mutex mutex;
+
+    LockEntryMap locks;
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries;
+    std::vector<LockedBatchEntry*> free_lock_entries;
+  } CACHELINE_ALIGNED;
+
+  static constexpr size_t kNumShards = 16;
+
+  // Make sure the entries exist in the shard maps and return pointers so we can access
+  // them without holding the shard locks. Returns a vector with pointers in the same order
   // as the keys in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  // Invokes action(shard, entry) for every entry of the batch, where shard is the one
+  // returned by get_shard_idx(entry). The mutex of every involved shard is taken only once.
+  template <class Entries, class GetShardIdx, class Action>
+  void ForEachEntryInShard(Entries* entries, const GetShardIdx& get_shard_idx,
+                           const Action& action);
 
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::array<Shard, kNumShards> shards_;
 };
 
 std::string SharedLockManager::ToString(const LockState& state) {
@@ -302,24 +325,62 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
   return true;
 }
 
-void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
-  for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
-    if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
-      } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+template <class Entries, class GetShardIdx, class Action>
+void SharedLockManager::Impl::ForEachEntryInShard(
+    Entries* entries, const GetShardIdx& get_shard_idx, const Action& action) {
+  static_assert(kNumShards <= 32, "Shards should fit into used_shards mask");
+  if (entries->size() == 1) {
+    auto& entry = entries->front();
+    auto& shard = shards_[get_shard_idx(entry)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    action(&shard, &entry);
+    return;
+  }
+
+  boost::container::small_vector<uint8_t, 16> entry_shards;
+  entry_shards.reserve(entries->size());
+  uint32_t used_shards = 0;
+  for (const auto& entry : *entries) {
+    const auto shard_idx = static_cast<uint8_t>(get_shard_idx(entry));
+    entry_shards.push_back(shard_idx);
+    used_shards |= 1U << shard_idx;
+  }
+  while (used_shards) {
+    const auto shard_idx = __builtin_ctz(used_shards);
+    used_shards &= used_shards - 1;
+    auto& shard = shards_[shard_idx];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (size_t i = 0; i != entry_shards.size(); ++i) {
+      if (entry_shards[i] == shard_idx) {
+        action(&shard, &(*entries)[i]);
       }
     }
-    value->ref_count++;
-    key_and_intent_type.locked = value;
   }
 }
 
+void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
+  ForEachEntryInShard(
+      key_to_intent_type,
+      [](const LockBatchEntry& entry) {
+        return RefCntPrefixHash()(entry.key) % kNumShards;
+      },
+      [this](Shard* shard, LockBatchEntry* key_and_intent_type) {
+        auto& value = shard->locks[key_and_intent_type->key];
+        if (!value) {
+          if (!shard->free_lock_entries.empty()) {
+            value = shard->free_lock_entries.back();
+            shard->free_lock_entries.pop_back();
+          } else {
+            shard->lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+            value = shard->lock_entries.back().get();
+            value->shard_idx = shard - shards_.data();
+          }
+        }
+        value->ref_count++;
+        key_and_intent_type->locked = value;
+      });
+}
+
 void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type) {
   TRACE("Unlocking a batch of $0 keys", key_to_intent_type.size());
 
@@ -331,13 +392,17 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
-  for (const auto& item : key_to_intent_type) {
-    if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
-    }
-  }
+  ForEachEntryInShard(
+      &key_to_intent_type,
+      [](const LockBatchEntry& entry) {
+        return entry.locked->shard_idx;
+      },
+      [](Shard* shard, const LockBatchEntry* item) {
+        if (--(item->locked->ref_count) == 0) {
+          shard->locks.erase(item->key);
+          shard->free_lock_entries.push_back(item->locked);
+        }
+      });
 }
 
 SharedLockManager::SharedLockManager() : impl_(new Impl) {
@@ -17,11 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include "yb/client/meta_cache.h"
 #include "yb/client/snapshot_test_util.h"
 #include "yb/client/table.h"
 #include "yb/client/table_alterer.h"
 
 #include "yb/common/entity_ids_types.h"
+#include "yb/common/partition.h"
 #include "yb/common/ql_expr.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
@@ -894,6 +896,58 @@ TEST_F(TabletSplitITest, DifferentYBTableInstances) {
   ASSERT_EQ(rows_count, kNumRows);
 }
 
+// Checks that lookups by key served from the meta cache snapshot do not return the split tablet
+// after the table partitions were refreshed, and that the snapshot is rebuilt with child tablets.
+TEST_F(TabletSplitITest, LockFreeLookupAfterSplit) {
+  constexpr auto kNumRows = kDefaultNumRows;
+
+  CreateSingleTablet();
+
+  const auto split_hash_code = ASSERT_RESULT(WriteRowsAndGetMiddleHashCode(kNumRows));
+  const auto table = table_.table();
+  const auto lookup = [this, &table](const PartitionKey& partition_key) {
+    return client_->LookupTabletByKeyFuture(
+        table, partition_key, CoarseMonoClock::now() + 10s * kTimeMultiplier).get();
+  };
+  const std::vector<PartitionKey> partition_keys = {
+    PartitionSchema::EncodeMultiColumnHashValue(0),
+    PartitionSchema::EncodeMultiColumnHashValue(split_hash_code - 1),
+    PartitionSchema::EncodeMultiColumnHashValue(split_hash_code),
+    PartitionSchema::EncodeMultiColumnHashValue(PartitionSchema::kMaxPartitionKey),
+  };
+
+  // Fill the cache with the tablet being split.
+  for (const auto& partition_key : partition_keys) {
+    ASSERT_OK(lookup(partition_key));
+  }
+  auto lock_free_lookups_start = client::internal::TEST_GetLockFreeLookups();
+  for (const auto& partition_key : partition_keys) {
+    ASSERT_OK(lookup(partition_key));
+  }
+  ASSERT_EQ(client::internal::TEST_GetLockFreeLookups() - lock_free_lookups_start,
+            static_cast<int64_t>(partition_keys.size()));
+
+  const auto source_tablet_id = ASSERT_RESULT(SplitTabletAndValidate(split_hash_code, kNumRows));
+  ASSERT_OK(WaitForTabletSplitCompletion(/* expected_non_split_tablets =*/ 2));
+
+  table->MarkPartitionsAsStale();
+  for (const auto& partition_key : partition_keys) {
+    auto tablet = ASSERT_RESULT(lookup(partition_key));
+    ASSERT_NE(tablet->tablet_id(), source_tablet_id);
+    ASSERT_TRUE(tablet->partition().ContainsKey(partition_key))
+        << "Key: " << Slice(partition_key).ToDebugHexString() << ", tablet: " << tablet->ToString();
+  }
+
+  // Child tablets are cached now, so lookups should be served by the rebuilt snapshot.
+  lock_free_lookups_start = client::internal::TEST_GetLockFreeLookups();
+  for (const auto& partition_key : partition_keys) {
+    auto tablet = ASSERT_RESULT(lookup(partition_key));
+    ASSERT_NE(tablet->tablet_id(), source_tablet_id);
+  }
+  ASSERT_EQ(client::internal::TEST_GetLockFreeLookups() - lock_free_lookups_start,
+            static_cast<int64_t>(partition_keys.size()));
+}
+
 TEST_F(TabletSplitITest, SplitSingleTabletLongTransactions) {
   constexpr auto kNumRows = 1000;
   constexpr auto kNumApplyLargeTxnBatches = 10;
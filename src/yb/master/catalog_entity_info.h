@@ -78,6 +78,8 @@ struct TabletReplicaDriveInfo {
   uint64 wal_files_size = 0;
   uint64 uncompressed_sst_file_size = 0;
   bool may_have_orphaned_post_split_data = true;
+  double read_ops_per_sec = 0;
+  double write_ops_per_sec = 0;
 };
 
 // Information on a current replica of a tablet.
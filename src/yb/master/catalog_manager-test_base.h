@@ -24,6 +24,7 @@
 #include "yb/master/ts_descriptor.h"
 
 #include "yb/util/atomic.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_util.h"
 
@@ -324,6 +325,20 @@ class TestLoadBalancerBase {
     gflags::SetCommandLineOption("leader_balance_threshold", "0");
     PrepareTestState(ts_descs_multi_az);
     TestLeaderBlacklist();
+
+    gflags::SetCommandLineOption("load_balancer_load_aware", "true");
+    gflags::SetCommandLineOption("load_balancer_size_weight", "1");
+    gflags::SetCommandLineOption("load_balancer_ops_weight", "0");
+    PrepareTestState(ts_descs_multi_az);
+    TestLoadAwareBalancingReplicas();
+
+    gflags::SetCommandLineOption("load_balancer_size_weight", "0");
+    gflags::SetCommandLineOption("load_balancer_ops_weight", "1");
+    PrepareTestState(ts_descs_multi_az);
+    TestLoadAwareBalancingLeaders();
+    gflags::SetCommandLineOption("load_balancer_load_aware", "false");
+    gflags::SetCommandLineOption("load_balancer_size_weight", "0.4");
+    gflags::SetCommandLineOption("load_balancer_ops_weight", "0.4");
   }
 
  protected:
@@ -949,6 +964,41 @@ class TestLoadBalancerBase {
     ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
   }
 
+  void TestLoadAwareBalancingReplicas() {
+    using namespace yb::size_literals;
+    LOG(INFO) << "Testing load aware balancing of replicas";
+    replication_info_.mutable_live_replicas()->set_num_replicas(kDefaultNumReplicas);
+    ts_descs_.push_back(SetupTS("3333", "a"));
+
+    // Tablet 1 is much larger than the others, so moving it to the new tablet server balances the
+    // size best, even though tablets led from the same zone are preferred otherwise.
+    for (size_t i = 0; i < tablets_.size(); ++i) {
+      SetTabletLoad(tablets_[i].get(), i == 1 ? 100_GB : 1_GB, /* ops_per_sec = */ 0);
+    }
+    ASSERT_OK(AnalyzeTablets());
+
+    std::string placeholder;
+    TestAddLoad(tablets_[1]->tablet_id(), placeholder, ts_descs_[3]->permanent_uuid());
+  }
+
+  void TestLoadAwareBalancingLeaders() {
+    LOG(INFO) << "Testing load aware balancing of leaders";
+    // Leader distribution is 2 1 1, that is balanced by count. But ts0 leads tablets 0 and 3 that
+    // serve most of the requests.
+    SetTabletLoad(tablets_[0].get(), /* sst_files_size = */ 0, /* ops_per_sec = */ 1000);
+    SetTabletLoad(tablets_[1].get(), /* sst_files_size = */ 0, /* ops_per_sec = */ 10);
+    SetTabletLoad(tablets_[2].get(), /* sst_files_size = */ 0, /* ops_per_sec = */ 10);
+    SetTabletLoad(tablets_[3].get(), /* sst_files_size = */ 0, /* ops_per_sec = */ 500);
+    ASSERT_OK(AnalyzeTablets());
+
+    // Moving the leader of tablet 3 balances the request rate best. After that ts0 still has the
+    // highest request rate, but moving the leader of tablet 0 would not decrease the variance.
+    std::string tablet_id, placeholder;
+    TestMoveLeader(&tablet_id, ts_descs_[0]->permanent_uuid(), placeholder);
+    ASSERT_EQ(tablet_id, tablets_[3]->tablet_id());
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+  }
+
   void TestBalancingLeadersWithThreshold() {
     LOG(INFO) << "Testing moving overloaded leaders with threshold = 2";
     // Move all leaders to ts0.
@@ -1171,6 +1221,16 @@ class TestLoadBalancerBase {
     tablet->SetReplicaLocations(replicas);
   }
 
+  void SetTabletLoad(TabletInfo* tablet, uint64_t sst_files_size, double ops_per_sec) {
+    std::shared_ptr<TabletReplicaMap> replicas =
+      std::const_pointer_cast<TabletReplicaMap>(tablet->GetReplicaLocations());
+    for (auto& replica : *replicas) {
+      replica.second.drive_info.sst_files_size = sst_files_size;
+      replica.second.drive_info.read_ops_per_sec = ops_per_sec;
+    }
+    tablet->SetReplicaLocations(replicas);
+  }
+
   void MoveTabletLeader(TabletInfo* tablet, std::shared_ptr<TSDescriptor> ts_desc) {
     std::shared_ptr<TabletReplicaMap> replicas =
       std::const_pointer_cast<TabletReplicaMap>(tablet->GetReplicaLocations());
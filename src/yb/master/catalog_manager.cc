@@ -12611,7 +12611,9 @@ void CatalogManager::ProcessTabletStorageMetadata(
         storage_metadata.sst_file_size(),
         storage_metadata.wal_file_size(),
         storage_metadata.uncompressed_sst_file_size(),
-        storage_metadata.may_have_orphaned_post_split_data()};
+        storage_metadata.may_have_orphaned_post_split_data(),
+        storage_metadata.read_ops_per_sec(),
+        storage_metadata.write_ops_per_sec()};
   tablet->UpdateReplicaDriveInfo(ts_uuid, drive_info);
 }
 
@@ -14,6 +14,7 @@
 #include "yb/master/cluster_balance.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <utility>
 
@@ -120,6 +121,19 @@ DEFINE_RUNTIME_bool(load_balancer_drive_aware, true,
 DEFINE_RUNTIME_bool(load_balancer_ignore_cloud_info_similarity, false,
     "If true, ignore the similarity between cloud infos when deciding which tablet to move");
 
+DEFINE_RUNTIME_bool(load_balancer_load_aware, false,
+    "If true, tablet replicas and leaders are balanced by their cost, that is computed from the "
+    "SST files size and the request rate of tablets reported by tablet servers, instead of their "
+    "counts. Global load balancing is not performed in this mode.");
+
+DEFINE_RUNTIME_double(load_balancer_size_weight, 0.4,
+    "Weight of the SST files size in the cost of a tablet replica, when "
+    "load_balancer_load_aware is set. The rest of the cost is the number of replicas.");
+
+DEFINE_RUNTIME_double(load_balancer_ops_weight, 0.4,
+    "Weight of the request rate in the cost of a tablet replica and a tablet leader, when "
+    "load_balancer_load_aware is set. The rest of the cost is the number of replicas or leaders.");
+
 METRIC_DEFINE_gauge_int64(cluster,
                           is_load_balancing_enabled,
                           "Is Load Balancing Enabled",
@@ -932,7 +946,8 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
     for (auto right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_load_[right];
-      ssize_t load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
+      double load_variance =
+          state_->GetBalancingLoad(high_load_uuid) - state_->GetBalancingLoad(low_load_uuid);
       bool is_global_balancing_move = false;
 
       // Check for state change or end conditions.
@@ -943,7 +958,8 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
           return false;
         }
         // If there is load variance, then there is a chance we can benefit from globally balancing.
-        if (load_variance > 0 && CanBalanceGlobalLoad()) {
+        // Global load is a number of tablets, so it is not used in load aware mode.
+        if (load_variance > 0 && !state_->load_aware_ && CanBalanceGlobalLoad()) {
           int global_load_variance = global_state_->GetGlobalLoad(high_load_uuid) -
                                      global_state_->GetGlobalLoad(low_load_uuid);
           if (global_load_variance < state_->options_->kMinGlobalLoadVarianceToBalance) {
@@ -961,7 +977,8 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
       }
 
       // If we don't find a tablet_id to move between these two TSs, advance the state.
-      if (VERIFY_RESULT(GetTabletToMove(high_load_uuid, low_load_uuid, moving_tablet_id))) {
+      if (VERIFY_RESULT(GetTabletToMove(
+              high_load_uuid, low_load_uuid, load_variance, moving_tablet_id))) {
         // If we got this far, we have the candidate we want, so fill in the output params and
         // return. The tablet_id is filled in from GetTabletToMove.
         *from_ts = high_load_uuid;
@@ -981,7 +998,8 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
 }
 
 Result<bool> ClusterLoadBalancer::GetTabletToMove(
-    const TabletServerId& from_ts, const TabletServerId& to_ts, TabletId* moving_tablet_id) {
+    const TabletServerId& from_ts, const TabletServerId& to_ts, double load_variance,
+    TabletId* moving_tablet_id) {
   const auto& from_ts_meta = state_->per_ts_meta_[from_ts];
   // If drive aware, all_tablets is sorted by decreasing drive load.
   vector<set<TabletId>> all_tablets_by_drive = GetTabletsOnTSToMove(global_state_->drive_aware_,
@@ -1002,6 +1020,12 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
         continue;
       }
 
+      // In load aware mode the move should decrease the load variance, i.e. the cost of the replica
+      // should be less than the variance.
+      if (state_->load_aware_ && state_->GetReplicaCost(tablet_id) >= load_variance) {
+        continue;
+      }
+
       if (VERIFY_RESULT(
           state_->CanAddTabletToTabletServer(tablet_id, to_ts, &GetPlacementByTablet(tablet_id)))) {
         filtered_drive_tablets.insert(tablet_id);
@@ -1017,6 +1041,8 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
     bool found_tablet_to_move = false;
     CatalogManagerUtil::CloudInfoSimilarity chosen_tablet_ci_similarity =
         CatalogManagerUtil::NO_MATCH;
+    // Remaining load variance after the move, in load aware mode.
+    double chosen_tablet_remaining_variance = 0;
     for (const TabletId& tablet_id : drive_tablets) {
       const auto& placement_info = GetPlacementByTablet(tablet_id);
       // TODO(#15853): this should be augmented as well to allow dropping by one replica, if still
@@ -1052,13 +1078,23 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
         ci_similarity = CatalogManagerUtil::ComputeCloudInfoSimilarity(leader_ci, to_ts_ci);
       }
 
-      if (found_tablet_to_move && ci_similarity <= chosen_tablet_ci_similarity) {
+      // In load aware mode, prefer the tablet that balances the pair of tablet servers best.
+      double remaining_variance = 0;
+      if (state_->load_aware_) {
+        remaining_variance = std::abs(load_variance - 2 * state_->GetReplicaCost(tablet_id));
+        if (found_tablet_to_move && remaining_variance > chosen_tablet_remaining_variance) {
+          continue;
+        }
+      }
+      if (found_tablet_to_move && remaining_variance == chosen_tablet_remaining_variance &&
+          ci_similarity <= chosen_tablet_ci_similarity) {
         continue;
       }
       // This is the best tablet to move, so far.
       found_tablet_to_move = true;
       *moving_tablet_id = tablet_id;
       chosen_tablet_ci_similarity = ci_similarity;
+      chosen_tablet_remaining_variance = remaining_variance;
     }
 
     // If there is any tablet we can move from this drive, choose it and return.
@@ -1165,8 +1201,8 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       auto high_leader_blacklisted =
           (global_state_->leader_blacklisted_servers_.find(high_load_uuid) !=
               global_state_->leader_blacklisted_servers_.end());
-      ssize_t load_variance =
-          state_->GetLeaderLoad(high_load_uuid) - state_->GetLeaderLoad(low_load_uuid);
+      double load_variance = state_->GetBalancingLeaderLoad(high_load_uuid) -
+                             state_->GetBalancingLeaderLoad(low_load_uuid);
 
       bool is_global_balancing_move = false;
 
@@ -1182,7 +1218,7 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
         }
         // Check if we can benefit from global leader balancing.
         // If we have > 0 load_variance and there are no per table moves left.
-        if (load_variance > 0 && CanBalanceGlobalLoad()) {
+        if (load_variance > 0 && !state_->load_aware_ && CanBalanceGlobalLoad()) {
           int global_load_variance = state_->global_state_->GetGlobalLeaderLoad(high_load_uuid) -
                                         state_->global_state_->GetGlobalLeaderLoad(low_load_uuid);
           // Already globally balanced. Since we are sorted by global load, we can return here as
@@ -1199,9 +1235,22 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       // Find the leaders on the higher loaded TS that have running peers on the lower loaded TS.
       // If there are, we have a candidate we want, so fill in the output params and return.
       const set<TabletId>& leaders = state_->per_ts_meta_[high_load_uuid].leaders;
-      for (const auto& tablet : GetLeadersOnTSToMove(global_state_->drive_aware_,
-                                                     leaders,
-                                                     state_->per_ts_meta_[low_load_uuid])) {
+      auto leaders_to_move = GetLeadersOnTSToMove(
+          global_state_->drive_aware_, leaders, state_->per_ts_meta_[low_load_uuid]);
+      if (state_->load_aware_ && !high_leader_blacklisted) {
+        // Only consider leaders whose move decreases the load variance, starting with the one
+        // that balances the pair of tablet servers best.
+        std::erase_if(leaders_to_move, [this, load_variance](const auto& tablet) {
+          return state_->GetLeaderCost(tablet.first) >= load_variance;
+        });
+        std::stable_sort(
+            leaders_to_move.begin(), leaders_to_move.end(),
+            [this, load_variance](const auto& lhs, const auto& rhs) {
+              return std::abs(load_variance - 2 * state_->GetLeaderCost(lhs.first)) <
+                     std::abs(load_variance - 2 * state_->GetLeaderCost(rhs.first));
+            });
+      }
+      for (const auto& tablet : leaders_to_move) {
         *moving_tablet_id = tablet.first;
         *to_ts_path = tablet.second;
         *from_ts = high_load_uuid;
@@ -282,8 +282,10 @@ class ClusterLoadBalancer {
       TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts)
       REQUIRES_SHARED(catalog_manager_->mutex_);
 
+  // Picks a tablet to move from from_ts to to_ts, whose balancing loads differ by load_variance.
   Result<bool> GetTabletToMove(
-      const TabletServerId& from_ts, const TabletServerId& to_ts, TabletId* moving_tablet_id)
+      const TabletServerId& from_ts, const TabletServerId& to_ts, double load_variance,
+      TabletId* moving_tablet_id)
       REQUIRES_SHARED(catalog_manager_->mutex_);
 
   // Issue the change config and modify the in-memory state for moving a replica from one tablet
@@ -33,6 +33,12 @@ DECLARE_int32(replication_factor);
 
 DECLARE_bool(allow_leader_balancing_dead_node);
 
+DECLARE_bool(load_balancer_load_aware);
+
+DECLARE_double(load_balancer_size_weight);
+
+DECLARE_double(load_balancer_ops_weight);
+
 namespace yb {
 namespace master {
 
@@ -55,6 +61,34 @@ std::string CBTabletMetadata::ToString() const {
       leader_uuid, leader_stepdown_failures, leader_blacklisted_tablet_servers);
 }
 
+CBTabletLoad& CBTabletLoad::operator+=(const CBTabletLoad& rhs) {
+  sst_files_size += rhs.sst_files_size;
+  read_ops_per_sec += rhs.read_ops_per_sec;
+  write_ops_per_sec += rhs.write_ops_per_sec;
+  return *this;
+}
+
+CBTabletLoad& CBTabletLoad::operator-=(const CBTabletLoad& rhs) {
+  sst_files_size -= rhs.sst_files_size;
+  read_ops_per_sec -= rhs.read_ops_per_sec;
+  write_ops_per_sec -= rhs.write_ops_per_sec;
+  return *this;
+}
+
+std::string CBTabletLoad::ToString() const {
+  return YB_STRUCT_TO_STRING(sst_files_size, read_ops_per_sec, write_ops_per_sec);
+}
+
+namespace {
+
+// Returns value in units of the average value per tablet. Dimension that was not reported by
+// any tablet is measured by the number of tablets instead.
+double NormalizedCost(double value, double total, size_t num_tablets, size_t count) {
+  return total > 0 ? value * num_tablets / total : count;
+}
+
+} // namespace
+
 int GlobalLoadState::GetGlobalLoad(const TabletServerId& ts_uuid) const {
   const auto& ts_meta = per_ts_global_meta_.at(ts_uuid);
   return ts_meta.starting_tablets_count + ts_meta.running_tablets_count;
@@ -68,7 +102,8 @@ int GlobalLoadState::GetGlobalLeaderLoad(const TabletServerId& ts_uuid) const {
 PerTableLoadState::PerTableLoadState(GlobalLoadState* global_state)
     : leader_balance_threshold_(FLAGS_leader_balance_threshold),
       current_time_(MonoTime::Now()),
-      global_state_(global_state) {}
+      global_state_(global_state),
+      load_aware_(FLAGS_load_balancer_load_aware) {}
 
 PerTableLoadState::~PerTableLoadState() {}
 
@@ -85,6 +120,14 @@ bool PerTableLoadState::LeaderLoadComparator::operator()(
     return !a_leader_blacklisted;
   }
 
+  if (state_->load_aware_) {
+    auto a_cost = state_->GetBalancingLeaderLoad(a);
+    auto b_cost = state_->GetBalancingLeaderLoad(b);
+    if (a_cost != b_cost) {
+      return a_cost < b_cost;
+    }
+  }
+
   // Use global leader load as tie-breaker.
   auto a_load = state_->GetLeaderLoad(a);
   auto b_load = state_->GetLeaderLoad(b);
@@ -100,6 +143,13 @@ bool PerTableLoadState::LeaderLoadComparator::operator()(
 }
 
 bool PerTableLoadState::CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
+  if (load_aware_) {
+    auto cost_a = GetBalancingLoad(a);
+    auto cost_b = GetBalancingLoad(b);
+    if (cost_a != cost_b) {
+      return cost_a < cost_b;
+    }
+  }
   auto load_a = GetLoad(a);
   auto load_b = GetLoad(b);
   if (load_a == load_b) {
@@ -122,6 +172,57 @@ size_t PerTableLoadState::GetLeaderLoad(const TabletServerId& ts_uuid) const {
   return per_ts_meta_.at(ts_uuid).leaders.size();
 }
 
+double PerTableLoadState::ReplicaCost(size_t num_replicas, const CBTabletLoad& load) const {
+  // Every replica stores the data and applies the writes.
+  const double size_weight = FLAGS_load_balancer_size_weight;
+  const double ops_weight = FLAGS_load_balancer_ops_weight;
+  const auto num_tablets = num_tablets_with_load_;
+  return std::max(1.0 - size_weight - ops_weight, 0.0) * num_replicas +
+         size_weight * NormalizedCost(
+             load.sst_files_size, total_tablets_load_.sst_files_size, num_tablets, num_replicas) +
+         ops_weight * NormalizedCost(
+             load.write_ops_per_sec, total_tablets_load_.write_ops_per_sec, num_tablets,
+             num_replicas);
+}
+
+double PerTableLoadState::LeaderCost(size_t num_leaders, const CBTabletLoad& load) const {
+  // Leader serves the reads and replicates the writes.
+  const double ops_weight = std::min<double>(FLAGS_load_balancer_ops_weight, 1.0);
+  return (1.0 - ops_weight) * num_leaders +
+         ops_weight * NormalizedCost(
+             load.read_ops_per_sec + load.write_ops_per_sec,
+             total_tablets_load_.read_ops_per_sec + total_tablets_load_.write_ops_per_sec,
+             num_tablets_with_load_, num_leaders);
+}
+
+double PerTableLoadState::GetBalancingLoad(const TabletServerId& ts_uuid) const {
+  if (!load_aware_) {
+    return GetLoad(ts_uuid);
+  }
+  return ReplicaCost(GetLoad(ts_uuid), per_ts_meta_.at(ts_uuid).replicas_load);
+}
+
+double PerTableLoadState::GetBalancingLeaderLoad(const TabletServerId& ts_uuid) const {
+  if (!load_aware_) {
+    return GetLeaderLoad(ts_uuid);
+  }
+  return LeaderCost(GetLeaderLoad(ts_uuid), per_ts_meta_.at(ts_uuid).leaders_load);
+}
+
+double PerTableLoadState::GetReplicaCost(const TabletId& tablet_id) const {
+  if (!load_aware_) {
+    return 1;
+  }
+  return ReplicaCost(1, per_tablet_meta_.at(tablet_id).load);
+}
+
+double PerTableLoadState::GetLeaderCost(const TabletId& tablet_id) const {
+  if (!load_aware_) {
+    return 1;
+  }
+  return LeaderCost(1, per_tablet_meta_.at(tablet_id).load);
+}
+
 bool PerTableLoadState::ShouldSkipReplica(const TabletReplica& replica) {
   bool is_replica_live = IsTsInLivePlacement(replica.ts_desc);
   // Ignore read replica when balancing live nodes.
@@ -167,6 +268,20 @@ Status PerTableLoadState::UpdateTablet(TabletInfo *tablet) {
   // Get the size of replica.
   size_t replica_size = GetReplicaSize(replica_map);
 
+  // Resource usage should be known before replicas are added to tablet servers.
+  for (const auto& [ts_uuid, replica] : *replica_map) {
+    if (ShouldSkipReplica(replica)) {
+      continue;
+    }
+    auto& load = tablet_meta.load;
+    load.sst_files_size = std::max<double>(load.sst_files_size, replica.drive_info.sst_files_size);
+    load.read_ops_per_sec = std::max(load.read_ops_per_sec, replica.drive_info.read_ops_per_sec);
+    load.write_ops_per_sec = std::max(
+        load.write_ops_per_sec, replica.drive_info.write_ops_per_sec);
+  }
+  total_tablets_load_ += tablet_meta.load;
+  ++num_tablets_with_load_;
+
   // Set state information for both the tablet and the tablet server replicas.
   for (const auto& replica_it : *replica_map) {
     const auto& ts_uuid = replica_it.first;
@@ -761,7 +876,9 @@ Status PerTableLoadState::AddRunningTablet(const TabletId& tablet_id,
   if (ret.second) {
     ++global_state_->per_ts_global_meta_[ts_uuid].running_tablets_count;
     ++total_running_;
-    ++per_tablet_meta_[tablet_id].running;
+    auto& tablet_meta = per_tablet_meta_[tablet_id];
+    ++tablet_meta.running;
+    meta_ts.replicas_load += tablet_meta.load;
   }
   meta_ts.path_to_tablets[path].insert(tablet_id);
   return Status::OK();
@@ -781,7 +898,9 @@ Status PerTableLoadState::RemoveRunningTablet(
   }
   global_state_->per_ts_global_meta_[ts_uuid].running_tablets_count -= num_erased;
   total_running_ -= num_erased;
-  per_tablet_meta_[tablet_id].running -= num_erased;
+  auto& tablet_meta = per_tablet_meta_[tablet_id];
+  tablet_meta.running -= num_erased;
+  meta_ts.replicas_load -= tablet_meta.load;
   bool found = false;
   for (auto &path : meta_ts.path_to_tablets) {
     if (path.second.erase(tablet_id) == 0) {
@@ -797,12 +916,15 @@ Status PerTableLoadState::AddStartingTablet(
     const TabletId& tablet_id, const TabletServerId& ts_uuid) {
   SCHECK(per_ts_meta_.find(ts_uuid) != per_ts_meta_.end(), IllegalState,
           Format(uninitialized_ts_meta_format_msg, ts_uuid, table_id_));
-  auto ret = per_ts_meta_.at(ts_uuid).starting_tablets.insert(tablet_id);
+  auto& meta_ts = per_ts_meta_.at(ts_uuid);
+  auto ret = meta_ts.starting_tablets.insert(tablet_id);
   if (ret.second) {
     ++global_state_->per_ts_global_meta_[ts_uuid].starting_tablets_count;
     ++total_starting_;
     ++global_state_->total_starting_tablets_;
-    ++per_tablet_meta_[tablet_id].starting;
+    auto& tablet_meta = per_tablet_meta_[tablet_id];
+    ++tablet_meta.starting;
+    meta_ts.replicas_load += tablet_meta.load;
     // If the tablet wasn't over replicated before the add, it's over replicated now.
     if (tablets_missing_replicas_.count(tablet_id) == 0) {
       tablets_over_replicated_.insert(tablet_id);
@@ -821,6 +943,7 @@ Status PerTableLoadState::AddLeaderTablet(
   auto ret = meta_ts.leaders.insert(tablet_id);
   if (ret.second) {
     ++global_state_->per_ts_global_meta_[ts_uuid].leaders_count;
+    meta_ts.leaders_load += per_tablet_meta_[tablet_id].load;
   }
   meta_ts.path_to_leaders[ts_path].insert(tablet_id);
   return Status::OK();
@@ -830,8 +953,12 @@ Status PerTableLoadState::RemoveLeaderTablet(
     const TabletId& tablet_id, const TabletServerId& ts_uuid) {
   SCHECK(per_ts_meta_.find(ts_uuid) != per_ts_meta_.end(), IllegalState,
           Format(uninitialized_ts_meta_format_msg, ts_uuid, table_id_));
-  auto num_erased = per_ts_meta_.at(ts_uuid).leaders.erase(tablet_id);
+  auto& meta_ts = per_ts_meta_.at(ts_uuid);
+  auto num_erased = meta_ts.leaders.erase(tablet_id);
   global_state_->per_ts_global_meta_[ts_uuid].leaders_count -= num_erased;
+  if (num_erased) {
+    meta_ts.leaders_load -= per_tablet_meta_[tablet_id].load;
+  }
   return Status::OK();
 }
 
@@ -50,6 +50,19 @@ enum ReplicaType {
   READ_ONLY,
 };
 
+// Resource usage of tablet replicas, as reported by tablet servers. Used to balance the cost of
+// replicas and leaders instead of their counts, when load_balancer_load_aware is set.
+struct CBTabletLoad {
+  double sst_files_size = 0;
+  double read_ops_per_sec = 0;
+  double write_ops_per_sec = 0;
+
+  CBTabletLoad& operator+=(const CBTabletLoad& rhs);
+  CBTabletLoad& operator-=(const CBTabletLoad& rhs);
+
+  std::string ToString() const;
+};
+
 struct CBTabletMetadata {
   bool is_missing_replicas() { return is_under_replicated || !under_replicated_placements.empty(); }
 
@@ -107,6 +120,9 @@ struct CBTabletMetadata {
   // Leader stepdown failures. We use this to prevent retrying the same leader stepdown too soon.
   LeaderStepDownFailureTimes leader_stepdown_failures;
 
+  // Max resource usage reported by replicas of this tablet.
+  CBTabletLoad load;
+
   std::string ToString() const;
 };
 
@@ -145,6 +161,12 @@ struct CBTabletServerMetadata {
 
   // The set of tablet ids that this tablet server disabled (ex. after split).
   std::set<TabletId> disabled_by_ts_tablets;
+
+  // Total resource usage of running and starting tablets on this tablet server.
+  CBTabletLoad replicas_load;
+
+  // Total resource usage of tablet leaders on this tablet server.
+  CBTabletLoad leaders_load;
 };
 
 struct CBTabletServerLoadCounts {
@@ -286,6 +308,17 @@ class PerTableLoadState {
   // Get the load for a certain TS.
   size_t GetLeaderLoad(const TabletServerId& ts_uuid) const;
 
+  // Get the load that replicas are balanced by. It is the number of replicas, or the weighted
+  // cost of replicas in load aware mode. The cost of the average tablet of the table is 1.
+  double GetBalancingLoad(const TabletServerId& ts_uuid) const;
+
+  // Get the load that leaders are balanced by, see GetBalancingLoad.
+  double GetBalancingLeaderLoad(const TabletServerId& ts_uuid) const;
+
+  // Cost of a single replica or leader of the tablet, in the units of GetBalancingLoad.
+  double GetReplicaCost(const TabletId& tablet_id) const;
+  double GetLeaderCost(const TabletId& tablet_id) const;
+
   bool IsTsInLivePlacement(TSDescriptor* ts_desc) {
     return ts_desc->placement_uuid() == options_->live_placement_uuid;
   }
@@ -433,11 +466,23 @@ class PerTableLoadState {
   // Allow only leader balancing for this table.
   bool allow_only_leader_balancing_ = false;
 
+  // Whether replicas and leaders are balanced by their weighted cost instead of their counts.
+  bool load_aware_ = false;
+
+  // Total resource usage of all tablets of the table and their number.
+  CBTabletLoad total_tablets_load_;
+  size_t num_tablets_with_load_ = 0;
+
   // List of availability zones for affinitized leaders.
   std::vector<AffinitizedZonesSet> affinitized_zones_;
 
  private:
   bool ShouldSkipReplica(const TabletReplica& replica);
+
+  // Returns cost of num_replicas replicas, whose total resource usage is load.
+  double ReplicaCost(size_t num_replicas, const CBTabletLoad& load) const;
+  double LeaderCost(size_t num_leaders, const CBTabletLoad& load) const;
+
   size_t GetReplicaSize(std::shared_ptr<const TabletReplicaMap> replica_map);
   const std::string uninitialized_ts_meta_format_msg =
       "Found uninitialized ts_meta: ts_uuid: $0, table_uuid: $1";
@@ -307,7 +307,8 @@ Status Master::RegisterServices() {
                                                      std::move(master_tablet_service)));
 
   std::unique_ptr<ServiceIf> consensus_service(
-      new ConsensusServiceImpl(metric_entity(), catalog_manager_.get()));
+      new ConsensusServiceImpl(metric_entity(), catalog_manager_.get(),
+                               &messenger()->ThreadPool(rpc::ServicePriority::kHigh)));
   RETURN_NOT_OK(RpcAndWebServerBase::RegisterService(FLAGS_master_consensus_svc_queue_length,
                                                      std::move(consensus_service),
                                                      rpc::ServicePriority::kHigh));
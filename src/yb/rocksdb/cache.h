@@ -66,6 +66,12 @@ extern std::shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern std::shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new cache with CLOCK eviction policy, sharded the same way as LRU cache.
+// Lookups do not take any locks, so it scales better than LRU cache when many threads read hot
+// entries concurrently. It does not distinguish single touch and multi touch entries.
+extern std::shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                            bool strict_capacity_limit = false);
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
@@ -214,4 +214,11 @@ extern const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
 extern const FilterPolicy* NewFixedSizeFilterPolicy(size_t total_bits,
                                                     double error_rate,
                                                     Logger* logger);
+
+// Same as NewFixedSizeFilterPolicy, but every key is mapped to a single 512-bit line with one bit
+// per 64-bit word, so a probe touches exactly one cache line and does not branch on data.
+// Uses slightly more bits per key than classic Bloom filter for the same error rate.
+extern const FilterPolicy* NewFixedSizeBlockedBloomFilterPolicy(size_t total_bits,
+                                                                double error_rate,
+                                                                Logger* logger);
 }  // namespace rocksdb
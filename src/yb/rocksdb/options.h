@@ -167,9 +167,21 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximum size of the dictionary built for data blocks of the SST file. The dictionary is
+  // stored in the SST file meta block and used to compress all its data blocks.
+  // Supported by kZlibCompression and kLZ4Compression, 0 disables dictionary compression.
+  uint32_t max_dict_bytes;
+  // Amount of data block contents buffered while building the SST file to sample the dictionary.
+  // Data blocks are written only after the dictionary is built, so this memory is used by every
+  // table builder. 0 means 100 * max_dict_bytes.
+  uint32_t max_dict_buffer_bytes;
+
+  CompressionOptions()
+      : window_bits(-14), level(-1), strategy(0), max_dict_bytes(0), max_dict_buffer_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0,
+                     uint32_t _max_dict_buffer_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes),
+        max_dict_buffer_bytes(_max_dict_buffer_bytes) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -215,6 +215,12 @@ enum Tickers : uint32_t {
   COMPACTION_FILES_FILTERED,
   COMPACTION_FILES_NOT_FILTERED,
 
+  // Data blocks read ahead by iterators during sequential scans. Bytes read ahead are counted as
+  // used when a block is served from the readahead buffer, the rest is counted as wasted.
+  READAHEAD_BYTES_READ,
+  READAHEAD_BYTES_USED,
+  READAHEAD_BYTES_WASTED,
+
   // End of ticker enum.
   TICKER_ENUM_MAX,
 };
@@ -318,6 +324,10 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
 
     {COMPACTION_FILES_FILTERED, "rocksdb_compaction_files_filtered"},
     {COMPACTION_FILES_NOT_FILTERED, "rocksdb_compaction_files_not_filtered"},
+
+    {READAHEAD_BYTES_READ, "rocksdb_readahead_bytes_read"},
+    {READAHEAD_BYTES_USED, "rocksdb_readahead_bytes_used"},
+    {READAHEAD_BYTES_WASTED, "rocksdb_readahead_bytes_wasted"},
 };
 
 /**
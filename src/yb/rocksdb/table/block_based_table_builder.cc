@@ -110,7 +110,8 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
-                    std::string* compressed_output) {
+                    std::string* compressed_output,
+                    const CompressionDict* dict = nullptr) {
   if (*type == kNoCompression) {
     return raw;
   }
@@ -129,7 +130,7 @@ Slice CompressBlock(const Slice& raw,
       if (Zlib_Compress(
               compression_options,
               GetCompressFormatForVersion(kZlibCompression, format_version),
-              raw.cdata(), raw.size(), compressed_output) &&
+              raw.cdata(), raw.size(), compressed_output, dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -147,7 +148,7 @@ Slice CompressBlock(const Slice& raw,
       if (LZ4_Compress(
               compression_options,
               GetCompressFormatForVersion(kLZ4Compression, format_version),
-              raw.cdata(), raw.size(), compressed_output) &&
+              raw.cdata(), raw.size(), compressed_output, dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -305,6 +306,21 @@ struct BlockBasedTableBuilder::Rep {
 
   yb::MemTrackerPtr mem_tracker;
 
+  // Dictionary compression state. While buffer_data_blocks is true, finished data blocks are kept
+  // in buffered_data until enough data is collected to build the dictionary. After that buffered
+  // blocks are written and buffering is turned off.
+  struct BufferedDataBlock {
+    size_t end;  // End offset of the block contents in buffered_data.
+    std::string last_key;
+    std::string next_block_first_key;
+  };
+  bool buffer_data_blocks = false;
+  size_t dict_buffer_bytes = 0;
+  std::string buffered_data;
+  std::vector<BufferedDataBlock> buffered_data_blocks;
+  yb::ScopedTrackedConsumption buffered_data_consumption;
+  std::unique_ptr<CompressionDict> compression_dict;
+
   bool TEST_skip_writing_key_value_encoding_format_ = false;
 
   Rep(const ImmutableCFOptions& _ioptions,
@@ -386,6 +402,20 @@ BlockBasedTableBuilder::Rep::Rep(
         "BlockBasedTableBuilder", _ioptions.mem_tracker);
   }
 
+  // Block based filter and hash index expect data blocks to be written as soon as they are
+  // finished, so dictionary compression is not used with them.
+  if (compression_opts.max_dict_bytes > 0 && CompressionDictSupported(compression_type) &&
+      CompressionTypeSupported(compression_type) &&
+      (filter_block_builder == nullptr || filter_type != FilterType::kBlockBasedFilter) &&
+      table_options.index_type != IndexType::kHashSearch) {
+    buffer_data_blocks = true;
+    dict_buffer_bytes = compression_opts.max_dict_buffer_bytes > 0
+        ? compression_opts.max_dict_buffer_bytes : 100ULL * compression_opts.max_dict_bytes;
+    if (mem_tracker) {
+      buffered_data_consumption = yb::ScopedTrackedConsumption(mem_tracker, 0);
+    }
+  }
+
   metadata_writer = std::make_shared<FileWriterWithOffsetAndCachePrefix>();
   metadata_writer->writer = metadata_file;
   if (data_file != nullptr) {
@@ -498,12 +528,58 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   Rep* const r = rep_;
   assert(!r->closed);
   if (!ok()) return;
-  size_t data_block_size = 0;
 
-  if (!r->data_block_builder.empty()) {
-    data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+  if (r->buffer_data_blocks) {
+    const auto block_contents = r->data_block_builder.Finish();
+    r->buffered_data.append(block_contents.cdata(), block_contents.size());
+    r->buffered_data_blocks.push_back(Rep::BufferedDataBlock {
+      .end = r->buffered_data.size(),
+      .last_key = r->last_key,
+      .next_block_first_key = next_block_first_key.ToBuffer(),
+    });
+    r->data_block_builder.Reset();
+    if (r->buffered_data_consumption) {
+      r->buffered_data_consumption.Reset(r->buffered_data.capacity());
+    }
+    if (r->buffered_data.size() >= r->dict_buffer_bytes) {
+      WriteBufferedDataBlocks();
+    }
+    return;
   }
+
+  WriteDataBlock(r->data_block_builder.Finish(), &r->last_key, next_block_first_key);
+  r->data_block_builder.Reset();
+}
+
+void BlockBasedTableBuilder::WriteBufferedDataBlocks() {
+  Rep* const r = rep_;
+  r->buffer_data_blocks = false;
+
+  auto dict = BuildCompressionDictionary(r->buffered_data, r->compression_opts.max_dict_bytes);
+  if (!dict.empty()) {
+    r->compression_dict = std::make_unique<CompressionDict>(std::move(dict));
+  }
+
+  size_t begin = 0;
+  for (auto& block : r->buffered_data_blocks) {
+    WriteDataBlock(
+        Slice(r->buffered_data.data() + begin, r->buffered_data.data() + block.end),
+        &block.last_key, block.next_block_first_key);
+    if (!ok()) break;
+    begin = block.end;
+  }
+
+  r->buffered_data_blocks = {};
+  r->buffered_data = {};
+  r->buffered_data_consumption = yb::ScopedTrackedConsumption();
+}
+
+void BlockBasedTableBuilder::WriteDataBlock(
+    const Slice& raw_block_contents, std::string* last_key, const Slice& next_block_first_key) {
+  Rep* const r = rep_;
+  const size_t data_block_size = WriteBlock(
+      raw_block_contents, &r->data_pending_handle, r->data_writer.get(),
+      r->compression_dict.get());
   if (!ok()) return;
 
   if (!r->table_options.skip_table_builder_flush) {
@@ -526,7 +602,7 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   // "the r" as the key for the index block entry since it is >= all
   // entries in the first block and < all entries in subsequent
   // blocks.
-  r->data_index_builder->AddIndexEntry(&r->last_key,
+  r->data_index_builder->AddIndexEntry(last_key,
       next_block_first_key.empty() ? nullptr : &next_block_first_key,
       r->data_pending_handle);
   while (r->data_index_builder->ShouldFlush()) {
@@ -583,7 +659,8 @@ size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
     BlockHandle* handle,
-    FileWriterWithOffsetAndCachePrefix* writer_info) {
+    FileWriterWithOffsetAndCachePrefix* writer_info,
+    const CompressionDict* dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -596,7 +673,7 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, &r->compressed_output, dict);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -717,6 +794,11 @@ Status BlockBasedTableBuilder::Finish() {
   if (!r->data_block_builder.empty()) {
     FlushDataBlock(end_slice);  // no more data block
   }
+  if (r->buffer_data_blocks && ok()) {
+    // Not enough data was collected to reach the buffer limit, so build dictionary using
+    // all data of the file.
+    WriteBufferedDataBlocks();
+  }
   if (r->filter_block_builder != nullptr) {
     FlushFilterBlock(nullptr);  // no more filter block
   }
@@ -743,6 +825,13 @@ Status BlockBasedTableBuilder::Finish() {
     meta_index_builder.Add(item.first, block_handle);
   }
 
+  if (ok() && r->compression_dict) {
+    BlockHandle compression_dict_block_handle;
+    WriteRawBlock(r->compression_dict->data(), kNoCompression, &compression_dict_block_handle,
+                  r->metadata_writer.get());
+    meta_index_builder.Add(kCompressionDictBlock, compression_dict_block_handle);
+  }
+
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
       // Add mapping from "<filter_block_prefix>.Name" to location of either filter block or
@@ -865,8 +954,10 @@ uint64_t BlockBasedTableBuilder::NumEntries() const {
 }
 
 uint64_t BlockBasedTableBuilder::TotalFileSize() const {
-  return rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
-      rep_->metadata_writer->offset;
+  // Buffered data blocks are accounted, so output files are still split at the expected size
+  // while data for the dictionary is being collected.
+  return (rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
+      rep_->metadata_writer->offset) + rep_->buffered_data.size();
 }
 
 uint64_t BlockBasedTableBuilder::BaseFileSize() const {
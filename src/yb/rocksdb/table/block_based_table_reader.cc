@@ -23,6 +23,7 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -55,6 +56,7 @@
 #include "yb/rocksdb/table/two_level_iterator.h"
 #include "yb/rocksdb/table_properties.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/statistics.h"
@@ -62,13 +64,28 @@
 
 #include "yb/util/atomic.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stats/perf_step_timer.h"
 #include "yb/util/status_format.h"
 #include "yb/util/string_util.h"
 
+using namespace yb::size_literals;
+
+DEFINE_RUNTIME_int32(rocksdb_iterator_readahead_min_sequential_blocks, 2,
+    "Number of consecutive data blocks of an SST file that should be accessed by an iterator "
+    "before it starts to read ahead. 0 to disable iterator readahead.");
+
+DEFINE_RUNTIME_uint64(rocksdb_iterator_initial_readahead_size, 64_KB,
+    "Initial size of the data read ahead by an iterator, when sequential access is detected.");
+
+DEFINE_RUNTIME_uint64(rocksdb_iterator_max_readahead_size, 512_KB,
+    "Max size of the data read ahead by an iterator. Readahead size is doubled while access "
+    "stays sequential.");
+
 namespace rocksdb {
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -80,6 +97,9 @@ typedef FilterPolicy::FilterType FilterType;
 
 namespace {
 
+// Max number of data blocks read by a single batched read during prefetch.
+constexpr size_t kPrefetchBatchSize = 32;
+
 // Delete the resource that is held by the iterator.
 template <class ResourceType>
 void DeleteHeldResource(void* arg, void* ignored) {
@@ -243,11 +263,123 @@ struct BlockBasedTable::Rep {
 
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
+
+  // Dictionary used to compress data blocks of this table, null if dictionary is not used.
+  std::unique_ptr<UncompressionDict> compression_dict;
+  // Accounts memory used by compression_dict, since it lives as long as the table reader.
+  std::unique_ptr<yb::ScopedTrackedConsumption> compression_dict_consumption;
+};
+
+// Detects sequential access to data blocks by a single iterator and reads the following part of
+// the file with a single read, so the next blocks are served from memory. The readahead window is
+// doubled after every readahead while the access stays sequential, and is halved on random access.
+// Readahead buffer is accounted in the block based table mem tracker, when specified.
+class DataBlockReadahead {
+ public:
+  DataBlockReadahead(Statistics* statistics, const yb::MemTrackerPtr& mem_tracker)
+      : statistics_(statistics),
+        window_size_(FLAGS_rocksdb_iterator_initial_readahead_size) {
+    if (mem_tracker) {
+      buffer_consumption_ = yb::ScopedTrackedConsumption(mem_tracker, 0);
+    }
+  }
+
+  ~DataBlockReadahead() {
+    ReleaseBuffer();
+  }
+
+  // Should be called on every access to the data block, including block cache hits.
+  void BlockAccessed(const BlockHandle& handle) {
+    if (handle.offset() == next_block_offset_) {
+      ++num_sequential_blocks_;
+    } else {
+      num_sequential_blocks_ = 0;
+      window_size_ = std::max<size_t>(
+          window_size_ / 2, FLAGS_rocksdb_iterator_initial_readahead_size);
+    }
+    next_block_offset_ = handle.offset() + handle.size() + kBlockTrailerSize;
+  }
+
+  // Returns block with trailer from the readahead buffer, reading the following part of the file
+  // ahead when access is sequential. Returns empty slice when block should be read regularly.
+  Slice Read(RandomAccessFileReader* file, const BlockHandle& handle) {
+    const size_t read_size = static_cast<size_t>(handle.size()) + kBlockTrailerSize;
+    if (handle.offset() >= buffer_offset_ &&
+        handle.offset() + read_size <= buffer_offset_ + buffer_data_.size()) {
+      buffer_used_ += read_size;
+      return Slice(buffer_data_.data() + (handle.offset() - buffer_offset_), read_size);
+    }
+
+    const auto min_sequential_blocks = FLAGS_rocksdb_iterator_readahead_min_sequential_blocks;
+    if (min_sequential_blocks <= 0 || num_sequential_blocks_ < min_sequential_blocks) {
+      return Slice();
+    }
+
+    ReleaseBuffer();
+    const size_t readahead_size = std::max(window_size_, read_size);
+    if (buffer_capacity_ < readahead_size) {
+      buffer_.reset(new char[readahead_size]);
+      buffer_capacity_ = readahead_size;
+      if (buffer_consumption_) {
+        buffer_consumption_.Reset(readahead_size);
+      }
+    }
+    Status status;
+    {
+      PERF_TIMER_GUARD(block_read_time);
+      status = file->Read(handle.offset(), readahead_size, &buffer_data_, buffer_.get());
+    }
+    if (!status.ok() || buffer_data_.size() < read_size) {
+      // Let the regular read report the error.
+      buffer_data_.clear();
+      return Slice();
+    }
+    PERF_COUNTER_ADD(block_read_count, 1);
+    PERF_COUNTER_ADD(block_read_byte, buffer_data_.size());
+    RecordTick(statistics_, READAHEAD_BYTES_READ, buffer_data_.size());
+
+    buffer_offset_ = handle.offset();
+    buffer_used_ = read_size;
+    window_size_ = std::min<size_t>(
+        window_size_ * 2,
+        std::max(FLAGS_rocksdb_iterator_max_readahead_size,
+                 FLAGS_rocksdb_iterator_initial_readahead_size));
+    return Slice(buffer_data_.data(), read_size);
+  }
+
+ private:
+  void ReleaseBuffer() {
+    if (buffer_data_.empty()) {
+      return;
+    }
+    // The same block could be served several times after reseek, so used bytes are capped by
+    // the amount of data read.
+    const size_t used = std::min(buffer_used_, buffer_data_.size());
+    RecordTick(statistics_, READAHEAD_BYTES_USED, used);
+    RecordTick(statistics_, READAHEAD_BYTES_WASTED, buffer_data_.size() - used);
+    buffer_data_.clear();
+  }
+
+  Statistics* const statistics_;
+
+  uint64_t next_block_offset_ = std::numeric_limits<uint64_t>::max();
+  int32_t num_sequential_blocks_ = 0;
+  size_t window_size_;
+
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_capacity_ = 0;
+  yb::ScopedTrackedConsumption buffer_consumption_;
+  // Data read ahead, could point outside of buffer_, if file is memory mapped.
+  Slice buffer_data_;
+  uint64_t buffer_offset_ = 0;
+  size_t buffer_used_ = 0;
 };
 
 // BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
 // to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
 // functions in order to check if prefix may match or to create a secondary iterator.
+// The only exception is the readahead state of data block iterators, so such state should be used
+// by a single iterator.
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -260,7 +392,13 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
-    return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
+    return table_->NewDataBlockIterator(
+        read_options_, index_value, block_type_, /* input_iter = */ nullptr, readahead_.get());
+  }
+
+  void EnableReadahead() {
+    readahead_ = std::make_unique<DataBlockReadahead>(
+        table_->rep_->ioptions.statistics, table_->rep_->mem_tracker);
   }
 
   bool PrefixMayMatch(const Slice& internal_key) override {
@@ -278,6 +416,7 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+  std::unique_ptr<DataBlockReadahead> readahead_;
 };
 
 
@@ -436,6 +575,8 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
+  RETURN_NOT_OK(new_table->ReadCompressionDictBlock(meta_iter.get()));
+
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
     // Will use block cache for data index access?
     if (table_options.cache_index_and_filter_blocks) {
@@ -576,6 +717,24 @@ Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
   return Status::OK();
 }
 
+Status BlockBasedTable::ReadCompressionDictBlock(InternalIterator* meta_iter) {
+  BlockHandle handle;
+  if (!FindMetaBlock(meta_iter, kCompressionDictBlock, &handle).ok()) {
+    // Table was written without compression dictionary.
+    return Status::OK();
+  }
+  BlockContents contents;
+  RETURN_NOT_OK(ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      handle, &contents, rep_->ioptions.env, rep_->mem_tracker, /* do_uncompress = */ false));
+  rep_->compression_dict = std::make_unique<UncompressionDict>(contents.data.ToBuffer());
+  if (rep_->mem_tracker) {
+    rep_->compression_dict_consumption = std::make_unique<yb::ScopedTrackedConsumption>(
+        rep_->mem_tracker, rep_->compression_dict->memory_usage());
+  }
+  return Status::OK();
+}
+
 Status BlockBasedTable::SetupFilter(InternalIterator* meta_iter) {
   // Find filter handle and filter type.
   if (!rep_->filter_policy) {
@@ -762,7 +921,8 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const UncompressionDict* dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -806,7 +966,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -834,7 +994,8 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const UncompressionDict* dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -843,7 +1004,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -1169,7 +1330,7 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
 
 yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock(
     const ReadOptions& ro, const Slice& index_value,
-    const BlockType block_type, const bool use_cache) {
+    const BlockType block_type, const bool use_cache, DataBlockReadahead* readahead) {
   const bool no_io = (ro.read_tier == kBlockCacheTier);
   Cache* block_cache = rep_->table_options.block_cache.get();
   Cache* block_cache_compressed = rep_->table_options.block_cache_compressed.get();
@@ -1182,6 +1343,10 @@ yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock
   // can add more features in the future.
   RETURN_NOT_OK(handle.DecodeFrom(&input));
 
+  if (readahead) {
+    readahead->BlockAccessed(handle);
+  }
+
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
 
   // If either block cache is enabled, we'll try to read from it.
@@ -1203,20 +1368,21 @@ yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock
 
     Status status = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker,
+        rep_->compression_dict.get());
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
       {
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
-        RETURN_NOT_OK(block_based_table::ReadBlockFromFile(
-            reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr));
+        RETURN_NOT_OK(ReadBlockFromFile(
+            reader, ro, handle, block_cache_compressed == nullptr, readahead, &raw_block));
       }
 
       RETURN_NOT_OK(PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                         ro, statistics, &block, raw_block.release(),
-                                        rep_->table_options.format_version, rep_->mem_tracker));
+                                        rep_->table_options.format_version, rep_->mem_tracker,
+                                        rep_->compression_dict.get()));
       status = Status::OK();
     }
 
@@ -1234,9 +1400,8 @@ yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock
   }
 
   std::unique_ptr<Block> block_value;
-  RETURN_NOT_OK(block_based_table::ReadBlockFromFile(
-      reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-      rep_->mem_tracker));
+  RETURN_NOT_OK(ReadBlockFromFile(
+      reader, ro, handle, /* do_uncompress = */ true, readahead, &block_value));
 
   block.value = block_value.release();
   RSTATUS_DCHECK(block.value, Incomplete, "No data block"); // Not expected to happen.
@@ -1244,6 +1409,30 @@ yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock
   return block;
 }
 
+Status BlockBasedTable::ReadBlockFromFile(
+    FileReaderWithCachePrefix* reader, const ReadOptions& ro, const BlockHandle& handle,
+    bool do_uncompress, DataBlockReadahead* readahead, std::unique_ptr<Block>* result) {
+  if (readahead) {
+    auto data = readahead->Read(reader->reader.get(), handle);
+    if (!data.empty()) {
+      BlockContents contents;
+      auto status = ParseBlockContents(
+          reader->reader.get(), rep_->footer, ro, handle, data, &contents, rep_->mem_tracker,
+          do_uncompress, rep_->compression_dict.get());
+      if (status.ok()) {
+        result->reset(new Block(std::move(contents)));
+        return Status::OK();
+      }
+      // Block is reread regularly, so the file could handle validation failure itself, for
+      // instance encrypted file could retry decryption.
+      VLOG(1) << "Failed to use block read ahead: " << status;
+    }
+  }
+  return block_based_table::ReadBlockFromFile(
+      reader->reader.get(), rep_->footer, ro, handle, result, rep_->ioptions.env,
+      rep_->mem_tracker, do_uncompress, rep_->compression_dict.get());
+}
+
 yb::Result<std::unique_ptr<Block>> BlockBasedTable::RetrieveBlockFromFile(const ReadOptions& ro,
     const Slice& index_value, const BlockType block_type) {
   auto block = VERIFY_RESULT(RetrieveBlock(ro, index_value, block_type, /* use_cache = */ false));
@@ -1252,10 +1441,11 @@ yb::Result<std::unique_ptr<Block>> BlockBasedTable::RetrieveBlockFromFile(const
 }
 
 InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
-    const Slice& index_value, BlockType block_type, BlockIter* input_iter) {
+    const Slice& index_value, BlockType block_type, BlockIter* input_iter,
+    DataBlockReadahead* readahead) {
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
-  auto block = RetrieveBlock(ro, index_value, block_type);
+  auto block = RetrieveBlock(ro, index_value, block_type, /* use_cache = */ true, readahead);
   if (block) {
     InternalIterator* iter = block->value->NewIterator(
         rep_->comparator.get(), GetKeyValueEncodingFormat(block_type), input_iter);
@@ -1380,6 +1570,9 @@ InternalIterator* BlockBasedTable::NewIterator(const ReadOptions& read_options,
                                                bool skip_filters) {
   auto state = std::make_unique<BlockEntryIteratorState>(
       this, read_options, skip_filters, BlockType::kData);
+  if (FLAGS_rocksdb_iterator_readahead_min_sequential_blocks > 0) {
+    state->EnableReadahead();
+  }
   // TODO: unify the semantics across NewIterator callsites, so that we can pass an arena across
   // them, and decide the free / no free based on that. This callsite, for example, allows us to
   // put the top level iterator on the arena and potentially even the State object, however, not
@@ -1513,10 +1706,9 @@ Status BlockBasedTable::Prefetch(const Slice* const begin,
   // indicates if we are on the last page that need to be pre-fetched
   bool prefetching_boundary_page = false;
 
+  std::vector<BlockHandle> handles;
   for (begin ? iiter.Seek(*begin) : iiter.SeekToFirst(); iiter.Valid();
        iiter.Next()) {
-    Slice block_handle = iiter.value();
-
     if (end && comparator.Compare(iiter.key(), *end) >= 0) {
       if (prefetching_boundary_page) {
         break;
@@ -1527,17 +1719,115 @@ Status BlockBasedTable::Prefetch(const Slice* const begin,
       prefetching_boundary_page = true;
     }
 
-    // Load the block specified by the block_handle into the block cache
-    BlockIter biter;
-    NewDataBlockIterator(ReadOptions::kDefault, block_handle, BlockType::kData, &biter);
+    Slice input = iiter.value();
+    handles.emplace_back();
+    RETURN_NOT_OK(handles.back().DecodeFrom(&input));
 
-    if (!biter.status().ok()) {
-      // there was an unexpected error while pre-fetching
-      return biter.status();
+    // Load the blocks specified by the collected handles into the block cache
+    if (handles.size() >= kPrefetchBatchSize) {
+      RETURN_NOT_OK(PrefetchDataBlocks(ReadOptions::kDefault, handles));
+      handles.clear();
     }
   }
+  RETURN_NOT_OK(iiter.status());
 
-  return Status::OK();
+  return PrefetchDataBlocks(ReadOptions::kDefault, handles);
+}
+
+Status BlockBasedTable::PrefetchDataBlocks(
+    const ReadOptions& ro, const std::vector<BlockHandle>& handles) {
+  if (handles.empty()) {
+    return Status::OK();
+  }
+
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache_compressed = rep_->table_options.block_cache_compressed.get();
+  if (!ro.fill_cache || (block_cache == nullptr && block_cache_compressed == nullptr)) {
+    // There is no place to keep the prefetched blocks, so just validate them, as a regular read
+    // through data block iterator would do.
+    for (const auto& handle : handles) {
+      std::string index_value;
+      handle.AppendEncodedTo(&index_value);
+      RETURN_NOT_OK(RetrieveBlockFromFile(ro, index_value, BlockType::kData));
+    }
+    return Status::OK();
+  }
+
+  FileReaderWithCachePrefix* reader = GetBlockReader(BlockType::kData);
+  Statistics* statistics = rep_->ioptions.statistics;
+  const auto format_version = rep_->table_options.format_version;
+  const auto* dict = rep_->compression_dict.get();
+
+  struct CacheKeys {
+    char key_buffer[block_based_table::kCacheKeyBufferSize];
+    char compressed_key_buffer[block_based_table::kCacheKeyBufferSize];
+    Slice key;
+    Slice compressed_key;
+  };
+  std::vector<CacheKeys> missing_keys;
+  std::vector<BlockHandle> missing_handles;
+  missing_keys.reserve(handles.size());
+  missing_handles.reserve(handles.size());
+
+  for (const auto& handle : handles) {
+    auto& keys = missing_keys.emplace_back();
+    if (block_cache != nullptr) {
+      keys.key = GetCacheKey(reader->cache_key_prefix, handle, keys.key_buffer);
+    }
+    if (block_cache_compressed != nullptr) {
+      keys.compressed_key = GetCacheKey(
+          reader->compressed_cache_key_prefix, handle, keys.compressed_key_buffer);
+    }
+
+    CachableEntry<Block> block;
+    RETURN_NOT_OK(GetDataBlockFromCache(
+        keys.key, keys.compressed_key, block_cache, block_cache_compressed, statistics, ro,
+        &block, format_version, BlockType::kData, rep_->mem_tracker, dict));
+    if (block.value == nullptr) {
+      missing_handles.push_back(handle);
+      continue;
+    }
+    missing_keys.pop_back();
+    if (block.cache_handle) {
+      block.Release(block_cache);
+    } else {
+      delete block.value;
+    }
+  }
+
+  if (missing_handles.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<BlockContents> contents;
+  std::vector<Status> statuses;
+  {
+    StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
+    RETURN_NOT_OK(ReadBlocksContents(
+        reader->reader.get(), rep_->footer, ro, missing_handles, &contents, &statuses,
+        rep_->mem_tracker, block_cache_compressed == nullptr, dict));
+  }
+
+  Status result;
+  for (size_t i = 0; i != missing_handles.size(); ++i) {
+    auto status = statuses[i];
+    if (status.ok()) {
+      CachableEntry<Block> block;
+      status = PutDataBlockToCache(
+          missing_keys[i].key, missing_keys[i].compressed_key, block_cache,
+          block_cache_compressed, ro, statistics, &block, new Block(std::move(contents[i])),
+          format_version, rep_->mem_tracker, dict);
+      if (block.cache_handle) {
+        block.Release(block_cache);
+      } else {
+        delete block.value;
+      }
+    }
+    if (!status.ok() && result.ok()) {
+      result = status;
+    }
+  }
+  return result;
 }
 
 bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
@@ -1725,6 +2015,10 @@ Status BlockBasedTable::DumpTable(WritableFile* out_file) {
         RETURN_NOT_OK(out_file->Append("  Properties block handle: "));
         RETURN_NOT_OK(out_file->Append(meta_iter->value().ToString(true).c_str()));
         RETURN_NOT_OK(out_file->Append("\n"));
+      } else if (meta_iter->key() == rocksdb::kCompressionDictBlock) {
+        RETURN_NOT_OK(out_file->Append("  Compression dictionary block handle: "));
+        RETURN_NOT_OK(out_file->Append(meta_iter->value().ToString(true).c_str()));
+        RETURN_NOT_OK(out_file->Append("\n"));
       } else if (strstr(meta_iter->key().ToString().c_str(),
                         "filter.rocksdb.") != nullptr) {
         RETURN_NOT_OK(out_file->Append("  Filter block handle: "));
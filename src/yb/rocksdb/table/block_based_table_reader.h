@@ -42,6 +42,7 @@ namespace rocksdb {
 class Block;
 class BlockIter;
 class BlockHandle;
+class DataBlockReadahead;
 class Cache;
 class FilterBlockReader;
 class BlockBasedFilterBlockReader;
@@ -58,6 +59,7 @@ struct ReadOptions;
 class GetContext;
 class InternalIterator;
 class IndexReader;
+class UncompressionDict;
 
 // Index reader special unique pointer to control the instance's way of deletion. Can be removed
 // when https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
@@ -158,6 +160,11 @@ class BlockBasedTable : public TableReader {
   // IO or iteration error.
   Status Prefetch(const Slice* begin, const Slice* end) override;
 
+  // Loads the data blocks specified by handles into the block cache. Blocks missing in the cache
+  // are read from the file with a single batched read, so reads of different blocks could be
+  // kept in flight concurrently.
+  Status PrefetchDataBlocks(const ReadOptions& ro, const std::vector<BlockHandle>& handles);
+
   // Given a key, return an approximate byte offset in the file where
   // the data for that key begins (or would begin if the key were
   // present in the file).  The returned value is in terms of file
@@ -195,9 +202,10 @@ class BlockBasedTable : public TableReader {
   // Converts an index entry (i.e. an encoded BlockHandle) into an iterator over the contents of
   // a correspoding block. Updates and returns input_iter if the one is specified, or returns
   // a new iterator.
+  // readahead is used to read blocks missing in the block cache, when specified.
   InternalIterator* NewDataBlockIterator(
       const ReadOptions& ro, const Slice& index_value, BlockType block_type,
-      BlockIter* input_iter = nullptr);
+      BlockIter* input_iter = nullptr, DataBlockReadahead* readahead = nullptr);
 
   const ImmutableCFOptions& ioptions();
 
@@ -263,7 +271,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* dict = nullptr);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -278,7 +287,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* dict = nullptr);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -303,6 +313,9 @@ class BlockBasedTable : public TableReader {
 
   Status SetupFilter(InternalIterator* meta_iter);
 
+  // Loads dictionary used to compress data blocks, if the table has one.
+  Status ReadCompressionDictBlock(InternalIterator* meta_iter);
+
   // Read the meta block from sst.
   static Status ReadMetaBlock(
       Rep* rep, std::unique_ptr<Block>* meta_block, std::unique_ptr<InternalIterator>* iter);
@@ -324,7 +337,12 @@ class BlockBasedTable : public TableReader {
   // Retrieves block from file system or cache.
   // NOTE! A caller is responsible for a block cleanup.
   yb::Result<CachableEntry<Block>> RetrieveBlock(const ReadOptions& ro, const Slice& index_value,
-      BlockType block_type, bool use_cache = true);
+      BlockType block_type, bool use_cache = true, DataBlockReadahead* readahead = nullptr);
+
+  // Reads block from file, using readahead buffer when readahead is specified.
+  Status ReadBlockFromFile(
+      FileReaderWithCachePrefix* reader, const ReadOptions& ro, const BlockHandle& handle,
+      bool do_uncompress, DataBlockReadahead* readahead, std::unique_ptr<Block>* result);
 
   explicit BlockBasedTable(Rep* rep) : rep_(rep) {}
 
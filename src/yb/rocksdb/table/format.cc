@@ -26,6 +26,7 @@
 #include <inttypes.h>
 
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/util/coding.h"
@@ -346,6 +347,21 @@ Status VerifyBlockChecksum(
   return Status::OK();
 }
 
+Status ValidateBlockReadResult(
+    RandomAccessFileReader* file, const Footer& footer, const ReadOptions& options,
+    const BlockHandle& handle, size_t expected_read_size, const Slice& read_result) {
+  if (read_result.size() != expected_read_size) {
+    return STATUS_FORMAT(
+        Corruption, "Truncated block read in file: $0, block handle: $1, expected size: $2",
+        file->file()->filename(), handle.ToDebugString(), expected_read_size);
+  }
+
+  if (options.verify_checksums) {
+    return VerifyBlockChecksum(file, footer, handle, read_result.cdata(), handle.size());
+  }
+  return Status::OK();
+}
+
 // Read a block and check its CRC. When this function returns, *contents will contain the result of
 // reading.
 Status ReadBlock(
@@ -367,16 +383,8 @@ Status ReadBlock(
             expected_read_size(expected_read_size_) {}
 
       Status Validate(const Slice& read_result) const override {
-        if (read_result.size() != expected_read_size) {
-          return STATUS_FORMAT(
-              Corruption, "Truncated block read in file: $0, block handle: $1, expected size: $2",
-              file->file()->filename(), handle.ToDebugString(), expected_read_size);
-        }
-
-        if (options.verify_checksums) {
-          return VerifyBlockChecksum(file, footer, handle, read_result.cdata(), handle.size());
-        }
-        return Status::OK();
+        return ValidateBlockReadResult(
+            file, footer, options, handle, expected_read_size, read_result);
       };
 
       RandomAccessFileReader* file;
@@ -439,7 +447,8 @@ BlockContents::BlockContents(
 Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
                          const ReadOptions& options, const BlockHandle& handle,
                          BlockContents* contents, Env* env,
-                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested) {
+                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                         const UncompressionDict* dict) {
   Status status;
   Slice slice;
   size_t n = static_cast<size_t>(handle.size());
@@ -470,7 +479,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
 
   if (decompression_requested && compression_type != kNoCompression) {
-    return UncompressBlockContents(slice.cdata(), n, contents, footer.version(), mem_tracker);
+    return UncompressBlockContents(
+        slice.cdata(), n, contents, footer.version(), mem_tracker, dict);
   }
 
   if (slice.cdata() != used_buf) {
@@ -487,6 +497,94 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   return status;
 }
 
+Status ReadBlocksContents(RandomAccessFileReader* file, const Footer& footer,
+                          const ReadOptions& options, const std::vector<BlockHandle>& handles,
+                          std::vector<BlockContents>* contents, std::vector<Status>* statuses,
+                          const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                          const UncompressionDict* dict) {
+  const size_t num_blocks = handles.size();
+  contents->clear();
+  contents->resize(num_blocks);
+  statuses->assign(num_blocks, Status::OK());
+
+  std::vector<std::unique_ptr<char[]>> buffers(num_blocks);
+  std::vector<yb::ReadRequest> requests(num_blocks);
+  size_t total_read_size = 0;
+  for (size_t i = 0; i != num_blocks; ++i) {
+    const size_t read_size = static_cast<size_t>(handles[i].size()) + kBlockTrailerSize;
+    buffers[i].reset(new char[read_size]);
+    auto& request = requests[i];
+    request.offset = handles[i].offset();
+    request.n = read_size;
+    request.scratch = reinterpret_cast<uint8_t*>(buffers[i].get());
+    total_read_size += read_size;
+  }
+
+  {
+    PERF_TIMER_GUARD(block_read_time);
+    RETURN_NOT_OK(file->MultiRead(requests.data(), num_blocks));
+  }
+  PERF_COUNTER_ADD(block_read_count, num_blocks);
+  PERF_COUNTER_ADD(block_read_byte, total_read_size);
+
+  for (size_t i = 0; i != num_blocks; ++i) {
+    const auto& handle = handles[i];
+    const auto& request = requests[i];
+    auto& status = (*statuses)[i];
+    const size_t n = static_cast<size_t>(handle.size());
+    Slice slice = request.result;
+    status = request.status;
+    if (status.ok()) {
+      status = ValidateBlockReadResult(file, footer, options, handle, request.n, slice);
+    }
+    if (!status.ok()) {
+      // Validation failure could be handled by the file itself, for instance encrypted file
+      // could retry decryption. So the block is reread using the regular path.
+      status = ReadBlock(file, footer, options, handle, &slice, buffers[i].get());
+      if (!status.ok()) {
+        LOG(ERROR) << __func__ << ": " << status;
+        continue;
+      }
+    }
+
+    PERF_TIMER_GUARD(block_decompress_time);
+    const auto compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
+    auto& block_contents = (*contents)[i];
+    if (decompression_requested && compression_type != kNoCompression) {
+      status = UncompressBlockContents(
+          slice.cdata(), n, &block_contents, footer.version(), mem_tracker, dict);
+    } else if (slice.cdata() != buffers[i].get()) {
+      block_contents = BlockContents(Slice(slice.data(), n), false, compression_type);
+    } else {
+      block_contents = BlockContents(
+          std::move(buffers[i]), n, true, compression_type, mem_tracker);
+    }
+  }
+  return Status::OK();
+}
+
+Status ParseBlockContents(RandomAccessFileReader* file, const Footer& footer,
+                          const ReadOptions& options, const BlockHandle& handle,
+                          const Slice& data, BlockContents* contents,
+                          const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                          const UncompressionDict* dict) {
+  const size_t n = static_cast<size_t>(handle.size());
+  RETURN_NOT_OK(ValidateBlockReadResult(
+      file, footer, options, handle, n + kBlockTrailerSize, data));
+
+  PERF_TIMER_GUARD(block_decompress_time);
+  const auto compression_type = static_cast<rocksdb::CompressionType>(data.data()[n]);
+  if (decompression_requested && compression_type != kNoCompression) {
+    return UncompressBlockContents(
+        data.cdata(), n, contents, footer.version(), mem_tracker, dict);
+  }
+
+  std::unique_ptr<char[]> heap_buf(new char[n]);
+  memcpy(heap_buf.get(), data.cdata(), n);
+  *contents = BlockContents(std::move(heap_buf), n, true, compression_type, mem_tracker);
+  return Status::OK();
+}
+
 //
 // The 'data' points to the raw block contents that was read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -497,7 +595,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
 Status UncompressBlockContents(const char* data, size_t n,
                                BlockContents* contents,
                                uint32_t format_version,
-                               const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+                               const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                               const UncompressionDict* dict) {
   std::unique_ptr<char[]> ubuf;
   int decompress_size = 0;
   assert(data[n] != kNoCompression);
@@ -519,7 +618,8 @@ Status UncompressBlockContents(const char* data, size_t n,
     case kZlibCompression:
       ubuf = std::unique_ptr<char[]>(Zlib_Uncompress(
           data, n, &decompress_size,
-          GetCompressFormatForVersion(kZlibCompression, format_version)));
+          GetCompressFormatForVersion(kZlibCompression, format_version),
+          /* windowBits = */ -14, dict));
       if (!ubuf) {
         static char zlib_corrupt_msg[] =
           "Zlib not supported or corrupted Zlib compressed block contents";
@@ -543,7 +643,7 @@ Status UncompressBlockContents(const char* data, size_t n,
     case kLZ4Compression:
       ubuf = std::unique_ptr<char[]>(LZ4_Uncompress(
           data, n, &decompress_size,
-          GetCompressFormatForVersion(kLZ4Compression, format_version)));
+          GetCompressFormatForVersion(kLZ4Compression, format_version), dict));
       if (!ubuf) {
         static char lz4_corrupt_msg[] =
           "LZ4 not supported or corrupted LZ4 compressed block contents";
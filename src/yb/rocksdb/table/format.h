@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 #include "yb/util/slice.h"
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/options.h"
@@ -39,6 +40,7 @@ class MemTracker;
 namespace rocksdb {
 
 class Block;
+class UncompressionDict;
 struct ReadOptions;
 
 // the length of the magic number in bytes.
@@ -255,7 +257,34 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                const UncompressionDict* dict = nullptr);
+
+// Reads the blocks identified by "handles" from "file", keeping several reads in flight when
+// the file supports it. Result of reading handles[i] is stored to (*contents)[i] and its status
+// to (*statuses)[i]. Returns non-OK only when the reads could not be issued at all.
+extern Status ReadBlocksContents(RandomAccessFileReader* file,
+                                 const Footer& footer,
+                                 const ReadOptions& options,
+                                 const std::vector<BlockHandle>& handles,
+                                 std::vector<BlockContents>* contents,
+                                 std::vector<Status>* statuses,
+                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                 bool do_uncompress,
+                                 const UncompressionDict* dict = nullptr);
+
+// Fills contents with the block identified by "handle", when the block together with its
+// trailer was already read from "file" to "data". Block is validated the same way as
+// ReadBlockContents does and its contents are copied, so "data" could be released after return.
+extern Status ParseBlockContents(RandomAccessFileReader* file,
+                                 const Footer& footer,
+                                 const ReadOptions& options,
+                                 const BlockHandle& handle,
+                                 const Slice& data,
+                                 BlockContents* contents,
+                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                 bool do_uncompress,
+                                 const UncompressionDict* dict = nullptr);
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -264,10 +293,13 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
 // free this buffer.
 // For description of compress_format_version and possible values, see
 // util/compression.h
+// dict is the dictionary of the SST file, required to uncompress blocks that were compressed
+// with it.
 extern Status UncompressBlockContents(const char* data, size_t n,
                                       BlockContents* contents,
                                       uint32_t compress_format_version,
-                                      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+                                      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                      const UncompressionDict* dict = nullptr);
 
 // Implementation details follow.  Clients should ignore,
 
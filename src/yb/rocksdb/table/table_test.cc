@@ -66,6 +66,8 @@
 #include "yb/rocksdb/util/testutil.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/format.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/string_util.h"
 #include "yb/util/test_macros.h"
 
@@ -74,6 +76,8 @@ using std::unique_ptr;
 using namespace std::literals;
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_int32(rocksdb_iterator_readahead_min_sequential_blocks);
+DECLARE_uint64(rocksdb_iterator_initial_readahead_size);
 
 namespace rocksdb {
 
@@ -310,7 +314,7 @@ class TableConstructor: public Constructor {
                             internal_comparator,
                             int_tbl_prop_collector_factories,
                             options.compression,
-                            CompressionOptions(),
+                            options.compression_opts,
                             /* skip_filters */ false),
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get());
@@ -1584,6 +1588,147 @@ TEST_F(BlockBasedTableTest, NumBlockStat) {
             c.GetTableReader()->GetTableProperties()->num_data_blocks);
 }
 
+void TestDictionaryCompression(CompressionType compression_type) {
+  auto build_table = [compression_type](uint32_t max_dict_bytes) {
+    Random rnd(301);
+    TableConstructor c(BytewiseComparator());
+    // Small repetitive keys and values, as produced by DocDB.
+    for (int i = 0; i < 20000; ++i) {
+      char key[64];
+      snprintf(key, sizeof(key), "doc_key_%08d_column_%02d", i / 10, i % 10);
+      c.Add(key, yb::Format("value_$0_$1", rnd.Uniform(100), i % 7 == 0 ? "null" : "some_text"));
+    }
+
+    Options options;
+    options.compression = compression_type;
+    options.compression_opts.max_dict_bytes = max_dict_bytes;
+    options.compression_opts.max_dict_buffer_bytes = 64 * 1024;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 1024;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    const ImmutableCFOptions ioptions(options);
+    c.Finish(options, ioptions, table_options,
+             GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+    std::unique_ptr<InternalIterator> iter(c.NewIterator());
+    iter->SeekToFirst();
+    for (const auto& kv : kvmap) {
+      EXPECT_TRUE(iter->Valid());
+      EXPECT_EQ(kv.first, iter->key().ToBuffer());
+      EXPECT_EQ(kv.second, iter->value().ToBuffer());
+      iter->Next();
+    }
+    EXPECT_FALSE(iter->Valid());
+    EXPECT_OK(iter->status());
+    return c.GetTableReader()->GetTableProperties()->data_size;
+  };
+
+  const auto size_without_dict = build_table(0);
+  const auto size_with_dict = build_table(4 * 1024);
+  LOG(INFO) << "Data size without dictionary: " << size_without_dict
+            << ", with dictionary: " << size_with_dict;
+  ASSERT_LT(size_with_dict, size_without_dict);
+}
+
+// Checks that data blocks compressed with dictionary are read back correctly, and take less space
+// than blocks compressed without dictionary.
+TEST_F(BlockBasedTableTest, DictionaryCompression) {
+  for (auto compression_type : {kZlibCompression, kLZ4Compression}) {
+    if (!CompressionTypeSupported(compression_type)) {
+      LOG(INFO) << "Skipping " << CompressionTypeToString(compression_type)
+                << ", it is not supported";
+      continue;
+    }
+    SCOPED_TRACE(CompressionTypeToString(compression_type));
+    ASSERT_NO_FATALS(TestDictionaryCompression(compression_type));
+  }
+}
+
+// Checks that forward scan reads data blocks ahead, while point seeks do not.
+TEST_F(BlockBasedTableTest, IteratorReadahead) {
+  Random rnd(301);
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i < 5000; ++i) {
+    char key[32];
+    snprintf(key, sizeof(key), "key_%08d", i);
+    c.Add(key, RandomString(&rnd, 100));
+  }
+
+  Options options;
+  options.compression = kNoCompression;
+  options.statistics = CreateDBStatisticsForTests();
+  const auto mem_tracker = yb::MemTracker::CreateTracker("IteratorReadahead");
+  options.block_based_table_mem_tracker = mem_tracker;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  table_options.no_block_cache = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+  const auto num_data_blocks = c.GetTableReader()->GetTableProperties()->num_data_blocks;
+  ASSERT_GT(num_data_blocks, 100);
+  auto* statistics = options.statistics.get();
+
+  auto scan = [&c, &kvmap] {
+    perf_context.Reset();
+    std::unique_ptr<InternalIterator> iter(c.NewIterator());
+    iter->SeekToFirst();
+    for (const auto& kv : kvmap) {
+      EXPECT_TRUE(iter->Valid());
+      EXPECT_EQ(kv.first, iter->key().ToBuffer());
+      EXPECT_EQ(kv.second, iter->value().ToBuffer());
+      iter->Next();
+    }
+    EXPECT_FALSE(iter->Valid());
+    EXPECT_OK(iter->status());
+    return perf_context.block_read_count;
+  };
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_iterator_readahead_min_sequential_blocks) = 0;
+  const auto reads_without_readahead = scan();
+  ASSERT_GE(reads_without_readahead, num_data_blocks);
+  ASSERT_EQ(statistics->getTickerCount(READAHEAD_BYTES_READ), 0);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_iterator_readahead_min_sequential_blocks) = 2;
+  const auto reads_with_readahead = scan();
+  LOG(INFO) << "Block reads without readahead: " << reads_without_readahead
+            << ", with readahead: " << reads_with_readahead;
+  ASSERT_LT(reads_with_readahead * 10, reads_without_readahead);
+  const auto bytes_read = statistics->getTickerCount(READAHEAD_BYTES_READ);
+  const auto bytes_used = statistics->getTickerCount(READAHEAD_BYTES_USED);
+  ASSERT_GT(bytes_used, 0);
+  ASSERT_EQ(bytes_read, bytes_used + statistics->getTickerCount(READAHEAD_BYTES_WASTED));
+
+  // Random seeks should not trigger readahead.
+  std::unique_ptr<InternalIterator> iter(c.NewIterator());
+  for (int i = 0; i < 100; ++i) {
+    const auto& key = keys[rnd.Uniform(static_cast<int>(keys.size()))];
+    iter->Seek(key);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(key, iter->key().ToBuffer());
+  }
+  iter.reset();
+  ASSERT_EQ(statistics->getTickerCount(READAHEAD_BYTES_READ), bytes_read);
+
+  // Readahead buffer is accounted in the mem tracker while the iterator is alive.
+  {
+    const auto consumption_before = mem_tracker->consumption();
+    std::unique_ptr<InternalIterator> scan_iter(c.NewIterator());
+    for (scan_iter->SeekToFirst(); scan_iter->Valid(); scan_iter->Next()) {}
+    ASSERT_OK(scan_iter->status());
+    ASSERT_GE(mem_tracker->consumption(),
+              consumption_before +
+                  static_cast<int64_t>(FLAGS_rocksdb_iterator_initial_readahead_size));
+    scan_iter.reset();
+    ASSERT_EQ(mem_tracker->consumption(), consumption_before);
+  }
+}
+
 // A simple tool that takes the snapshot of block cache statistics.
 class BlockCachePropertiesSnapshot {
  public:
@@ -25,6 +25,8 @@
 
 #include "yb/rocksdb/filter_policy.h"
 
+#include "yb/gutil/hash/city.h"
+
 #include "yb/rocksdb/util/hash.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/util/slice.h"
@@ -530,6 +532,210 @@ class FixedSizeFilterPolicy : public FilterPolicy {
   Logger* logger_;
 };
 
+// Fixed size blocked Bloom filter, also known as split block Bloom filter.
+//
+// Filter consists of 512-bit lines, every key is mapped to exactly one line, so each probe touches
+// a single cache line. Line is split into 8 words of 64 bits, and every key sets exactly one bit in
+// each word. So probe consists of 8 independent word checks without data dependent branches, that
+// compiler vectorizes into a few SIMD instructions on platforms that support them.
+// Line is picked using high half of 64-bit hash with multiply-shift reduction instead of modulo,
+// bits inside words are picked by multiplying low half of hash by odd constants.
+//
+// Encoding:
+// +----------------------------------------------------------------+
+// |         filter data: num_lines * kBlockedBloomLineSize bytes   |
+// +----------------------------------------------------------------+
+// | format version : 1 byte             | num_lines : 4 bytes      |
+// +----------------------------------------------------------------+
+// Format version allows changing encoding in the future, while keeping existing SST files readable.
+constexpr size_t kBlockedBloomLineSize = 64;
+constexpr size_t kBlockedBloomWordsPerLine = kBlockedBloomLineSize / sizeof(uint64_t);
+constexpr size_t kBlockedBloomMetaDataSize = 5;
+constexpr uint8_t kBlockedBloomFormatVersion = 1;
+
+constexpr uint32_t kBlockedBloomSalt[kBlockedBloomWordsPerLine] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+inline uint64_t BlockedBloomHash(const Slice& key) {
+  return util_hash::CityHash64(key.cdata(), key.size());
+}
+
+inline size_t BlockedBloomLine(uint64_t hash, size_t num_lines) {
+  return static_cast<size_t>(((hash >> 32) * num_lines) >> 32);
+}
+
+inline void BlockedBloomMasks(uint64_t hash, uint64_t* masks) {
+  const auto h = static_cast<uint32_t>(hash);
+  for (size_t i = 0; i != kBlockedBloomWordsPerLine; ++i) {
+    masks[i] = 1ULL << ((h * kBlockedBloomSalt[i]) >> 26);
+  }
+}
+
+// Returns max average number of keys per line, so false positive rate does not exceed error_rate.
+// Number of keys in a line follows Poisson distribution, the false positive rate of the line with
+// n keys is (1 - (1 - 1/64)^n)^8.
+double BlockedBloomMaxKeysPerLine(double error_rate) {
+  constexpr double kBitsPerWord = 64;
+  auto false_positive_rate = [](double keys_per_line) {
+    double result = 0;
+    double probability = exp(-keys_per_line);
+    const auto max_keys = static_cast<size_t>(keys_per_line * 3 + 64);
+    for (size_t n = 0; n <= max_keys; ++n) {
+      result += probability * pow(1 - pow(1 - 1 / kBitsPerWord, n), kBlockedBloomWordsPerLine);
+      probability *= keys_per_line / (n + 1);
+    }
+    return result;
+  };
+  double low = 0;
+  double high = kBlockedBloomLineSize * 8;
+  for (int i = 0; i != 50; ++i) {
+    double middle = (low + high) / 2;
+    if (false_positive_rate(middle) <= error_rate) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+class FixedSizeBlockedBloomBitsBuilder : public FilterBitsBuilder {
+ public:
+  FixedSizeBlockedBloomBitsBuilder(const FixedSizeBlockedBloomBitsBuilder&) = delete;
+  void operator=(const FixedSizeBlockedBloomBitsBuilder&) = delete;
+
+  FixedSizeBlockedBloomBitsBuilder(size_t total_bits, double max_keys_per_line)
+      : num_lines_(std::max<size_t>(total_bits / (kBlockedBloomLineSize * 8), 1)),
+        max_keys_(std::max<size_t>(static_cast<size_t>(max_keys_per_line * num_lines_), 1)),
+        data_(new char[FilterSize()]) {
+    memset(data_.get(), 0, FilterSize());
+  }
+
+  void AddKey(const Slice& key) override {
+    ++keys_added_;
+    const auto hash = BlockedBloomHash(key);
+    uint64_t masks[kBlockedBloomWordsPerLine];
+    BlockedBloomMasks(hash, masks);
+    char* line = data_.get() + BlockedBloomLine(hash, num_lines_) * kBlockedBloomLineSize;
+    for (size_t i = 0; i != kBlockedBloomWordsPerLine; ++i) {
+      auto* word = line + i * sizeof(uint64_t);
+      EncodeFixed64(word, DecodeFixed64(word) | masks[i]);
+    }
+  }
+
+  bool IsFull() const override { return keys_added_ >= max_keys_; }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    char* meta = data_.get() + num_lines_ * kBlockedBloomLineSize;
+    meta[0] = static_cast<char>(kBlockedBloomFormatVersion);
+    EncodeFixed32(meta + 1, static_cast<uint32_t>(num_lines_));
+    buf->reset(data_.release());
+    return Slice(buf->get(), FilterSize());
+  }
+
+ private:
+  size_t FilterSize() const {
+    return num_lines_ * kBlockedBloomLineSize + kBlockedBloomMetaDataSize;
+  }
+
+  const size_t num_lines_;
+  const size_t max_keys_;
+  size_t keys_added_ = 0;
+  std::unique_ptr<char[]> data_;
+};
+
+class FixedSizeBlockedBloomBitsReader : public FilterBitsReader {
+ public:
+  FixedSizeBlockedBloomBitsReader(const FixedSizeBlockedBloomBitsReader&) = delete;
+  void operator=(const FixedSizeBlockedBloomBitsReader&) = delete;
+
+  FixedSizeBlockedBloomBitsReader(const Slice& contents, Logger* logger)
+      : data_(contents.cdata()) {
+    if (contents.size() <= kBlockedBloomMetaDataSize) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger, "Blocked bloom filter is too short, won't be used.");
+      FAIL_IF_NOT_PRODUCTION();
+      return;
+    }
+    const char* meta = contents.cend() - kBlockedBloomMetaDataSize;
+    const auto format_version = static_cast<uint8_t>(meta[0]);
+    const auto num_lines = DecodeFixed32(meta + 1);
+    if (format_version != kBlockedBloomFormatVersion) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger,
+           "Unknown blocked bloom filter format version %d, won't be used.", format_version);
+      FAIL_IF_NOT_PRODUCTION();
+      return;
+    }
+    if (num_lines == 0 ||
+        contents.size() != num_lines * kBlockedBloomLineSize + kBlockedBloomMetaDataSize) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger, "Blocked bloom filter data is broken, won't be used.");
+      FAIL_IF_NOT_PRODUCTION();
+      return;
+    }
+    num_lines_ = num_lines;
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    // Broken filter is regarded as match.
+    if (num_lines_ == 0) {
+      return true;
+    }
+    const auto hash = BlockedBloomHash(entry);
+    uint64_t masks[kBlockedBloomWordsPerLine];
+    BlockedBloomMasks(hash, masks);
+    const char* line = data_ + BlockedBloomLine(hash, num_lines_) * kBlockedBloomLineSize;
+    uint64_t missing = 0;
+    for (size_t i = 0; i != kBlockedBloomWordsPerLine; ++i) {
+      missing |= masks[i] & ~DecodeFixed64(line + i * sizeof(uint64_t));
+    }
+    return missing == 0;
+  }
+
+ private:
+  const char* data_;
+  size_t num_lines_ = 0;
+};
+
+class FixedSizeBlockedBloomFilterPolicy : public FilterPolicy {
+ public:
+  FixedSizeBlockedBloomFilterPolicy(size_t total_bits, double error_rate, Logger* logger)
+      : total_bits_(total_bits),
+        max_keys_per_line_(BlockedBloomMaxKeysPerLine(error_rate)),
+        logger_(logger) {
+    DCHECK_GT(error_rate, 0);
+    DCHECK_GT(total_bits, 0);
+  }
+
+  FilterType GetFilterType() const override { return FilterType::kFixedSizeFilter; }
+
+  const char* Name() const override {
+    return "rocksdb.FixedSizeBlockedBloomFilter";
+  }
+
+  // Not used in FixedSizeFilter. GetFilterBitsBuilder/Reader interface should be used.
+  void CreateFilter(const Slice* keys, int n, std::string* dst) const override {
+    assert(!"FixedSizeBlockedBloomFilterPolicy::CreateFilter is not supported");
+  }
+
+  bool KeyMayMatch(const Slice& key, const Slice& filter) const override {
+    assert(!"FixedSizeBlockedBloomFilterPolicy::KeyMayMatch is not supported");
+    return true;
+  }
+
+  FilterBitsBuilder* GetFilterBitsBuilder() const override {
+    return new FixedSizeBlockedBloomBitsBuilder(total_bits_, max_keys_per_line_);
+  }
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
+    return new FixedSizeBlockedBloomBitsReader(contents, logger_);
+  }
+
+ private:
+  size_t total_bits_;
+  double max_keys_per_line_;
+  Logger* logger_;
+};
+
 }  // namespace
 
 const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
@@ -544,4 +750,10 @@ const FilterPolicy* NewFixedSizeFilterPolicy(size_t total_bits,
   return new FixedSizeFilterPolicy(total_bits, error_rate, logger);
 }
 
+const FilterPolicy* NewFixedSizeBlockedBloomFilterPolicy(size_t total_bits,
+                                                         double error_rate,
+                                                         Logger* logger) {
+  return new FixedSizeBlockedBloomFilterPolicy(total_bits, error_rate, logger);
+}
+
 }  // namespace rocksdb
@@ -29,6 +29,7 @@ int main() {
 }
 #else
 
+#include <chrono>
 #include <vector>
 #include "yb/util/flags.h"
 
@@ -236,7 +237,19 @@ class FixedSizeFilterBloomTestContext : public BloomTestContext {
           nullptr)};
 };
 
-YB_DEFINE_ENUM(BuilderReaderBloomTestType, (kFullFilter)(kFixedSizeFilter));
+class FixedSizeBlockedBloomFilterTestContext : public FixedSizeFilterBloomTestContext {
+ public:
+  const FilterPolicy& filter_policy() const override { return *filter_policy_.get(); }
+
+ private:
+  std::unique_ptr<const FilterPolicy> filter_policy_{
+      NewFixedSizeBlockedBloomFilterPolicy(
+          FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+          nullptr)};
+};
+
+YB_DEFINE_ENUM(BuilderReaderBloomTestType,
+               (kFullFilter)(kFixedSizeFilter)(kFixedSizeBlockedBloomFilter));
 
 namespace {
 
@@ -246,6 +259,8 @@ std::unique_ptr<const BloomTestContext> CreateContext(BuilderReaderBloomTestType
       return std::make_unique<FullFilterBloomTestContext>();
     case BuilderReaderBloomTestType::kFixedSizeFilter:
       return std::make_unique<FixedSizeFilterBloomTestContext>();
+    case BuilderReaderBloomTestType::kFixedSizeBlockedBloomFilter:
+      return std::make_unique<FixedSizeBlockedBloomFilterTestContext>();
   }
   FATAL_INVALID_ENUM_VALUE(BuilderReaderBloomTestType, type);
 }
@@ -374,7 +389,49 @@ TEST_P(BuilderReaderBloomTest, FullVaryingLengths) {
 
 INSTANTIATE_TEST_CASE_P(, BuilderReaderBloomTest, ::testing::Values(
     BuilderReaderBloomTestType::kFullFilter,
-    BuilderReaderBloomTestType::kFixedSizeFilter));
+    BuilderReaderBloomTestType::kFixedSizeFilter,
+    BuilderReaderBloomTestType::kFixedSizeBlockedBloomFilter));
+
+// Compares fixed size filters: false positive rate, bytes per key and probe time.
+TEST_F(BloomTest, FixedSizeFiltersBenchmark) {
+  constexpr size_t kNumProbes = 1000000;
+  constexpr size_t kNumFilters = 64;
+
+  for (auto type : {BuilderReaderBloomTestType::kFixedSizeFilter,
+                    BuilderReaderBloomTestType::kFixedSizeBlockedBloomFilter}) {
+    auto context = CreateContext(type);
+    const auto& policy = context->filter_policy();
+    std::vector<std::unique_ptr<const char[]>> buffers(kNumFilters);
+    std::vector<std::unique_ptr<FilterBitsReader>> readers;
+    size_t num_keys = 0;
+    size_t filters_size = 0;
+    char buffer[sizeof(size_t)];
+    // Fill several filters to get probes that miss CPU cache, as happens for block cache.
+    for (auto& buf : buffers) {
+      std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+      while (!builder->IsFull()) {
+        builder->AddKey(Key(num_keys++, buffer));
+      }
+      auto filter = builder->Finish(&buf);
+      filters_size += filter.size();
+      readers.emplace_back(policy.GetFilterBitsReader(filter));
+    }
+
+    size_t false_positives = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != kNumProbes; ++i) {
+      false_positives += readers[i % kNumFilters]->MayMatch(Key(i + 1000000000, buffer));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    LOG(INFO) << StringPrintf(
+        "%s: false positives: %.3f%%, bytes per key: %.2f, probe: %.1f ns",
+        ToCString(type), false_positives * 100.0 / kNumProbes,
+        static_cast<double>(filters_size) / num_keys,
+        std::chrono::duration<double, std::nano>(elapsed).count() / kNumProbes);
+    ASSERT_LE(false_positives, kNumProbes * FilterPolicy::kDefaultFixedSizeFilterErrorRate * 2);
+  }
+}
 
 }  // namespace rocksdb
 
@@ -24,6 +24,10 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/statistics.h"
@@ -49,6 +53,25 @@ DEFINE_UNKNOWN_bool(cache_overflow_single_touch, true,
             "Whether to enable overflow of single touch cache into the multi touch cache "
             "allocation");
 
+DEFINE_RUNTIME_bool(cache_adaptive_single_touch_ratio, false,
+    "Whether to adjust the split between single touch and multi touch caches to the workload. "
+    "Keys of recently evicted entries are remembered, and when such key is inserted again, the "
+    "part of the cache it was evicted from is extended. cache_single_touch_ratio is used as the "
+    "initial split.");
+
+DEFINE_RUNTIME_double(cache_min_single_touch_ratio, 0.05,
+    "Min fraction of the cache dedicated to single-touch items, when "
+    "cache_adaptive_single_touch_ratio is enabled.");
+
+DEFINE_RUNTIME_double(cache_max_single_touch_ratio, 0.5,
+    "Max fraction of the cache dedicated to single-touch items, when "
+    "cache_adaptive_single_touch_ratio is enabled.");
+
+DEFINE_RUNTIME_bool(cache_single_touch_admission, false,
+    "Whether to use frequency based admission for single touch items. A new item is not added "
+    "to the full single touch cache when it was accessed less frequently than the item that "
+    "would be evicted for it, so large scans don't evict frequently used blocks.");
+
 namespace rocksdb {
 
 Cache::~Cache() {
@@ -376,6 +399,148 @@ class LRUHandleDeleter {
   autovector<LRUHandle*> handles_;
 };
 
+// Remembers hashes of entries recently evicted from the sub cache, until total charge of
+// remembered entries exceeds capacity. Insertion of a remembered entry (ghost hit) means that the
+// sub cache would have served it, if the sub cache were larger.
+class GhostList {
+ public:
+  void Add(uint32_t hash, size_t charge, size_t capacity) {
+    auto& entry = entries_[hash];
+    charge_ = charge_ - entry.charge + charge;
+    entry.charge = charge;
+    entry.serial_no = ++last_serial_no_;
+    queue_.push_back(QueueEntry {.hash = hash, .serial_no = entry.serial_no});
+    while (charge_ > capacity && !queue_.empty()) {
+      PopFront();
+    }
+    // Ghost hits leave stale queue entries, drop them when they take too much space.
+    if (queue_.size() > 2 * entries_.size() + kMaxStaleEntries) {
+      while (!queue_.empty()) {
+        PopFront();
+      }
+    }
+  }
+
+  // Removes the hash and returns true if it was remembered.
+  bool Remove(uint32_t hash) {
+    auto it = entries_.find(hash);
+    if (it == entries_.end()) {
+      return false;
+    }
+    charge_ -= it->second.charge;
+    entries_.erase(it);
+    return true;
+  }
+
+  // Total charge of remembered entries.
+  size_t charge() const {
+    return charge_;
+  }
+
+ private:
+  static constexpr size_t kMaxStaleEntries = 1024;
+
+  struct Entry {
+    size_t charge = 0;
+    uint64_t serial_no = 0;
+  };
+
+  struct QueueEntry {
+    uint32_t hash;
+    uint64_t serial_no;
+  };
+
+  void PopFront() {
+    const auto& front = queue_.front();
+    auto it = entries_.find(front.hash);
+    // Entry could have been removed, or added again later.
+    if (it != entries_.end() && it->second.serial_no == front.serial_no) {
+      charge_ -= it->second.charge;
+      entries_.erase(it);
+    }
+    queue_.pop_front();
+  }
+
+  std::unordered_map<uint32_t, Entry> entries_;
+  std::deque<QueueEntry> queue_;
+  size_t charge_ = 0;
+  uint64_t last_serial_no_ = 0;
+};
+
+// Count-min sketch with 4 bit counters, used to estimate how frequently the key was accessed
+// recently. Counters are halved when number of increments reaches 10 times number of counters,
+// so estimation reflects recent accesses.
+class FrequencySketch {
+ public:
+  void Resize(size_t expected_entries) {
+    size_t width = kMinWidth;
+    while (width < expected_entries && width < kMaxWidth) {
+      width *= 2;
+    }
+    width_mask_ = width - 1;
+    // Two 4 bit counters per byte.
+    counters_.assign(kDepth * width / 2, 0);
+    increments_ = 0;
+  }
+
+  void Increment(uint32_t hash) {
+    bool incremented = false;
+    for (size_t row = 0; row != kDepth; ++row) {
+      const auto index = Index(hash, row);
+      if (Get(index) < kMaxCount) {
+        Set(index, Get(index) + 1);
+        incremented = true;
+      }
+    }
+    if (incremented && ++increments_ >= 10 * (width_mask_ + 1)) {
+      Age();
+    }
+  }
+
+  uint8_t Estimate(uint32_t hash) const {
+    uint8_t result = kMaxCount;
+    for (size_t row = 0; row != kDepth; ++row) {
+      result = std::min(result, Get(Index(hash, row)));
+    }
+    return result;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr uint8_t kMaxCount = 15;
+  static constexpr size_t kMinWidth = 256;
+  static constexpr size_t kMaxWidth = 1ULL << 20;
+
+  size_t Index(uint32_t hash, size_t row) const {
+    static constexpr uint64_t kSeeds[kDepth] = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+        0xcbf29ce484222325ULL};
+    const uint64_t mixed = (hash + kSeeds[row]) * 0x9e3779b97f4a7c15ULL;
+    return row * (width_mask_ + 1) + ((mixed >> 32) & width_mask_);
+  }
+
+  uint8_t Get(size_t index) const {
+    return (counters_[index / 2] >> ((index & 1) * 4)) & 0xf;
+  }
+
+  void Set(size_t index, uint8_t value) {
+    auto& byte = counters_[index / 2];
+    const auto shift = (index & 1) * 4;
+    byte = (byte & ~(0xf << shift)) | (value << shift);
+  }
+
+  void Age() {
+    for (auto& byte : counters_) {
+      byte = (byte >> 1) & 0x77;
+    }
+    increments_ /= 2;
+  }
+
+  std::vector<uint8_t> counters_;
+  size_t width_mask_ = 0;
+  size_t increments_ = 0;
+};
+
 // A single shard of sharded cache.
 class LRUCache {
  public:
@@ -388,8 +553,12 @@ class LRUCache {
   void SetCapacity(size_t capacity);
 
   void SetMetrics(shared_ptr<yb::CacheMetrics> metrics) {
+    MutexLock l(&mutex_);
     metrics_ = metrics;
     table_.SetMetrics(metrics);
+    if (metrics_) {
+      metrics_->multi_touch_cache_capacity->IncrementBy(multi_touch_capacity_);
+    }
   }
 
   // Set the flag to reject insertion if cache if full.
@@ -436,8 +605,16 @@ class LRUCache {
   LRUSubCache single_touch_sub_cache_;
   LRUSubCache multi_touch_sub_cache_;
 
-  size_t total_capacity_;
-  size_t multi_touch_capacity_;
+  size_t total_capacity_ = 0;
+  size_t multi_touch_capacity_ = 0;
+
+  // Hashes of entries recently evicted from single touch and multi touch caches.
+  // Used to adjust multi_touch_capacity_ when cache_adaptive_single_touch_ratio is enabled.
+  GhostList single_touch_ghosts_;
+  GhostList multi_touch_ghosts_;
+
+  // Access frequency of keys, used when cache_single_touch_admission is enabled.
+  FrequencySketch frequency_sketch_;
 
   // Just reduce the reference count by 1.
   // Return true if last reference
@@ -456,6 +633,27 @@ class LRUCache {
 
   void DecrementUsage(const SubCacheType subcache_type, const size_t charge);
 
+  // Updates multi touch capacity, keeping the corresponding metric in sync.
+  void SetMultiTouchCapacity(size_t capacity);
+
+  // Checks whether the entry being inserted was recently evicted, adjusting the split between
+  // single touch and multi touch caches accordingly. An entry that was evicted and is inserted
+  // again is treated as touched for the second time and goes to the multi touch cache.
+  // Returns the sub cache the entry should be inserted to.
+  SubCacheType ProcessGhostHit(LRUHandle* e, SubCacheType subcache_type);
+
+  // Remembers the entry evicted from the specified sub cache, when adaptive split is enabled.
+  void AddGhost(LRUHandle* e, SubCacheType subcache_type);
+
+  // Whether the new single touch entry should be rejected, because it was accessed less
+  // frequently than the entry that would be evicted for it.
+  bool ShouldRejectSingleTouch(LRUHandle* e);
+
+  bool IsAdaptive() const {
+    return FLAGS_cache_adaptive_single_touch_ratio && FLAGS_cache_single_touch_ratio > 0 &&
+           FLAGS_cache_single_touch_ratio < 1;
+  }
+
   // Checks if the corresponding subcache contains space.
   bool HasFreeSpace(const SubCacheType subcache_type);
 
@@ -500,6 +698,77 @@ void LRUCache::DecrementUsage(const SubCacheType subcache_type, const size_t cha
   GetSubCache(subcache_type)->DecrementUsage(charge);
 }
 
+void LRUCache::SetMultiTouchCapacity(size_t capacity) {
+  if (metrics_) {
+    if (capacity > multi_touch_capacity_) {
+      metrics_->multi_touch_cache_capacity->IncrementBy(capacity - multi_touch_capacity_);
+    } else {
+      metrics_->multi_touch_cache_capacity->DecrementBy(multi_touch_capacity_ - capacity);
+    }
+  }
+  multi_touch_capacity_ = capacity;
+}
+
+void LRUCache::AddGhost(LRUHandle* e, SubCacheType subcache_type) {
+  if (!IsAdaptive()) {
+    return;
+  }
+  if (subcache_type == MULTI_TOUCH) {
+    multi_touch_ghosts_.Add(e->hash, e->charge, multi_touch_capacity_);
+  } else {
+    single_touch_ghosts_.Add(e->hash, e->charge, total_capacity_ - multi_touch_capacity_);
+  }
+}
+
+SubCacheType LRUCache::ProcessGhostHit(LRUHandle* e, SubCacheType subcache_type) {
+  if (!IsAdaptive() || subcache_type == MULTI_TOUCH) {
+    return subcache_type;
+  }
+  const auto min_multi_touch_capacity = static_cast<size_t>(
+      round((1 - FLAGS_cache_max_single_touch_ratio) * total_capacity_));
+  const auto max_multi_touch_capacity = static_cast<size_t>(
+      round((1 - FLAGS_cache_min_single_touch_ratio) * total_capacity_));
+  // Similar to ARC, the step is larger when the other ghost list is larger, so the split moves
+  // faster when the workload changes.
+  if (single_touch_ghosts_.Remove(e->hash)) {
+    const auto ratio = single_touch_ghosts_.charge() > 0
+        ? multi_touch_ghosts_.charge() / single_touch_ghosts_.charge() : 0;
+    const auto delta = e->charge * std::max<size_t>(ratio, 1);
+    SetMultiTouchCapacity(std::max(
+        multi_touch_capacity_ > delta ? multi_touch_capacity_ - delta : 0,
+        min_multi_touch_capacity));
+    if (metrics_) {
+      metrics_->single_touch_ghost_hits->Increment();
+    }
+  } else if (multi_touch_ghosts_.Remove(e->hash)) {
+    const auto ratio = multi_touch_ghosts_.charge() > 0
+        ? single_touch_ghosts_.charge() / multi_touch_ghosts_.charge() : 0;
+    const auto delta = e->charge * std::max<size_t>(ratio, 1);
+    SetMultiTouchCapacity(std::min(multi_touch_capacity_ + delta, max_multi_touch_capacity));
+    if (metrics_) {
+      metrics_->multi_touch_ghost_hits->Increment();
+    }
+  } else {
+    return subcache_type;
+  }
+  e->query_id = kInMultiTouchId;
+  return MULTI_TOUCH;
+}
+
+bool LRUCache::ShouldRejectSingleTouch(LRUHandle* e) {
+  if (!FLAGS_cache_single_touch_admission) {
+    return false;
+  }
+  const auto capacity = GetSubCacheCapacity(SINGLE_TOUCH);
+  if (single_touch_sub_cache_.Usage() + e->charge <= capacity ||
+      single_touch_sub_cache_.IsLRUEmpty()) {
+    // Nothing would be evicted.
+    return false;
+  }
+  const LRUHandle* victim = single_touch_sub_cache_.LRU_Head().next;
+  return frequency_sketch_.Estimate(e->hash) < frequency_sketch_.Estimate(victim->hash);
+}
+
 // Call deleter and free
 
 void LRUCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t),
@@ -551,6 +820,7 @@ void LRUCache::EvictFromLRU(const size_t charge,
     old->in_cache = false;
     Unref(old);
     sub_cache->DecrementUsage(old->charge);
+    AddGhost(old, subcache_type);
     deleted->Add(old);
   }
 }
@@ -560,8 +830,10 @@ void LRUCache::SetCapacity(size_t capacity) {
 
   {
     MutexLock l(&mutex_);
-    multi_touch_capacity_ = round((1 - FLAGS_cache_single_touch_ratio) * capacity);
+    SetMultiTouchCapacity(round((1 - FLAGS_cache_single_touch_ratio) * capacity));
     total_capacity_ = capacity;
+    // Blocks are expected to be at least 4KB.
+    frequency_sketch_.Resize(capacity / 4096);
     EvictFromLRU(0, &last_reference_list, MULTI_TOUCH);
     EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
   }
@@ -580,6 +852,9 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
   MutexLock l(&mutex_);
+  if (FLAGS_cache_single_touch_admission) {
+    frequency_sketch_.Increment(hash);
+  }
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->in_cache);
@@ -677,6 +952,7 @@ void LRUCache::Release(Cache::Handle* handle) {
         e->in_cache = false;
         Unref(e);
         sub_cache->DecrementUsage(e->charge);
+        AddGhost(e, e->GetSubCacheType());
         last_reference = true;
       } else {
         // put the item on the list to be potentially freed.
@@ -745,7 +1021,26 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
       // If there is no multi touch cache, default to single cache.
       subcache_type = SINGLE_TOUCH;
     } else {
-      subcache_type = table_.GetSubCacheTypeCandidate(e);
+      subcache_type = ProcessGhostHit(e, table_.GetSubCacheTypeCandidate(e));
+    }
+    if (subcache_type == SINGLE_TOUCH && ShouldRejectSingleTouch(e)) {
+      // The entry is not retained by the cache. If the caller requested a handle, it gets
+      // a handle that is not in the cache and is freed on release.
+      LRUSubCache* sub_cache = GetSubCache(subcache_type);
+      if (handle == nullptr) {
+        last_reference_list.Add(e);
+      } else {
+        e->in_cache = false;
+        e->refs = 1;
+        sub_cache->IncrementUsage(e->charge);
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      if (metrics_) {
+        metrics_->admission_rejections->Increment();
+        metrics_->single_touch_cache_usage->IncrementBy(charge);
+        metrics_->cache_usage->IncrementBy(charge);
+      }
+      return Status::OK();
     }
     EvictFromLRU(charge, &last_reference_list, subcache_type);
     LRUSubCache* sub_cache = GetSubCache(subcache_type);
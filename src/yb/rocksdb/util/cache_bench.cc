@@ -49,6 +49,7 @@ DEFINE_UNKNOWN_int32(threads, 16, "Number of concurrent threads to run.");
 DEFINE_UNKNOWN_int64(cache_size, 8 * KB * KB,
              "Number of bytes to use as a cache of uncompressed data.");
 DEFINE_UNKNOWN_int32(num_shard_bits, 4, "shard_bits.");
+DEFINE_NON_RUNTIME_string(cache_type, "lru", "Cache implementation to benchmark: lru or clock.");
 
 DEFINE_UNKNOWN_int64(max_key, 1 * KB * KB * KB, "Max number of key to place in cache");
 DEFINE_UNKNOWN_uint64(ops_per_thread, 1200000, "Number of operations per thread.");
@@ -136,6 +137,9 @@ struct ThreadState {
   uint32_t tid;
   Random rnd;
   SharedState* shared;
+  uint64_t lookups = 0;
+  uint64_t hits = 0;
+  uint64_t lookup_nanos = 0;
 
   ThreadState(uint32_t index, SharedState* _shared)
       : tid(index), rnd(1000 + index), shared(_shared) {}
@@ -145,7 +149,9 @@ struct ThreadState {
 class CacheBench {
  public:
   CacheBench() :
-      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
+      cache_(FLAGS_cache_type == "clock"
+                 ? NewClockCache(FLAGS_cache_size, FLAGS_num_shard_bits)
+                 : NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
       num_threads_(FLAGS_threads) {}
 
   ~CacheBench() {}
@@ -157,7 +163,7 @@ class CacheBench {
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter);
     }
   }
 
@@ -195,6 +201,23 @@ class CacheBench {
           static_cast<double>(FLAGS_threads * FLAGS_ops_per_thread) / elapsed);
       fprintf(stdout, "Complete in %.3f s; QPS = %u\n", elapsed, qps);
     }
+
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+    uint64_t lookup_nanos = 0;
+    for (auto* thread : threads) {
+      lookups += thread->lookups;
+      hits += thread->hits;
+      lookup_nanos += thread->lookup_nanos;
+      delete thread;
+    }
+    if (lookups != 0) {
+      // Lookup throughput that threads would get if they only did lookups.
+      const double lookup_qps = lookup_nanos != 0
+          ? static_cast<double>(lookups) * 1e9 * num_threads_ / lookup_nanos : 0;
+      fprintf(stdout, "Lookups = %" PRIu64 "; hit ratio = %.3f; lookup QPS = %.0f\n",
+              lookups, static_cast<double>(hits) / lookups, lookup_qps);
+    }
     return true;
   }
 
@@ -228,23 +251,32 @@ class CacheBench {
   }
 
   void OperateCache(ThreadState* thread) {
+    rocksdb::Env* env = rocksdb::Env::Default();
     for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
       uint64_t rand_key = thread->rnd.Next() % FLAGS_max_key;
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       int32_t prob_op = thread->rnd.Uniform(100);
-      if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
+      if (prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
-      } else if (prob_op -= FLAGS_insert_percent &&
-                 prob_op < FLAGS_lookup_percent) {
+        cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter);
+        continue;
+      }
+      prob_op -= FLAGS_insert_percent;
+      if (prob_op < FLAGS_lookup_percent) {
         // do lookup
-        auto handle = cache_->Lookup(key);
+        const auto start = env->NowNanos();
+        auto handle = cache_->Lookup(key, kDefaultQueryId);
         if (handle) {
           cache_->Release(handle);
+          ++thread->hits;
         }
-      } else if (prob_op -= FLAGS_lookup_percent &&
-                 prob_op < FLAGS_erase_percent) {
+        thread->lookup_nanos += env->NowNanos() - start;
+        ++thread->lookups;
+        continue;
+      }
+      prob_op -= FLAGS_lookup_percent;
+      if (prob_op < FLAGS_erase_percent) {
         // do erase
         cache_->Erase(key);
       }
@@ -252,6 +284,7 @@ class CacheBench {
   }
 
   void PrintEnv() const {
+    printf("Cache type          : %s\n", FLAGS_cache_type.c_str());
     printf("Number of threads   : %d\n", FLAGS_threads);
     printf("Ops per thread      : %" PRIu64 "\n", FLAGS_ops_per_thread);
     printf("Cache size          : %" PRIu64 "\n", FLAGS_cache_size);
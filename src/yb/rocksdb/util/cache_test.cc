@@ -21,12 +21,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <atomic>
 #include <forward_list>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "yb/gutil/dynamic_annotations.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/util/coding.h"
 
@@ -37,6 +40,9 @@
 using std::shared_ptr;
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_bool(cache_overflow_single_touch);
+DECLARE_bool(cache_adaptive_single_touch_ratio);
+DECLARE_bool(cache_single_touch_admission);
 
 namespace rocksdb {
 
@@ -745,6 +751,213 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+TEST_F(CacheTest, AdaptiveSingleTouchRatio) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  FLAGS_cache_overflow_single_touch = false;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cache_adaptive_single_touch_ratio) = true;
+  auto cache = NewLRUCache(10, 0);
+
+  // Single touch cache holds only 2 entries, evicted entries 6 and 7 are remembered.
+  for (int i = 0; i <= 9; i++) {
+    ASSERT_OK(InsertIntoCache(cache, i /* key */, i /* value */));
+  }
+  AssertCacheSizes(cache.get(), 2, 0);
+
+  // Recently evicted entry goes directly to the multi touch cache, and the single touch cache is
+  // extended, since it would have served the entry if it were larger.
+  ASSERT_OK(InsertIntoCache(cache, 7 /* key */, 7 /* value */));
+  AssertCacheSizes(cache.get(), 2, 1);
+  {
+    Cache::Handle* h = cache->Lookup(ToString(7), CacheTest::kTestQueryId);
+    ASSERT_NE(h, nullptr);
+    ASSERT_EQ(MULTI_TOUCH, cache->GetSubCacheType(h));
+    cache->Release(h);
+  }
+  for (int i = 100; i <= 109; i++) {
+    ASSERT_OK(InsertIntoCache(cache, i /* key */, i /* value */));
+  }
+  AssertCacheSizes(cache.get(), 3, 1);
+
+  // Entry that was never inserted does not change the split.
+  ASSERT_OK(InsertIntoCache(cache, 200 /* key */, 200 /* value */));
+  AssertCacheSizes(cache.get(), 3, 1);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cache_adaptive_single_touch_ratio) = false;
+  FLAGS_cache_overflow_single_touch = true;
+}
+
+TEST_F(CacheTest, SingleTouchAdmission) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cache_single_touch_admission) = true;
+  auto cache = NewLRUCache(10, 0);
+
+  // Emulate reads that miss the cache and insert the block.
+  for (int i = 0; i <= 9; i++) {
+    ASSERT_EQ(cache->Lookup(ToString(i), CacheTest::kTestQueryId), nullptr);
+    ASSERT_OK(InsertIntoCache(cache, i /* key */, i /* value */));
+  }
+  AssertCacheSizes(cache.get(), 10, 0);
+
+  // Blocks of a scan that were not accessed before do not evict entries that were.
+  for (int i = 100; i <= 119; i++) {
+    ASSERT_OK(InsertIntoCache(cache, i /* key */, i /* value */));
+  }
+  AssertCacheSizes(cache.get(), 10, 0);
+  for (int i = 0; i <= 9; i++) {
+    Cache::Handle* h = cache->Lookup(ToString(i), CacheTest::kTestQueryId);
+    ASSERT_NE(h, nullptr);
+    cache->Release(h);
+  }
+
+  // Rejected entry is still returned to the caller that requested the handle.
+  {
+    Cache::Handle* h = nullptr;
+    ASSERT_OK(InsertIntoCache(
+        cache, 200 /* key */, 200 /* value */, CacheTest::kTestQueryId, 1, &h));
+    ASSERT_NE(h, nullptr);
+    ASSERT_NE(cache->Value(h), nullptr);
+    cache->Release(h);
+    ASSERT_EQ(cache->Lookup(ToString(200), CacheTest::kTestQueryId), nullptr);
+  }
+  AssertCacheSizes(cache.get(), 10, 0);
+
+  // Entry accessed as frequently as the eviction candidate is admitted.
+  for (int i = 0; i != 2; ++i) {
+    ASSERT_EQ(cache->Lookup(ToString(300), CacheTest::kTestQueryId), nullptr);
+  }
+  ASSERT_OK(InsertIntoCache(cache, 300 /* key */, 300 /* value */));
+  {
+    Cache::Handle* h = cache->Lookup(ToString(300), CacheTest::kTestQueryId);
+    ASSERT_NE(h, nullptr);
+    cache->Release(h);
+  }
+  AssertCacheSizes(cache.get(), 10, 0);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cache_single_touch_admission) = false;
+}
+
+TEST_F(CacheTest, ClockCache) {
+  auto cache = NewClockCache(10, 0);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_OK(Insert(cache, 100, 101));
+  ASSERT_EQ(101, Lookup(cache, 100));
+
+  // Replaced and erased values are deleted.
+  ASSERT_OK(Insert(cache, 100, 102));
+  ASSERT_EQ(102, Lookup(cache, 100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(101, deleted_values_[0]);
+  Erase(cache, 100);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(0U, cache->GetUsage());
+
+  // Entry that was used since the last visit of the clock hand gets second chance.
+  for (int i = 0; i != 10; ++i) {
+    ASSERT_OK(Insert(cache, i, i + 1000));
+  }
+  ASSERT_EQ(1000, Lookup(cache, 0));
+  ASSERT_OK(Insert(cache, 10, 1010));
+  ASSERT_EQ(1000, Lookup(cache, 0));
+  ASSERT_EQ(-1, Lookup(cache, 1));
+  ASSERT_EQ(10U, cache->GetUsage());
+
+  // Referenced entries are not evicted.
+  Cache::Handle* h = cache->Lookup(EncodeKey(5), kTestQueryId);
+  ASSERT_NE(h, nullptr);
+  for (int i = 100; i != 200; ++i) {
+    ASSERT_OK(Insert(cache, i, i + 1000));
+  }
+  ASSERT_EQ(10U, cache->GetUsage());
+  ASSERT_EQ(1U, cache->GetPinnedUsage());
+  ASSERT_EQ(1005, Lookup(cache, 5));
+  cache->Release(h);
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
+TEST_F(CacheTest, ClockCacheStrictCapacityLimit) {
+  auto cache = NewClockCache(5, 0, true /* strict_capacity_limit */);
+  std::vector<Cache::Handle*> handles(5);
+  for (int i = 0; i != 5; ++i) {
+    ASSERT_OK(cache->Insert(
+        EncodeKey(i), kTestQueryId, EncodeValue(i), 1, &CacheTest::Deleter, &handles[i]));
+  }
+  Cache::Handle* extra_handle = nullptr;
+  auto s = cache->Insert(
+      EncodeKey(100), kTestQueryId, EncodeValue(100), 1, &CacheTest::Deleter, &extra_handle);
+  ASSERT_TRUE(s.IsIncomplete());
+  ASSERT_EQ(extra_handle, nullptr);
+  ASSERT_EQ(0U, deleted_keys_.size());
+
+  // Without handle, the value is deleted when it could not be inserted.
+  ASSERT_TRUE(Insert(cache, 100, 100).IsIncomplete());
+  ASSERT_EQ(1U, deleted_keys_.size());
+
+  for (auto* handle : handles) {
+    cache->Release(handle);
+  }
+  ASSERT_OK(Insert(cache, 100, 100));
+  ASSERT_EQ(100, Lookup(cache, 100));
+}
+
+namespace {
+
+std::atomic<int> clock_cache_live_values{0};
+
+void ClockCacheTestDeleter(const Slice& key, void* value) {
+  ASSERT_EQ(DecodeKey(key), DecodeValue(value));
+  --clock_cache_live_values;
+}
+
+} // namespace
+
+// Lookups run concurrently with modifications of the same shard, and should never return value
+// of another key.
+TEST_F(CacheTest, ClockCacheConcurrent) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 200;
+  constexpr int kOpsPerThread = 100000;
+
+  auto cache = NewClockCache(kNumKeys / 2, 1);
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([&cache, &failed, t] {
+      Random rnd(t);
+      for (int i = 0; i != kOpsPerThread; ++i) {
+        const int key = rnd.Uniform(kNumKeys);
+        const auto op = rnd.Uniform(10);
+        if (op < 3) {
+          ++clock_cache_live_values;
+          if (!cache->Insert(EncodeKey(key), kTestQueryId, EncodeValue(key), 1,
+                             &ClockCacheTestDeleter).ok()) {
+            failed = true;
+          }
+        } else if (op < 9) {
+          auto* handle = cache->Lookup(EncodeKey(key), kTestQueryId);
+          if (handle != nullptr) {
+            if (DecodeValue(cache->Value(handle)) != key) {
+              failed = true;
+            }
+            cache->Release(handle);
+          }
+        } else {
+          cache->Erase(EncodeKey(key));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_FALSE(failed.load());
+  ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kNumKeys));
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+  cache.reset();
+  ASSERT_EQ(0, clock_cache_live_values.load());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
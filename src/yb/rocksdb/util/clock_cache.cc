@@ -0,0 +1,743 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Cache with CLOCK eviction policy, whose lookup path does not take any locks.
+//
+// Every cache entry is represented by ClockHandle, that has atomic flags with reference count,
+// "in cache" bit and "usage" bit. Lookup probes the shard hash table without locking, and
+// references the found handle using compare and swap on its flags, setting the usage bit.
+// Insert, Erase and eviction modify the shard under the shard mutex. Eviction is performed by
+// the clock hand, that goes over all handles of the shard: unreferenced entry with usage bit set
+// gets second chance and its usage bit is cleared, otherwise the entry is evicted.
+//
+// Memory of handles and hash tables is not released until the cache is destroyed, unused handles
+// are reused for new entries. So a lookup that races with modifications always reads valid memory.
+// It could miss an entry that is being modified, or find a handle that was reused for another key,
+// so key of the found handle is checked after the handle is referenced, since a referenced handle
+// could not be reused.
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/util/hash.h"
+#include "yb/rocksdb/util/mutexlock.h"
+#include "yb/rocksdb/util/statistics.h"
+
+#include "yb/util/cache_metrics.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
+
+namespace rocksdb {
+
+namespace {
+
+constexpr uint32_t kInCacheBit = 1;
+constexpr uint32_t kUsageBit = 2;
+constexpr uint32_t kRefsOffset = 2;
+constexpr uint32_t kOneRef = 1 << kRefsOffset;
+
+constexpr size_t kInitialTableSize = 64;
+
+struct ClockHandle {
+  // Reference count, kInCacheBit and kUsageBit.
+  std::atomic<uint32_t> flags{0};
+  // Read by lookups before the handle is referenced, so it is atomic.
+  std::atomic<uint32_t> hash{0};
+  size_t charge = 0;
+  void* value = nullptr;
+  void (*deleter)(const Slice& key, void* value) = nullptr;
+  std::string key;
+
+  static bool InCache(uint32_t flags) {
+    return (flags & kInCacheBit) != 0;
+  }
+
+  static uint32_t CountRefs(uint32_t flags) {
+    return flags >> kRefsOffset;
+  }
+};
+
+// Open addressing hash table with linear probing. It is modified only under the shard mutex,
+// while lookups probe it concurrently. Entries are removed using backward shift deletion, so
+// there are no tombstones and the table is grown only when number of entries increases.
+class ClockHandleTable {
+ public:
+  explicit ClockHandleTable(size_t size)
+      : mask_(size - 1), slots_(new std::atomic<ClockHandle*>[size]) {
+    for (size_t i = 0; i != size; ++i) {
+      slots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  size_t size() const {
+    return mask_ + 1;
+  }
+
+  size_t num_entries() const {
+    return num_entries_;
+  }
+
+  // Returns handle that could correspond to the key with the specified hash, starting probing at
+  // *index. Should be called without mutex, returned handle should be referenced and checked.
+  ClockHandle* Probe(uint32_t hash, size_t* index, size_t* num_probes) const {
+    for (; *num_probes <= mask_; ++*num_probes) {
+      auto* handle = slots_[*index].load(std::memory_order_acquire);
+      *index = (*index + 1) & mask_;
+      if (handle == nullptr) {
+        break;
+      }
+      if (handle->hash.load(std::memory_order_relaxed) == hash) {
+        ++*num_probes;
+        return handle;
+      }
+    }
+    *num_probes = mask_ + 1;
+    return nullptr;
+  }
+
+  size_t HomeIndex(uint32_t hash) const {
+    return hash & mask_;
+  }
+
+  // Finds slot index of the handle with the specified key. Requires shard mutex.
+  size_t FindKey(const Slice& key, uint32_t hash) const {
+    for (size_t i = HomeIndex(hash);; i = (i + 1) & mask_) {
+      auto* handle = slots_[i].load(std::memory_order_relaxed);
+      if (handle == nullptr ||
+          (handle->hash.load(std::memory_order_relaxed) == hash && Slice(handle->key) == key)) {
+        return i;
+      }
+    }
+  }
+
+  // Finds slot index of the specified handle. Requires shard mutex.
+  size_t FindHandle(ClockHandle* handle) const {
+    for (size_t i = HomeIndex(handle->hash.load(std::memory_order_relaxed));;
+         i = (i + 1) & mask_) {
+      auto* current = slots_[i].load(std::memory_order_relaxed);
+      if (current == handle || current == nullptr) {
+        return i;
+      }
+    }
+  }
+
+  ClockHandle* Get(size_t index) const {
+    return slots_[index].load(std::memory_order_relaxed);
+  }
+
+  // Stores handle in the slot returned by FindKey. Requires shard mutex.
+  void Set(size_t index, ClockHandle* handle) {
+    if (slots_[index].load(std::memory_order_relaxed) == nullptr) {
+      ++num_entries_;
+    }
+    slots_[index].store(handle, std::memory_order_release);
+  }
+
+  // Removes handle from the specified slot. Requires shard mutex.
+  void Remove(size_t index) {
+    --num_entries_;
+    size_t next = index;
+    for (;;) {
+      next = (next + 1) & mask_;
+      auto* handle = slots_[next].load(std::memory_order_relaxed);
+      if (handle == nullptr) {
+        break;
+      }
+      // Handle stays in place when its home slot is cyclically in (index, next].
+      auto home = HomeIndex(handle->hash.load(std::memory_order_relaxed));
+      if (index <= next ? (index < home && home <= next) : (index < home || home <= next)) {
+        continue;
+      }
+      slots_[index].store(handle, std::memory_order_release);
+      index = next;
+    }
+    slots_[index].store(nullptr, std::memory_order_release);
+  }
+
+ private:
+  const size_t mask_;
+  std::unique_ptr<std::atomic<ClockHandle*>[]> slots_;
+  size_t num_entries_ = 0;
+};
+
+// Values of removed entries, deleters are invoked after the shard mutex is released.
+class ClockValueDeleter {
+ public:
+  explicit ClockValueDeleter(yb::CacheMetrics* metrics) : metrics_(metrics) {}
+
+  ClockValueDeleter(const ClockValueDeleter&) = delete;
+  void operator=(const ClockValueDeleter&) = delete;
+
+  void Add(std::string&& key, void* value, void (*deleter)(const Slice& key, void* value),
+           size_t charge) {
+    entries_.push_back(Entry {
+      .key = std::move(key), .value = value, .deleter = deleter, .charge = charge
+    });
+  }
+
+  ~ClockValueDeleter() {
+    for (auto& entry : entries_) {
+      (*entry.deleter)(entry.key, entry.value);
+      if (metrics_ != nullptr) {
+        metrics_->multi_touch_cache_usage->DecrementBy(entry.charge);
+        metrics_->cache_usage->DecrementBy(entry.charge);
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    void* value;
+    void (*deleter)(const Slice& key, void* value);
+    size_t charge;
+  };
+
+  yb::CacheMetrics* metrics_;
+  std::vector<Entry> entries_;
+};
+
+// A single shard of sharded clock cache.
+class ClockCacheShard {
+ public:
+  ClockCacheShard() {
+    tables_.push_back(std::make_unique<ClockHandleTable>(kInitialTableSize));
+    table_.store(tables_.back().get(), std::memory_order_release);
+  }
+
+  ~ClockCacheShard() {
+    for (auto& handle : handles_) {
+      auto flags = handle.flags.load(std::memory_order_relaxed);
+      DCHECK_EQ(ClockHandle::CountRefs(flags), 0U);
+      if (ClockHandle::InCache(flags)) {
+        (*handle.deleter)(handle.key, handle.value);
+      }
+    }
+  }
+
+  // Should be called before the shard is used by other threads.
+  void SetMetrics(const std::shared_ptr<yb::CacheMetrics>& metrics) {
+    metrics_ = metrics;
+  }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) {
+    MutexLock l(&mutex_);
+    strict_capacity_limit_ = strict_capacity_limit;
+  }
+
+  void SetCapacity(size_t capacity) {
+    ClockValueDeleter deleted(metrics_.get());
+    MutexLock l(&mutex_);
+    capacity_ = capacity;
+    EvictFromClock(0, &deleted);
+  }
+
+  Status Insert(const Slice& key, uint32_t hash, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Cache::Handle** handle, Statistics* statistics);
+
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, Statistics* statistics);
+
+  void Release(ClockHandle* handle);
+
+  void Erase(const Slice& key, uint32_t hash);
+
+  size_t Evict(size_t required);
+
+  size_t GetUsage() const {
+    return usage_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetPinnedUsage() const;
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe);
+
+ private:
+  // Increments reference count of the handle if it is in cache.
+  static bool TryRef(ClockHandle* handle);
+
+  // Decrements reference count and returns true when it was the last reference to the handle
+  // that is not in cache anymore.
+  static bool Unref(ClockHandle* handle);
+
+  // Evicts unreferenced entries until there is enough space for the new entry of specified
+  // charge, or every entry was visited twice. Requires mutex.
+  void EvictFromClock(size_t charge, ClockValueDeleter* deleted);
+
+  // Evicts the handle if it is in cache, unreferenced and was not used since the last visit of
+  // the clock hand. Returns true if the handle was evicted. Requires mutex.
+  bool TryEvict(ClockHandle* handle, ClockValueDeleter* deleted);
+
+  // Marks the handle as not in cache, and frees it when it is not referenced. Requires mutex.
+  void RemoveFromCache(ClockHandle* handle, ClockValueDeleter* deleted);
+
+  // Moves value of the handle that is neither referenced nor in cache to deleted, and makes
+  // handle available for reuse. Requires mutex.
+  void Free(ClockHandle* handle, ClockValueDeleter* deleted);
+
+  ClockHandle* NewHandle();
+
+  // Returns table to insert a new entry to, growing it when it is too full. Requires mutex.
+  ClockHandleTable* TableForInsert();
+
+  void RecordLookup(ClockHandle* handle, Statistics* statistics);
+
+  mutable port::Mutex mutex_;
+
+  // Current hash table, read by lookups without the mutex.
+  std::atomic<ClockHandleTable*> table_{nullptr};
+  // Current and replaced hash tables, replaced tables are retained for concurrent lookups.
+  std::vector<std::unique_ptr<ClockHandleTable>> tables_;
+
+  // All handles of the shard, handles are never deallocated.
+  std::deque<ClockHandle> handles_;
+  // Handles that could be reused for new entries.
+  std::vector<ClockHandle*> free_handles_;
+  size_t clock_hand_ = 0;
+
+  size_t capacity_ = 0;
+  bool strict_capacity_limit_ = false;
+  // Charge of all entries that were not freed yet, including referenced entries that were
+  // removed from cache.
+  std::atomic<size_t> usage_{0};
+
+  std::shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+bool ClockCacheShard::TryRef(ClockHandle* handle) {
+  auto flags = handle->flags.load(std::memory_order_relaxed);
+  do {
+    if (!ClockHandle::InCache(flags)) {
+      return false;
+    }
+  } while (!handle->flags.compare_exchange_weak(
+      flags, (flags + kOneRef) | kUsageBit, std::memory_order_acquire,
+      std::memory_order_relaxed));
+  return true;
+}
+
+bool ClockCacheShard::Unref(ClockHandle* handle) {
+  auto flags = handle->flags.fetch_sub(kOneRef, std::memory_order_acq_rel);
+  DCHECK_GT(ClockHandle::CountRefs(flags), 0U);
+  return ClockHandle::CountRefs(flags) == 1 && !ClockHandle::InCache(flags);
+}
+
+ClockHandle* ClockCacheShard::NewHandle() {
+  if (!free_handles_.empty()) {
+    auto* result = free_handles_.back();
+    free_handles_.pop_back();
+    return result;
+  }
+  return &handles_.emplace_back();
+}
+
+ClockHandleTable* ClockCacheShard::TableForInsert() {
+  auto* table = table_.load(std::memory_order_relaxed);
+  // Keep load factor under 0.5, so probe sequences are short.
+  if ((table->num_entries() + 1) * 2 <= table->size()) {
+    return table;
+  }
+  auto new_table = std::make_unique<ClockHandleTable>(table->size() * 2);
+  for (size_t i = 0; i != table->size(); ++i) {
+    auto* handle = table->Get(i);
+    if (handle != nullptr) {
+      new_table->Set(new_table->FindHandle(handle), handle);
+    }
+  }
+  table = new_table.get();
+  tables_.push_back(std::move(new_table));
+  table_.store(table, std::memory_order_release);
+  return table;
+}
+
+void ClockCacheShard::Free(ClockHandle* handle, ClockValueDeleter* deleted) {
+  usage_.fetch_sub(handle->charge, std::memory_order_relaxed);
+  deleted->Add(std::move(handle->key), handle->value, handle->deleter, handle->charge);
+  handle->key.clear();
+  handle->value = nullptr;
+  free_handles_.push_back(handle);
+}
+
+void ClockCacheShard::RemoveFromCache(ClockHandle* handle, ClockValueDeleter* deleted) {
+  auto flags = handle->flags.fetch_and(~kInCacheBit, std::memory_order_acq_rel);
+  DCHECK(ClockHandle::InCache(flags));
+  if (ClockHandle::CountRefs(flags) == 0) {
+    Free(handle, deleted);
+  }
+}
+
+bool ClockCacheShard::TryEvict(ClockHandle* handle, ClockValueDeleter* deleted) {
+  auto flags = handle->flags.load(std::memory_order_relaxed);
+  if (!ClockHandle::InCache(flags) || ClockHandle::CountRefs(flags) != 0) {
+    return false;
+  }
+  if (flags & kUsageBit) {
+    // Second chance for the recently used entry.
+    handle->flags.fetch_and(~kUsageBit, std::memory_order_relaxed);
+    return false;
+  }
+  // Fails if the handle was referenced concurrently.
+  if (!handle->flags.compare_exchange_strong(flags, 0, std::memory_order_acquire)) {
+    return false;
+  }
+  auto* table = table_.load(std::memory_order_relaxed);
+  table->Remove(table->FindHandle(handle));
+  Free(handle, deleted);
+  return true;
+}
+
+void ClockCacheShard::EvictFromClock(size_t charge, ClockValueDeleter* deleted) {
+  size_t steps_left = 2 * handles_.size();
+  while (usage_.load(std::memory_order_relaxed) + charge > capacity_ && steps_left > 0) {
+    --steps_left;
+    if (clock_hand_ >= handles_.size()) {
+      clock_hand_ = 0;
+    }
+    TryEvict(&handles_[clock_hand_++], deleted);
+  }
+}
+
+Status ClockCacheShard::Insert(const Slice& key, uint32_t hash, void* value, size_t charge,
+                               void (*deleter)(const Slice& key, void* value),
+                               Cache::Handle** handle, Statistics* statistics) {
+  ClockValueDeleter deleted(metrics_.get());
+  Status s;
+  {
+    MutexLock l(&mutex_);
+    EvictFromClock(charge, &deleted);
+    if (strict_capacity_limit_ && usage_.load(std::memory_order_relaxed) + charge > capacity_) {
+      if (handle == nullptr) {
+        // Not accounted in usage, so zero charge is used.
+        deleted.Add(key.ToString(), value, deleter, 0);
+      } else {
+        *handle = nullptr;
+      }
+      s = STATUS(Incomplete, "Insert failed due to clock cache being full.");
+    } else {
+      auto* e = NewHandle();
+      e->key.assign(key.cdata(), key.size());
+      e->hash.store(hash, std::memory_order_relaxed);
+      e->charge = charge;
+      e->value = value;
+      e->deleter = deleter;
+      // Lookup that references reused handle should see its new fields.
+      e->flags.store(kInCacheBit | (handle != nullptr ? kOneRef : 0), std::memory_order_release);
+      usage_.fetch_add(charge, std::memory_order_relaxed);
+
+      auto* table = TableForInsert();
+      auto index = table->FindKey(key, hash);
+      auto* old = table->Get(index);
+      // Release store in Set publishes the handle fields to lookups.
+      table->Set(index, e);
+      if (old != nullptr) {
+        RemoveFromCache(old, &deleted);
+      }
+      if (handle != nullptr) {
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+    }
+  }
+  if (statistics != nullptr) {
+    if (s.ok()) {
+      RecordTick(statistics, BLOCK_CACHE_ADD);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+      RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_ADD);
+      RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, charge);
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    }
+  }
+  if (s.ok() && metrics_ != nullptr) {
+    metrics_->multi_touch_cache_usage->IncrementBy(charge);
+    metrics_->cache_usage->IncrementBy(charge);
+  }
+  return s;
+}
+
+Cache::Handle* ClockCacheShard::Lookup(const Slice& key, uint32_t hash, Statistics* statistics) {
+  const auto* table = table_.load(std::memory_order_acquire);
+  size_t index = table->HomeIndex(hash);
+  size_t num_probes = 0;
+  ClockHandle* result = nullptr;
+  while (auto* handle = table->Probe(hash, &index, &num_probes)) {
+    if (!TryRef(handle)) {
+      continue;
+    }
+    // Handle could be reused for another key before it was referenced.
+    if (handle->hash.load(std::memory_order_relaxed) == hash && Slice(handle->key) == key) {
+      result = handle;
+      break;
+    }
+    Release(handle);
+  }
+  RecordLookup(result, statistics);
+  return reinterpret_cast<Cache::Handle*>(result);
+}
+
+void ClockCacheShard::RecordLookup(ClockHandle* handle, Statistics* statistics) {
+  if (statistics != nullptr) {
+    if (handle != nullptr) {
+      RecordTick(statistics, BLOCK_CACHE_HIT);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, handle->charge);
+      RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_HIT);
+      RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, handle->charge);
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_MISS);
+    }
+  }
+  if (metrics_ != nullptr) {
+    metrics_->lookups->Increment();
+    if (handle != nullptr) {
+      metrics_->cache_hits->Increment();
+    } else {
+      metrics_->cache_misses->Increment();
+    }
+  }
+}
+
+void ClockCacheShard::Release(ClockHandle* handle) {
+  if (!Unref(handle)) {
+    return;
+  }
+  ClockValueDeleter deleted(metrics_.get());
+  MutexLock l(&mutex_);
+  Free(handle, &deleted);
+}
+
+void ClockCacheShard::Erase(const Slice& key, uint32_t hash) {
+  ClockValueDeleter deleted(metrics_.get());
+  MutexLock l(&mutex_);
+  auto* table = table_.load(std::memory_order_relaxed);
+  auto index = table->FindKey(key, hash);
+  auto* handle = table->Get(index);
+  if (handle != nullptr) {
+    table->Remove(index);
+    RemoveFromCache(handle, &deleted);
+  }
+}
+
+size_t ClockCacheShard::Evict(size_t required) {
+  ClockValueDeleter deleted(metrics_.get());
+  MutexLock l(&mutex_);
+  size_t steps_left = 2 * handles_.size();
+  size_t evicted = 0;
+  while (evicted < required && steps_left > 0) {
+    --steps_left;
+    if (clock_hand_ >= handles_.size()) {
+      clock_hand_ = 0;
+    }
+    auto* handle = &handles_[clock_hand_++];
+    const auto charge = handle->charge;
+    if (TryEvict(handle, &deleted)) {
+      evicted += charge;
+    }
+  }
+  return evicted;
+}
+
+size_t ClockCacheShard::GetPinnedUsage() const {
+  MutexLock l(&mutex_);
+  size_t result = 0;
+  for (const auto& handle : handles_) {
+    if (ClockHandle::CountRefs(handle.flags.load(std::memory_order_relaxed)) != 0) {
+      result += handle.charge;
+    }
+  }
+  return result;
+}
+
+void ClockCacheShard::ApplyToAllCacheEntries(
+    void (*callback)(void*, size_t), bool thread_safe) {
+  if (thread_safe) {
+    mutex_.Lock();
+  }
+  for (const auto& handle : handles_) {
+    if (ClockHandle::InCache(handle.flags.load(std::memory_order_relaxed))) {
+      callback(handle.value, handle.charge);
+    }
+  }
+  if (thread_safe) {
+    mutex_.Unlock();
+  }
+}
+
+class ShardedClockCache : public Cache {
+ private:
+  ClockCacheShard* shards_;
+  port::Mutex capacity_mutex_;
+  std::atomic<uint64_t> last_id_{0};
+  size_t num_shard_bits_;
+  size_t capacity_;
+  bool strict_capacity_limit_;
+
+  static inline uint32_t HashSlice(const Slice& s) {
+    return Hash(s.data(), s.size(), 0);
+  }
+
+  uint32_t Shard(uint32_t hash) const {
+    return (num_shard_bits_ > 0) ? (hash >> (32 - num_shard_bits_)) : 0;
+  }
+
+  size_t num_shards() const {
+    return 1ULL << num_shard_bits_;
+  }
+
+ public:
+  ShardedClockCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
+      : num_shard_bits_(num_shard_bits),
+        capacity_(capacity),
+        strict_capacity_limit_(strict_capacity_limit) {
+    shards_ = new ClockCacheShard[num_shards()];
+    const size_t per_shard = (capacity + (num_shards() - 1)) / num_shards();
+    for (size_t s = 0; s != num_shards(); ++s) {
+      shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+      shards_[s].SetCapacity(per_shard);
+    }
+  }
+
+  virtual ~ShardedClockCache() {
+    delete[] shards_;
+  }
+
+  void SetCapacity(size_t capacity) override {
+    const size_t per_shard = (capacity + (num_shards() - 1)) / num_shards();
+    MutexLock l(&capacity_mutex_);
+    for (size_t s = 0; s != num_shards(); ++s) {
+      shards_[s].SetCapacity(per_shard);
+    }
+    capacity_ = capacity;
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    // Queries with no cache query ids are not cached.
+    if (query_id == kNoCacheQueryId) {
+      return Status::OK();
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Insert(key, hash, value, charge, deleter, handle, statistics);
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    if (query_id == kNoCacheQueryId) {
+      return nullptr;
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Lookup(key, hash, statistics);
+  }
+
+  void Release(Handle* handle) override {
+    if (handle == nullptr) {
+      return;
+    }
+    auto* h = reinterpret_cast<ClockHandle*>(handle);
+    shards_[Shard(h->hash.load(std::memory_order_relaxed))].Release(h);
+  }
+
+  void Erase(const Slice& key) override {
+    const uint32_t hash = HashSlice(key);
+    shards_[Shard(hash)].Erase(key, hash);
+  }
+
+  size_t Evict(size_t bytes_to_evict) override {
+    size_t total_evicted = 0;
+    // Start at random shard.
+    auto index = Shard(yb::RandomUniformInt<uint32_t>());
+    for (size_t i = 0; bytes_to_evict > total_evicted && i != num_shards(); ++i) {
+      total_evicted += shards_[index].Evict(bytes_to_evict - total_evicted);
+      index = (index + 1) & (num_shards() - 1);
+    }
+    return total_evicted;
+  }
+
+  void* Value(Handle* handle) override {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+  }
+
+  uint64_t NewId() override {
+    return ++last_id_;
+  }
+
+  size_t GetCapacity() const override { return capacity_; }
+
+  bool HasStrictCapacityLimit() const override {
+    return strict_capacity_limit_;
+  }
+
+  size_t GetUsage() const override {
+    size_t usage = 0;
+    for (size_t s = 0; s != num_shards(); ++s) {
+      usage += shards_[s].GetUsage();
+    }
+    return usage;
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return reinterpret_cast<ClockHandle*>(handle)->charge;
+  }
+
+  size_t GetPinnedUsage() const override {
+    size_t usage = 0;
+    for (size_t s = 0; s != num_shards(); ++s) {
+      usage += shards_[s].GetPinnedUsage();
+    }
+    return usage;
+  }
+
+  void DisownData() override {
+    shards_ = nullptr;
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    for (size_t s = 0; s != num_shards(); ++s) {
+      shards_[s].ApplyToAllCacheEntries(callback, thread_safe);
+    }
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    auto metrics = std::make_shared<yb::CacheMetrics>(entity);
+    for (size_t s = 0; s != num_shards(); ++s) {
+      shards_[s].SetMetrics(metrics);
+    }
+  }
+
+  // Clock cache does not have single touch part, so all entries are reported as multi touch.
+  std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
+    std::vector<std::pair<size_t, size_t>> cache_sizes;
+    cache_sizes.reserve(num_shards());
+    for (size_t s = 0; s != num_shards(); ++s) {
+      cache_sizes.emplace_back(0, shards_[s].GetUsage());
+    }
+    return cache_sizes;
+  }
+};
+
+} // namespace
+
+std::shared_ptr<Cache> NewClockCache(
+    size_t capacity, int num_shard_bits, bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(capacity, num_shard_bits, strict_capacity_limit);
+}
+
+}  // namespace rocksdb
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
@@ -53,6 +54,71 @@
 
 namespace rocksdb {
 
+// Dictionary used to compress data blocks of the SST file. Data blocks of DocDB are small and
+// similar to each other, so compressing them with dictionary of content typical for the file
+// allows to find matches that are not present in the block itself.
+class CompressionDict {
+ public:
+  explicit CompressionDict(std::string dict) : dict_(std::move(dict)) {}
+
+  CompressionDict(const CompressionDict&) = delete;
+  void operator=(const CompressionDict&) = delete;
+
+  const std::string& data() const {
+    return dict_;
+  }
+
+ private:
+  std::string dict_;
+};
+
+// Dictionary used to uncompress data blocks of the SST file. Loaded once when the table reader is
+// opened, and shared by all readers of the table.
+class UncompressionDict {
+ public:
+  explicit UncompressionDict(std::string dict) : dict_(std::move(dict)) {}
+
+  UncompressionDict(const UncompressionDict&) = delete;
+  void operator=(const UncompressionDict&) = delete;
+
+  const std::string& data() const {
+    return dict_;
+  }
+
+  size_t memory_usage() const {
+    return dict_.capacity();
+  }
+
+ private:
+  std::string dict_;
+};
+
+// Builds dictionary of at most max_dict_bytes from the specified data, that contains contents of
+// the data blocks. The dictionary consists of samples taken uniformly from the data, so it
+// contains content typical for all data blocks of the file.
+// Compressors prefer matches at the end of the dictionary, so the data is used in its original
+// order.
+inline std::string BuildCompressionDictionary(const std::string& data, size_t max_dict_bytes) {
+  constexpr size_t kSampleSize = 64;
+  if (data.size() <= max_dict_bytes) {
+    return data;
+  }
+  const size_t num_samples = std::max<size_t>(max_dict_bytes / kSampleSize, 1);
+  const size_t sample_size = std::min(kSampleSize, max_dict_bytes);
+  const size_t stride = (data.size() - sample_size) / std::max<size_t>(num_samples - 1, 1);
+  std::string result;
+  result.reserve(num_samples * sample_size);
+  for (size_t i = 0; i != num_samples; ++i) {
+    result.append(data, i * stride, sample_size);
+  }
+  return result;
+}
+
+// Whether data blocks compressed with the specified type could use compression dictionary.
+inline bool CompressionDictSupported(CompressionType compression_type) {
+  return compression_type == kZlibCompression || compression_type == kLZ4Compression;
+}
+
 inline bool Snappy_Supported() {
 #ifdef SNAPPY
   return true;
@@ -198,7 +264,8 @@ inline bool GetDecompressedSizeInfo(const char** input_data,
 inline bool Zlib_Compress(const CompressionOptions& opts,
                           uint32_t compress_format_version,
                           const char* input, size_t length,
-                          ::std::string* output) {
+                          ::std::string* output,
+                          const CompressionDict* dict = nullptr) {
 #ifdef YB_ZLIB
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -228,6 +295,16 @@ inline bool Zlib_Compress(const CompressionOptions& opts,
     return false;
   }
 
+  if (dict) {
+    st = deflateSetDictionary(
+        &_stream, reinterpret_cast<const Bytef*>(dict->data().data()),
+        static_cast<unsigned int>(dict->data().size()));
+    if (st != Z_OK) {
+      deflateEnd(&_stream);
+      return false;
+    }
+  }
+
   // Compress the input, and put compressed data in output.
   _stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input));
   _stream.avail_in = static_cast<unsigned int>(length);
@@ -265,10 +342,13 @@ inline bool Zlib_Compress(const CompressionOptions& opts,
 // block header
 // compress_format_version == 2 -- decompressed size is included in the block
 // header in varint32 format
+// Blocks compressed with dictionary could be uncompressed only when the same dictionary is
+// provided.
 inline char* Zlib_Uncompress(const char* input_data, size_t input_length,
                              int* decompress_size,
                              uint32_t compress_format_version,
-                             int windowBits = -14) {
+                             int windowBits = -14,
+                             const UncompressionDict* dict = nullptr) {
 #ifdef YB_ZLIB
   uint32_t output_len = 0;
   if (compress_format_version == 2) {
@@ -297,6 +377,17 @@ inline char* Zlib_Uncompress(const char* input_data, size_t input_length,
     return nullptr;
   }
 
+  // Raw inflate accepts dictionary before any data is processed.
+  if (dict) {
+    st = inflateSetDictionary(
+        &_stream, reinterpret_cast<const Bytef*>(dict->data().data()),
+        static_cast<unsigned int>(dict->data().size()));
+    if (st != Z_OK) {
+      inflateEnd(&_stream);
+      return nullptr;
+    }
+  }
+
   _stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input_data));
   _stream.avail_in = static_cast<unsigned int>(input_length);
 
@@ -498,7 +589,8 @@ inline char* BZip2_Uncompress(const char* input_data, size_t input_length,
 // header in varint32 format
 inline bool LZ4_Compress(const CompressionOptions& opts,
                          uint32_t compress_format_version, const char* input,
-                         size_t length, ::std::string* output) {
+                         size_t length, ::std::string* output,
+                         const CompressionDict* dict = nullptr) {
 #ifdef LZ4
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -521,9 +613,19 @@ inline bool LZ4_Compress(const CompressionOptions& opts,
 
   int compressBound = LZ4_compressBound(static_cast<int>(length));
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  int outlen =
-      LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
-                                 static_cast<int>(length), compressBound);
+  int outlen;
+  if (dict) {
+    // LZ4 uses only the last 64KB of the dictionary.
+    LZ4_stream_t* stream = LZ4_createStream();
+    LZ4_loadDict(stream, dict->data().data(), static_cast<int>(dict->data().size()));
+    outlen = LZ4_compress_fast_continue(
+        stream, input, &(*output)[output_header_len], static_cast<int>(length), compressBound,
+        /* acceleration= */ 1);
+    LZ4_freeStream(stream);
+  } else {
+    outlen = LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
+                                        static_cast<int>(length), compressBound);
+  }
   if (outlen == 0) {
     return false;
   }
@@ -537,9 +639,12 @@ inline bool LZ4_Compress(const CompressionOptions& opts,
 // block header using memcpy, which makes database non-portable)
 // compress_format_version == 2 -- decompressed size is included in the block
 // header in varint32 format
+// Blocks compressed with dictionary could be uncompressed only when the same dictionary is
+// provided.
 inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
                             int* decompress_size,
-                            uint32_t compress_format_version) {
+                            uint32_t compress_format_version,
+                            const UncompressionDict* dict = nullptr) {
 #ifdef LZ4
   uint32_t output_len = 0;
   if (compress_format_version == 2) {
@@ -559,9 +664,15 @@ inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
     input_data += 8;
   }
   char* output = new char[output_len];
-  *decompress_size =
-      LZ4_decompress_safe(input_data, output, static_cast<int>(input_length),
-                          static_cast<int>(output_len));
+  if (dict) {
+    *decompress_size = LZ4_decompress_safe_usingDict(
+        input_data, output, static_cast<int>(input_length), static_cast<int>(output_len),
+        dict->data().data(), static_cast<int>(dict->data().size()));
+  } else {
+    *decompress_size =
+        LZ4_decompress_safe(input_data, output, static_cast<int>(input_length),
+                            static_cast<int>(output_len));
+  }
   if (*decompress_size < 0) {
     delete[] output;
     return nullptr;
@@ -116,6 +116,9 @@ class RandomAccessFileReader {
   Status Read(uint64_t offset, size_t n, Slice* result, char* scratch) const;
   Status ReadAndValidate(
       uint64_t offset, size_t n, Slice* result, char* scratch, const yb::ReadValidator& validator);
+  // Performs several reads, that could be kept in flight concurrently. See
+  // yb::RandomAccessFile::MultiRead.
+  Status MultiRead(yb::ReadRequest* requests, size_t num_requests) const;
 
   RandomAccessFile* file() { return file_.get(); }
 };
@@ -824,8 +824,20 @@ Status ParseColumnFamilyOption(const std::string& name,
         return STATUS(InvalidArgument,
             "unable to parse the specified CF option " + name);
       }
+      end = value.find(':', start);
       new_options->compression_opts.strategy =
-          ParseInt(value.substr(start, value.size() - start));
+          ParseInt(value.substr(start, end == std::string::npos ? end : end - start));
+      // Dictionary options are optional, to keep accepting values without them.
+      if (end != std::string::npos) {
+        start = end + 1;
+        end = value.find(':', start);
+        new_options->compression_opts.max_dict_bytes = static_cast<uint32_t>(
+            ParseUint64(value.substr(start, end == std::string::npos ? end : end - start)));
+        if (end != std::string::npos) {
+          new_options->compression_opts.max_dict_buffer_bytes =
+              static_cast<uint32_t>(ParseUint64(value.substr(end + 1)));
+        }
+      }
     } else if (name == "compaction_options_fifo") {
       new_options->compaction_options_fifo.max_table_files_size =
           ParseUint64(value);
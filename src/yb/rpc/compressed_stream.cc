@@ -27,18 +27,52 @@
 #include "yb/rpc/outbound_data.h"
 #include "yb/rpc/refined_stream.h"
 #include "yb/rpc/reactor_thread_role.h"
+#include "yb/rpc/rpc_introspection.pb.h"
 
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/flags.h"
+#include "yb/util/strongly_typed_bool.h"
 
 using namespace std::literals;
 
 DEFINE_UNKNOWN_int32(stream_compression_algo, 0, "Algorithm used for stream compression. "
                                          "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4.");
 
+DEFINE_RUNTIME_uint32(stream_compression_min_savings_percent, 10,
+    "Connection sends data without compression for a while, when compression of the last "
+    "stream_compression_sample_bytes saved less than the specified percent of bytes. "
+    "0 to always compress.");
+
+DEFINE_RUNTIME_uint64(stream_compression_sample_bytes, 1_MB,
+    "Number of bytes used to evaluate efficiency of compression of the connection.");
+
+DEFINE_RUNTIME_uint64(stream_compression_skip_bytes, 16_MB,
+    "Number of bytes that connection sends without compression when compression was not "
+    "efficient, before trying to compress data again.");
+
+METRIC_DEFINE_simple_counter(
+  server, stream_compression_input_bytes, "Bytes passed to RPC stream compression",
+  yb::MetricUnit::kBytes);
+
+METRIC_DEFINE_simple_counter(
+  server, stream_compression_output_bytes,
+  "Bytes produced by RPC stream compression, including bytes sent without compression",
+  yb::MetricUnit::kBytes);
+
+METRIC_DEFINE_simple_counter(
+  server, stream_compression_skipped_bytes,
+  "Bytes sent by compressed RPC streams without compression, because compression of the "
+  "connection was not efficient", yb::MetricUnit::kBytes);
+
+METRIC_DEFINE_simple_counter(
+  server, stream_compression_time_us, "Time spent compressing data of RPC streams",
+  yb::MetricUnit::kMicroseconds);
+
 namespace yb {
 namespace rpc {
 
@@ -46,6 +80,8 @@ using SmallRefCntBuffers = ByteBlocks;
 
 namespace {
 
+YB_STRONGLY_TYPED_BOOL(CompressData);
+
 class Compressor {
  public:
   virtual std::string ToString() const = 0;
@@ -53,9 +89,13 @@ class Compressor {
   // Initialize compressor, required since we don't use exceptions to return error from ctor.
   virtual Status Init() = 0;
 
-  // Compress specified vector of input buffers into single output buffer.
-  virtual Status Compress(
-      const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data) = 0;
+  // Compress specified vector of input buffers and send result to the lower layer of the stream.
+  // When compress_data is false, input is stored in the format of the compressor without
+  // compression, so it could be read by the regular decompressor.
+  // Returns the number of bytes sent to the lower layer.
+  virtual Result<size_t> Compress(
+      const SmallRefCntBuffers& input, CompressData compress_data, RefinedStream* stream,
+      OutboundDataPtr data) = 0;
 
   // Decompress specified input slice to specified output buffer.
   virtual Result<ReadBufferFull> Decompress(StreamReadBuffer* inp, StreamReadBuffer* out) = 0;
@@ -178,13 +218,25 @@ class ZlibCompressor : public Compressor {
     return "Zlib";
   }
 
-  Status Compress(
-      const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data)
-      ON_REACTOR_THREAD override {
+  Result<size_t> Compress(
+      const SmallRefCntBuffers& input, CompressData compress_data, RefinedStream* stream,
+      OutboundDataPtr data) ON_REACTOR_THREAD override {
     RefCntBuffer output(deflateBound(&deflate_stream_, TotalLen(input)));
     deflate_stream_.avail_out = static_cast<unsigned int>(output.size());
     deflate_stream_.next_out = output.udata();
 
+    if (compress_data != compress_data_) {
+      // Previous call flushed all input, so changing level does not produce additional output.
+      // Level 0 makes deflate emit stored blocks, that are read by inflate as usual.
+      int res = deflateParams(
+          &deflate_stream_, compress_data ? Z_DEFAULT_COMPRESSION : Z_NO_COMPRESSION,
+          Z_DEFAULT_STRATEGY);
+      if (res != Z_OK) {
+        return STATUS_FORMAT(RuntimeError, "Cannot change deflate level: $0", res);
+      }
+      compress_data_ = compress_data;
+    }
+
     for (auto it = input.begin(); it != input.end();) {
       const auto& buf = *it++;
       deflate_stream_.next_in = const_cast<Bytef*>(buf.udata());
@@ -210,10 +262,12 @@ class ZlibCompressor : public Compressor {
     }
 
     output.Shrink(deflate_stream_.next_out - output.udata());
+    auto result = output.size();
 
     // Send compressed data to underlying stream.
-    return stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
-        std::move(output), std::move(data)));
+    RETURN_NOT_OK(stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
+        std::move(output), std::move(data))));
+    return result;
   }
 
   Result<ReadBufferFull> Decompress(StreamReadBuffer* inp, StreamReadBuffer* out) override {
@@ -239,6 +293,7 @@ class ZlibCompressor : public Compressor {
   z_stream inflate_stream_;
   bool deflate_inited_ = false;
   bool inflate_inited_ = false;
+  CompressData compress_data_ = CompressData::kTrue;
 };
 
 // Source implementation that provides input from range of buffers.
@@ -376,6 +431,45 @@ static size_t FindMaxChunkSize(size_t header_len, const F& max_compressed_len) {
 constexpr size_t kSnappyHeaderLen = 2;
 const size_t kSnappyMaxChunkSize = FindMaxChunkSize(kSnappyHeaderLen, &snappy::MaxCompressedLength);
 
+// Stores data provided by source as snappy block with single literal, i.e. without compression.
+// Returns size of the block, that does not exceed snappy::MaxCompressedLength of the data.
+size_t StoreSnappyBlock(snappy::Source* source, char* out) {
+  auto* p = out;
+  // Block starts with varint encoded length of uncompressed data.
+  auto len = source->Available();
+  for (auto left = len; ; left >>= 7) {
+    if (left < 0x80) {
+      *p++ = static_cast<char>(left);
+      break;
+    }
+    *p++ = static_cast<char>(left | 0x80);
+  }
+  if (len == 0) {
+    return p - out;
+  }
+  // Literal tag contains length - 1, or the number of following bytes that contain it.
+  auto literal_len = len - 1;
+  if (literal_len < 60) {
+    *p++ = static_cast<char>(literal_len << 2);
+  } else {
+    auto* tag = p++;
+    size_t num_bytes = 0;
+    for (; literal_len; literal_len >>= 8) {
+      *p++ = static_cast<char>(literal_len & 0xff);
+      ++num_bytes;
+    }
+    *tag = static_cast<char>((59 + num_bytes) << 2);
+  }
+  while (source->Available()) {
+    size_t fragment_len = 0;
+    const auto* fragment = source->Peek(&fragment_len);
+    memcpy(p, fragment, fragment_len);
+    p += fragment_len;
+    source->Skip(fragment_len);
+  }
+  return p - out;
+}
+
 class SnappyCompressor : public Compressor {
  public:
   static constexpr char kId = 'S';
@@ -400,11 +494,12 @@ class SnappyCompressor : public Compressor {
     return "Snappy";
   }
 
-  Status Compress(
-      const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data)
-      ON_REACTOR_THREAD override {
+  Result<size_t> Compress(
+      const SmallRefCntBuffers& input, CompressData compress_data, RefinedStream* stream,
+      OutboundDataPtr data) ON_REACTOR_THREAD override {
     RangeSource<SmallRefCntBuffers::const_iterator> source(input.begin(), input.end());
     auto input_size = source.Available();
+    size_t result = 0;
     bool stop = false;
     while (!stop) {
       // Split input into chunks of size kSnappyMaxChunkSize or less.
@@ -416,17 +511,23 @@ class SnappyCompressor : public Compressor {
         stop = true;
       }
       RefCntBuffer output(kHeaderLen + snappy::MaxCompressedLength(source.Available()));
-      snappy::UncheckedByteArraySink sink(output.data() + kHeaderLen);
-      auto compressed_len = snappy::Compress(&source, &sink);
+      size_t compressed_len;
+      if (compress_data) {
+        snappy::UncheckedByteArraySink sink(output.data() + kHeaderLen);
+        compressed_len = snappy::Compress(&source, &sink);
+      } else {
+        compressed_len = StoreSnappyBlock(&source, output.data() + kHeaderLen);
+      }
       BigEndian::Store16(output.data(), compressed_len);
       output.Shrink(kHeaderLen + compressed_len);
+      result += output.size();
       RETURN_NOT_OK(stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
           std::move(output),
           // We processed last buffer, attach data to it, so it will be notified when this buffer
           // is transferred.
           stop ? std::move(data) : nullptr)));
     }
-    return Status::OK();
+    return result;
   }
 
   Result<ReadBufferFull> Decompress(StreamReadBuffer* inp, StreamReadBuffer* out) override {
@@ -508,6 +609,26 @@ constexpr size_t kLZ4HeaderLen = 2;
 const size_t kLZ4MaxChunkSize = FindMaxChunkSize(kLZ4HeaderLen, &LZ4_compressBound);
 const size_t kLZ4BufferSize = 64_KB;
 
+// Stores chunk as LZ4 block with single sequence of literals, i.e. without compression.
+// Returns size of the block, that does not exceed LZ4_compressBound of the chunk size.
+int StoreLZ4Block(Slice chunk, char* out) {
+  auto* p = out;
+  // High 4 bits of the token contain length of literals, 15 means that the length continues in
+  // the following bytes.
+  auto len = chunk.size();
+  if (len < 15) {
+    *p++ = static_cast<char>(len << 4);
+  } else {
+    *p++ = static_cast<char>(15 << 4);
+    for (len -= 15; len >= 255; len -= 255) {
+      *p++ = static_cast<char>(255);
+    }
+    *p++ = static_cast<char>(len);
+  }
+  memcpy(p, chunk.data(), chunk.size());
+  return narrow_cast<int>(p + chunk.size() - out);
+}
+
 class LZ4DecompressState {
  public:
   LZ4DecompressState(char* input_buffer, char* output_buffer, Slice* prev_decompress_data_left)
@@ -685,9 +806,10 @@ class LZ4Compressor : public Compressor {
     return "LZ4";
   }
 
-  Status Compress(
-      const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data)
-      ON_REACTOR_THREAD override {
+  Result<size_t> Compress(
+      const SmallRefCntBuffers& input, CompressData compress_data, RefinedStream* stream,
+      OutboundDataPtr data) ON_REACTOR_THREAD override {
+    size_t result = 0;
     // Increment iterator in loop body to be able to check whether it is last iteration or not.
     for (auto input_it = input.begin(); input_it != input.end();) {
       Slice input_slice = input_it->AsSlice();
@@ -702,13 +824,16 @@ class LZ4Compressor : public Compressor {
         }
         input_slice.remove_prefix(chunk.size());
         RefCntBuffer output(kHeaderLen + LZ4_compressBound(narrow_cast<int>(chunk.size())));
-        int res = LZ4_compress(
-            chunk.cdata(), output.data() + kHeaderLen, narrow_cast<int>(chunk.size()));
+        int res = compress_data
+            ? LZ4_compress(
+                  chunk.cdata(), output.data() + kHeaderLen, narrow_cast<int>(chunk.size()))
+            : StoreLZ4Block(chunk, output.data() + kHeaderLen);
         if (res <= 0) {
           return STATUS_FORMAT(RuntimeError, "LZ4 compression failed: $0", res);
         }
         BigEndian::Store16(output.data(), res);
         output.Shrink(kHeaderLen + res);
+        result += output.size();
         RETURN_NOT_OK(stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
             std::move(output),
             // We processed last buffer, attach data to it, so it will be notified when this buffer
@@ -717,7 +842,7 @@ class LZ4Compressor : public Compressor {
       }
     }
 
-    return Status::OK();
+    return result;
   }
 
   Result<ReadBufferFull> Decompress(StreamReadBuffer* inp, StreamReadBuffer* out) override {
@@ -761,13 +886,73 @@ BOOST_PP_SEQ_FOR_EACH(YB_CREATE_COMPRESSOR_CASE, kIndex, YB_COMPRESSION_ALGORITH
   }
 }
 
+// Decides whether data sent over the connection should be compressed.
+// Compression that saved less than stream_compression_min_savings_percent of the last
+// stream_compression_sample_bytes is not worth the CPU spent, for instance when the data is already
+// compressed or encrypted. So connection sends next stream_compression_skip_bytes without
+// compression, and then evaluates compression again.
+// Data sent without compression is stored in the format of the compressor, so this decision is
+// local to the sending side of the connection.
+// Connection that is disabled by StreamCompressionFilter never compresses data it sends.
+class AdaptiveCompressionPolicy {
+ public:
+  explicit AdaptiveCompressionPolicy(CompressData enabled) : enabled_(enabled) {}
+
+  CompressData enabled() const {
+    return enabled_;
+  }
+
+  CompressData ShouldCompress() const {
+    return CompressData(enabled_ && skip_bytes_left_ == 0);
+  }
+
+  // Returns true when compression was disabled for the connection by this call.
+  bool DataSent(CompressData compress_data, size_t input_size, size_t output_size) {
+    if (!compress_data) {
+      skip_bytes_left_ -= std::min(skip_bytes_left_, input_size);
+      return false;
+    }
+    sample_input_size_ += input_size;
+    sample_output_size_ += output_size;
+    if (sample_input_size_ < FLAGS_stream_compression_sample_bytes) {
+      return false;
+    }
+    const auto min_savings_percent = std::min<size_t>(
+        FLAGS_stream_compression_min_savings_percent, 100);
+    const auto efficient = min_savings_percent == 0 ||
+        sample_output_size_ * 100 <= sample_input_size_ * (100 - min_savings_percent);
+    sample_input_size_ = 0;
+    sample_output_size_ = 0;
+    if (efficient) {
+      return false;
+    }
+    skip_bytes_left_ = FLAGS_stream_compression_skip_bytes;
+    return skip_bytes_left_ != 0;
+  }
+
+ private:
+  const CompressData enabled_;
+  size_t sample_input_size_ = 0;
+  size_t sample_output_size_ = 0;
+  size_t skip_bytes_left_ = 0;
+};
+
 class CompressedRefiner : public StreamRefiner {
  public:
-  CompressedRefiner() = default;
+  CompressedRefiner(const scoped_refptr<MetricEntity>& metric_entity, CompressData enabled)
+      : policy_(enabled) {
+    if (metric_entity) {
+      input_bytes_counter_ = METRIC_stream_compression_input_bytes.Instantiate(metric_entity);
+      output_bytes_counter_ = METRIC_stream_compression_output_bytes.Instantiate(metric_entity);
+      skipped_bytes_counter_ = METRIC_stream_compression_skipped_bytes.Instantiate(metric_entity);
+      time_counter_ = METRIC_stream_compression_time_us.Instantiate(metric_entity);
+    }
+  }
 
  private:
   void Start(RefinedStream* stream) override {
     stream_ = stream;
+    VLOG_IF_WITH_PREFIX(1, !policy_.enabled()) << "Compression is disabled by filter";
   }
 
   Status ProcessHeader() ON_REACTOR_THREAD override {
@@ -798,7 +983,28 @@ class CompressedRefiner : public StreamRefiner {
   Status Send(OutboundDataPtr data) ON_REACTOR_THREAD override {
     boost::container::small_vector<RefCntSlice, 10> input;
     data->Serialize(&input);
-    return compressor_->Compress(input, stream_, std::move(data));
+    const auto input_size = TotalLen(input);
+    const auto compress_data = policy_.ShouldCompress();
+    const auto start = MonoTime::Now();
+    const auto output_size = VERIFY_RESULT(compressor_->Compress(
+        input, compress_data, stream_, std::move(data)));
+    const auto time_us = (MonoTime::Now() - start).ToMicroseconds();
+    IncrementCounterBy(time_counter_, time_us);
+    IncrementCounterBy(input_bytes_counter_, input_size);
+    IncrementCounterBy(output_bytes_counter_, output_size);
+    input_bytes_ += input_size;
+    output_bytes_ += output_size;
+    compression_time_us_ += time_us;
+    if (!compress_data) {
+      IncrementCounterBy(skipped_bytes_counter_, input_size);
+      skipped_bytes_ += input_size;
+    }
+    if (policy_.DataSent(compress_data, input_size, output_size)) {
+      VLOG_WITH_PREFIX(1)
+          << "Compression is not efficient, skip compression of next "
+          << FLAGS_stream_compression_skip_bytes << " bytes";
+    }
+    return Status::OK();
   }
 
   Status Handshake() ON_REACTOR_THREAD override {
@@ -828,12 +1034,37 @@ class CompressedRefiner : public StreamRefiner {
     return compressor_ ? compressor_->ToString() : "PLAIN";
   }
 
+  void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) override {
+    if (!compressor_) {
+      return;
+    }
+    auto& compression = *resp->mutable_compression();
+    compression.set_algorithm(compressor_->ToString());
+    compression.set_enabled(policy_.enabled());
+    compression.set_input_bytes(input_bytes_);
+    compression.set_output_bytes(output_bytes_);
+    compression.set_skipped_bytes(skipped_bytes_);
+    compression.set_compression_time_us(compression_time_us_);
+  }
+
   const std::string& LogPrefix() const {
     return stream_->LogPrefix();
   }
 
   RefinedStream* stream_ = nullptr;
   std::unique_ptr<Compressor> compressor_ = nullptr;
+  AdaptiveCompressionPolicy policy_;
+
+  // Statistics of this connection, server level metrics below aggregate them over all connections.
+  uint64_t input_bytes_ = 0;
+  uint64_t output_bytes_ = 0;
+  uint64_t skipped_bytes_ = 0;
+  uint64_t compression_time_us_ = 0;
+
+  CounterPtr input_bytes_counter_;
+  CounterPtr output_bytes_counter_;
+  CounterPtr skipped_bytes_counter_;
+  CounterPtr time_counter_;
 };
 
 } // namespace
@@ -844,10 +1075,13 @@ const Protocol* CompressedStreamProtocol() {
 }
 
 StreamFactoryPtr CompressedStreamFactory(
-    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker) {
+    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker,
+    StreamCompressionFilter filter) {
   return std::make_shared<RefinedStreamFactory>(
-      std::move(lower_layer_factory), buffer_tracker, [](const StreamCreateData& data) {
-    return std::make_unique<CompressedRefiner>();
+      std::move(lower_layer_factory), buffer_tracker,
+      [filter = std::move(filter)](const StreamCreateData& data) {
+    return std::make_unique<CompressedRefiner>(
+        data.metric_entity, CompressData(!filter || filter(data)));
   });
 }
 
@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <boost/version.hpp>
 
 #include "yb/rpc/rpc_fwd.h"
@@ -22,9 +24,16 @@
 namespace yb {
 namespace rpc {
 
+// Returns whether connection created with the specified data should compress data it sends.
+// For instance compression could be used only for connections to peers in other zones.
+// Connection that does not compress data still sends it in the format of the compressor, so the
+// peer reads it as usual.
+using StreamCompressionFilter = std::function<bool(const StreamCreateData& data)>;
+
 const Protocol* CompressedStreamProtocol();
 StreamFactoryPtr CompressedStreamFactory(
-    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker);
+    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker,
+    StreamCompressionFilter filter = StreamCompressionFilter());
 
 }  // namespace rpc
 }  // namespace yb
@@ -44,6 +44,9 @@ LocalOutboundCall::LocalOutboundCall(
 
 Status LocalOutboundCall::SetRequestParam(
     AnyMessageConstPtr req, const MemTrackerPtr& mem_tracker) {
+  if (!controller()->request_tail().empty()) {
+    return STATUS(NotSupported, "Request tail is not supported by local calls");
+  }
   req_ = req;
   return Status::OK();
 }
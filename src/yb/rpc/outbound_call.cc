@@ -211,11 +211,22 @@ void OutboundCall::NotifyTransferred(const Status& status, Connection* conn) {
 void OutboundCall::Serialize(ByteBlocks* output) {
   output->emplace_back(std::move(buffer_));
   buffer_consumption_ = ScopedTrackedConsumption();
+  for (auto& block : request_tail_) {
+    output->push_back(std::move(block));
+  }
+  request_tail_.clear();
 }
 
 Status OutboundCall::SetRequestParam(AnyMessageConstPtr req, const MemTrackerPtr& mem_tracker) {
+  request_tail_ = std::move(controller_->request_tail_);
+  controller_->request_tail_.clear();
+  size_t tail_size = 0;
+  for (const auto& block : request_tail_) {
+    tail_size += block.size();
+  }
+
   auto req_size = req.SerializedSize();
-  size_t message_size = SerializedMessageSize(req_size, 0);
+  size_t message_size = SerializedMessageSize(req_size, tail_size);
 
   using Output = google::protobuf::io::CodedOutputStream;
   auto timeout_ms = VERIFY_RESULT(TimeoutMs());
@@ -236,7 +247,8 @@ Status OutboundCall::SetRequestParam(AnyMessageConstPtr req, const MemTrackerPtr
 
   // 1. The length for the whole request, not including the 4-byte
   // length prefix.
-  NetworkByteOrder::Store32(dst, narrow_cast<uint32_t>(total_size - kMsgLengthPrefixLength));
+  NetworkByteOrder::Store32(
+      dst, narrow_cast<uint32_t>(total_size + tail_size - kMsgLengthPrefixLength));
   dst += sizeof(uint32_t);
 
   // 2. The varint-prefixed RequestHeader PB
@@ -253,9 +265,9 @@ Status OutboundCall::SetRequestParam(AnyMessageConstPtr req, const MemTrackerPtr
   if (mem_tracker) {
     buffer_consumption_ = ScopedTrackedConsumption(mem_tracker, buffer_.size());
   }
-  RETURN_NOT_OK(SerializeMessage(req, req_size, buffer_, 0, header_size));
+  RETURN_NOT_OK(SerializeMessage(req, req_size, buffer_, tail_size, header_size));
   if (method_metrics_) {
-    IncrementCounterBy(method_metrics_->request_bytes, buffer_.size());
+    IncrementCounterBy(method_metrics_->request_bytes, buffer_.size() + tail_size);
   }
   return Status::OK();
 }
@@ -429,6 +429,10 @@ class OutboundCall : public RpcCall {
   // Consumption of buffer_. Same synchronization rules as buffer_.
   ScopedTrackedConsumption buffer_consumption_;
 
+  // Already serialized fields of the request, sent after buffer_. Taken from the controller,
+  // same synchronization rules as buffer_.
+  std::vector<RefCntSlice> request_tail_;
+
   // Once a response has been received for this call, contains that response.
   // This is written to by the reactor thread, and read by the client thread after the call is
   // complete, so no synchronization is needed, and the functions extracting data from this object
@@ -51,6 +51,7 @@ bool RefinedStream::Idle(std::string* reason) {
 
 void RefinedStream::DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {
   lower_stream_->DumpPB(req, resp);
+  refiner_->DumpPB(req, resp);
 }
 
 const Endpoint& RefinedStream::Remote() const {
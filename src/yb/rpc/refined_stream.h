@@ -37,6 +37,8 @@ class StreamRefiner {
 
   virtual std::string ToString() const = 0;
 
+  virtual void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {}
+
   virtual ~StreamRefiner() = default;
 };
 
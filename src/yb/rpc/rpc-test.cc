@@ -61,6 +61,7 @@
 #include "yb/util/format.h"
 #include "yb/util/logging_test_util.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
@@ -76,6 +77,7 @@ METRIC_DECLARE_histogram(rpc_incoming_queue_time);
 METRIC_DECLARE_counter(tcp_bytes_sent);
 METRIC_DECLARE_counter(tcp_bytes_received);
 METRIC_DECLARE_counter(rpcs_timed_out_early_in_queue);
+METRIC_DECLARE_counter(stream_compression_skipped_bytes);
 
 DEFINE_UNKNOWN_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -86,6 +88,8 @@ DECLARE_bool(enable_rpc_keepalive);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int64(rpc_throttle_threshold_bytes);
 DECLARE_int32(stream_compression_algo);
+DECLARE_uint64(stream_compression_sample_bytes);
+DECLARE_uint64(stream_compression_skip_bytes);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_string(vmodule);
 DECLARE_uint64(rpc_connection_timeout_ms);
@@ -1230,7 +1234,7 @@ class TestRpcCompression : public RpcTestBase, public testing::WithParamInterfac
     builder.SetListenProtocol(CompressedStreamProtocol());
     builder.AddStreamFactory(
         CompressedStreamProtocol(),
-        CompressedStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker()));
+        CompressedStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker(), filter_));
     return EXPECT_RESULT(builder.Build());
   }
 
@@ -1241,6 +1245,8 @@ class TestRpcCompression : public RpcTestBase, public testing::WithParamInterfac
       return CreateCompressedMessenger(name, options);
     }, f);
   }
+
+  StreamCompressionFilter filter_;
 };
 
 TEST_P(TestRpcCompression, Simple) {
@@ -1310,6 +1316,82 @@ TEST_P(TestRpcCompression, Compression) {
   });
 }
 
+void TestAdaptiveCompression(CalculatorServiceProxy* proxy, const MetricEntityPtr& metric_entity) {
+  constexpr size_t kStringLen = 4_KB;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_stream_compression_sample_bytes) = kStringLen;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_stream_compression_skip_bytes) = kStringLen * 4;
+
+  // Requests are distributed between connections, so send enough of them to each connection.
+  const auto num_echoes = 10 * FLAGS_num_connections_to_server;
+  auto echo_all = [proxy, num_echoes](const std::function<std::string()>& data_generator) {
+    for (int i = 0; i != num_echoes; ++i) {
+      RpcController controller;
+      controller.set_timeout(5s * kTimeMultiplier);
+      rpc_test::EchoRequestPB req;
+      req.set_data(data_generator());
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(proxy->Echo(req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+    }
+  };
+
+  // Random data could not be compressed, so connections send it without compression.
+  ASSERT_NO_FATALS(echo_all([] { return RandomString(kStringLen); }));
+  auto skipped_counter = ASSERT_RESULT(GetCounter(
+      metric_entity, METRIC_stream_compression_skipped_bytes));
+  ASSERT_GT(skipped_counter->value(), 0);
+
+  // After stream_compression_skip_bytes connections compress data again, and continue to do so
+  // while it is efficient.
+  ASSERT_NO_FATALS(echo_all([] { return std::string(kStringLen, 'Y'); }));
+  auto skipped_bytes = skipped_counter->value();
+  ASSERT_NO_FATALS(echo_all([] { return std::string(kStringLen, 'Y'); }));
+  ASSERT_EQ(skipped_counter->value(), skipped_bytes);
+}
+
+TEST_P(TestRpcCompression, AdaptiveCompression) {
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    TestAdaptiveCompression(proxy, metric_entity());
+  });
+}
+
+TEST_P(TestRpcCompression, CompressionFilter) {
+  constexpr size_t kStringLen = 4_KB;
+
+  // Inbound connections don't have remote hostname, so only server side of connections is
+  // disabled by this filter.
+  filter_ = [](const StreamCreateData& data) {
+    return !data.remote_hostname.empty();
+  };
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    for (int i = 0; i != 10 * FLAGS_num_connections_to_server; ++i) {
+      RpcController controller;
+      controller.set_timeout(5s * kTimeMultiplier);
+      rpc_test::EchoRequestPB req;
+      req.set_data(std::string(kStringLen, 'Y'));
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(proxy->Echo(req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+    }
+
+    DumpRunningRpcsRequestPB dump_req;
+    DumpRunningRpcsResponsePB dump_resp;
+    ASSERT_OK(server_messenger()->DumpRunningRpcs(dump_req, &dump_resp));
+    uint64_t total_input_bytes = 0;
+    for (const auto& connection : dump_resp.inbound_connections()) {
+      SCOPED_TRACE(connection.ShortDebugString());
+      ASSERT_TRUE(connection.has_compression());
+      const auto& compression = connection.compression();
+      ASSERT_FALSE(compression.enabled());
+      ASSERT_EQ(compression.skipped_bytes(), compression.input_bytes());
+      // Data is sent in the format of the compressor, so it is not smaller than the input.
+      ASSERT_GE(compression.output_bytes(), compression.input_bytes());
+      total_input_bytes += compression.input_bytes();
+    }
+    ASSERT_GT(total_input_bytes, kStringLen);
+  });
+}
+
 std::string CompressionName(const testing::TestParamInfo<int>& info) {
   switch (info.param) {
     case 1: return "Zlib";
@@ -32,6 +32,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -39,6 +40,7 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status_fwd.h"
 
 namespace yb {
@@ -140,6 +142,17 @@ class RpcController {
   // Return the configured timeout.
   MonoDelta timeout() const;
 
+  // Sets already serialized fields that are appended to the request message of the next remote
+  // call, after the fields of the request itself. The blocks are sent as is, without copying, so
+  // the same bytes could be shared by requests to multiple servers. Local calls do not support it.
+  void set_request_tail(std::vector<RefCntSlice> tail) {
+    request_tail_ = std::move(tail);
+  }
+
+  const std::vector<RefCntSlice>& request_tail() const {
+    return request_tail_;
+  }
+
   // Assign sidecar with specified index to out.
   Result<RefCntSlice> ExtractSidecar(int idx) const;
 
@@ -163,6 +176,9 @@ class RpcController {
   bool allow_local_calls_in_curr_thread_ = false;
   InvokeCallbackMode invoke_callback_mode_ = InvokeCallbackMode::kThreadPoolNormal;
 
+  // Taken by the outbound call when the request is serialized.
+  std::vector<RefCntSlice> request_tail_;
+
   DISALLOW_COPY_AND_ASSIGN(RpcController);
 };
 
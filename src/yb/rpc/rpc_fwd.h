@@ -86,6 +86,7 @@ struct ProcessCallsResult;
 struct ReactorMetrics;
 struct RpcMethodMetrics;
 struct RpcMetrics;
+struct StreamCreateData;
 
 class RpcService;
 using RpcServicePtr = scoped_refptr<RpcService>;
@@ -878,6 +878,29 @@ TEST_F(RpcStubTest, TrafficMetrics) {
   ASSERT_LT(proxy_request_bytes->value(), kUpperBytesLimit);
 }
 
+// Checks that request tail is sent after the fields of the request, and that the same tail could be
+// used by multiple calls.
+TEST_F(RpcStubTest, RequestTail) {
+  CalculatorServiceProxy proxy(proxy_cache_.get(), server_hostport_);
+
+  // Fields of a message with the same field could be concatenated, the last value wins.
+  rpc_test::EchoRequestPB tail_req;
+  tail_req.set_data(RandomHumanReadableString(1_KB));
+  const auto tail_str = tail_req.SerializeAsString();
+  RefCntBuffer tail(tail_str);
+
+  for (int i = 0; i != 2; ++i) {
+    RpcController controller;
+    controller.set_request_tail({RefCntSlice(tail)});
+    rpc_test::EchoRequestPB req;
+    req.set_data("request");
+    rpc_test::EchoResponsePB resp;
+    ASSERT_OK(proxy.Echo(req, &resp, &controller));
+    ASSERT_EQ(resp.data(), tail_req.data());
+    ASSERT_TRUE(controller.request_tail().empty());
+  }
+}
+
 template <class T>
 std::string ReversedAsString(T t) {
   std::reverse(t.begin(), t.end());
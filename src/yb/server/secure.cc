@@ -13,13 +13,18 @@
 
 #include "yb/server/secure.h"
 
+#include "yb/common/placement_info.h"
+
 #include "yb/fs/fs_manager.h"
 
 #include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/secure_stream.h"
+#include "yb/rpc/stream.h"
 #include "yb/rpc/tcp_stream.h"
 
+#include "yb/server/server_base_options.h"
+
 #include "yb/util/env.h"
 #include "yb/util/format.h"
 #include "yb/util/net/net_util.h"
@@ -63,6 +68,27 @@ DEFINE_UNKNOWN_string(cert_file_pattern, "node.$0.crt", "Pattern used for certif
 DEFINE_UNKNOWN_bool(enable_stream_compression, true,
     "Whether it is allowed to use stream compression.");
 
+DEFINE_RUNTIME_string(stream_compression_skip_locality, "",
+    "Do not compress data sent to peers with the specified locality: zone - peers in the same "
+    "zone, region - peers in the same region. Empty to compress data sent to all peers. "
+    "Data sent to peers with unknown placement is always compressed. Applied to new "
+    "connections.");
+
+namespace {
+
+bool ValidateStreamCompressionSkipLocality(const char* flag_name, const std::string& value) {
+  if (value.empty() || value == "zone" || value == "region") {
+    return true;
+  }
+  LOG(ERROR) << "Invalid value for '" << flag_name << "': " << value
+             << ", should be empty, zone or region";
+  return false;
+}
+
+} // namespace
+
+DEFINE_validator(stream_compression_skip_locality, &ValidateStreamCompressionSkipLocality);
+
 namespace yb {
 namespace server {
 
@@ -82,6 +108,23 @@ string CertsDir(const std::string& root_dir, SecureContextType type) {
   return certs_dir;
 }
 
+// Decides whether connection should compress data it sends, using placement of its peer.
+bool ShouldCompressConnection(const rpc::StreamCreateData& data) {
+  const std::string skip_locality = FLAGS_stream_compression_skip_locality;
+  if (skip_locality.empty()) {
+    return true;
+  }
+  // Inbound connections don't have remote hostname, so look up peer by its address.
+  auto peer_cloud_info = PeerPlacementRegistry::Instance().Find(
+      data.remote_hostname.empty() ? data.remote.address().to_string() : data.remote_hostname);
+  if (!peer_cloud_info) {
+    return true;
+  }
+  auto locality = PlacementInfoConverter::GetLocalityLevel(
+      GetPlacementFromGFlags(), *peer_cloud_info);
+  return locality < (skip_locality == "zone" ? LocalityLevel::kZone : LocalityLevel::kRegion);
+}
+
 } // namespace
 
 bool IsNodeToNodeEncryptionEnabled() {
@@ -138,7 +181,8 @@ void ApplyCompressedStream(
       -1, "Compressed Read Buffer", parent_mem_tracker);
   builder->AddStreamFactory(
       rpc::CompressedStreamProtocol(),
-      rpc::CompressedStreamFactory(std::move(lower_layer_factory), buffer_tracker));
+      rpc::CompressedStreamFactory(
+          std::move(lower_layer_factory), buffer_tracker, &ShouldCompressConnection));
 }
 
 Result<std::unique_ptr<rpc::SecureContext>> SetupSecureContext(
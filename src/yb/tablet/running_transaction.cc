@@ -18,12 +18,16 @@
 #include "yb/common/hybrid_time.h"
 #include "yb/common/pgsql_error.h"
 
+#include "yb/docdb/rocksdb_writer.h"
+
+#include "yb/tablet/shared_transaction_status_cache.h"
 #include "yb/tablet/transaction_participant_context.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/trace.h"
 #include "yb/util/tsan_util.h"
 #include "yb/util/yb_pg_errcodes.h"
@@ -40,6 +44,12 @@ DEFINE_UNKNOWN_int64(transaction_abort_check_interval_ms, 5000 * yb::kTimeMultip
 DEFINE_UNKNOWN_int64(transaction_abort_check_timeout_ms, 30000 * yb::kTimeMultiplier,
              "Timeout used when checking for aborted transactions.");
 
+DEFINE_RUNTIME_AUTO_bool(batch_transaction_status_requests, kLocalVolatile, false, true,
+    "Request statuses of transactions with the same status tablet, that are resolved by the "
+    "participant concurrently, in a single RPC.");
+
+DECLARE_uint64(txn_intents_cache_max_records);
+
 namespace yb {
 namespace tablet {
 
@@ -73,9 +83,38 @@ void RunningTransaction::AddReplicatedBatch(
   replicated_batches_.EncodeTo(encoded_replicated_batches);
 }
 
-void RunningTransaction::BatchReplicated(const TransactionalBatchData& value) {
+void RunningTransaction::BatchReplicated(
+    const TransactionalBatchData& value, const docdb::CachedIntents* intents) {
   VLOG_WITH_PREFIX(4) << __func__ << "(" << value.ToString() << ")";
   last_batch_data_ = value;
+
+  if (!cached_intents_) {
+    return;
+  }
+  // Cache without intents of some batch is useless, so it is dropped as a whole.
+  if (!intents ||
+      cached_intents_->num_records() + intents->num_records() >
+          FLAGS_txn_intents_cache_max_records ||
+      cached_intents_consumption_.mem_tracker()->AnyLimitExceeded()) {
+    VLOG_WITH_PREFIX(4) << "Drop intents cache of " << cached_intents_->num_records()
+                        << " records";
+    cached_intents_.reset();
+    cached_intents_consumption_ = ScopedTrackedConsumption();
+    return;
+  }
+  cached_intents_->Append(*intents);
+  cached_intents_consumption_.Reset(cached_intents_->memory_usage());
+}
+
+void RunningTransaction::StartCachingIntents(MemTrackerPtr mem_tracker) {
+  cached_intents_ = std::make_unique<docdb::CachedIntents>();
+  cached_intents_consumption_ = ScopedTrackedConsumption(
+      std::move(mem_tracker), cached_intents_->memory_usage());
+}
+
+std::unique_ptr<docdb::CachedIntents> RunningTransaction::TakeCachedIntents() {
+  cached_intents_consumption_ = ScopedTrackedConsumption();
+  return std::move(cached_intents_);
 }
 
 void RunningTransaction::SetLocalCommitData(
@@ -123,6 +162,9 @@ void RunningTransaction::RequestStatusAt(const StatusRequest& request,
       return;
     }
   }
+  if (RequestStatusFromSharedCache(request, lock)) {
+    return;
+  }
   bool was_empty = status_waiters_.empty();
   status_waiters_.push_back(request);
   if (!was_empty) {
@@ -140,6 +182,51 @@ void RunningTransaction::RequestStatusAt(const StatusRequest& request,
   SendStatusRequest(request_id, shared_self);
 }
 
+bool RunningTransaction::RequestStatusFromSharedCache(
+    const StatusRequest& request, std::unique_lock<std::mutex>* lock) {
+  if (!context_.shared_status_cache_ || external_transaction()) {
+    return false;
+  }
+  auto info = context_.shared_status_cache_->Get(id());
+  if (!info) {
+    return false;
+  }
+  // Should match UpdateStatus.
+  auto time_of_status = info->status == TransactionStatus::ABORTED && info->coordinator_safe_time
+      ? info->coordinator_safe_time : info->status_ht;
+  auto transaction_status = GetStatusAt(
+      request.global_limit_ht, time_of_status, info->status, external_transaction());
+  if (!transaction_status) {
+    return false;
+  }
+  VLOG_WITH_PREFIX(4) << "Status from shared cache: " << info->ToString() << ", requested: "
+                      << request.ToString();
+  SubtxnSet aborted_subtxn_set;
+  if (transaction_status == TransactionStatus::COMMITTED ||
+      transaction_status == TransactionStatus::PENDING) {
+    aborted_subtxn_set = info->aborted_subtxn_set;
+  }
+
+  // Remember the status, so the following requests are served without the shared cache, and
+  // cleanup aborted transaction, as it would be done for the status received from coordinator.
+  auto shared_self = shared_from_this();
+  {
+    MinRunningNotifier min_running_notifier(&context_.applier_);
+    auto did_abort_txn = UpdateStatus(
+        info->status, info->status_ht, info->coordinator_safe_time, info->aborted_subtxn_set);
+    if (did_abort_txn) {
+      context_.NotifyAborted(id());
+      context_.EnqueueRemoveUnlocked(id(), RemoveReason::kStatusReceived, &min_running_notifier);
+    }
+    lock->unlock();
+  }
+
+  context_.metric_shared_status_cache_hits_->Increment();
+  request.callback(TransactionStatusResult{
+      *transaction_status, time_of_status, aborted_subtxn_set});
+  return true;
+}
+
 bool RunningTransaction::WasAborted() const {
   return last_known_status_ == TransactionStatus::ABORTED;
 }
@@ -234,6 +321,12 @@ void RunningTransaction::SendStatusRequest(
     int64_t serial_no, const RunningTransactionPtr& shared_self) {
   TRACE_FUNC();
   VTRACE(1, yb::ToString(metadata_.transaction_id));
+  if (FLAGS_batch_transaction_status_requests) {
+    context_.status_request_batcher_.Request(
+        metadata_.status_tablet, metadata_.transaction_id,
+        std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self));
+    return;
+  }
   tserver::GetTransactionStatusRequestPB req;
   req.set_tablet_id(metadata_.status_tablet);
   req.add_transaction_id()->assign(
@@ -356,6 +449,16 @@ void RunningTransaction::DoStatusReceived(const Status& status,
         << response.ShortDebugString();
     auto coordinator_safe_time = response.coordinator_safe_time().size() == 1
         ? HybridTime::FromPB(response.coordinator_safe_time(0)) : HybridTime();
+    if (context_.shared_status_cache_ && time_of_status != HybridTime::kMin &&
+        !external_transaction()) {
+      context_.shared_status_cache_->Put(TransactionStatusInfo {
+        .transaction_id = id(),
+        .status = transaction_status,
+        .aborted_subtxn_set = aborted_subtxn_set,
+        .status_ht = time_of_status,
+        .coordinator_safe_time = coordinator_safe_time,
+      });
+    }
     auto did_abort_txn = UpdateStatus(
         transaction_status, time_of_status, coordinator_safe_time, aborted_subtxn_set);
     if (did_abort_txn) {
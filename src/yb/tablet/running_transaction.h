@@ -96,7 +96,17 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
   void SetLocalCommitData(HybridTime time, const SubtxnSet& aborted_subtxn_set);
   void AddReplicatedBatch(
       size_t batch_idx, boost::container::small_vector_base<uint8_t>* encoded_replicated_batches);
-  void BatchReplicated(const TransactionalBatchData& value);
+  // Intents of the replicated batch are added to the intents cache, when it is started and not
+  // null.
+  void BatchReplicated(const TransactionalBatchData& value, const docdb::CachedIntents* intents);
+
+  // Starts keeping strong write intents of this transaction in memory, so it could be applied
+  // without reading them from the intents DB. Should be invoked before the first batch of the
+  // transaction is replicated.
+  void StartCachingIntents(MemTrackerPtr mem_tracker);
+
+  // Returns cached intents when all intents of the transaction are cached, null otherwise.
+  std::unique_ptr<docdb::CachedIntents> TakeCachedIntents();
   void RequestStatusAt(const StatusRequest& request,
                        std::unique_lock<std::mutex>* lock);
   bool WasAborted() const;
@@ -138,6 +148,11 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
       TransactionStatus last_known_status,
       bool external_transaction);
 
+  // Responds to the request using status received by participant of another tablet, when it
+  // covers the requested time. Returns true if request was responded, releasing the lock.
+  bool RequestStatusFromSharedCache(
+      const StatusRequest& request, std::unique_lock<std::mutex>* lock);
+
   void SendStatusRequest(int64_t serial_no, const RunningTransactionPtr& shared_self);
 
   void StatusReceived(const Status& status,
@@ -193,6 +208,9 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
 
   // Time of the next check whether this transaction has been aborted.
   HybridTime abort_check_ht_;
+
+  std::unique_ptr<docdb::CachedIntents> cached_intents_;
+  ScopedTrackedConsumption cached_intents_consumption_;
 };
 
 Status MakeAbortedStatus(const TransactionId& id);
@@ -28,9 +28,11 @@
 
 #include "yb/tablet/transaction_intent_applier.h"
 #include "yb/tablet/transaction_participant.h"
+#include "yb/tablet/transaction_status_resolver.h"
 
 #include "yb/util/delayer.h"
 #include "yb/util/math_util.h"
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/shared_lock.h"
 #include "yb/util/status_callback.h"
 
@@ -62,8 +64,10 @@ typedef std::shared_ptr<RunningTransaction> RunningTransactionPtr;
 class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
-                            TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+                            TransactionIntentApplier* applier,
+                            int max_transactions_in_status_request)
+      : participant_context_(*participant_context), applier_(*applier),
+        status_request_batcher_(participant_context, &rpcs_, max_transactions_in_status_request) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -94,6 +98,10 @@ class RunningTransactionContext {
   rpc::Rpcs rpcs_;
   TransactionParticipantContext& participant_context_;
   TransactionIntentApplier& applier_;
+  TransactionStatusRequestBatcher status_request_batcher_;
+  // Set before the participant is started, null when statuses are not shared with other tablets.
+  std::shared_ptr<SharedTransactionStatusCache> shared_status_cache_;
+  scoped_refptr<Counter> metric_shared_status_cache_hits_;
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
@@ -0,0 +1,116 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/shared_transaction_status_cache.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_uint64(transaction_status_cache_ttl_ms);
+DECLARE_uint64(transaction_status_cache_max_entries);
+
+namespace yb {
+namespace tablet {
+
+class SharedTransactionStatusCacheTest : public YBTest {
+ protected:
+  TransactionStatusInfo MakeInfo(
+      const TransactionId& transaction_id, TransactionStatus status, uint64_t status_ht) {
+    return TransactionStatusInfo {
+      .transaction_id = transaction_id,
+      .status = status,
+      .aborted_subtxn_set = {},
+      .status_ht = HybridTime(status_ht),
+      .coordinator_safe_time = HybridTime(),
+    };
+  }
+
+  SharedTransactionStatusCache cache_;
+};
+
+TEST_F(SharedTransactionStatusCacheTest, Replace) {
+  auto txn_id = TransactionId::GenerateRandom();
+  ASSERT_FALSE(cache_.Get(txn_id));
+
+  cache_.Put(MakeInfo(txn_id, TransactionStatus::PENDING, 2000));
+  auto info = cache_.Get(txn_id);
+  ASSERT_TRUE(info);
+  ASSERT_EQ(info->status, TransactionStatus::PENDING);
+  ASSERT_EQ(info->status_ht, HybridTime(2000));
+
+  // Older pending status does not replace the newer one.
+  cache_.Put(MakeInfo(txn_id, TransactionStatus::PENDING, 1000));
+  ASSERT_EQ(cache_.Get(txn_id)->status_ht, HybridTime(2000));
+
+  cache_.Put(MakeInfo(txn_id, TransactionStatus::PENDING, 3000));
+  ASSERT_EQ(cache_.Get(txn_id)->status_ht, HybridTime(3000));
+
+  cache_.Put(MakeInfo(txn_id, TransactionStatus::COMMITTED, 2500));
+  info = cache_.Get(txn_id);
+  ASSERT_EQ(info->status, TransactionStatus::COMMITTED);
+  ASSERT_EQ(info->status_ht, HybridTime(2500));
+
+  // Final status is never replaced.
+  cache_.Put(MakeInfo(txn_id, TransactionStatus::PENDING, 4000));
+  info = cache_.Get(txn_id);
+  ASSERT_EQ(info->status, TransactionStatus::COMMITTED);
+  ASSERT_EQ(info->status_ht, HybridTime(2500));
+}
+
+TEST_F(SharedTransactionStatusCacheTest, Expiration) {
+  constexpr auto kTtl = 500ms;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_transaction_status_cache_ttl_ms) = ToMilliseconds(kTtl);
+
+  auto txn_id = TransactionId::GenerateRandom();
+  cache_.Put(MakeInfo(txn_id, TransactionStatus::ABORTED, 1000));
+  ASSERT_TRUE(cache_.Get(txn_id));
+
+  std::this_thread::sleep_for(kTtl);
+  ASSERT_FALSE(cache_.Get(txn_id));
+
+  // Expired entries are removed by the following puts.
+  cache_.Put(MakeInfo(TransactionId::GenerateRandom(), TransactionStatus::ABORTED, 1000));
+  ASSERT_EQ(cache_.TEST_size(), 1U);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_transaction_status_cache_ttl_ms) = 0;
+  txn_id = TransactionId::GenerateRandom();
+  cache_.Put(MakeInfo(txn_id, TransactionStatus::ABORTED, 1000));
+  ASSERT_FALSE(cache_.Get(txn_id));
+}
+
+TEST_F(SharedTransactionStatusCacheTest, MaxEntries) {
+  constexpr size_t kMaxEntries = 10;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_transaction_status_cache_max_entries) = kMaxEntries;
+
+  std::vector<TransactionId> txn_ids;
+  for (size_t i = 0; i != kMaxEntries * 2; ++i) {
+    txn_ids.push_back(TransactionId::GenerateRandom());
+    cache_.Put(MakeInfo(txn_ids.back(), TransactionStatus::PENDING, 1000));
+    // Replaced entries should not be accounted twice.
+    cache_.Put(MakeInfo(txn_ids.back(), TransactionStatus::PENDING, 2000));
+    ASSERT_LE(cache_.TEST_size(), kMaxEntries);
+  }
+
+  // The oldest transactions are evicted first.
+  ASSERT_FALSE(cache_.Get(txn_ids.front()));
+  ASSERT_TRUE(cache_.Get(txn_ids.back()));
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,91 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/shared_transaction_status_cache.h"
+
+#include "yb/util/flags.h"
+
+DEFINE_RUNTIME_uint64(transaction_status_cache_ttl_ms, 1000,
+    "Time to keep transaction status received from the coordinator in the status cache shared by "
+    "transaction participants of the tablet server. 0 to disable the cache.");
+
+DEFINE_RUNTIME_uint64(transaction_status_cache_max_entries, 10000,
+    "Max number of transactions in the status cache shared by transaction participants of the "
+    "tablet server.");
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+bool IsFinal(TransactionStatus status) {
+  return status == TransactionStatus::COMMITTED || status == TransactionStatus::ABORTED;
+}
+
+} // namespace
+
+void SharedTransactionStatusCache::Put(const TransactionStatusInfo& info) {
+  const auto ttl = FLAGS_transaction_status_cache_ttl_ms;
+  if (ttl == 0) {
+    return;
+  }
+  const auto now = CoarseMonoClock::now();
+  const auto expiration = now + std::chrono::milliseconds(ttl);
+
+  std::lock_guard lock(mutex_);
+  auto [it, inserted] = entries_.try_emplace(info.transaction_id);
+  auto& entry = it->second;
+  if (!inserted && entry.expiration > now) {
+    if (IsFinal(entry.info.status) ||
+        (!IsFinal(info.status) && entry.info.status_ht >= info.status_ht)) {
+      return;
+    }
+  }
+  entry.info = info;
+  if (inserted || entry.expiration != expiration) {
+    entry.expiration = expiration;
+    expiration_queue_.emplace_back(expiration, info.transaction_id);
+  }
+  CleanupUnlocked(now);
+}
+
+boost::optional<TransactionStatusInfo> SharedTransactionStatusCache::Get(
+    const TransactionId& transaction_id) {
+  std::lock_guard lock(mutex_);
+  auto it = entries_.find(transaction_id);
+  if (it == entries_.end() || it->second.expiration <= CoarseMonoClock::now()) {
+    return boost::none;
+  }
+  return it->second.info;
+}
+
+size_t SharedTransactionStatusCache::TEST_size() {
+  std::lock_guard lock(mutex_);
+  return entries_.size();
+}
+
+void SharedTransactionStatusCache::CleanupUnlocked(CoarseTimePoint now) {
+  const auto max_entries = FLAGS_transaction_status_cache_max_entries;
+  while (!expiration_queue_.empty() &&
+         (expiration_queue_.front().first <= now || expiration_queue_.size() > max_entries)) {
+    const auto& [expiration, transaction_id] = expiration_queue_.front();
+    auto it = entries_.find(transaction_id);
+    if (it != entries_.end() && it->second.expiration == expiration) {
+      entries_.erase(it);
+    }
+    expiration_queue_.pop_front();
+  }
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/tablet/transaction_status_resolver.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tablet {
+
+// Transaction statuses received from transaction coordinators, shared by transaction participants
+// of all tablets of the tablet server.
+//
+// Participant requests status of a transaction from its coordinator when the last known status
+// does not cover the time requested by a reader or by conflict resolution. A transaction that
+// wrote to several tablets of the same server is resolved by each of their participants, so
+// participant checks this cache before sending the request.
+//
+// Entry has the same meaning as the last known status of RunningTransaction: COMMITTED and
+// ABORTED statuses are final, PENDING status is valid up to status_ht. So entry with later
+// status_ht replaces the previous one, and final status is never replaced.
+// Entries expire after transaction_status_cache_ttl_ms, and the number of entries is limited by
+// transaction_status_cache_max_entries.
+//
+// This class is thread safe.
+class SharedTransactionStatusCache {
+ public:
+  // Adds status received from the coordinator. Statuses of external transactions should not be
+  // added, since ABORTED is not final for them.
+  void Put(const TransactionStatusInfo& info);
+
+  // Returns the latest known status of the transaction, if it did not expire yet.
+  boost::optional<TransactionStatusInfo> Get(const TransactionId& transaction_id);
+
+  size_t TEST_size();
+
+ private:
+  struct Entry {
+    TransactionStatusInfo info;
+    CoarseTimePoint expiration;
+  };
+
+  void CleanupUnlocked(CoarseTimePoint now) REQUIRES(mutex_);
+
+  std::mutex mutex_;
+  std::unordered_map<TransactionId, Entry, TransactionIdHash> entries_ GUARDED_BY(mutex_);
+  // Entries in order of their expiration. Entry that was replaced leaves a stale record here,
+  // it is ignored when its expiration does not match the expiration of the entry.
+  std::deque<std::pair<CoarseTimePoint, TransactionId>> expiration_queue_ GUARDED_BY(mutex_);
+};
+
+} // namespace tablet
+} // namespace yb
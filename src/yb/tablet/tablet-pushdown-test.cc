@@ -50,6 +50,7 @@
 #include "yb/tablet/read_result.h"
 #include "yb/tablet/tablet-test-util.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 
 #include "yb/util/status_log.h"
 #include "yb/util/test_macros.h"
@@ -94,6 +95,7 @@ class TabletPushdownTest : public YBTabletTest {
   // the same set of rows. Run the scan and verify that the
   // expected rows are returned.
   void TestScanYieldsExpectedResults(int column_id, int lower, int upper) {
+    const auto read_ops_before = tablet()->metrics()->tablet_read_ops->value();
     ReadHybridTime read_time = ReadHybridTime::SingleTime(CHECK_RESULT(tablet()->SafeTime()));
     QLReadRequestPB req;
     auto* condition = req.mutable_where_expr()->mutable_condition();
@@ -109,6 +111,7 @@ class TabletPushdownTest : public YBTabletTest {
 
     ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, result.response.status())
         << "Error: " << result.response.error_message();
+    ASSERT_EQ(read_ops_before + 1, tablet()->metrics()->tablet_read_ops->value());
 
     auto row_block = CreateRowBlock(QLClient::YQL_CLIENT_CQL, schema_, rows_data.ToBuffer());
     std::vector<std::string> results;
@@ -124,7 +127,7 @@ class TabletPushdownTest : public YBTabletTest {
     ASSERT_EQ("{ int32:210, int32:2100, string:\"00000210\" }", results[10]);
   }
 
- private:
+ protected:
   int nrows_;
 };
 
@@ -132,6 +135,12 @@ TEST_F(TabletPushdownTest, TestPushdownIntKeyRange) {
   TestScanYieldsExpectedResults(kFirstColumnId, 200, 210);
 }
 
+TEST_F(TabletPushdownTest, TabletOpsMetrics) {
+  ASSERT_EQ(nrows_, tablet()->metrics()->tablet_write_ops->value());
+  ASSERT_EQ(0, tablet()->metrics()->tablet_read_ops->value());
+  TestScanYieldsExpectedResults(kFirstColumnId, 200, 210);
+}
+
 // TODO: Value range scan is not working yet, it returns 2100 rows.
 TEST_F(TabletPushdownTest, TestPushdownIntValueRange) {
   // Push down a double-ended range on the integer value column.
@@ -271,6 +271,7 @@ DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DECLARE_int64(cdc_intent_retention_ms);
+DECLARE_uint64(txn_intents_cache_max_records);
 
 DEFINE_test_flag(uint64, inject_sleep_before_applying_intents_ms, 0,
                  "Sleep before applying intents to docdb after transaction commit");
@@ -506,6 +507,9 @@ Tablet::Tablet(const TabletInitData& data)
         client_future_, clock(), DCHECK_NOTNULL(tablet_metrics_entity_),
         DCHECK_NOTNULL(data.wait_queue_pool)->NewToken(ThreadPool::ExecutionMode::SERIAL)));
     }
+    if (data.tablet_options.transaction_status_cache) {
+      transaction_participant_->SetSharedStatusCache(data.tablet_options.transaction_status_cache);
+    }
   }
 
   // Create index table metadata cache for secondary index update.
@@ -1323,6 +1327,15 @@ Status Tablet::WriteTransactionalBatch(
   if (store_metadata) {
     writer.SetMetadataToStore(&put_batch.transaction());
   }
+  // Intents of small transactions are also kept in memory by participant, so the transaction
+  // could be applied without reading them from the intents DB.
+  docdb::CachedIntents cached_intents;
+  const bool cache_intents =
+      !put_batch.transaction().external_transaction() &&
+      put_batch.write_pairs().size() <= FLAGS_txn_intents_cache_max_records;
+  if (cache_intents) {
+    writer.SetIntentsCache(&cached_intents);
+  }
   rocksdb::WriteBatch write_batch;
   write_batch.SetDirectWriter(&writer);
   RequestScope request_scope = VERIFY_RESULT(RequestScope::Create(transaction_participant_.get()));
@@ -1331,7 +1344,8 @@ Status Tablet::WriteTransactionalBatch(
 
   last_batch_data.hybrid_time = hybrid_time;
   last_batch_data.next_write_id = writer.intra_txn_write_id();
-  transaction_participant()->BatchReplicated(transaction_id, last_batch_data);
+  transaction_participant()->BatchReplicated(
+      transaction_id, last_batch_data, cache_intents ? &cached_intents : nullptr);
 
   return Status::OK();
 }
@@ -1499,6 +1513,7 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
   RETURN_NOT_OK(scoped_read_operation);
 
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  metrics_->tablet_read_ops->Increment();
 
   docdb::RedisReadOperation doc_op(redis_read_request, doc_db(), deadline, read_time);
   RETURN_NOT_OK(doc_op.Execute());
@@ -1534,6 +1549,7 @@ Status Tablet::HandleQLReadRequest(
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  metrics_->tablet_read_ops->Increment();
 
   bool schema_version_compatible = IsSchemaVersionCompatible(
       metadata()->schema_version(), ql_read_request.schema_version(),
@@ -1626,6 +1642,7 @@ Status Tablet::HandlePgsqlReadRequest(
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  metrics_->tablet_read_ops->Increment();
 
   const shared_ptr<tablet::TableInfo> table_info =
       VERIFY_RESULT(metadata_->GetTableInfo(pgsql_read_request.table_id()));
@@ -1898,6 +1915,19 @@ Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApply
   // transaction is done properly in the rare situation where the committed transaction's intents
   // are still in intents db and not yet in regular db.
   AtomicFlagSleepMs(&FLAGS_TEST_inject_sleep_before_applying_intents_ms);
+  if (data.cached_intents) {
+    // All intents are in memory, so they are applied in a single batch without reading the
+    // intents DB.
+    docdb::ConsensusFrontiers frontiers;
+    auto frontiers_ptr = data.op_id.empty() ? nullptr : InitFrontiers(data, &frontiers);
+    docdb::CachedIntentsWriter writer(
+        data.transaction_id, *data.cached_intents, data.aborted, data.commit_ht, &key_bounds_,
+        frontiers_ptr);
+    rocksdb::WriteBatch regular_write_batch;
+    regular_write_batch.SetDirectWriter(&writer);
+    WriteToRocksDB(frontiers_ptr, &regular_write_batch, StorageDbType::kRegular);
+    return docdb::ApplyTransactionState();
+  }
   docdb::ApplyIntentsContext context(
       data.transaction_id, data.apply_state, data.aborted, data.commit_ht, data.log_ht,
       &key_bounds_, intents_db_.get());
@@ -32,6 +32,8 @@
 
 #include "yb/tablet/tablet_bootstrap.h"
 
+#include <deque>
+#include <future>
 #include <map>
 #include <set>
 
@@ -100,6 +102,7 @@
 #include "yb/util/status.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/threadpool.h"
 
 DEFINE_UNKNOWN_bool(skip_remove_old_recovery_dir, false,
             "Skip removing WAL recovery dir after startup. (useful for debugging)");
@@ -144,6 +147,32 @@ DEFINE_test_flag(bool, dump_docdb_after_tablet_bootstrap, false,
 DEFINE_test_flag(bool, play_pending_uncommitted_entries, false,
                  "Play all the pending entries present in the log even if they are uncommitted.");
 
+DEFINE_RUNTIME_int32(tablet_bootstrap_read_ahead_segments, 1,
+    "Number of log segments that are read and decoded on a separate thread while the bootstrap "
+    "thread replays the previous segment. 0 to read segments on the bootstrap thread.");
+
+METRIC_DEFINE_gauge_uint64(tablet, tablet_bootstrap_log_read_ms,
+                           "Tablet Bootstrap Log Read Time",
+                           yb::MetricUnit::kMilliseconds,
+                           "Time spent reading and decoding log segments during the last tablet "
+                           "bootstrap.");
+
+METRIC_DEFINE_gauge_uint64(tablet, tablet_bootstrap_log_read_wait_ms,
+                           "Tablet Bootstrap Log Read Wait Time",
+                           yb::MetricUnit::kMilliseconds,
+                           "Time the last tablet bootstrap waited for log segments to be read.");
+
+METRIC_DEFINE_gauge_uint64(tablet, tablet_bootstrap_replay_ms,
+                           "Tablet Bootstrap Replay Time",
+                           yb::MetricUnit::kMilliseconds,
+                           "Time spent replaying log entries during the last tablet bootstrap.");
+
+METRIC_DEFINE_gauge_uint64(tablet, tablet_bootstrap_ops_read,
+                           "Tablet Bootstrap Operations Read",
+                           yb::MetricUnit::kOperations,
+                           "Number of operations read from the log during the last tablet "
+                           "bootstrap.");
+
 namespace yb {
 namespace tablet {
 
@@ -192,6 +221,45 @@ static string DebugInfo(const string& tablet_id,
                     segment_path, debug_str);
 }
 
+namespace {
+
+struct SegmentReadResult {
+  log::ReadEntriesResult read_result;
+  MonoDelta read_time;
+};
+
+SegmentReadResult ReadSegment(const scoped_refptr<ReadableLogSegment>& segment) {
+  auto start = MonoTime::Now();
+  auto read_result = segment->ReadEntries();
+  return SegmentReadResult {
+    .read_result = std::move(read_result),
+    .read_time = MonoTime::Now() - start,
+  };
+}
+
+// Starts reading of the segment on the pool. Reads the segment in the current thread when pool is
+// not specified or refuses the task.
+std::future<SegmentReadResult> StartSegmentRead(
+    ThreadPool* pool, const scoped_refptr<ReadableLogSegment>& segment) {
+  auto promise = std::make_shared<std::promise<SegmentReadResult>>();
+  auto result = promise->get_future();
+  if (pool) {
+    // The task holds references to the segment and the promise only, so it could safely outlive
+    // the bootstrap, for instance when replay fails before the segment is used.
+    auto status = pool->SubmitFunc([segment, promise] {
+      promise->set_value(ReadSegment(segment));
+    });
+    if (status.ok()) {
+      return result;
+    }
+    LOG(WARNING) << "Failed to submit read of log segment " << segment->path() << ": " << status;
+  }
+  promise->set_value(ReadSegment(segment));
+  return result;
+}
+
+} // namespace
+
 // ================================================================================================
 // Class ReplayState.
 // ================================================================================================
@@ -511,6 +579,7 @@ class TabletBootstrap {
         append_pool_(data.append_pool),
         allocation_pool_(data.allocation_pool),
         log_sync_pool_(data.log_sync_pool),
+        log_read_pool_(data.log_read_pool),
         skip_wal_rewrite_(GetAtomicFlag(&FLAGS_skip_wal_rewrite)),
         test_hooks_(data.test_hooks) {
   }
@@ -813,6 +882,7 @@ class TabletBootstrap {
     const auto& metadata = *tablet_->metadata();
     log_options.retention_secs = metadata.wal_retention_secs();
     log_options.env = GetEnv();
+    log_options.sync_coordinator = data_.log_sync_coordinator;
     if (tablet_->metadata()->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE) {
       auto log_segment_size = FLAGS_transaction_status_tablet_log_segment_size_bytes;
       if (log_segment_size) {
@@ -1326,13 +1396,38 @@ class TabletBootstrap {
     // Find the earliest log segment we need to read, so the rest can be ignored.
     auto iter = should_skip_flushed_entries ? SkipFlushedEntries(&segments) : segments.begin();
 
+    // Segments are read and decoded ahead on the log read pool, while this thread replays entries
+    // of the previous segment. Replay itself stays sequential, since entries should be applied to
+    // RocksDB in op id order. Read ahead is used only when WAL is not rewritten, so segments being
+    // read are not modified by the log.
+    size_t read_ahead_segments = 0;
+    if (log_read_pool_ && skip_wal_rewrite_) {
+      read_ahead_segments = static_cast<size_t>(std::max(
+          GetAtomicFlag(&FLAGS_tablet_bootstrap_read_ahead_segments), 0));
+    }
+    auto read_iter = iter;
+    std::deque<std::future<SegmentReadResult>> segment_reads;
+
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
     for (; iter != segments.end(); ++iter) {
       const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-      auto read_result = segment->ReadEntries();
+      // Keep the current segment and up to read_ahead_segments next segments being read.
+      while (read_iter != segments.end() && segment_reads.size() <= read_ahead_segments) {
+        segment_reads.push_back(StartSegmentRead(
+            read_ahead_segments ? log_read_pool_ : nullptr, *read_iter));
+        ++read_iter;
+      }
+      auto wait_start = MonoTime::Now();
+      auto segment_read = segment_reads.front().get();
+      segment_reads.pop_front();
+      stats_.read_wait_time += MonoTime::Now() - wait_start;
+      stats_.read_time += segment_read.read_time;
+
+      auto replay_start = MonoTime::Now();
+      auto& read_result = segment_read.read_result;
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
@@ -1352,6 +1447,7 @@ class TabletBootstrap {
       if (!read_result.entry_metadata.empty()) {
         last_entry_time = read_result.entry_metadata.back().entry_time;
       }
+      stats_.replay_time += MonoTime::Now() - replay_start;
 
       // If the LogReader failed to read for some reason, we'll still try to replay as many entries
       // as possible, and then fail with Corruption.
@@ -1382,6 +1478,7 @@ class TabletBootstrap {
       listener_->StatusMessage(status);
     }
 
+    auto replay_start = MonoTime::Now();
     replay_state_->UpdateCommittedFromStored();
     RETURN_NOT_OK(ApplyCommittedPendingReplicates());
 
@@ -1408,6 +1505,9 @@ class TabletBootstrap {
       }
     }
 
+    stats_.replay_time += MonoTime::Now() - replay_start;
+    UpdateBootstrapMetrics();
+
     LOG_WITH_PREFIX(INFO) << "Dumping replay state to log at the end of " << __FUNCTION__;
     DumpReplayStateToLog();
 
@@ -1456,6 +1556,20 @@ class TabletBootstrap {
     return Status::OK();
   }
 
+  void UpdateBootstrapMetrics() {
+    const auto& entity = tablet_->GetTabletMetricsEntity();
+    if (!entity) {
+      return;
+    }
+    METRIC_tablet_bootstrap_log_read_ms.Instantiate(entity, 0)->set_value(
+        stats_.read_time.ToMilliseconds());
+    METRIC_tablet_bootstrap_log_read_wait_ms.Instantiate(entity, 0)->set_value(
+        stats_.read_wait_time.ToMilliseconds());
+    METRIC_tablet_bootstrap_replay_ms.Instantiate(entity, 0)->set_value(
+        stats_.replay_time.ToMilliseconds());
+    METRIC_tablet_bootstrap_ops_read.Instantiate(entity, 0)->set_value(stats_.ops_read);
+  }
+
   Status PlayWriteRequest(
       consensus::LWReplicateMsg* replicate_msg,
       AlreadyAppliedToRegularDB already_applied_to_regular_db) {
@@ -1755,6 +1869,9 @@ class TabletBootstrap {
   // Thread pool for executing log fsync tasks.
   ThreadPool* log_sync_pool_;
 
+  // Thread pool for reading log segments ahead of replay.
+  ThreadPool* log_read_pool_;
+
   // Statistics on the replay of entries in the log.
   struct Stats {
     std::string ToString() const;
@@ -1764,6 +1881,16 @@ class TabletBootstrap {
 
     // Number of REPLICATE messages which were overwritten by later entries.
     int ops_overwritten = 0;
+
+    // Total time spent reading and decoding log segments, including reads done in parallel with
+    // replay.
+    MonoDelta read_time = MonoDelta::kZero;
+
+    // Time the bootstrap thread waited for segments to be read.
+    MonoDelta read_wait_time = MonoDelta::kZero;
+
+    // Time spent replaying read entries.
+    MonoDelta replay_time = MonoDelta::kZero;
   } stats_;
 
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
@@ -1788,8 +1915,9 @@ class TabletBootstrap {
 // ============================================================================
 
 string TabletBootstrap::Stats::ToString() const {
-  return Format("Read operations: $0, overwritten operations: $1",
-                ops_read, ops_overwritten);
+  return Format("Read operations: $0, overwritten operations: $1, read time: $2, "
+                "read wait time: $3, replay time: $4",
+                ops_read, ops_overwritten, read_time, read_wait_time, replay_time);
 }
 
 Status BootstrapTabletImpl(
@@ -161,6 +161,10 @@ struct BootstrapTabletData {
   ThreadPool* append_pool = nullptr;
   ThreadPool* allocation_pool = nullptr;
   ThreadPool* log_sync_pool = nullptr;
+  // Thread pool used to read and decode log segments ahead of replay. When not set, segments are
+  // read by the bootstrap thread.
+  ThreadPool* log_read_pool = nullptr;
+  log::LogSyncCoordinator* log_sync_coordinator = nullptr;
   consensus::RetryableRequests* retryable_requests = nullptr;
   std::shared_ptr<TabletBootstrapTestHooksIf> test_hooks = nullptr;
   bool bootstrap_retryable_requests = true;
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "yb/gutil/ref_counted.h"
 
@@ -46,6 +47,7 @@ typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 class ChangeMetadataOperation;
 class Operation;
 class OperationFilter;
+class SharedTransactionStatusCache;
 class SnapshotCoordinator;
 class SnapshotOperation;
 class SplitOperation;
@@ -61,6 +63,7 @@ class TransactionStatePB;
 class TruncateOperation;
 class TruncatePB;
 class UpdateTxnOperation;
+using UpdateTxnOperations = std::vector<std::unique_ptr<UpdateTxnOperation>>;
 class WriteOperation;
 class WriteQuery;
 class WriteQueryContext;
@@ -148,6 +148,14 @@ METRIC_DEFINE_counter(tablet, docdb_obsolete_keys_found_past_cutoff,
     yb::MetricUnit::kKeys,
     "Number of obsolete keys found in RocksDB searches that were past history cutoff");
 
+METRIC_DEFINE_counter(tablet, tablet_read_ops, "Tablet Read Ops",
+    yb::MetricUnit::kOperations,
+    "Number of read requests handled by this tablet");
+
+METRIC_DEFINE_counter(tablet, tablet_write_ops, "Tablet Write Ops",
+    yb::MetricUnit::kOperations,
+    "Number of write requests successfully applied by this tablet");
+
 using strings::Substitute;
 
 namespace yb {
@@ -174,7 +182,9 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& table_entity,
     MINIT(tablet_entity, failed_batch_lock),
     MINIT(tablet_entity, docdb_keys_found),
     MINIT(tablet_entity, docdb_obsolete_keys_found),
-    MINIT(tablet_entity, docdb_obsolete_keys_found_past_cutoff) {
+    MINIT(tablet_entity, docdb_obsolete_keys_found_past_cutoff),
+    MINIT(tablet_entity, tablet_read_ops),
+    MINIT(tablet_entity, tablet_write_ops) {
 }
 #undef MINIT
 
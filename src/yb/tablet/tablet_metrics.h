@@ -75,6 +75,11 @@ struct TabletMetrics {
   scoped_refptr<Counter> docdb_keys_found;
   scoped_refptr<Counter> docdb_obsolete_keys_found;
   scoped_refptr<Counter> docdb_obsolete_keys_found_past_cutoff;
+
+  // Number of read and write requests served by this tablet. Unlike the latency histograms above,
+  // these are attached to the tablet entity, so they are not aggregated across tablets of a table.
+  scoped_refptr<Counter> tablet_read_ops;
+  scoped_refptr<Counter> tablet_write_ops;
 };
 
 class ScopedTabletMetricsTracker {
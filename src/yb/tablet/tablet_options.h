@@ -58,6 +58,7 @@ struct TabletOptions {
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
   std::shared_ptr<rocksdb::RateLimiter> rate_limiter;
   std::shared_ptr<rocksdb::RocksDBPriorityThreadPoolMetrics> priority_thread_pool_metrics;
+  std::shared_ptr<SharedTransactionStatusCache> transaction_status_cache;
 };
 
 using TransactionManagerProvider = std::function<client::TransactionManager&()>;
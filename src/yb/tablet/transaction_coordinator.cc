@@ -1409,50 +1409,67 @@ class TransactionCoordinator::Impl : public TransactionStateContext,
   }
 
   void Handle(std::unique_ptr<tablet::UpdateTxnOperation> request, int64_t term) {
-    auto& state = *request->request();
-    auto id = FullyDecodeTransactionId(state.transaction_id());
-    if (!id.ok()) {
-      LOG(WARNING) << "Failed to decode id from " << state.ShortDebugString() << ": " << id;
-      request->CompleteWithStatus(id.status());
-      return;
-    }
-
-    if (state.has_external_hybrid_time()) {
-      auto ignore_transaction_result =  MaybeIgnoreIfTransactionInWrongState(state.status(), *id);
-      if (!ignore_transaction_result.ok()) {
-        request->CompleteWithStatus(ignore_transaction_result.status());
-        return;
+    UpdateTxnOperations requests;
+    requests.push_back(std::move(request));
+    HandleBatch(std::move(requests), term);
+  }
+
+  void HandleBatch(UpdateTxnOperations requests, int64_t term) {
+    std::vector<std::pair<std::unique_ptr<tablet::UpdateTxnOperation>, TransactionId>> accepted;
+    accepted.reserve(requests.size());
+    for (auto& request : requests) {
+      auto& state = *request->request();
+      auto id = FullyDecodeTransactionId(state.transaction_id());
+      if (!id.ok()) {
+        LOG(WARNING) << "Failed to decode id from " << state.ShortDebugString() << ": " << id;
+        request->CompleteWithStatus(id.status());
+        continue;
       }
-      if (*ignore_transaction_result) {
-        request->CompleteWithStatus(Status::OK());
-        return;
+
+      if (state.has_external_hybrid_time()) {
+        auto ignore_transaction_result = MaybeIgnoreIfTransactionInWrongState(state.status(), *id);
+        if (!ignore_transaction_result.ok()) {
+          request->CompleteWithStatus(ignore_transaction_result.status());
+          continue;
+        }
+        if (*ignore_transaction_result) {
+          request->CompleteWithStatus(Status::OK());
+          continue;
+        }
       }
+      accepted.emplace_back(std::move(request), *id);
     }
 
+    // Requests are completed outside of the lock.
+    std::vector<std::pair<std::unique_ptr<tablet::UpdateTxnOperation>, Status>> failed;
     PostponedLeaderActions actions;
     {
-      std::unique_lock<std::mutex> lock(managed_mutex_);
+      std::lock_guard<std::mutex> lock(managed_mutex_);
       postponed_leader_actions_.leader_term = term;
-      auto it = managed_transactions_.find(*id);
-      if (it == managed_transactions_.end()) {
-        auto status = HandleTransactionNotFound(*id, state);
-        if (status.ok()) {
+      for (auto& [request, id] : accepted) {
+        auto it = managed_transactions_.find(id);
+        if (it == managed_transactions_.end()) {
+          auto status = HandleTransactionNotFound(id, *request->request());
+          if (!status.ok()) {
+            failed.emplace_back(
+                std::move(request),
+                status.CloneAndAddErrorCode(TransactionError(TransactionErrorCode::kAborted)));
+            continue;
+          }
           it = managed_transactions_.emplace(
-              this, *id, context_.clock().Now(), log_prefix_).first;
-        } else {
-          lock.unlock();
-          status = status.CloneAndAddErrorCode(TransactionError(TransactionErrorCode::kAborted));
-          request->CompleteWithStatus(status);
-          return;
+              this, id, context_.clock().Now(), log_prefix_).first;
         }
-      }
 
-      managed_transactions_.modify(it, [&request](TransactionState& state) {
-        state.Handle(std::move(request));
-      });
+        managed_transactions_.modify(it, [&request](TransactionState& state) {
+          state.Handle(std::move(request));
+        });
+      }
       postponed_leader_actions_.Swap(&actions);
     }
 
+    for (auto& [request, status] : failed) {
+      request->CompleteWithStatus(status);
+    }
     ExecutePostponedLeaderActions(&actions);
   }
 
@@ -1866,6 +1883,10 @@ void TransactionCoordinator::Handle(
   impl_->Handle(std::move(request), term);
 }
 
+void TransactionCoordinator::HandleBatch(UpdateTxnOperations requests, int64_t term) {
+  impl_->HandleBatch(std::move(requests), term);
+}
+
 void TransactionCoordinator::Start() {
   impl_->Start();
 }
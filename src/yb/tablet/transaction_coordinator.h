@@ -118,6 +118,10 @@ class TransactionCoordinator {
   // Handles new request for transaction update.
   void Handle(std::unique_ptr<tablet::UpdateTxnOperation> request, int64_t term);
 
+  // Handles requests for updates of multiple transactions, i.e. a batch of heartbeats, holding
+  // the lock of managed transactions once for the whole batch.
+  void HandleBatch(UpdateTxnOperations requests, int64_t term);
+
   // Prepares log garbage collection. Return min index that should be preserved.
   int64_t PrepareGC(std::string* details = nullptr);
 
@@ -30,6 +30,7 @@
 #include "yb/consensus/consensus_util.h"
 
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/rocksdb_writer.h"
 #include "yb/docdb/transaction_dump.h"
 
 #include "yb/rpc/poller.h"
@@ -57,6 +58,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/operation_counter.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/tsan_util.h"
@@ -100,6 +102,15 @@ DEFINE_NON_RUNTIME_int32(wait_queue_poll_interval_ms, 100,
     "The interval duration between wait queue polls to fetch transaction statuses of "
     "active blockers.");
 
+DEFINE_RUNTIME_uint64(txn_intents_cache_max_records, 64,
+    "Max number of strong write intents of a transaction in a tablet, that are also kept in "
+    "memory. Transaction with cached intents is applied without reading its intents from the "
+    "intents DB. 0 to disable.");
+
+DEFINE_NON_RUNTIME_int64(txn_intents_cache_limit_bytes, 128_MB,
+    "Max memory used by cached intents of transactions of all tablets of the server. "
+    "Intents of new batches are not cached when the limit is exceeded.");
+
 DECLARE_int64(transaction_abort_check_timeout_ms);
 
 DECLARE_int64(cdc_intent_retention_ms);
@@ -107,6 +118,14 @@ DECLARE_int64(cdc_intent_retention_ms);
 METRIC_DEFINE_simple_counter(
     tablet, transaction_not_found, "Total number of missing transactions during load",
     yb::MetricUnit::kTransactions);
+METRIC_DEFINE_simple_counter(
+    tablet, transactions_applied_from_intents_cache,
+    "Total number of transactions applied using intents kept in memory",
+    yb::MetricUnit::kTransactions);
+METRIC_DEFINE_simple_counter(
+    tablet, transaction_status_shared_cache_hits,
+    "Total number of transaction status requests served using status received by participant of "
+    "another tablet", yb::MetricUnit::kRequests);
 METRIC_DEFINE_simple_gauge_uint64(
     tablet, transactions_running, "Total number of transactions running in participant",
     yb::MetricUnit::kTransactions);
@@ -129,6 +148,7 @@ YB_STRONGLY_TYPED_BOOL(PostApplyCleanup);
 
 constexpr size_t kRunningTransactionSize = sizeof(RunningTransaction);
 const std::string kParentMemTrackerId = "transactions";
+const std::string kIntentsCacheMemTrackerId = "intents_cache";
 
 std::string TransactionApplyData::ToString() const {
   return YB_STRUCT_TO_STRING(
@@ -142,7 +162,7 @@ class TransactionParticipant::Impl
   Impl(TransactionParticipantContext* context, TransactionIntentApplier* applier,
        const scoped_refptr<MetricEntity>& entity,
        const std::shared_ptr<MemTracker>& tablets_mem_tracker)
-      : RunningTransactionContext(context, applier),
+      : RunningTransactionContext(context, applier, FLAGS_max_transactions_in_status_request),
         log_prefix_(context->LogPrefix()),
         loader_(this, entity),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)),
@@ -150,12 +170,19 @@ class TransactionParticipant::Impl
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
     metric_transaction_not_found_ = METRIC_transaction_not_found.Instantiate(entity);
+    metric_transactions_applied_from_intents_cache_ =
+        METRIC_transactions_applied_from_intents_cache.Instantiate(entity);
+    metric_shared_status_cache_hits_ =
+        METRIC_transaction_status_shared_cache_hits.Instantiate(entity);
     metric_aborted_transactions_pending_cleanup_ =
         METRIC_aborted_transactions_pending_cleanup.Instantiate(entity, 0);
     auto parent_mem_tracker = MemTracker::FindOrCreateTracker(
         kParentMemTrackerId, tablets_mem_tracker);
     mem_tracker_ = MemTracker::CreateTracker(Format("$0-$1", kParentMemTrackerId,
         participant_context_.tablet_id()), parent_mem_tracker);
+    // Shared by all tablets, so the limit is applied to the whole server.
+    intents_cache_mem_tracker_ = MemTracker::FindOrCreateTracker(
+        FLAGS_txn_intents_cache_limit_bytes, kIntentsCacheMemTrackerId, parent_mem_tracker);
   }
 
   ~Impl() {
@@ -175,6 +202,10 @@ class TransactionParticipant::Impl
     return wait_queue_.get();
   }
 
+  void SetSharedStatusCache(std::shared_ptr<SharedTransactionStatusCache> cache) {
+    shared_status_cache_ = std::move(cache);
+  }
+
   bool StartShutdown() {
     bool expected = false;
     if (!closing_.compare_exchange_strong(expected, true)) {
@@ -220,6 +251,7 @@ class TransactionParticipant::Impl
       mem_tracker_->UnregisterFromParent();
     }
 
+    status_request_batcher_.Shutdown();
     rpcs_.Shutdown();
     loader_.Shutdown();
     for (auto& resolver : status_resolvers) {
@@ -259,8 +291,13 @@ class TransactionParticipant::Impl
       return STATUS(InvalidArgument, Format("For external transaction $0, status tablet is empty",
                                              metadata.transaction_id));
     }
-    transactions_.insert(std::make_shared<RunningTransaction>(
-        metadata, TransactionalBatchData(), OneWayBitmap(), metadata.start_time, this));
+    auto transaction = std::make_shared<RunningTransaction>(
+        metadata, TransactionalBatchData(), OneWayBitmap(), metadata.start_time, this);
+    // Intents could be cached only when we see the first batch of the transaction.
+    if (FLAGS_txn_intents_cache_max_records && !metadata.external_transaction) {
+      transaction->StartCachingIntents(intents_cache_mem_tracker_);
+    }
+    transactions_.insert(std::move(transaction));
     mem_tracker_->Consume(kRunningTransactionSize);
     TransactionsModifiedUnlocked(&min_running_notifier);
     return true;
@@ -369,7 +406,9 @@ class TransactionParticipant::Impl
     return std::make_pair(transaction.metadata().isolation, transaction.last_batch_data());
   }
 
-  void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data) {
+  void BatchReplicated(
+      const TransactionId& id, const TransactionalBatchData& data,
+      const docdb::CachedIntents* intents) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = transactions_.find(id);
     if (it == transactions_.end()) {
@@ -377,7 +416,7 @@ class TransactionParticipant::Impl
           << "Update last write id for unknown transaction: " << id;
       return;
     }
-    (**it).BatchReplicated(data);
+    (**it).BatchReplicated(data, intents);
   }
 
   void RequestStatusAt(const StatusRequest& request) {
@@ -684,6 +723,7 @@ class TransactionParticipant::Impl
     }
 
     bool was_previously_committed = false;
+    std::unique_ptr<docdb::CachedIntents> cached_intents;
 
     {
       // It is our last chance to load transaction metadata, if missing.
@@ -715,6 +755,9 @@ class TransactionParticipant::Impl
         CHECK(transactions_.modify(lock_and_iterator.iterator, [&data](auto& txn) {
           txn->SetLocalCommitData(data.commit_ht, data.aborted);
         }));
+        if (!data.apply_state) {
+          cached_intents = lock_and_iterator.transaction().TakeCachedIntents();
+        }
         if (!lock_and_iterator.transaction().external_transaction()) {
           LOG_IF_WITH_PREFIX(DFATAL, data.log_ht < last_safe_time_)
               << "Apply transaction before last safe time " << data.transaction_id
@@ -733,7 +776,15 @@ class TransactionParticipant::Impl
         // TODO(wait-queues): Consider signaling before replicating the transaction update.
         wait_queue_->SignalCommitted(data.transaction_id, data.commit_ht);
       }
-      auto apply_state = CHECK_RESULT(applier_.ApplyIntents(data));
+      docdb::ApplyTransactionState apply_state;
+      if (cached_intents) {
+        auto cached_data = data;
+        cached_data.cached_intents = cached_intents.get();
+        apply_state = CHECK_RESULT(applier_.ApplyIntents(cached_data));
+        metric_transactions_applied_from_intents_cache_->Increment();
+      } else {
+        apply_state = CHECK_RESULT(applier_.ApplyIntents(data));
+      }
 
       VLOG_WITH_PREFIX(4) << "TXN: " << data.transaction_id << ": apply state: "
                           << apply_state.ToString();
@@ -1856,6 +1907,7 @@ class TransactionParticipant::Impl
   scoped_refptr<AtomicGauge<uint64_t>> metric_transactions_running_;
   scoped_refptr<AtomicGauge<uint64_t>> metric_aborted_transactions_pending_cleanup_;
   scoped_refptr<Counter> metric_transaction_not_found_;
+  scoped_refptr<Counter> metric_transactions_applied_from_intents_cache_;
 
   TransactionLoader loader_;
   std::atomic<bool> closing_{false};
@@ -1883,6 +1935,7 @@ class TransactionParticipant::Impl
   std::unique_ptr<docdb::WaitQueue> wait_queue_;
 
   std::shared_ptr<MemTracker> mem_tracker_ GUARDED_BY(mutex_);
+  std::shared_ptr<MemTracker> intents_cache_mem_tracker_;
 };
 
 TransactionParticipant::TransactionParticipant(
@@ -1921,8 +1974,9 @@ Result<boost::optional<std::pair<IsolationLevel, TransactionalBatchData>>>
 }
 
 void TransactionParticipant::BatchReplicated(
-    const TransactionId& id, const TransactionalBatchData& data) {
-  return impl_->BatchReplicated(id, data);
+    const TransactionId& id, const TransactionalBatchData& data,
+    const docdb::CachedIntents* intents) {
+  return impl_->BatchReplicated(id, data, intents);
 }
 
 HybridTime TransactionParticipant::LocalCommitTime(const TransactionId& id) {
@@ -2035,6 +2089,11 @@ void TransactionParticipant::SetWaitQueue(std::unique_ptr<docdb::WaitQueue> wait
   return impl_->SetWaitQueue(std::move(wait_queue));
 }
 
+void TransactionParticipant::SetSharedStatusCache(
+    std::shared_ptr<SharedTransactionStatusCache> cache) {
+  impl_->SetSharedStatusCache(std::move(cache));
+}
+
 docdb::WaitQueue* TransactionParticipant::wait_queue() const {
   return impl_->wait_queue();
 }
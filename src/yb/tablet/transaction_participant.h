@@ -78,6 +78,8 @@ struct TransactionApplyData {
   TabletId status_tablet;
   // Owned by running transaction if non-null.
   const docdb::ApplyTransactionState* apply_state = nullptr;
+  // All intents of the transaction kept in memory, if non-null. Owned by the caller of apply.
+  const docdb::CachedIntents* cached_intents = nullptr;
   bool is_external = false;
 
   std::string ToString() const;
@@ -117,6 +119,10 @@ class TransactionParticipant : public TransactionStatusManager {
 
   void SetWaitQueue(std::unique_ptr<docdb::WaitQueue> wait_queue);
 
+  // Sets status cache shared with participants of other tablets of the server.
+  // Should be invoked before Start.
+  void SetSharedStatusCache(std::shared_ptr<SharedTransactionStatusCache> cache);
+
   docdb::WaitQueue* wait_queue() const;
 
   // Notify participant that this context is ready and it could start performing its requests.
@@ -143,7 +149,10 @@ class TransactionParticipant : public TransactionStatusManager {
       const TransactionId& id, size_t batch_idx,
       boost::container::small_vector_base<uint8_t>* encoded_replicated_batches);
 
-  void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data);
+  // intents - strong write intents of the replicated batch, if they were collected.
+  void BatchReplicated(
+      const TransactionId& id, const TransactionalBatchData& data,
+      const docdb::CachedIntents* intents);
 
   HybridTime LocalCommitTime(const TransactionId& id) override;
 
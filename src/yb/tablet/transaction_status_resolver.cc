@@ -13,12 +13,17 @@
 
 #include "yb/tablet/transaction_status_resolver.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "yb/client/client.h"
 #include "yb/client/meta_cache.h"
 #include "yb/client/transaction_rpc.h"
 
 #include "yb/common/wire_protocol.h"
 
+#include "yb/gutil/casts.h"
+
 #include "yb/rpc/rpc.h"
 
 #include "yb/tablet/transaction_participant_context.h"
@@ -31,6 +36,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
+#include "yb/util/unique_lock.h"
 
 DEFINE_test_flag(int32, inject_status_resolver_delay_ms, 0,
                  "Inject delay before launching transaction status resolver RPC.");
@@ -347,5 +353,208 @@ bool TransactionStatusResolver::Running() const {
   return impl_->Running();
 }
 
+class TransactionStatusRequestBatcher::Impl {
+ public:
+  Impl(TransactionParticipantContext* participant_context, rpc::Rpcs* rpcs,
+       int max_transactions_per_request)
+      : participant_context_(*participant_context), rpcs_(*rpcs),
+        max_transactions_per_request_(std::max(max_transactions_per_request, 1)),
+        log_prefix_(participant_context->LogPrefix()) {}
+
+  void Shutdown() {
+    std::vector<Request> requests;
+    {
+      std::lock_guard lock(mutex_);
+      closing_ = true;
+      for (auto& [tablet_id, queue] : queues_) {
+        std::move(queue.requests.begin(), queue.requests.end(), std::back_inserter(requests));
+        queue.requests.clear();
+      }
+    }
+    Fail(requests, STATUS(Aborted, "Aborted because of shutdown"));
+  }
+
+  void Add(const TabletId& status_tablet, const TransactionId& transaction_id,
+           TransactionStatusResponseCallback callback) {
+    std::vector<Request> batch;
+    {
+      UniqueLock lock(mutex_);
+      if (closing_) {
+        lock.unlock();
+        callback(STATUS(Aborted, "Aborted because of shutdown"), {});
+        return;
+      }
+      auto& queue = queues_[status_tablet];
+      queue.requests.push_back(Request {
+        .transaction_id = transaction_id,
+        .callback = std::move(callback),
+      });
+      if (queue.in_flight) {
+        return;
+      }
+      batch = PickBatchUnlocked(&queue);
+    }
+    Send(status_tablet, std::move(batch));
+  }
+
+ private:
+  struct Request {
+    TransactionId transaction_id;
+    TransactionStatusResponseCallback callback;
+  };
+
+  struct Queue {
+    std::vector<Request> requests;
+    bool in_flight = false;
+  };
+
+  const std::string& LogPrefix() const {
+    return log_prefix_;
+  }
+
+  std::vector<Request> PickBatchUnlocked(Queue* queue) REQUIRES(mutex_) {
+    queue->in_flight = !queue->requests.empty();
+    if (queue->requests.size() <= max_transactions_per_request_) {
+      return std::move(queue->requests);
+    }
+    auto split = queue->requests.begin() + max_transactions_per_request_;
+    std::vector<Request> result(
+        std::make_move_iterator(queue->requests.begin()), std::make_move_iterator(split));
+    queue->requests.erase(queue->requests.begin(), split);
+    return result;
+  }
+
+  void Send(const TabletId& status_tablet, std::vector<Request> batch) {
+    VLOG_WITH_PREFIX(4) << "Requesting status of " << batch.size() << " transactions from "
+                        << status_tablet;
+
+    tserver::GetTransactionStatusRequestPB req;
+    req.set_tablet_id(status_tablet);
+    req.set_propagated_hybrid_time(participant_context_.Now().ToUint64());
+    for (const auto& request : batch) {
+      const auto& txn_id = request.transaction_id;
+      req.add_transaction_id()->assign(pointer_cast<const char*>(txn_id.data()), txn_id.size());
+    }
+
+    auto client = participant_context_.client_future().get();
+    auto handle = client ? rpcs_.Prepare() : rpcs_.InvalidHandle();
+    if (handle == rpcs_.InvalidHandle()) {
+      Fail(batch, STATUS(Aborted, "Aborted because cannot start RPC"));
+      BatchDone(status_tablet);
+      return;
+    }
+    *handle = client::GetTransactionStatus(
+        TransactionRpcDeadline(),
+        nullptr /* tablet */,
+        client,
+        &req,
+        [this, handle, status_tablet, batch = std::move(batch)](
+            const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+      rpcs_.Unregister(handle);
+      StatusReceived(status, response, batch);
+      BatchDone(status_tablet);
+    });
+    (**handle).SendRpc();
+  }
+
+  void StatusReceived(
+      Status status, const tserver::GetTransactionStatusResponsePB& response,
+      const std::vector<Request>& batch) {
+    VLOG_WITH_PREFIX(4) << "Received statuses of " << batch.size() << " transactions: " << status
+                        << ", " << response.ShortDebugString();
+
+    if (status.ok() && response.has_error()) {
+      status = StatusFromPB(response.error().status());
+    }
+    const auto size = narrow_cast<int>(batch.size());
+    if (status.ok() && batch.size() != 1 &&
+        (response.status().size() != size || response.status_hybrid_time().size() != size ||
+         (response.aborted_subtxn_set().size() != 0 &&
+              response.aborted_subtxn_set().size() != size))) {
+      // Node with old software version would always return 1 status.
+      LOG_WITH_PREFIX(DFATAL)
+          << "Bad response size, expected " << size << " entries, but found: "
+          << response.ShortDebugString();
+      status = STATUS_FORMAT(IllegalState, "Bad transaction status response size: $0",
+                             response.status().size());
+    }
+    if (!status.ok()) {
+      Fail(batch, status);
+      return;
+    }
+    if (batch.size() == 1) {
+      batch.front().callback(status, response);
+      return;
+    }
+
+    tserver::GetTransactionStatusResponsePB transaction_response;
+    for (int i = 0; i != size; ++i) {
+      transaction_response.Clear();
+      if (response.has_propagated_hybrid_time()) {
+        transaction_response.set_propagated_hybrid_time(response.propagated_hybrid_time());
+      }
+      transaction_response.add_status(response.status(i));
+      transaction_response.add_status_hybrid_time(response.status_hybrid_time(i));
+      if (i < response.num_replicated_batches().size()) {
+        transaction_response.add_num_replicated_batches(response.num_replicated_batches(i));
+      }
+      if (i < response.coordinator_safe_time().size()) {
+        transaction_response.add_coordinator_safe_time(response.coordinator_safe_time(i));
+      }
+      if (i < response.aborted_subtxn_set().size()) {
+        *transaction_response.add_aborted_subtxn_set() = response.aborted_subtxn_set(i);
+      }
+      batch[i].callback(status, transaction_response);
+    }
+  }
+
+  void BatchDone(const TabletId& status_tablet) {
+    std::vector<Request> batch;
+    {
+      std::lock_guard lock(mutex_);
+      auto it = queues_.find(status_tablet);
+      batch = PickBatchUnlocked(&it->second);
+      if (batch.empty()) {
+        queues_.erase(it);
+        return;
+      }
+    }
+    Send(status_tablet, std::move(batch));
+  }
+
+  void Fail(const std::vector<Request>& requests, const Status& status) {
+    for (const auto& request : requests) {
+      request.callback(status, {});
+    }
+  }
+
+  TransactionParticipantContext& participant_context_;
+  rpc::Rpcs& rpcs_;
+  const size_t max_transactions_per_request_;
+  const std::string log_prefix_;
+
+  std::mutex mutex_;
+  bool closing_ GUARDED_BY(mutex_) = false;
+  std::unordered_map<TabletId, Queue> queues_ GUARDED_BY(mutex_);
+};
+
+TransactionStatusRequestBatcher::TransactionStatusRequestBatcher(
+    TransactionParticipantContext* participant_context, rpc::Rpcs* rpcs,
+    int max_transactions_per_request)
+    : impl_(new Impl(participant_context, rpcs, max_transactions_per_request)) {
+}
+
+TransactionStatusRequestBatcher::~TransactionStatusRequestBatcher() {}
+
+void TransactionStatusRequestBatcher::Shutdown() {
+  impl_->Shutdown();
+}
+
+void TransactionStatusRequestBatcher::Request(
+    const TabletId& status_tablet, const TransactionId& transaction_id,
+    TransactionStatusResponseCallback callback) {
+  impl_->Add(status_tablet, transaction_id, std::move(callback));
+}
+
 } // namespace tablet
 } // namespace yb
@@ -22,6 +22,8 @@
 
 #include "yb/tablet/transaction_participant.h"
 
+#include "yb/tserver/tserver_fwd.h"
+
 #include "yb/util/status_fwd.h"
 
 namespace yb {
@@ -75,5 +77,36 @@ class TransactionStatusResolver {
   std::unique_ptr<Impl> impl_;
 };
 
+using TransactionStatusResponseCallback =
+    std::function<void(const Status&, const tserver::GetTransactionStatusResponsePB&)>;
+
+// Utility class to request status of transactions from many concurrent callers.
+// Status requests to the same status tablet are sent one at a time. Requests that are added while
+// the request to their status tablet is in flight are sent together in the next request, so
+// number of RPCs to the status tablet does not grow with the number of resolved transactions.
+class TransactionStatusRequestBatcher {
+ public:
+  TransactionStatusRequestBatcher(
+      TransactionParticipantContext* participant_context, rpc::Rpcs* rpcs,
+      int max_transactions_per_request);
+  ~TransactionStatusRequestBatcher();
+
+  // Fails all queued requests, and all requests that are added after this call.
+  // Requests in flight are completed when rpcs is shutdown.
+  void Shutdown();
+
+  // Requests status of the transaction from the status tablet.
+  // Callback is invoked with the response that contains status of this transaction only, as if
+  // it was requested alone.
+  void Request(
+      const TabletId& status_tablet, const TransactionId& transaction_id,
+      TransactionStatusResponseCallback callback);
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
 } // namespace tablet
 } // namespace yb
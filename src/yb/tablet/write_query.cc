@@ -219,6 +219,7 @@ void WriteQuery::Finished(WriteOperation* operation, const Status& status) {
       auto op_duration_usec =
           MonoDelta(CoarseMonoClock::now() - start_time_).ToMicroseconds();
       metrics->ql_write_latency->Increment(op_duration_usec);
+      metrics->tablet_write_ops->Increment();
     }
   }
 
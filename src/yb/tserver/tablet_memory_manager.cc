@@ -76,6 +76,27 @@ DEFINE_UNKNOWN_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_NON_RUNTIME_string(db_block_cache_type, "lru",
+    "Eviction policy of the block cache: lru or clock. Lookups in clock cache do not take any "
+    "locks, so it has less contention when many threads read hot blocks, but it does not "
+    "separate single touch and multi touch blocks.");
+TAG_FLAG(db_block_cache_type, advanced);
+
+namespace {
+
+bool ValidateBlockCacheType(const char* flag_name, const std::string& value) {
+  if (value == "lru" || value == "clock") {
+    return true;
+  }
+  LOG(ERROR) << "Invalid value for '" << flag_name << "': " << value
+             << ", should be lru or clock";
+  return false;
+}
+
+} // namespace
+
+DEFINE_validator(db_block_cache_type, &ValidateBlockCacheType);
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
@@ -196,8 +217,13 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+    if (FLAGS_db_block_cache_type == "clock") {
+      options->block_cache = rocksdb::NewClockCache(block_cache_size_bytes,
+                                                    FLAGS_db_block_cache_num_shard_bits);
+    } else {
+      options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
+                                                  FLAGS_db_block_cache_num_shard_bits);
+    }
     options->block_cache->SetMetrics(metrics);
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
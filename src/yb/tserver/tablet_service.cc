@@ -48,6 +48,7 @@
 #include "yb/common/ql_wire_protocol.h"
 #include "yb/common/row_mark.h"
 #include "yb/common/schema.h"
+#include "yb/common/wire_protocol.h"
 #include "yb/consensus/leader_lease.h"
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/consensus_util.h"
@@ -1098,6 +1099,76 @@ void TabletServiceImpl::UpdateTransaction(const UpdateTransactionRequestPB* req,
   }
 }
 
+void TabletServiceImpl::UpdateTransactions(const UpdateTransactionsRequestPB* req,
+                                           UpdateTransactionsResponsePB* resp,
+                                           rpc::RpcContext context) {
+  TRACE("UpdateTransactions");
+
+  VLOG(1) << "UpdateTransactions: " << req->tablet_id() << ", " << req->states_size()
+          << " transactions, context: " << context.ToString();
+  UpdateClock(*req, server_->Clock());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  auto* coordinator = tablet.tablet->transaction_coordinator();
+  if (!coordinator) {
+    SetupErrorAndRespond(
+        resp->mutable_error(),
+        STATUS(InvalidArgument, "Does not have transaction coordinator to process heartbeats"),
+        &context);
+    return;
+  }
+
+  // Operations are completed independently, the last completed one sends the response.
+  struct BatchState {
+    explicit BatchState(rpc::RpcContext context_) : context(std::move(context_)) {}
+
+    rpc::RpcContext context;
+    std::atomic<size_t> pending_operations{0};
+  };
+
+  auto batch_state = std::make_shared<BatchState>(std::move(context));
+  tablet::UpdateTxnOperations operations;
+  operations.reserve(req->states_size());
+  for (int i = 0; i != req->states_size(); ++i) {
+    auto* status_pb = resp->add_statuses();
+    const auto& state = req->states(i);
+    if (state.status() != TransactionStatus::PENDING) {
+      StatusToPB(STATUS_FORMAT(InvalidArgument, "Unexpected status in batch of heartbeats: $0",
+                               TransactionStatus_Name(state.status())),
+                 status_pb);
+      continue;
+    }
+    StatusToPB(Status::OK(), status_pb);
+    auto operation = std::make_unique<tablet::UpdateTxnOperation>(tablet.tablet);
+    operation->AllocateRequest()->CopyFrom(state);
+    operation->set_completion_callback(
+        [batch_state, resp, i, clock = server_->Clock()](const Status& status) {
+      if (!status.ok()) {
+        StatusToPB(status, resp->mutable_statuses(i));
+      }
+      if (batch_state->pending_operations.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        resp->set_propagated_hybrid_time(clock->Now().ToUint64());
+        batch_state->context.RespondSuccess();
+      }
+    });
+    operations.push_back(std::move(operation));
+  }
+
+  if (operations.empty()) {
+    resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+    batch_state->context.RespondSuccess();
+    return;
+  }
+
+  batch_state->pending_operations = operations.size();
+  coordinator->HandleBatch(std::move(operations), tablet.leader_term);
+}
+
 template <class Req, class Resp, class Action>
 void TabletServiceImpl::PerformAtLeader(
     const Req& req, Resp* resp, rpc::RpcContext* context, const Action& action) {
@@ -1901,17 +1972,20 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
 }
 
 ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& metric_entity,
-                                           TabletPeerLookupIf* tablet_manager)
+                                           TabletPeerLookupIf* tablet_manager,
+                                           rpc::ThreadPool* thread_pool)
     : ConsensusServiceIf(metric_entity),
-      tablet_manager_(tablet_manager) {
+      tablet_manager_(tablet_manager),
+      thread_pool_(thread_pool) {
 }
 
 ConsensusServiceImpl::~ConsensusServiceImpl() {
 }
 
-void ConsensusServiceImpl::CompleteUpdateConsensusResponse(
-    std::shared_ptr<tablet::TabletPeer> tablet_peer,
-    consensus::LWConsensusResponsePB* resp) {
+namespace {
+
+void CompleteUpdateConsensusResponse(
+    const TabletPeerPtr& tablet_peer, consensus::LWConsensusResponsePB* resp) {
   auto tablet = tablet_peer->shared_tablet();
   if (tablet) {
     resp->set_num_sst_files(tablet->GetCurrentVersionNumSSTFiles());
@@ -1919,61 +1993,141 @@ void ConsensusServiceImpl::CompleteUpdateConsensusResponse(
   resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
 }
 
+// State shared by the tablet updates of a single MultiRaftUpdateConsensus call. The response is
+// sent once the last of the updates completes.
+class MultiRaftUpdateState {
+ public:
+  MultiRaftUpdateState(size_t num_updates, rpc::RpcContext context)
+      : pending_updates_(num_updates), context_(std::move(context)) {}
+
+  rpc::RpcContext& context() {
+    return context_;
+  }
+
+  void UpdateDone() {
+    if (pending_updates_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      context_.RespondSuccess();
+    }
+  }
+
+ private:
+  std::atomic<size_t> pending_updates_;
+  rpc::RpcContext context_;
+};
+
+// Applies a single request from the multi-raft batch to its tablet. The request is passed to
+// consensus as a field of the inbound call, so ops are not copied.
+class MultiRaftUpdateTask : public rpc::ThreadPoolTask {
+ public:
+  MultiRaftUpdateTask(
+      std::shared_ptr<MultiRaftUpdateState> state, TabletPeerPtr tablet_peer,
+      std::shared_ptr<consensus::RaftConsensus> consensus,
+      const consensus::LWConsensusRequestPB* req, consensus::LWConsensusResponsePB* resp)
+      : state_(std::move(state)), tablet_peer_(std::move(tablet_peer)),
+        consensus_(std::move(consensus)), req_(req), resp_(resp) {}
+
+  void Run() override {
+    auto& context = state_->context();
+    // The request is only handed to us as const, but consensus moves ops out of it.
+    auto s = consensus_->Update(
+        rpc::SharedField(
+            context.shared_params(), const_cast<consensus::LWConsensusRequestPB*>(req_)),
+        resp_, context.GetClientDeadline());
+    if (PREDICT_FALSE(!s.ok())) {
+      SetError(s);
+      return;
+    }
+    CompleteUpdateConsensusResponse(tablet_peer_, resp_);
+  }
+
+  void Done(const Status& status) override {
+    if (!status.ok()) {
+      SetError(status);
+    }
+    auto state = std::move(state_);
+    delete this;
+    state->UpdateDone();
+  }
+
+ private:
+  void SetError(const Status& status) {
+    // Clear the response first, since a partially-filled response could
+    // result in confusing a caller, or in having missing required fields
+    // in embedded optional messages.
+    resp_->Clear();
+    SetupError(resp_->mutable_error(), status);
+  }
+
+  std::shared_ptr<MultiRaftUpdateState> state_;
+  TabletPeerPtr tablet_peer_;
+  std::shared_ptr<consensus::RaftConsensus> consensus_;
+  const consensus::LWConsensusRequestPB* req_;
+  consensus::LWConsensusResponsePB* resp_;
+};
+
+} // namespace
+
 void ConsensusServiceImpl::MultiRaftUpdateConsensus(
-      const consensus::MultiRaftConsensusRequestPB *req,
-      consensus::MultiRaftConsensusResponsePB *resp,
-      rpc::RpcContext context) {
-    DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
-    // Effectively performs ConsensusServiceImpl::UpdateConsensus for
-    // each ConsensusRequestPB in the batch but does not fail the entire
-    // batch if a single request fails.
-    for (int i = 0; i < req->consensus_request_size(); i++) {
-      // Unfortunately, we have to use const_cast here,
-      // because the protobuf-generated interface only gives us a const request
-      // but we need to be able to move messages out of the request for efficiency.
-      auto consensus_req = const_cast<ConsensusRequestPB*>(&req->consensus_request(i));
-      auto consensus_resp = resp->add_consensus_response();;
-
-      auto uuid_match_res = CheckUuidMatch(tablet_manager_, "UpdateConsensus", consensus_req,
-                                           context.requestor_string());
-      if (!uuid_match_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), uuid_match_res.status());
-        continue;
-      }
+    const consensus::LWMultiRaftConsensusRequestPB* req,
+    consensus::LWMultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
+  // Effectively performs ConsensusServiceImpl::UpdateConsensus for each ConsensusRequestPB in the
+  // batch but does not fail the entire batch if a single request fails. Updates of different
+  // tablets do not depend on each other, so they are applied concurrently and the response is
+  // sent when all of them are done.
+  std::vector<MultiRaftUpdateTask*> tasks;
+  tasks.reserve(req->consensus_request().size());
+  std::vector<std::pair<const consensus::LWConsensusRequestPB*,
+                        consensus::LWConsensusResponsePB*>> updates;
+  updates.reserve(req->consensus_request().size());
+  for (const auto& consensus_req : req->consensus_request()) {
+    auto* consensus_resp = resp->add_consensus_response();
+    updates.emplace_back(&consensus_req, consensus_resp);
+  }
+
+  auto state = std::make_shared<MultiRaftUpdateState>(updates.size() + 1, std::move(context));
+  auto& call_context = state->context();
+  for (const auto& [consensus_req, consensus_resp] : updates) {
+    auto uuid_match_res = CheckUuidMatch(tablet_manager_, "UpdateConsensus", consensus_req,
+                                         call_context.requestor_string());
+    if (!uuid_match_res.ok()) {
+      SetupError(consensus_resp->mutable_error(), uuid_match_res.status());
+      state->UpdateDone();
+      continue;
+    }
 
-      auto peer_tablet_res = LookupTabletPeer(tablet_manager_, consensus_req->tablet_id());
-      if (!peer_tablet_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), peer_tablet_res.status());
-        continue;
-      }
-      auto tablet_peer = peer_tablet_res.get().tablet_peer;
+    auto peer_tablet_res = LookupTabletPeer(tablet_manager_, consensus_req->tablet_id());
+    if (!peer_tablet_res.ok()) {
+      SetupError(consensus_resp->mutable_error(), peer_tablet_res.status());
+      state->UpdateDone();
+      continue;
+    }
+    auto tablet_peer = peer_tablet_res->tablet_peer;
+
+    // Submit the update directly to the TabletPeer's Consensus instance.
+    auto consensus_res = GetConsensus(tablet_peer);
+    if (!consensus_res.ok()) {
+      SetupError(consensus_resp->mutable_error(), consensus_res.status());
+      state->UpdateDone();
+      continue;
+    }
 
-      // Submit the update directly to the TabletPeer's Consensus instance.
-      auto consensus_res = GetConsensus(tablet_peer);
-      if (!consensus_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), consensus_res.status());
-        continue;
-      }
-      auto consensus = *consensus_res;
-
-      // TODO(lw_uc) effective update for multiraft.
-      auto temp_resp = rpc::MakeSharedMessage<consensus::LWConsensusResponsePB>();
-      Status s = consensus->Update(
-         rpc::CopySharedMessage(*consensus_req),
-         temp_resp.get(), context.GetClientDeadline());
-      if (PREDICT_FALSE(!s.ok())) {
-        // Clear the response first, since a partially-filled response could
-        // result in confusing a caller, or in having missing required fields
-        // in embedded optional messages.
-        consensus_resp->Clear();
-        SetupError(consensus_resp->mutable_error(), s);
-        continue;
-      }
+    tasks.push_back(new MultiRaftUpdateTask(
+        state, std::move(tablet_peer), std::move(*consensus_res), consensus_req, consensus_resp));
+  }
 
-      CompleteUpdateConsensusResponse(tablet_peer, temp_resp.get());
-      temp_resp->ToGoogleProtobuf(consensus_resp);
+  // The last update is applied on the current thread, instead of waiting for a free worker.
+  if (!tasks.empty()) {
+    auto* last_task = tasks.back();
+    tasks.pop_back();
+    for (auto* task : tasks) {
+      thread_pool_->Enqueue(task);
     }
-    context.RespondSuccess();
+    last_task->Run();
+    last_task->Done(Status::OK());
+  }
+  state->UpdateDone();
 }
 
 void ConsensusServiceImpl::UpdateConsensus(const consensus::LWConsensusRequestPB* req,
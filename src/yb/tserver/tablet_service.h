@@ -115,6 +115,10 @@ class TabletServiceImpl : public TabletServerServiceIf, public ReadTabletProvide
                          UpdateTransactionResponsePB* resp,
                          rpc::RpcContext context) override;
 
+  void UpdateTransactions(const UpdateTransactionsRequestPB* req,
+                          UpdateTransactionsResponsePB* resp,
+                          rpc::RpcContext context) override;
+
   void GetTransactionStatus(const GetTransactionStatusRequestPB* req,
                             GetTransactionStatusResponsePB* resp,
                             rpc::RpcContext context) override;
@@ -294,7 +298,8 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
 class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
  public:
   ConsensusServiceImpl(const scoped_refptr<MetricEntity>& metric_entity,
-                       TabletPeerLookupIf* tablet_manager_);
+                       TabletPeerLookupIf* tablet_manager_,
+                       rpc::ThreadPool* thread_pool);
 
   virtual ~ConsensusServiceImpl();
 
@@ -302,8 +307,8 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                        consensus::LWConsensusResponsePB *resp,
                        rpc::RpcContext context) override;
 
-  void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
-                                consensus::MultiRaftConsensusResponsePB *resp,
+  void MultiRaftUpdateConsensus(const consensus::LWMultiRaftConsensusRequestPB *req,
+                                consensus::LWMultiRaftConsensusResponsePB *resp,
                                 rpc::RpcContext context) override;
 
   void RequestConsensusVote(const consensus::VoteRequestPB* req,
@@ -347,9 +352,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                             rpc::RpcContext context) override;
 
  private:
-  void CompleteUpdateConsensusResponse(std::shared_ptr<tablet::TabletPeer> tablet_peer,
-                                       consensus::LWConsensusResponsePB* resp);
   TabletPeerLookupIf* tablet_manager_;
+
+  // Used to apply updates from a multi-raft batch to their tablets concurrently.
+  rpc::ThreadPool* thread_pool_;
 };
 
 }  // namespace tserver
@@ -83,6 +83,7 @@ DECLARE_bool(TEST_tserver_disable_heartbeat);
 DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
 DECLARE_bool(disable_auto_flags_management);
+DECLARE_bool(enable_log_group_sync);
 DECLARE_int32(scheduled_full_compaction_frequency_hours);
 DECLARE_int32(scheduled_full_compaction_jitter_factor_percentage);
 
@@ -708,6 +709,18 @@ TEST_F(TsTabletManagerTest, DataAndWalFilesLocations) {
   }
 }
 
+// Checks that the WAL sync coordinator is created only when enabled, and that tablets work in
+// both modes.
+TEST_F(TsTabletManagerTest, LogGroupSync) {
+  ASSERT_EQ(tablet_manager_->log_sync_coordinator(), nullptr);
+  ASSERT_OK(CreateNewTablet(kTableId, kTabletId, schema_, nullptr));
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_log_group_sync) = true;
+  ASSERT_NO_FATAL_FAILURE(Reload());
+  ASSERT_NE(tablet_manager_->log_sync_coordinator(), nullptr);
+  ASSERT_OK(CreateNewTablet(kTableId, "another-tablet-id", schema_, nullptr));
+}
+
 namespace {
   const HybridTime kNoLastCompact = HybridTime(tablet::kNoLastFullCompactionTime);
   // An arbitrary realistic time.
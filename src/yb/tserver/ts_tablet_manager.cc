@@ -54,6 +54,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
+#include "yb/consensus/log_sync_coordinator.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
@@ -81,6 +82,7 @@
 
 #include "yb/tablet/metadata.pb.h"
 #include "yb/tablet/operations/split_operation.h"
+#include "yb/tablet/shared_transaction_status_cache.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -250,6 +252,11 @@ DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
 DEFINE_UNKNOWN_bool(enable_restart_transaction_status_tablets_first, true,
             "Set to true to prioritize bootstrapping transaction status tablets first.");
 
+DEFINE_NON_RUNTIME_bool(enable_log_group_sync, false,
+    "Perform forced WAL syncs of tablets placed on the same WAL root directory as group syncs, "
+    "coordinated by a node wide log sync coordinator. When disabled, every log syncs its own "
+    "segment independently.");
+
 DECLARE_bool(enable_wait_queues);
 
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
@@ -417,6 +424,13 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                .set_min_threads(1)
                .unlimited_threads()
                .Build(&log_sync_pool_));
+  CHECK_OK(ThreadPoolBuilder("log-read")
+               .set_min_threads(1)
+               .unlimited_threads()
+               .Build(&log_read_pool_));
+  if (FLAGS_enable_log_group_sync) {
+    log_sync_coordinator_ = std::make_unique<log::LogSyncCoordinator>(server_->metric_entity());
+  }
   CHECK_OK(ThreadPoolBuilder("prepare")
                .set_min_threads(1)
                .unlimited_threads()
@@ -473,6 +487,9 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
   tablet_options_.priority_thread_pool_metrics =
       std::make_shared<rocksdb::RocksDBPriorityThreadPoolMetrics>(
           ROCKSDB_PRIORITY_THREAD_POOL_METRICS_INSTANCE(server_->metric_entity()));
+
+  tablet_options_.transaction_status_cache =
+      std::make_shared<tablet::SharedTransactionStatusCache>();
 }
 
 TSTabletManager::~TSTabletManager() {
@@ -1583,6 +1600,8 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
       .append_pool = append_pool(),
       .allocation_pool = allocation_pool_.get(),
       .log_sync_pool = log_sync_pool(),
+      .log_read_pool = log_read_pool_.get(),
+      .log_sync_coordinator = log_sync_coordinator_.get(),
       .retryable_requests = &retryable_requests,
       .bootstrap_retryable_requests = bootstrap_retryable_requests,
       .consensus_meta = cmeta.get(),
@@ -1778,6 +1797,9 @@ void TSTabletManager::CompleteShutdown() {
   if (log_sync_pool_) {
     log_sync_pool_->Shutdown();
   }
+  if (log_read_pool_) {
+    log_read_pool_->Shutdown();
+  }
   if (tablet_prepare_pool_) {
     tablet_prepare_pool_->Shutdown();
   }
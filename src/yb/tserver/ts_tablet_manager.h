@@ -48,6 +48,7 @@
 #include "yb/common/snapshot.h"
 
 #include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/log_fwd.h"
 #include "yb/consensus/metadata.pb.h"
 
 #include "yb/docdb/local_waiting_txn_registry.h"
@@ -168,6 +169,8 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   ThreadPool* read_pool() const { return read_pool_.get(); }
   ThreadPool* append_pool() const { return append_pool_.get(); }
   ThreadPool* log_sync_pool() const { return log_sync_pool_.get(); }
+  // Null unless enable_log_group_sync is set.
+  log::LogSyncCoordinator* log_sync_coordinator() const { return log_sync_coordinator_.get(); }
   ThreadPool* full_compaction_pool() const { return full_compaction_pool_.get(); }
   ThreadPool* waiting_txn_pool() const { return waiting_txn_pool_.get(); }
 
@@ -590,6 +593,13 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Thread pool used to perform fsync operations corresponding to log::Log of each tablet_peer
   std::unique_ptr<ThreadPool> log_sync_pool_;
 
+  // Thread pool used to read log segments ahead of replay during tablet bootstrap.
+  std::unique_ptr<ThreadPool> log_read_pool_;
+
+  // Groups WAL syncs of tablets placed on the same WAL root directory, when enabled by
+  // enable_log_group_sync.
+  std::unique_ptr<log::LogSyncCoordinator> log_sync_coordinator_;
+
   // Thread pool used to open the tablets async, whether bootstrap is required or not.
   std::unique_ptr<ThreadPool> open_tablet_pool_;
 
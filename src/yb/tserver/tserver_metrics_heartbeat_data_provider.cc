@@ -21,6 +21,7 @@
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/xcluster_consumer.h"
@@ -73,6 +74,14 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   bool should_add_replication_status =
       FLAGS_tserver_heartbeat_metrics_add_replication_status && no_full_tablet_report;
 
+  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
+  double_t div = diff.ToSeconds();
+  auto ops_per_sec = [div](uint64_t num_ops, uint64_t prev_num_ops) {
+    return div > 0 && num_ops > prev_num_ops
+        ? static_cast<double>(num_ops - prev_num_ops) / div : 0;
+  };
+  decltype(prev_tablet_ops_) tablet_ops;
+
   for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
     if (tablet_peer) {
       auto tablet = tablet_peer->shared_tablet();
@@ -91,6 +100,18 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
           tablet_metadata->set_uncompressed_sst_file_size(sizes.second);
           tablet_metadata->set_may_have_orphaned_post_split_data(
                 tablet->MayHaveOrphanedPostSplitData());
+
+          auto* tablet_metrics = tablet->metrics();
+          if (tablet_metrics) {
+            auto& ops = tablet_ops[tablet_peer->tablet_id()];
+            ops.first = static_cast<uint64_t>(tablet_metrics->tablet_read_ops->value());
+            ops.second = static_cast<uint64_t>(tablet_metrics->tablet_write_ops->value());
+            auto it = prev_tablet_ops_.find(tablet_peer->tablet_id());
+            if (it != prev_tablet_ops_.end()) {
+              tablet_metadata->set_read_ops_per_sec(ops_per_sec(ops.first, it->second.first));
+              tablet_metadata->set_write_ops_per_sec(ops_per_sec(ops.second, it->second.second));
+            }
+          }
         }
       }
     }
@@ -135,6 +156,8 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
     }
   }
 
+  prev_tablet_ops_ = std::move(tablet_ops);
+
   metrics->set_total_sst_file_size(total_file_sizes);
   metrics->set_uncompressed_sst_file_size(uncompressed_file_sizes);
   metrics->set_num_sst_files(num_files);
@@ -149,9 +172,6 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
   // Calculate the read and write ops per second.
-  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
-  double_t div = diff.ToSeconds();
-
   double rops_per_sec = (div > 0 && num_reads > 0) ?
       (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 
 #include "yb/cdc/cdc_util.h"
 #include "yb/tserver/heartbeater.h"
@@ -37,6 +38,9 @@ class TServerMetricsHeartbeatDataProvider : public PeriodicalHeartbeatDataProvid
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
 
+  // Total read and write ops of every tablet, for computing per tablet iops.
+  std::unordered_map<TabletId, std::pair<uint64_t, uint64_t>> prev_tablet_ops_;
+
   // Stores the previously reported replication errors.
   cdc::TabletReplicationErrorMap prev_replication_error_map_;
 };
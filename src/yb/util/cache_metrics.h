@@ -53,10 +53,14 @@ struct CacheMetrics {
   scoped_refptr<Counter> cache_hits_caching;
   scoped_refptr<Counter> cache_misses;
   scoped_refptr<Counter> cache_misses_caching;
+  scoped_refptr<Counter> single_touch_ghost_hits;
+  scoped_refptr<Counter> multi_touch_ghost_hits;
+  scoped_refptr<Counter> admission_rejections;
 
   scoped_refptr<AtomicGauge<uint64_t> > cache_usage;
   scoped_refptr<AtomicGauge<uint64_t> > single_touch_cache_usage;
   scoped_refptr<AtomicGauge<uint64_t> > multi_touch_cache_usage;
+  scoped_refptr<AtomicGauge<uint64_t> > multi_touch_cache_capacity;
 };
 
 } // namespace yb
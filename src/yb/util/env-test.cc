@@ -60,6 +60,7 @@
 
 DECLARE_int32(o_direct_block_size_bytes);
 DECLARE_bool(TEST_simulate_fs_without_fallocate);
+DECLARE_bool(use_io_uring);
 
 #if !defined(__APPLE__)
 #include <linux/falloc.h>
@@ -584,6 +585,42 @@ TEST_F(TestEnv, TestReadFully) {
   ASSERT_STR_CONTAINS(status.ToString(), "EOF");
 }
 
+TEST_F(TestEnv, TestMultiRead) {
+  const string kTestPath = GetTestPath("test_env_multi_read");
+  const size_t kFileSize = 1024 * 1024;
+  const size_t kMaxReadSize = 32 * 1024;
+  const size_t kNumRequests = 200;
+
+  WriteTestFile(env_.get(), kTestPath, kFileSize);
+  ASSERT_NO_FATALS();
+
+  shared_ptr<RandomAccessFile> raf;
+  ASSERT_OK(env_util::OpenFileForRandom(env_.get(), kTestPath, &raf));
+
+  for (bool use_io_uring : {true, false}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_use_io_uring) = use_io_uring;
+    std::vector<ReadRequest> requests(kNumRequests);
+    std::vector<std::unique_ptr<uint8_t[]>> buffers;
+    for (auto& request : requests) {
+      request.offset = RandomUniformInt<size_t>(0, kFileSize - 1);
+      request.n = RandomUniformInt<size_t>(1, kMaxReadSize);
+      buffers.emplace_back(new uint8_t[request.n]);
+      request.scratch = buffers.back().get();
+    }
+    // Read that crosses EOF should return only available data.
+    requests.back().offset = kFileSize - 100;
+    requests.back().n = 200;
+
+    ASSERT_OK(raf->MultiRead(requests.data(), requests.size()));
+    for (const auto& request : requests) {
+      ASSERT_OK(request.status);
+      ASSERT_EQ(request.result.data(), request.scratch);
+      ASSERT_EQ(std::min(request.n, kFileSize - request.offset), request.result.size());
+      ASSERT_NO_FATALS(VerifyTestData(request.result, request.offset));
+    }
+  }
+}
+
 TEST_P(TestEnv, TestAppendVector) {
   WritableFileOptions opts;
   opts.o_direct = GetParam();
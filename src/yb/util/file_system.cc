@@ -33,6 +33,13 @@ Status RandomAccessFile::Read(uint64_t offset, size_t n, Slice* result, char* sc
   return Read(offset, n, result, reinterpret_cast<uint8_t*>(scratch));
 }
 
+Status RandomAccessFile::MultiRead(ReadRequest* requests, size_t num_requests) const {
+  for (auto* request = requests; request != requests + num_requests; ++request) {
+    request->status = Read(request->offset, request->n, &request->result, request->scratch);
+  }
+  return Status::OK();
+}
+
 Status RandomAccessFile::InvalidateCache(size_t offset, size_t length) {
   return STATUS(NotSupported, "InvalidateCache not supported.");
 }
@@ -18,7 +18,7 @@
 #include "yb/util/coding_consts.h"
 #include "yb/util/io.h"
 #include "yb/util/slice.h"
-#include "yb/util/status_fwd.h"
+#include "yb/util/status.h"
 
 namespace yb {
 
@@ -118,6 +118,18 @@ class ReadValidator {
   virtual ~ReadValidator() = default;
 };
 
+// Single read of RandomAccessFile::MultiRead.
+struct ReadRequest {
+  uint64_t offset = 0;
+  size_t n = 0;
+  // Buffer of at least n bytes, result could point into it.
+  uint8_t* scratch = nullptr;
+
+  // Filled by MultiRead.
+  Slice result;
+  Status status;
+};
+
 // A file abstraction for randomly reading the contents of a file.
 class RandomAccessFile : public FileWithUniqueId {
  public:
@@ -142,6 +154,14 @@ class RandomAccessFile : public FileWithUniqueId {
 
   Status Read(uint64_t offset, size_t n, Slice* result, char* scratch);
 
+  // Performs multiple reads, setting result and status of every request, with the same semantics
+  // as Read. Implementation could keep several reads in flight at the same time, the default
+  // implementation reads them one by one. Returns non OK status only if requests were not
+  // processed at all.
+  //
+  // Safe for concurrent use by multiple threads.
+  virtual Status MultiRead(ReadRequest* requests, size_t num_requests) const;
+
   // Returns the size of the file
   virtual Result<uint64_t> Size() const = 0;
 
@@ -28,6 +28,7 @@
 #include "yb/util/coding.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/errno.h"
+#include "yb/util/io_uring.h"
 #include "yb/util/malloc.h"
 #include "yb/util/result.h"
 #include "yb/util/stats/iostats_context_imp.h"
@@ -204,6 +205,29 @@ Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
   return s;
 }
 
+Status PosixRandomAccessFile::MultiRead(ReadRequest* requests, size_t num_requests) const {
+  ThreadRestrictions::AssertIOAllowed();
+  if (num_requests <= 1 || !IoUringRead(fd_, filename_, requests, num_requests).ok()) {
+    return RandomAccessFile::MultiRead(requests, num_requests);
+  }
+  // io_uring does not retry short reads, so the rest of such read is performed synchronously.
+  // Failed reads are also retried, so errors are reported the same way as Read does.
+  for (auto* request = requests; request != requests + num_requests; ++request) {
+    const size_t size = request->status.ok() ? request->result.size() : 0;
+    if (size == request->n || (size == 0 && request->status.ok())) {
+      continue;
+    }
+    Slice tail;
+    request->status = Read(
+        request->offset + size, request->n - size, &tail, request->scratch + size);
+    request->result = Slice(request->scratch, size + tail.size());
+  }
+  if (!use_os_buffer_) {
+    Fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);  // free OS pages
+  }
+  return Status::OK();
+}
+
 Result<uint64_t> PosixRandomAccessFile::Size() const {
   TRACE_EVENT1("io", __PRETTY_FUNCTION__, "path", filename_);
   ThreadRestrictions::AssertIOAllowed();
@@ -49,6 +49,10 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual Status Read(uint64_t offset, size_t n, Slice* result,
                       uint8_t* scratch) const override;
 
+  // Uses io_uring to keep the reads in flight concurrently when it is available, falls back to
+  // pread otherwise.
+  Status MultiRead(ReadRequest* requests, size_t num_requests) const override;
+
   Result<uint64_t> Size() const override;
 
   Result<uint64_t> INode() const override;
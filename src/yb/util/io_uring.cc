@@ -0,0 +1,367 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/io_uring.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+// Opcode probing and IORING_OP_READ appeared in the same kernel release, so headers without
+// IO_URING_OP_SUPPORTED do not provide everything required.
+#if defined(IO_URING_OP_SUPPORTED)
+#define YB_HAS_IO_URING 1
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "yb/util/errno.h"
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+DEFINE_RUNTIME_bool(use_io_uring, true,
+    "Use io_uring to keep multiple file reads in flight, when batched reads are requested and "
+    "io_uring is supported by the kernel. Otherwise such reads are performed one by one.");
+
+DEFINE_NON_RUNTIME_int32(io_uring_queue_depth, 64,
+    "Max number of reads in flight for io_uring of a single thread. The queue is created on the "
+    "first batched read of the thread and is never resized.");
+
+namespace yb {
+
+#ifdef YB_HAS_IO_URING
+
+namespace {
+
+// Set when io_uring could not be initialized because of missing kernel support or permissions,
+// so other threads do not try it again.
+std::atomic<bool> io_uring_unavailable{false};
+
+int SysIoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int SysIoUringRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+int SysIoUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+unsigned LoadAcquire(const unsigned* ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+void StoreRelease(unsigned* ptr, unsigned value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+template <class T>
+T* RingPtr(void* base, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+// io_uring instance implemented directly over the syscalls, so liburing is not required.
+// Used by a single thread.
+class IoUring {
+ public:
+  static Result<std::unique_ptr<IoUring>> Create(unsigned entries) {
+    std::unique_ptr<IoUring> result(new IoUring());
+    RETURN_NOT_OK(result->Init(entries));
+    return result;
+  }
+
+  ~IoUring() {
+    if (sqes_ != MAP_FAILED) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != MAP_FAILED) {
+      munmap(sq_ring_, sq_ring_size_);
+    }
+    if (ring_fd_ >= 0) {
+      close(ring_fd_);
+    }
+  }
+
+  Status Read(int fd, const std::string& filename, ReadRequest* requests, size_t num_requests);
+
+ private:
+  IoUring() = default;
+
+  Status Init(unsigned entries);
+  Status CheckReadSupported();
+
+  // Waits for completion of reads that were already submitted to the kernel, after
+  // io_uring_enter failed. Reads that were not submitted yet are dropped from the submission
+  // queue.
+  void Drain(
+      const std::string& filename, ReadRequest* requests, size_t num_in_flight,
+      const Status& status);
+
+  // Consumes available completions, returns number of consumed entries.
+  size_t ReapCompletions(const std::string& filename, ReadRequest* requests);
+
+  int ring_fd_ = -1;
+
+  void* sq_ring_ = MAP_FAILED;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = MAP_FAILED;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+  unsigned cq_mask_ = 0;
+};
+
+Status IoUring::Init(unsigned entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = SysIoUringSetup(entries, &params);
+  if (ring_fd_ < 0) {
+    return STATUS_FROM_ERRNO("io_uring_setup", errno);
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    return STATUS_FROM_ERRNO("mmap io_uring submission queue", errno);
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      return STATUS_FROM_ERRNO("mmap io_uring completion queue", errno);
+    }
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = static_cast<io_uring_sqe*>(mmap(
+      nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+      IORING_OFF_SQES));
+  if (sqes_ == MAP_FAILED) {
+    return STATUS_FROM_ERRNO("mmap io_uring submission queue entries", errno);
+  }
+
+  sq_head_ = RingPtr<unsigned>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingPtr<unsigned>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = *RingPtr<unsigned>(sq_ring_, params.sq_off.ring_mask);
+  sq_array_ = RingPtr<unsigned>(sq_ring_, params.sq_off.array);
+  sq_entries_ = params.sq_entries;
+
+  cq_head_ = RingPtr<unsigned>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingPtr<unsigned>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *RingPtr<unsigned>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingPtr<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+  return CheckReadSupported();
+}
+
+Status IoUring::CheckReadSupported() {
+  constexpr size_t kMaxOps = 256;
+  std::vector<char> buffer(sizeof(io_uring_probe) + kMaxOps * sizeof(io_uring_probe_op));
+  auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+  if (SysIoUringRegister(ring_fd_, IORING_REGISTER_PROBE, probe, kMaxOps) < 0) {
+    const int error = errno;
+    // Kernels without opcode probing do not support IORING_OP_READ either.
+    return STATUS_FROM_ERRNO("io_uring_register(IORING_REGISTER_PROBE)",
+                             error == EINVAL ? ENOSYS : error);
+  }
+  if (probe->last_op < IORING_OP_READ ||
+      !(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)) {
+    return STATUS_FROM_ERRNO("IORING_OP_READ", ENOSYS);
+  }
+  return Status::OK();
+}
+
+size_t IoUring::ReapCompletions(const std::string& filename, ReadRequest* requests) {
+  unsigned cq_head = *cq_head_;
+  const unsigned cq_tail = LoadAcquire(cq_tail_);
+  size_t result = 0;
+  for (; cq_head != cq_tail; ++cq_head) {
+    const auto& cqe = cqes_[cq_head & cq_mask_];
+    auto& request = requests[cqe.user_data];
+    if (cqe.res < 0) {
+      request.result = Slice(request.scratch, static_cast<size_t>(0));
+      request.status = STATUS_FROM_ERRNO_SPECIAL_EIO_HANDLING(filename, -cqe.res);
+    } else {
+      request.result = Slice(request.scratch, static_cast<size_t>(cqe.res));
+      request.status = Status::OK();
+    }
+    ++result;
+  }
+  StoreRelease(cq_head_, cq_head);
+  return result;
+}
+
+void IoUring::Drain(
+    const std::string& filename, ReadRequest* requests, size_t num_in_flight,
+    const Status& status) {
+  // Entries that the kernel did not consume were never submitted, so just drop them.
+  const unsigned sq_head = LoadAcquire(sq_head_);
+  num_in_flight -= *sq_tail_ - sq_head;
+  StoreRelease(sq_tail_, sq_head);
+
+  while (num_in_flight > 0) {
+    num_in_flight -= ReapCompletions(filename, requests);
+    if (num_in_flight == 0) {
+      break;
+    }
+    if (SysIoUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+      const int error = errno;
+      if (error != EINTR && error != EAGAIN && error != EBUSY) {
+        // Nothing else could be done here, kernel could still write to the buffers of
+        // the remaining reads.
+        LOG(WARNING) << "Failed to wait for " << num_in_flight << " io_uring reads of "
+                     << filename << " after " << status << ": "
+                     << STATUS_FROM_ERRNO("io_uring_enter", error);
+        return;
+      }
+    }
+  }
+}
+
+Status IoUring::Read(
+    int fd, const std::string& filename, ReadRequest* requests, size_t num_requests) {
+  size_t num_queued = 0;
+  size_t num_completed = 0;
+  size_t num_in_flight = 0;
+  while (num_completed < num_requests) {
+    // Fill submission queue. Number of reads in flight is limited by the submission queue size,
+    // so completion queue, that is at least twice larger, could not overflow.
+    unsigned sq_tail = *sq_tail_;
+    while (num_queued < num_requests && num_in_flight < sq_entries_ &&
+           sq_tail - LoadAcquire(sq_head_) < sq_entries_) {
+      auto& request = requests[num_queued];
+      const auto index = sq_tail & sq_mask_;
+      // IORING_OP_READ keeps the buffer address in the entry itself, so nothing referenced by
+      // the entry could be reused while the read is in flight.
+      auto* sqe = &sqes_[index];
+      memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = IORING_OP_READ;
+      sqe->fd = fd;
+      sqe->off = request.offset;
+      sqe->addr = reinterpret_cast<uint64_t>(request.scratch);
+      sqe->len = static_cast<uint32_t>(request.n);
+      sqe->user_data = num_queued;
+      sq_array_[index] = index;
+      ++sq_tail;
+      ++num_queued;
+      ++num_in_flight;
+    }
+    StoreRelease(sq_tail_, sq_tail);
+
+    const unsigned to_submit = sq_tail - LoadAcquire(sq_head_);
+    if (SysIoUringEnter(ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS) < 0) {
+      const int error = errno;
+      if (error != EINTR && error != EAGAIN && error != EBUSY) {
+        // Could happen only if the ring is in invalid state, so the ring should not be used
+        // anymore. Caller rereads the requests synchronously into the same buffers, so wait
+        // for reads that are already in flight before returning.
+        auto status = STATUS_FROM_ERRNO("io_uring_enter", error);
+        Drain(filename, requests, num_in_flight, status);
+        return status;
+      }
+    }
+
+    const auto num_reaped = ReapCompletions(filename, requests);
+    num_in_flight -= num_reaped;
+    num_completed += num_reaped;
+  }
+  return Status::OK();
+}
+
+thread_local std::unique_ptr<IoUring> thread_io_uring;
+thread_local bool thread_io_uring_failed = false;
+
+IoUring* ThreadLocalIoUring() {
+  if (thread_io_uring || thread_io_uring_failed) {
+    return thread_io_uring.get();
+  }
+  auto result = IoUring::Create(std::max(FLAGS_io_uring_queue_depth, 1));
+  if (!result.ok()) {
+    thread_io_uring_failed = true;
+    const auto error = Errno::ValueFromStatus(result.status());
+    if (error && (*error == ENOSYS || *error == EPERM)) {
+      if (!io_uring_unavailable.exchange(true)) {
+        LOG(WARNING) << "io_uring is not available, falling back to synchronous reads: "
+                     << result.status();
+      }
+    } else {
+      YB_LOG_EVERY_N_SECS(WARNING, 60)
+          << "Failed to initialize io_uring: " << result.status();
+    }
+    return nullptr;
+  }
+  thread_io_uring = std::move(*result);
+  return thread_io_uring.get();
+}
+
+} // namespace
+
+Status IoUringRead(int fd, const std::string& filename, ReadRequest* requests,
+                   size_t num_requests) {
+  if (!FLAGS_use_io_uring || io_uring_unavailable.load(std::memory_order_relaxed)) {
+    return STATUS(NotSupported, "io_uring is disabled");
+  }
+  auto* ring = ThreadLocalIoUring();
+  if (!ring) {
+    return STATUS(NotSupported, "io_uring is not available");
+  }
+  auto status = ring->Read(fd, filename, requests, num_requests);
+  if (!status.ok()) {
+    LOG(WARNING) << "io_uring read failed, falling back to synchronous reads: " << status;
+    thread_io_uring.reset();
+    thread_io_uring_failed = true;
+  }
+  return status;
+}
+
+#else
+
+Status IoUringRead(int fd, const std::string& filename, ReadRequest* requests,
+                   size_t num_requests) {
+  return STATUS(NotSupported, "io_uring is not supported on this platform");
+}
+
+#endif // YB_HAS_IO_URING
+
+} // namespace yb
@@ -0,0 +1,31 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <string>
+
+#include "yb/util/file_system.h"
+
+namespace yb {
+
+// Performs reads of the file descriptor using io_uring of the current thread, keeping up to
+// io_uring_queue_depth reads in flight, and sets result and status of every request.
+// Reads are not retried, so result could be shorter than requested.
+//
+// Returns NotSupported when io_uring is disabled, or is not supported by the kernel or platform.
+// In this case requests are not processed and the caller should fall back to synchronous reads.
+Status IoUringRead(int fd, const std::string& filename, ReadRequest* requests,
+                   size_t num_requests);
+
+} // namespace yb
@@ -15,6 +15,8 @@
 
 #include "yb/yql/cql/ql/exec/exec_context.h"
 
+#include <algorithm>
+
 #include <boost/function.hpp>
 
 #include "yb/client/schema.h"
@@ -22,6 +24,7 @@
 #include "yb/client/transaction.h"
 #include "yb/client/yb_op.h"
 
+#include "yb/common/partition.h"
 #include "yb/common/ql_rowblock.h"
 #include "yb/common/schema.h"
 
@@ -219,6 +222,13 @@ TnodeContext::TnodeContext(const TreeNode* tnode) : tnode_(tnode), start_time_(M
 
 TnodeContext::~TnodeContext() = default;
 
+ParallelScanState* TnodeContext::CreateParallelScan(
+    YBqlReadOpPtr template_op, uint32_t hash_code, uint32_t max_hash_code, size_t max_cursors) {
+  parallel_scan_ = std::make_unique<ParallelScanState>(
+      std::move(template_op), hash_code, max_hash_code, max_cursors);
+  return parallel_scan_.get();
+}
+
 TnodeContext* TnodeContext::AddChildTnode(const TreeNode* tnode) {
   DCHECK(!child_context_);
   child_context_ = std::make_unique<TnodeContext>(tnode);
@@ -461,6 +471,125 @@ Status TnodeContext::ComposeRowsResultForUser(const TreeNode* child_select_node,
 
 //--------------------------------------------------------------------------------------------------
 
+ParallelScanState::ParallelScanState(
+    YBqlReadOpPtr template_op, uint32_t hash_code, uint32_t max_hash_code, size_t max_cursors)
+    : template_op_(std::move(template_op)),
+      max_hash_code_(max_hash_code),
+      max_cursors_(max_cursors),
+      next_hash_code_(hash_code) {
+}
+
+void ParallelScanState::LoadPagingState(const QLPagingStatePB& paging_state) {
+  cursors_.clear();
+  for (const auto& cursor_pb : paging_state.parallel_scan_cursors()) {
+    cursors_.push_back(Cursor { .pb = cursor_pb });
+  }
+  next_hash_code_ = paging_state.parallel_scan_next_hash_code();
+  if (paging_state.has_read_time()) {
+    read_time_ = paging_state.read_time();
+  }
+}
+
+void ParallelScanState::ComposePagingState(QLPagingStatePB* paging_state) const {
+  // Position of the scan is defined by the cursors only.
+  paging_state->clear_next_partition_key();
+  paging_state->clear_next_row_key();
+  paging_state->clear_next_partition_index();
+  paging_state->clear_parallel_scan_cursors();
+  for (const auto& cursor : cursors_) {
+    if (!cursor.finished) {
+      *paging_state->add_parallel_scan_cursors() = cursor.pb;
+    }
+  }
+  paging_state->set_parallel_scan_next_hash_code(next_hash_code_);
+  if (read_time_.has_read_ht()) {
+    *paging_state->mutable_read_time() = read_time_;
+  }
+}
+
+void ParallelScanState::StartCursors(const client::TablePartitionList& partitions) {
+  auto partition_hash_code = [](const PartitionKey& key) -> uint32_t {
+    return key.empty() ? 0 : PartitionSchema::DecodeMultiColumnHashValue(key);
+  };
+  while (cursors_.size() < max_cursors_ && next_hash_code_ <= max_hash_code_) {
+    // The range ends right before the start of the next partition.
+    uint32_t end = max_hash_code_;
+    auto it = std::upper_bound(
+        partitions.begin(), partitions.end(), next_hash_code_,
+        [&partition_hash_code](uint32_t hash_code, const PartitionKey& key) {
+          return hash_code < partition_hash_code(key);
+        });
+    if (it != partitions.end()) {
+      end = std::min(end, partition_hash_code(*it) - 1);
+    }
+    Cursor cursor;
+    cursor.pb.set_hash_code(next_hash_code_);
+    cursor.pb.set_max_hash_code(end);
+    cursors_.push_back(std::move(cursor));
+    next_hash_code_ = end + 1;
+  }
+}
+
+std::vector<YBqlReadOpPtr> ParallelScanState::PrepareOps(int64_t max_rows) {
+  std::vector<YBqlReadOpPtr> result;
+  const auto num_ops = std::min<int64_t>(cursors_.size(), max_rows);
+  if (num_ops <= 0) {
+    return result;
+  }
+  result.reserve(num_ops);
+  for (int64_t i = 0; i != num_ops; ++i) {
+    auto& cursor = cursors_[i];
+    YBqlReadOpPtr op(template_op_->table()->NewQLSelect());
+    auto* req = op->mutable_request();
+    req->CopyFrom(template_op_->request());
+    req->set_hash_code(cursor.pb.hash_code());
+    req->set_max_hash_code(cursor.pb.max_hash_code());
+    // Split the rows between the cursors evenly.
+    req->set_limit(max_rows / num_ops + (i < max_rows % num_ops ? 1 : 0));
+    req->clear_offset();
+    req->set_return_paging_state(true);
+    req->clear_paging_state();
+    if (!cursor.pb.next_partition_key().empty() || !cursor.pb.next_row_key().empty()) {
+      auto* paging_state = req->mutable_paging_state();
+      paging_state->set_next_partition_key(cursor.pb.next_partition_key());
+      paging_state->set_next_row_key(cursor.pb.next_row_key());
+    }
+    op->set_yb_consistency_level(template_op_->yb_consistency_level());
+    cursor.op = op;
+    result.push_back(std::move(op));
+  }
+  return result;
+}
+
+void ParallelScanState::UpdateCursor(const client::YBqlReadOp& op) {
+  for (auto& cursor : cursors_) {
+    if (cursor.op.get() != &op) {
+      continue;
+    }
+    cursor.op = nullptr;
+    const auto& response = op.response();
+    const auto& paging_state = response.paging_state();
+    if (!response.has_paging_state() ||
+        (paging_state.next_partition_key().empty() && paging_state.next_row_key().empty())) {
+      cursor.finished = true;
+      return;
+    }
+    cursor.pb.set_next_partition_key(paging_state.next_partition_key());
+    cursor.pb.set_next_row_key(paging_state.next_row_key());
+    if (paging_state.has_read_time()) {
+      read_time_ = paging_state.read_time();
+    }
+    return;
+  }
+  LOG(DFATAL) << "Parallel scan cursor not found for op: " << op.ToString();
+}
+
+void ParallelScanState::RemoveFinishedCursors() {
+  std::erase_if(cursors_, [](const Cursor& cursor) { return cursor.finished; });
+}
+
+//--------------------------------------------------------------------------------------------------
+
 QueryPagingState::QueryPagingState(const StatementParameters& user_params,
                                    bool is_top_level_read_node)
     : max_fetch_size_(user_params.page_size()) {
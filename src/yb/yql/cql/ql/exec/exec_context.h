@@ -20,6 +20,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <rapidjson/document.h>
 
@@ -208,6 +209,10 @@ class QueryPagingState {
     return query_pb_;
   }
 
+  QLPagingStatePB* mutable_query_pb() {
+    return &query_pb_;
+  }
+
   const QLSelectRowCounterPB& counter_pb() const {
     return counter_pb_;
   }
@@ -246,6 +251,64 @@ class QueryPagingState {
   int64_t max_fetch_size_ = -1;
 };
 
+// State of a parallel scan, i.e. a full table or token range SELECT of a hash partitioned table
+// that reads hash code ranges of several tablets concurrently.
+//
+// Every range is read by its own cursor. Positions of the cursors are kept in the paging state
+// between user requests, so rows are returned in hash code order within a range but not across
+// ranges. Rows requested by all cursors at once are limited by the remaining fetch size of the
+// page, so a page never contains more rows than the serial scan would return.
+class ParallelScanState {
+ public:
+  // Scans hash codes in range [hash_code, max_hash_code] reading up to max_cursors ranges at once.
+  ParallelScanState(
+      client::YBqlReadOpPtr template_op, uint32_t hash_code, uint32_t max_hash_code,
+      size_t max_cursors);
+
+  // Loads positions of the scan from the paging state of the user request.
+  void LoadPagingState(const QLPagingStatePB& paging_state);
+
+  // Writes positions of the scan to the paging state to be sent to the user.
+  void ComposePagingState(QLPagingStatePB* paging_state) const;
+
+  // Starts cursors for ranges that were not read yet, up to max_cursors. Ranges are split at the
+  // boundaries of the specified partitions, so every cursor reads a single tablet.
+  void StartCursors(const client::TablePartitionList& partitions);
+
+  // Creates ops to read the next rows of active cursors, that read up to max_rows rows in total.
+  std::vector<client::YBqlReadOpPtr> PrepareOps(int64_t max_rows);
+
+  // Updates position of the cursor read by op, according to the paging state of its response.
+  void UpdateCursor(const client::YBqlReadOp& op);
+
+  // Removes cursors that reached the end of their ranges.
+  void RemoveFinishedCursors();
+
+  // Whether all ranges were read.
+  bool finished() const {
+    return cursors_.empty() && next_hash_code_ > max_hash_code_;
+  }
+
+ private:
+  struct Cursor {
+    QLScanCursorPB pb;
+    // Op that reads the cursor in the current round, if any.
+    client::YBqlReadOpPtr op;
+    bool finished = false;
+  };
+
+  // Op to copy the read request of the scan from.
+  const client::YBqlReadOpPtr template_op_;
+  const uint32_t max_hash_code_;
+  const size_t max_cursors_;
+
+  std::vector<Cursor> cursors_;
+  // First hash code that does not belong to any cursor.
+  uint32_t next_hash_code_;
+  // Read time of the scan, that should be used by the next pages.
+  ReadHybridTimePB read_time_;
+};
+
 class TnodeContext {
  public:
   explicit TnodeContext(const TreeNode* tnode);
@@ -352,6 +415,19 @@ class TnodeContext {
     partitions_count_ = count;
   }
 
+  // Access functions for parallel scan state.
+  ParallelScanState* CreateParallelScan(
+      client::YBqlReadOpPtr template_op, uint32_t hash_code, uint32_t max_hash_code,
+      size_t max_cursors);
+
+  ParallelScanState* parallel_scan() {
+    return parallel_scan_.get();
+  }
+
+  void ResetParallelScan() {
+    parallel_scan_.reset();
+  }
+
   // Access functions for child tnode context.
   TnodeContext* AddChildTnode(const TreeNode* tnode);
 
@@ -450,6 +526,9 @@ class TnodeContext {
   // Child context for nested statement.
   std::unique_ptr<TnodeContext> child_context_;
 
+  // State of the parallel scan, if the SELECT is executed as a parallel scan.
+  std::unique_ptr<ParallelScanState> parallel_scan_;
+
   // Select op template and primary keys for fetching from indexed table in an uncovered query.
   client::YBqlReadOpPtr uncovered_select_op_;
   std::unique_ptr<QLRowBlock> keys_;
@@ -22,6 +22,7 @@ namespace yb {
 namespace ql {
 
 class ExecContext;
+class ParallelScanState;
 class QueryPagingState;
 class Rescheduler;
 class TnodeContext;
@@ -28,6 +28,7 @@
 #include "yb/common/consistent_read_point.h"
 #include "yb/common/index.h"
 #include "yb/common/index_column.h"
+#include "yb/common/partition.h"
 #include "yb/common/ql_protocol_util.h"
 #include "yb/common/ql_rowblock.h"
 #include "yb/common/ql_value.h"
@@ -46,6 +47,7 @@
 #include "yb/util/trace.h"
 
 #include "yb/yql/cql/ql/exec/exec_context.h"
+#include "yb/yql/cql/ql/exec/request_template.h"
 #include "yb/yql/cql/ql/ptree/column_desc.h"
 #include "yb/yql/cql/ql/ptree/parse_tree.h"
 #include "yb/yql/cql/ql/ptree/pt_alter_keyspace.h"
@@ -111,6 +113,15 @@ DEFINE_UNKNOWN_bool(ycql_serial_operation_in_transaction_block, true,
             "If true, operations within a transaction block must be executed in order, "
             "at least semantically speaking.");
 
+DEFINE_RUNTIME_int32(ycql_parallel_scan_max_tablets, 1,
+    "Max number of tablets that a full table or token range SELECT reads concurrently. When it "
+    "is greater than 1, rows of different tablets are not returned in token order. "
+    "1 to scan tablets one by one.");
+
+DEFINE_RUNTIME_int32(ycql_parallel_scan_max_rows_in_flight, 10000,
+    "Max number of rows requested by the concurrent reads of a parallel scan at once, in addition "
+    "to the page size limit. 0 for no limit.");
+
 extern ErrorCode QLStatusToErrorCode(QLResponsePB::QLStatus status);
 
 Executor::Executor(QLEnv* ql_env, AuditLogger* audit_logger, Rescheduler* rescheduler,
@@ -928,6 +939,13 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   YBqlReadOpPtr select_op(table->NewQLSelect());
   QLReadRequestPB *req = select_op->mutable_request();
 
+  // Prepared statement with template: selected list and referenced columns are already set.
+  // Merge keeps the fields set by NewQLSelect, such as schema version and request id.
+  const RequestTemplate* request_template = GetRequestTemplate(tnode);
+  if (request_template) {
+    req->MergeFrom(request_template->read_request);
+  }
+
   // Where clause - Hash, range, and regular columns.
   req->set_is_aggregate(tnode->is_aggregate());
   Result<uint64_t> max_rows_estimate = WhereClauseToPB(req, tnode->key_where_ops(),
@@ -950,31 +968,34 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
 
   req->set_is_forward_scan(tnode->is_forward_scan());
 
-  // Specify selected list by adding the expressions to selected_exprs in read request.
-  QLRSRowDescPB *rsrow_desc_pb = req->mutable_rsrow_desc();
-  for (const auto& expr : tnode->selected_exprs()) {
-    if (expr->opcode() == TreeNodeOpcode::kPTAllColumns) {
-      const Status s = PTExprToPB(static_cast<const PTAllColumns*>(expr.get()), req);
-      if (PREDICT_FALSE(!s.ok())) {
-        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
-      }
-    } else {
-      const Status s = PTExprToPB(expr, req->add_selected_exprs());
-      if (PREDICT_FALSE(!s.ok())) {
-        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
-      }
+  Status s;
+  if (!request_template) {
+    // Specify selected list by adding the expressions to selected_exprs in read request.
+    QLRSRowDescPB *rsrow_desc_pb = req->mutable_rsrow_desc();
+    for (const auto& expr : tnode->selected_exprs()) {
+      if (expr->opcode() == TreeNodeOpcode::kPTAllColumns) {
+        s = PTExprToPB(static_cast<const PTAllColumns*>(expr.get()), req);
+        if (PREDICT_FALSE(!s.ok())) {
+          return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
+        }
+      } else {
+        s = PTExprToPB(expr, req->add_selected_exprs());
+        if (PREDICT_FALSE(!s.ok())) {
+          return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
+        }
 
-      // Add the expression metadata (rsrow descriptor).
-      QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
-      rscol_desc_pb->set_name(expr->QLName());
-      expr->rscol_type_PB(rscol_desc_pb->mutable_ql_type());
+        // Add the expression metadata (rsrow descriptor).
+        QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
+        rscol_desc_pb->set_name(expr->QLName());
+        expr->rscol_type_PB(rscol_desc_pb->mutable_ql_type());
+      }
     }
-  }
 
-  // Setup the column values that need to be read.
-  Status s = ColumnRefsToPB(tnode, req->mutable_column_refs());
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    // Setup the column values that need to be read.
+    s = ColumnRefsToPB(tnode, req->mutable_column_refs());
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    }
   }
 
   // Set the IF clause.
@@ -1057,6 +1078,10 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   if (req->has_max_hash_code())
     tnode_context->set_max_hash_code_from_partition_key_ops(req->max_hash_code());
 
+  if (VERIFY_RESULT(StartParallelScan(tnode, select_op, continue_user_request, tnode_context))) {
+    return Status::OK();
+  }
+
   // If we have several hash partitions (i.e. IN condition on hash columns) we initialize the
   // start partition here, and then iteratively scan the rest in FetchMoreRows.
   // Otherwise, the request will already have the right hashed column values set.
@@ -1096,6 +1121,108 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   return Status::OK();
 }
 
+namespace {
+
+bool CanScanInParallel(const PTSelectStmt* tnode, const QLReadRequestPB& req,
+                       const TnodeContext& tnode_context) {
+  // Only leaf scans of all hash keys in a token range, that return rows in pages and do not skip
+  // rows, could be split between tablets.
+  return tnode->IsTopLevelReadNode() && !tnode->child_select() && !tnode->is_system() &&
+         !tnode->is_aggregate() && !tnode->offset() && !req.distinct() && req.has_limit() &&
+         req.is_forward_scan() && req.hashed_column_values().empty() &&
+         tnode_context.UnreadPartitionsRemaining() == 0 &&
+         tnode->table()->partition_schema().IsHashPartitioning();
+}
+
+} // namespace
+
+Result<bool> Executor::StartParallelScan(const PTSelectStmt* tnode,
+                                         const YBqlReadOpPtr& select_op,
+                                         bool continue_user_request,
+                                         TnodeContext* tnode_context) {
+  const auto& user_paging_state = tnode_context->query_state()->query_pb();
+  const bool continue_parallel_scan =
+      continue_user_request && user_paging_state.has_parallel_scan_next_hash_code();
+  if (!continue_parallel_scan) {
+    // Scan that was started serially is continued serially.
+    if (FLAGS_ycql_parallel_scan_max_tablets <= 1 || continue_user_request ||
+        exec_context_->HasTransaction() ||
+        !CanScanInParallel(tnode, select_op->request(), *tnode_context)) {
+      return false;
+    }
+  }
+
+  const auto& req = select_op->request();
+  auto* scan = tnode_context->CreateParallelScan(
+      select_op, req.has_hash_code() ? req.hash_code() : 0,
+      req.has_max_hash_code() ? req.max_hash_code() : PartitionSchema::kMaxPartitionKey,
+      std::max(FLAGS_ycql_parallel_scan_max_tablets, 1));
+  if (continue_parallel_scan) {
+    scan->LoadPagingState(user_paging_state);
+  }
+  scan->StartCursors(*tnode->table()->GetPartitionsShared());
+  if (!AddParallelScanOps(tnode_context)) {
+    tnode_context->ResetParallelScan();
+    RETURN_NOT_OK(GenerateEmptyResult(tnode));
+  }
+  return true;
+}
+
+bool Executor::AddParallelScanOps(TnodeContext* tnode_context) {
+  const auto* query_state = tnode_context->query_state();
+  int64_t max_rows = query_state->max_fetch_size() - tnode_context->row_count();
+  if (FLAGS_ycql_parallel_scan_max_rows_in_flight > 0) {
+    max_rows = std::min<int64_t>(max_rows, FLAGS_ycql_parallel_scan_max_rows_in_flight);
+  }
+  auto ops = tnode_context->parallel_scan()->PrepareOps(max_rows);
+  for (const auto& op : ops) {
+    AddOperation(op, tnode_context);
+  }
+  return !ops.empty();
+}
+
+Result<bool> Executor::ContinueParallelScan(const PTSelectStmt* tnode,
+                                            TnodeContext* tnode_context) {
+  if (!tnode_context->rows_result()) {
+    return STATUS(InternalError, "Missing result for SELECT operation");
+  }
+
+  auto* scan = tnode_context->parallel_scan();
+  auto* query_state = tnode_context->query_state();
+  scan->RemoveFinishedCursors();
+  if (!query_state->reached_select_limit()) {
+    scan->StartCursors(*tnode->table()->GetPartitionsShared());
+    if (!scan->finished()) {
+      if (AddParallelScanOps(tnode_context)) {
+        return true;
+      }
+
+      // The page is full, return the cursors to the user to continue from.
+      query_state->set_original_request_id(exec_context_->params().request_id());
+      query_state->set_table_id(tnode->table()->id());
+      query_state->set_total_num_rows_read(query_state->read_count());
+      query_state->set_total_rows_skipped(query_state->skip_count());
+      auto* paging_state = query_state->mutable_query_pb();
+      scan->ComposePagingState(paging_state);
+      paging_state->set_schema_version(tnode->table()->schema().version());
+      if (!paging_state->has_read_time()) {
+        const auto read_time = session_->read_point()->GetReadTime();
+        if (read_time) {
+          read_time.ToPB(paging_state->mutable_read_time());
+        }
+      }
+      tnode_context->ResetParallelScan();
+      RETURN_NOT_OK(tnode_context->ComposeRowsResultForUser(nullptr, true /* for_new_batches */));
+      return false;
+    }
+  }
+
+  // Either all ranges were read or the LIMIT clause was reached.
+  tnode_context->ResetParallelScan();
+  RETURN_NOT_OK(tnode_context->ClearQueryState());
+  return false;
+}
+
 Result<QueryPagingState*> Executor::LoadPagingStateFromUser(const PTSelectStmt* tnode,
                                                             TnodeContext* tnode_context) {
   QueryPagingState *query_state = tnode_context->query_state();
@@ -1266,12 +1393,39 @@ Result<bool> Executor::FetchRowsByKeys(const PTSelectStmt* tnode,
 
 //--------------------------------------------------------------------------------------------------
 
+namespace {
+
+ErrorCode ColumnArgsErrorCode(const Status& s) {
+  // Note: INVALID_ARGUMENTS is retryable error code (due to mapping into STALE_METADATA),
+  //       INVALID_REQUEST - non-retryable.
+  return s.code() == Status::kNotSupported || s.code() == Status::kRuntimeError ?
+      ErrorCode::INVALID_REQUEST : ErrorCode::INVALID_ARGUMENTS;
+}
+
+} // namespace
+
 Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_context) {
   // Create write request.
   const shared_ptr<client::YBTable>& table = tnode->table();
   YBqlWriteOpPtr insert_op(table->NewQLInsert());
   QLWriteRequestPB *req = insert_op->mutable_request();
 
+  // Set whether write op writes to the static/primary row.
+  insert_op->set_writes_static_row(tnode->ModifiesStaticRow());
+  insert_op->set_writes_primary_row(tnode->ModifiesPrimaryRow());
+
+  // Prepared statement with template: only values of bind variables should be set.
+  const RequestTemplate* request_template = GetRequestTemplate(tnode);
+  if (request_template) {
+    auto applied = RequestTemplateToPB(tnode, *request_template, req);
+    if (PREDICT_FALSE(!applied.ok())) {
+      return exec_context_->Error(tnode, applied.status(), ColumnArgsErrorCode(applied.status()));
+    }
+    if (*applied) {
+      return AddOperation(insert_op, tnode_context);
+    }
+  }
+
   // Set the ttl.
   Status s = TtlToPB(tnode, req);
   if (PREDICT_FALSE(!s.ok())) {
@@ -1294,13 +1448,7 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_conte
   } else {
     s = ColumnArgsToPB(tnode, req);
     if (PREDICT_FALSE(!s.ok())) {
-      // Note: INVALID_ARGUMENTS is retryable error code (due to mapping into STALE_METADATA),
-      //       INVALID_REQUEST - non-retryable.
-      ErrorCode error_code =
-          s.code() == Status::kNotSupported || s.code() == Status::kRuntimeError ?
-          ErrorCode::INVALID_REQUEST : ErrorCode::INVALID_ARGUMENTS;
-
-      return exec_context_->Error(tnode, s, error_code);
+      return exec_context_->Error(tnode, s, ColumnArgsErrorCode(s));
     }
   }
 
@@ -1324,10 +1472,6 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_conte
     req->set_returns_status(true);
   }
 
-  // Set whether write op writes to the static/primary row.
-  insert_op->set_writes_static_row(tnode->ModifiesStaticRow());
-  insert_op->set_writes_primary_row(tnode->ModifiesPrimaryRow());
-
   // Add the operation.
   return AddOperation(insert_op, tnode_context);
 }
@@ -2110,7 +2254,11 @@ Result<bool> Executor::ProcessTnodeResults(TnodeContext* tnode_context) {
       if (!select_stmt->child_select()) {
         DCHECK_EQ(op->type(), YBOperation::Type::QL_READ);
         const auto& read_op = std::static_pointer_cast<YBqlReadOp>(op);
-        if (VERIFY_RESULT(FetchMoreRows(select_stmt, read_op, tnode_context, exec_context_))) {
+        if (tnode_context->parallel_scan()) {
+          // Reads of a parallel scan are continued together, once all of them are completed.
+          tnode_context->parallel_scan()->UpdateCursor(*read_op);
+        } else if (VERIFY_RESULT(
+            FetchMoreRows(select_stmt, read_op, tnode_context, exec_context_))) {
           op->mutable_response()->Clear();
           TRACE("Apply");
           session_->Apply(op);
@@ -2125,6 +2273,13 @@ Result<bool> Executor::ProcessTnodeResults(TnodeContext* tnode_context) {
     op_itr = ops.erase(op_itr);
   }
 
+  if (tnode_context->parallel_scan() && !tnode_context->HasPendingOperations()) {
+    if (VERIFY_RESULT(ContinueParallelScan(static_cast<const PTSelectStmt*>(tnode),
+                                           tnode_context))) {
+      has_buffered_ops = true;
+    }
+  }
+
   // If there is a child context, process it.
   TnodeContext* child_context = tnode_context->child_context();
   if (child_context != nullptr) {
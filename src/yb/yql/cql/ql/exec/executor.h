@@ -252,6 +252,21 @@ class Executor : public QLExprExecutor {
                              TnodeContext* tnode_context,
                              ExecContext* exec_context);
 
+  // Start a parallel scan when the select is a full table or token range scan that could read
+  // several tablets concurrently, or continue the parallel scan of the user's paging state.
+  // Returns true if the select is executed as a parallel scan.
+  Result<bool> StartParallelScan(const PTSelectStmt* tnode,
+                                 const client::YBqlReadOpPtr& select_op,
+                                 bool continue_user_request,
+                                 TnodeContext* tnode_context);
+
+  // Continue a parallel scan after all reads of the current round are completed.
+  // Returns true if reads of the next round were added.
+  Result<bool> ContinueParallelScan(const PTSelectStmt* tnode, TnodeContext* tnode_context);
+
+  // Add reads of the next round of a parallel scan, unless the page is full.
+  bool AddParallelScanOps(TnodeContext* tnode_context);
+
   // Fetch rows for a select statement using primary keys selected from an uncovered index.
   Result<bool> FetchRowsByKeys(const PTSelectStmt* tnode,
                                const client::YBqlReadOpPtr& select_op,
@@ -366,6 +381,26 @@ class Executor : public QLExprExecutor {
                               const PTInsertJsonClause *json_clause,
                               QLWriteRequestPB *req);
 
+  //------------------------------------------------------------------------------------------------
+  // Request templates of prepared statements.
+
+  // Returns the request template of the statement, building it at the first execution.
+  // Returns null when the statement should be executed without template.
+  const RequestTemplate* GetRequestTemplate(const PTInsertStmt *tnode);
+  const RequestTemplate* GetRequestTemplate(const PTSelectStmt *tnode);
+  template <class Stmt>
+  const RequestTemplate* DoGetRequestTemplate(const Stmt *tnode);
+
+  // Fill in the template, and mark it valid when it is applicable to the statement.
+  Status BuildRequestTemplate(const PTInsertStmt *tnode, RequestTemplate *request_template);
+  Status BuildRequestTemplate(const PTSelectStmt *tnode, RequestTemplate *request_template);
+
+  // Copy the write request from the template and set values of bind variables.
+  // Returns false when some bind variables are unset, so the template is not applicable.
+  Result<bool> RequestTemplateToPB(const PTInsertStmt *tnode,
+                                   const RequestTemplate& request_template,
+                                   QLWriteRequestPB *req);
+
   //------------------------------------------------------------------------------------------------
   // Where clause evaluation.
 
@@ -0,0 +1,232 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "yb/yql/cql/ql/exec/request_template.h"
+
+#include "yb/common/ql_value.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/flags.h"
+#include "yb/util/result.h"
+
+#include "yb/yql/cql/ql/exec/exec_context.h"
+#include "yb/yql/cql/ql/exec/executor.h"
+#include "yb/yql/cql/ql/ptree/column_arg.h"
+#include "yb/yql/cql/ql/ptree/column_desc.h"
+#include "yb/yql/cql/ql/ptree/pt_expr.h"
+#include "yb/yql/cql/ql/ptree/pt_insert.h"
+#include "yb/yql/cql/ql/ptree/pt_select.h"
+#include "yb/yql/cql/ql/util/statement_params.h"
+
+DEFINE_RUNTIME_bool(ycql_use_request_templates, true,
+    "Build the parts of requests of prepared INSERT and SELECT statements that do not depend on "
+    "bind variables once per statement, and only set values of bind variables at execution.");
+
+namespace yb {
+namespace ql {
+
+namespace {
+
+template <class Stmt>
+bool ShouldUseRequestTemplate(const Stmt* tnode) {
+  // Only prepared statements have bind variables. The template is not worth building for a
+  // statement that is executed once.
+  return FLAGS_ycql_use_request_templates && !tnode->bind_variables().empty();
+}
+
+RequestTemplate::BindSlot::Kind BindSlotKind(const ColumnDesc& col_desc) {
+  // Should match CreateQLExpression.
+  if (col_desc.is_hash()) {
+    return RequestTemplate::BindSlot::Kind::kHashColumn;
+  }
+  if (col_desc.is_primary()) {
+    return RequestTemplate::BindSlot::Kind::kRangeColumn;
+  }
+  return RequestTemplate::BindSlot::Kind::kRegularColumn;
+}
+
+int BindSlotIndex(const QLWriteRequestPB& req, RequestTemplate::BindSlot::Kind kind) {
+  switch (kind) {
+    case RequestTemplate::BindSlot::Kind::kHashColumn:
+      return req.hashed_column_values_size();
+    case RequestTemplate::BindSlot::Kind::kRangeColumn:
+      return req.range_column_values_size();
+    case RequestTemplate::BindSlot::Kind::kRegularColumn:
+      return req.column_values_size();
+  }
+  FATAL_INVALID_ENUM_VALUE(RequestTemplate::BindSlot::Kind, kind);
+}
+
+QLExpressionPB* BindSlotExpression(
+    QLWriteRequestPB* req, const RequestTemplate::BindSlot& slot) {
+  switch (slot.kind) {
+    case RequestTemplate::BindSlot::Kind::kHashColumn:
+      return req->mutable_hashed_column_values(slot.index);
+    case RequestTemplate::BindSlot::Kind::kRangeColumn:
+      return req->mutable_range_column_values(slot.index);
+    case RequestTemplate::BindSlot::Kind::kRegularColumn:
+      return req->mutable_column_values(slot.index)->mutable_expr();
+  }
+  FATAL_INVALID_ENUM_VALUE(RequestTemplate::BindSlot::Kind, slot.kind);
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+
+template <class Stmt>
+const RequestTemplate* Executor::DoGetRequestTemplate(const Stmt *tnode) {
+  if (!ShouldUseRequestTemplate(tnode)) {
+    return nullptr;
+  }
+  auto result = tnode->request_template();
+  if (!result) {
+    auto request_template = std::make_shared<RequestTemplate>();
+    auto status = BuildRequestTemplate(tnode, request_template.get());
+    if (!status.ok()) {
+      // The regular execution path reports the error.
+      VLOG(2) << "Failed to build request template: " << status;
+      request_template->valid = false;
+    }
+    result = tnode->SetRequestTemplate(std::move(request_template));
+  }
+  return result->valid ? result : nullptr;
+}
+
+const RequestTemplate* Executor::GetRequestTemplate(const PTInsertStmt *tnode) {
+  return DoGetRequestTemplate(tnode);
+}
+
+const RequestTemplate* Executor::GetRequestTemplate(const PTSelectStmt *tnode) {
+  return DoGetRequestTemplate(tnode);
+}
+
+Status Executor::BuildRequestTemplate(const PTInsertStmt *tnode,
+                                      RequestTemplate *request_template) {
+  // Clauses that are evaluated per execution are not supported.
+  if (tnode->InsertingValue()->opcode() == TreeNodeOpcode::kPTInsertJsonClause ||
+      tnode->ttl_seconds() != nullptr || tnode->user_timestamp_usec() != nullptr ||
+      tnode->if_clause() != nullptr || !tnode->subscripted_col_args().empty() ||
+      !tnode->json_col_args().empty()) {
+    return Status::OK();
+  }
+
+  QLWriteRequestPB *req = &request_template->write_request;
+  for (const ColumnArg& col : tnode->column_args()) {
+    if (!col.IsInitialized()) {
+      continue;
+    }
+
+    const ColumnDesc *col_desc = col.desc();
+    const PTExprPtr& expr = col.expr();
+    if (expr == nullptr) {
+      return Status::OK();
+    }
+
+    switch (expr->expr_op()) {
+      case ExprOperator::kConst: {
+        QLExpressionPB *expr_pb = CreateQLExpression(req, *col_desc);
+        RETURN_NOT_OK(PTExprToPB(expr, expr_pb));
+        if (col_desc->is_primary()) {
+          RETURN_NOT_OK(EvalExpr(expr_pb, QLTableRow::empty_row()));
+          if (expr_pb->has_value() && IsNull(expr_pb->value())) {
+            return Status::OK();
+          }
+        }
+        break;
+      }
+      case ExprOperator::kBindVar: {
+        const auto kind = BindSlotKind(*col_desc);
+        request_template->bind_slots.push_back(RequestTemplate::BindSlot {
+          .kind = kind,
+          .index = BindSlotIndex(*req, kind),
+          .bind_var = static_cast<const PTBindVar*>(expr.get()),
+          .is_primary = col_desc->is_primary(),
+        });
+        CreateQLExpression(req, *col_desc);
+        break;
+      }
+      default:
+        return Status::OK();
+    }
+  }
+
+  RETURN_NOT_OK(ColumnRefsToPB(tnode, req->mutable_column_refs()));
+  if (tnode->returns_status()) {
+    req->set_returns_status(true);
+  }
+
+  request_template->valid = true;
+  return Status::OK();
+}
+
+Status Executor::BuildRequestTemplate(const PTSelectStmt *tnode,
+                                      RequestTemplate *request_template) {
+  // Only selected columns, expressions are evaluated per execution.
+  for (const auto& expr : tnode->selected_exprs()) {
+    if (expr->opcode() != TreeNodeOpcode::kPTAllColumns && expr->expr_op() != ExprOperator::kRef) {
+      return Status::OK();
+    }
+  }
+
+  QLReadRequestPB *req = &request_template->read_request;
+  QLRSRowDescPB *rsrow_desc_pb = req->mutable_rsrow_desc();
+  for (const auto& expr : tnode->selected_exprs()) {
+    if (expr->opcode() == TreeNodeOpcode::kPTAllColumns) {
+      RETURN_NOT_OK(PTExprToPB(static_cast<const PTAllColumns*>(expr.get()), req));
+    } else {
+      RETURN_NOT_OK(PTExprToPB(expr, req->add_selected_exprs()));
+      QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
+      rscol_desc_pb->set_name(expr->QLName());
+      expr->rscol_type_PB(rscol_desc_pb->mutable_ql_type());
+    }
+  }
+  RETURN_NOT_OK(ColumnRefsToPB(tnode, req->mutable_column_refs()));
+
+  request_template->valid = true;
+  return Status::OK();
+}
+
+Result<bool> Executor::RequestTemplateToPB(const PTInsertStmt *tnode,
+                                           const RequestTemplate& request_template,
+                                           QLWriteRequestPB *req) {
+  const auto& params = exec_context_->params();
+  for (const auto& slot : request_template.bind_slots) {
+    // Unset bind variable removes the column from the request, so the template does not fit.
+    if (VERIFY_RESULT(params.IsBindVariableUnset(slot.bind_var->name()->c_str(),
+                                                 slot.bind_var->pos()))) {
+      return false;
+    }
+  }
+
+  // Merge keeps the fields set by NewQLInsert, such as statement type and schema version.
+  req->MergeFrom(request_template.write_request);
+  for (const auto& slot : request_template.bind_slots) {
+    QLExpressionPB *expr_pb = BindSlotExpression(req, slot);
+    RETURN_NOT_OK(PTExprToPB(slot.bind_var, expr_pb));
+    if (!slot.is_primary) {
+      continue;
+    }
+    RETURN_NOT_OK(EvalExpr(expr_pb, QLTableRow::empty_row()));
+    // Null values not allowed for primary key.
+    if (expr_pb->has_value() && IsNull(expr_pb->value())) {
+      return exec_context_->Error(tnode, ErrorCode::NULL_ARGUMENT_FOR_PRIMARY_KEY);
+    }
+  }
+  return true;
+}
+
+}  // namespace ql
+}  // namespace yb
@@ -0,0 +1,63 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// Request templates of prepared DML statements.
+//--------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+
+#include "yb/common/ql_protocol.pb.h"
+
+#include "yb/yql/cql/ql/ptree/ptree_fwd.h"
+
+namespace yb {
+namespace ql {
+
+// Part of the request of a DML statement that does not depend on bind variables. It is built by
+// the executor at the first execution of a prepared statement and shared by all executions of the
+// statement, from all connections, until the statement is reprepared. Executions merge the
+// template into the request created for the table, and only fill in the values of bind variables.
+// So the template should not contain fields that are set on request creation.
+struct RequestTemplate {
+  // Location of the value of a bind variable in the write request.
+  struct BindSlot {
+    enum class Kind {
+      kHashColumn,
+      kRangeColumn,
+      kRegularColumn,
+    };
+
+    Kind kind;
+    // Index of the value in the list of values of its kind.
+    int index;
+    const PTBindVar* bind_var;
+    bool is_primary;
+  };
+
+  // Whether the template is applicable to the statement. When it is not, statement is executed
+  // as usual, and the template is kept only to avoid building it again.
+  bool valid = false;
+
+  // INSERT: request with constant values, and value slots to fill at execution.
+  QLWriteRequestPB write_request;
+  std::vector<BindSlot> bind_slots;
+
+  // SELECT: request with selected expressions, result set descriptor and referenced columns.
+  QLReadRequestPB read_request;
+};
+
+}  // namespace ql
+}  // namespace yb
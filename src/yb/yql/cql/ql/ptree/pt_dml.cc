@@ -112,6 +112,16 @@ PTDmlStmt::PTDmlStmt(MemoryContext *memctx, const PTDmlStmt& other, bool copy_if
 PTDmlStmt::~PTDmlStmt() {
 }
 
+const RequestTemplate* PTDmlStmt::SetRequestTemplate(
+    std::shared_ptr<const RequestTemplate> request_template) const {
+  std::lock_guard lock(request_template_mutex_);
+  if (!request_template_holder_) {
+    request_template_holder_ = std::move(request_template);
+    request_template_.store(request_template_holder_.get(), std::memory_order_release);
+  }
+  return request_template_holder_.get();
+}
+
 size_t PTDmlStmt::num_columns() const {
   return table_->schema().num_columns();
 }
@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <iosfwd>
+#include <memory>
+#include <mutex>
 
 #include "yb/client/client_fwd.h"
 
@@ -412,6 +415,16 @@ class PTDmlStmt : public PTCollection {
     return select_has_primary_keys_set_;
   }
 
+  // Request template of the statement, null until it is built by the first execution.
+  const RequestTemplate* request_template() const {
+    return request_template_.load(std::memory_order_acquire);
+  }
+
+  // Sets the request template, unless it was already set by a concurrent execution.
+  // Returns the template of the statement.
+  const RequestTemplate* SetRequestTemplate(
+      std::shared_ptr<const RequestTemplate> request_template) const;
+
  protected:
 
   template <typename T>
@@ -529,6 +542,12 @@ class PTDmlStmt : public PTCollection {
   MCUnorderedSet<client::YBTablePtr> pk_only_indexes_;
   MCUnorderedSet<TableId> non_pk_only_indexes_;
 
+  // Request template built by the executor. Parse tree of a prepared statement is executed
+  // concurrently by all connections, so the template is published once and never replaced.
+  mutable std::mutex request_template_mutex_;
+  mutable std::shared_ptr<const RequestTemplate> request_template_holder_;
+  mutable std::atomic<const RequestTemplate*> request_template_{nullptr};
+
   // For inter-dependency analysis of DMLs in a batch/transaction
   bool modifies_primary_row_ = false;
   bool modifies_static_row_ = false;
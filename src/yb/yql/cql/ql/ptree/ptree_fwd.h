@@ -85,6 +85,8 @@ class TreeNode;
 class WhereExprState;
 class YBLocation;
 
+struct RequestTemplate;
+
 template<typename NodeType = TreeNode>
 class TreeListNode;
 
@@ -13,6 +13,7 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cmath>
 #include <thread>
 
@@ -43,6 +44,8 @@ using std::unique_ptr;
 using std::shared_ptr;
 using strings::Substitute;
 
+DECLARE_int32(ycql_parallel_scan_max_tablets);
+
 namespace yb {
 namespace ql {
 
@@ -1640,6 +1643,78 @@ TEST_F(TestQLQuery, TestPagination) {
   EXPECT_EQ(55, sum);
 }
 
+namespace {
+
+// Reads all pages of the select, checking that no page is larger than page size, and returns values
+// of the first two columns.
+std::vector<std::pair<int32_t, int32_t>> ReadAllPages(
+    TestQLProcessor* processor, const std::string& select_stmt, int page_size) {
+  std::vector<std::pair<int32_t, int32_t>> result;
+  StatementParameters params;
+  params.set_page_size(page_size);
+  for (;;) {
+    CHECK_OK(processor->Run(select_stmt, params));
+    auto row_block = processor->row_block();
+    CHECK_LE(row_block->row_count(), static_cast<size_t>(page_size));
+    for (const auto& row : row_block->rows()) {
+      result.emplace_back(row.column(0).int32_value(), row.column(1).int32_value());
+    }
+    if (processor->rows_result()->paging_state().empty()) {
+      break;
+    }
+    CHECK_OK(params.SetPagingState(processor->rows_result()->paging_state()));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_F(TestQLQuery, TestParallelScan) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  CHECK_VALID_STMT("CREATE TABLE scan_test (h int, r int, PRIMARY KEY ((h), r));");
+  constexpr int32_t kNumKeys = 50;
+  constexpr int32_t kRowsPerKey = 3;
+  std::vector<std::pair<int32_t, int32_t>> all_rows;
+  for (int32_t h = 0; h != kNumKeys; ++h) {
+    for (int32_t r = 0; r != kRowsPerKey; ++r) {
+      CHECK_VALID_STMT(Substitute("INSERT INTO scan_test (h, r) VALUES ($0, $1);", h, r));
+      all_rows.emplace_back(h, r);
+    }
+  }
+
+  const std::vector<std::string> kSelects = {
+    "SELECT h, r FROM scan_test",
+    "SELECT h, r FROM scan_test WHERE token(h) >= 0",
+  };
+  for (const auto& select_stmt : kSelects) {
+    for (int page_size : {1, 7, 1000}) {
+      ANNOTATE_UNPROTECTED_WRITE(FLAGS_ycql_parallel_scan_max_tablets) = 1;
+      auto serial = ReadAllPages(processor, select_stmt, page_size);
+      ANNOTATE_UNPROTECTED_WRITE(FLAGS_ycql_parallel_scan_max_tablets) = 4;
+      auto parallel = ReadAllPages(processor, select_stmt, page_size);
+
+      // Rows of different tablets could be returned in different order.
+      std::sort(serial.begin(), serial.end());
+      std::sort(parallel.begin(), parallel.end());
+      ASSERT_EQ(serial, parallel) << select_stmt << ", page size: " << page_size;
+    }
+  }
+  auto rows = ReadAllPages(processor, kSelects[0], 7);
+  std::sort(rows.begin(), rows.end());
+  ASSERT_EQ(rows, all_rows);
+
+  // Rows are not read beyond the LIMIT clause.
+  for (int page_size : {1, 7, 1000}) {
+    ASSERT_EQ(ReadAllPages(processor, "SELECT h, r FROM scan_test LIMIT 37", page_size).size(),
+              37U);
+  }
+}
+
 TEST_F(TestQLQuery, TestTokenBcall) {
   TestPartitionHash("token");
 }
@@ -100,6 +100,7 @@ DECLARE_int64(tablet_split_low_phase_shard_count_per_node);
 DECLARE_int64(tablet_split_low_phase_size_threshold_bytes);
 
 DECLARE_uint64(max_clock_skew_usec);
+DECLARE_uint64(ysql_scan_batch_rows);
 
 DECLARE_string(time_source);
 
@@ -525,6 +526,40 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(Simple)) {
   ASSERT_EQ(value, "hello");
 }
 
+// Check that where clauses pushed down to the batched scan, with comparisons of integer columns
+// evaluated over column arrays, filter the same rows as row by row evaluation.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BatchedScanFilter)) {
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (k INT PRIMARY KEY, a SMALLINT, b INT, c BIGINT, d TEXT)"));
+  ASSERT_OK(conn.Execute(
+      "INSERT INTO t SELECT i, (i % 7)::smallint, NULLIF(i % 5, 0), i * 1000000000::bigint, "
+      "'v' || (i % 3) FROM generate_series(1, 500) AS i"));
+
+  const std::vector<std::string> kConditions = {
+    "a = 3",
+    "b <> 2",
+    "b < 3",
+    "3 > b",
+    "c >= 250000000000",
+    "a <= 2 AND c > 100000000000",
+    "b IS NULL",
+    "b = NULL::int",
+    "a > 1 AND d = 'v1'",
+    "b + 1 = 3 AND a <> 4",
+  };
+
+  for (const auto& condition : kConditions) {
+    const auto query = Format("SELECT k, a, b, c, d FROM t WHERE $0 ORDER BY k", condition);
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_scan_batch_rows) = 0;
+    const auto expected = ASSERT_RESULT(conn.FetchAllAsString(query));
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_scan_batch_rows) = 16;
+    const auto batched = ASSERT_RESULT(conn.FetchAllAsString(query));
+    ASSERT_EQ(expected, batched) << "Condition: " << condition;
+  }
+}
+
 TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(Tracing)) {
   FLAGS_enable_tracing = false;
   auto conn = ASSERT_RESULT(Connect());